@@ -7,11 +7,15 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BlackboardData.h"
 #include "Buildings/EnclosureActor.h"
+#include "Core/ZooBehaviorTreeComponent.h"
 
 AAnimalAIController::AAnimalAIController()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
+	// RunBehaviorTree reuses this, so the LOD subsystem can throttle decisions.
+	BrainComponent = CreateDefaultSubobject<UZooBehaviorTreeComponent>(TEXT("BehaviorTreeComponent"));
+
 	AnimalBehaviorTree  = nullptr;
 	AnimalBlackboard    = nullptr;
 	CachedNeedsComponent = nullptr;
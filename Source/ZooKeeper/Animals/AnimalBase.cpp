@@ -4,6 +4,7 @@
 #include "Engine/DataTable.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Subsystems/AnimalManagerSubsystem.h"
+#include "Subsystems/CharacterLODSubsystem.h"
 
 #include "Data/ZooDataTypes.h"
 
@@ -55,10 +56,11 @@ void AAnimalBase::BeginPlay()
 		}
 	}
 
-	// Bind to the needs component's critical delegate so we can re-broadcast.
+	// Bind to the needs component's delegates so we can re-broadcast.
 	if (NeedsComponent)
 	{
 		NeedsComponent->OnNeedCritical.AddDynamic(this, &AAnimalBase::HandleNeedCritical);
+		NeedsComponent->OnNeedChanged.AddDynamic(this, &AAnimalBase::HandleNeedChanged);
 	}
 
 	// Register with the animal manager subsystem.
@@ -68,6 +70,11 @@ void AAnimalBase::BeginPlay()
 		{
 			Manager->RegisterAnimal(this);
 		}
+
+		if (UCharacterLODSubsystem* LODSubsystem = World->GetSubsystem<UCharacterLODSubsystem>())
+		{
+			LODSubsystem->RegisterCharacter(this);
+		}
 	}
 
 	UE_LOG(LogZooKeeper, Log, TEXT("Animal '%s' (Species: %s) spawned. WalkSpeed=%.0f RunSpeed=%.0f"),
@@ -83,6 +90,11 @@ void AAnimalBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		{
 			Manager->UnregisterAnimal(this);
 		}
+
+		if (UCharacterLODSubsystem* LODSubsystem = World->GetSubsystem<UCharacterLODSubsystem>())
+		{
+			LODSubsystem->UnregisterCharacter(this);
+		}
 	}
 
 	Super::EndPlay(EndPlayReason);
@@ -140,3 +152,8 @@ void AAnimalBase::HandleNeedCritical(FName NeedName)
 {
 	OnAnimalNeedCritical.Broadcast(this, NeedName);
 }
+
+void AAnimalBase::HandleNeedChanged(FName NeedName, float NewValue)
+{
+	OnAnimalNeedChanged.Broadcast(this, NeedName, NewValue);
+}
@@ -16,6 +16,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAnimalInspected, AAnimalBase*, An
 /** Broadcast when any of this animal's needs enters the critical range. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAnimalNeedCritical, AAnimalBase*, Animal, FName, NeedName);
 
+/** Broadcast when any of this animal's needs changes value. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAnimalNeedChanged, AAnimalBase*, Animal, FName, NeedName, float, NewValue);
+
 /**
  * AAnimalBase
  *
@@ -103,8 +106,16 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Animal")
 	FOnAnimalNeedCritical OnAnimalNeedCritical;
 
+	/** Re-broadcast of the needs component's OnNeedChanged, so listeners know which animal changed. */
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Animal")
+	FOnAnimalNeedChanged OnAnimalNeedChanged;
+
 private:
 	/** Callback bound to the needs component's OnNeedCritical delegate. */
 	UFUNCTION()
 	void HandleNeedCritical(FName NeedName);
+
+	/** Callback bound to the needs component's OnNeedChanged delegate. */
+	UFUNCTION()
+	void HandleNeedChanged(FName NeedName, float NewValue);
 };
@@ -1,4 +1,6 @@
 #include "AnimalNeedsComponent.h"
+#include "AnimalBase.h"
+#include "Buildings/EnclosureActor.h"
 #include "ZooKeeper.h"
 
 UAnimalNeedsComponent::UAnimalNeedsComponent()
@@ -23,22 +25,32 @@ UAnimalNeedsComponent::UAnimalNeedsComponent()
 	SocialDecayRate    = 0.004f;
 }
 
+void UAnimalNeedsComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UWorld* World = GetWorld())
+	{
+		ModifierSubsystem = World->GetSubsystem<UZooModifierSubsystem>();
+	}
+}
+
 void UAnimalNeedsComponent::TickComponent(float DeltaTime, ELevelTick TickType,
                                            FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// --- Standard decay ---
-	DecayNeed(Hunger,    HungerDecayRate,    DeltaTime, FName("Hunger"));
-	DecayNeed(Thirst,    ThirstDecayRate,    DeltaTime, FName("Thirst"));
-	DecayNeed(Energy,    EnergyDecayRate,    DeltaTime, FName("Energy"));
+	DecayNeed(Hunger,    GetEffectiveDecayRate(EZooModifierStat::HungerDecay, HungerDecayRate), DeltaTime, FName("Hunger"));
+	DecayNeed(Thirst,    GetEffectiveDecayRate(EZooModifierStat::ThirstDecay, ThirstDecayRate), DeltaTime, FName("Thirst"));
+	DecayNeed(Energy,    GetEffectiveDecayRate(EZooModifierStat::EnergyDecay, EnergyDecayRate), DeltaTime, FName("Energy"));
 	DecayNeed(Health,    HealthDecayRate,    DeltaTime, FName("Health"));
-	DecayNeed(Social,    SocialDecayRate,    DeltaTime, FName("Social"));
+	DecayNeed(Social,    GetEffectiveDecayRate(EZooModifierStat::SocialDecay, SocialDecayRate), DeltaTime, FName("Social"));
 
 	// --- Conditional modifiers ---
 
 	// Low energy makes the animal unhappier faster.
-	float EffectiveHappinessDecay = HappinessDecayRate;
+	float EffectiveHappinessDecay = GetEffectiveDecayRate(EZooModifierStat::HappinessDecay, HappinessDecayRate);
 	if (Energy < 0.2f)
 	{
 		EffectiveHappinessDecay += 0.004f;
@@ -154,6 +166,30 @@ float UAnimalNeedsComponent::GetNeedValue(FName NeedName) const
 //  Internals
 // ---------------------------------------------------------------------------
 
+float UAnimalNeedsComponent::GetEffectiveDecayRate(EZooModifierStat Stat, float BaseRate)
+{
+	if (!ModifierSubsystem)
+	{
+		return BaseRate;
+	}
+
+	const AAnimalBase* Animal = Cast<AAnimalBase>(GetOwner());
+	const AActor* Enclosure = Animal ? Animal->CurrentEnclosure : nullptr;
+	const uint32 Version = ModifierSubsystem->GetStatVersion(Stat);
+
+	FCachedDecayRate& Cached = CachedDecayRates[static_cast<int32>(Stat)];
+	if (Cached.Version != Version || Cached.BaseRate != BaseRate || Cached.Enclosure != FObjectKey(Enclosure))
+	{
+		Cached.Version = Version;
+		Cached.BaseRate = BaseRate;
+		Cached.Enclosure = FObjectKey(Enclosure);
+		Cached.EffectiveRate = FMath::Max(0.0f, ModifierSubsystem->GetModifiedValue(Stat, BaseRate, GetOwner(), Enclosure,
+			Animal ? Animal->SpeciesID : NAME_None));
+	}
+
+	return Cached.EffectiveRate;
+}
+
 void UAnimalNeedsComponent::DecayNeed(float& NeedValue, float DecayRate, float DeltaTime, FName NeedName)
 {
 	if (DecayRate <= 0.0f)
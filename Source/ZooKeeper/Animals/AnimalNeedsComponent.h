@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Subsystems/ZooModifierSubsystem.h"
 #include "AnimalNeedsComponent.generated.h"
 
 /** Broadcast whenever a need value changes. */
@@ -15,7 +16,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNeedCritical, FName, NeedName);
  *
  * Tracks the physiological and psychological needs of an animal.
  * Each need is a float in the range [0, 1] where 1 is fully satisfied.
- * Needs decay over time according to configurable rates.
+ * Needs decay over time according to configurable rates, adjusted by the
+ * modifiers of UZooModifierSubsystem.
  */
 UCLASS(ClassGroup = (Zoo), meta = (BlueprintSpawnableComponent, DisplayName = "Animal Needs"))
 class ZOOKEEPER_API UAnimalNeedsComponent : public UActorComponent
@@ -26,6 +28,7 @@ public:
 	UAnimalNeedsComponent();
 
 	//~ Begin UActorComponent Interface
+	virtual void BeginPlay() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	//~ End UActorComponent Interface
 
@@ -52,7 +55,7 @@ public:
 	float Social;
 
 	// -------------------------------------------------------------------
-	//  Decay Rates (units per second)
+	//  Decay Rates (units per second, before modifiers)
 	// -------------------------------------------------------------------
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Animal Needs|Decay", meta = (ClampMin = "0.0"))
@@ -123,6 +126,24 @@ private:
 	/** Critical threshold below which a need fires the OnNeedCritical delegate. */
 	static constexpr float CriticalThreshold = 0.15f;
 
+	/** A decay rate after modifiers, with what it was computed from. */
+	struct FCachedDecayRate
+	{
+		float BaseRate = -1.0f;
+		float EffectiveRate = 0.0f;
+		uint32 Version = MAX_uint32;
+		FObjectKey Enclosure;
+	};
+
+	/** Returns the decay rate for a need stat after modifiers, recomputing it only when its inputs changed. */
+	float GetEffectiveDecayRate(EZooModifierStat Stat, float BaseRate);
+
+	/** Cached rates, indexed by EZooModifierStat (HungerDecay through SocialDecay). */
+	FCachedDecayRate CachedDecayRates[static_cast<int32>(EZooModifierStat::SocialDecay) + 1];
+
+	UPROPERTY(Transient)
+	TObjectPtr<UZooModifierSubsystem> ModifierSubsystem;
+
 	/** Helper: apply decay to a single need, broadcast changes, and check critical state. */
 	void DecayNeed(float& NeedValue, float DecayRate, float DeltaTime, FName NeedName);
 
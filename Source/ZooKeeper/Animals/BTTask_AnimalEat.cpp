@@ -5,7 +5,6 @@
 #include "Buildings/FeederActor.h"
 #include "ZooKeeper.h"
 #include "AIController.h"
-#include "Kismet/GameplayStatics.h"
 
 UBTTask_AnimalEat::UBTTask_AnimalEat()
 {
@@ -37,22 +36,19 @@ EBTNodeResult::Type UBTTask_AnimalEat::ExecuteTask(UBehaviorTreeComponent& Owner
 
 	if (Enclosure)
 	{
-		// Search for a non-empty feeder tagged or within the enclosure area.
-		TArray<AActor*> Feeders;
-		UGameplayStatics::GetAllActorsOfClass(Animal->GetWorld(), AFeederActor::StaticClass(), Feeders);
-
+		// Use the nearest non-empty feeder registered with the enclosure.
 		float NearestDistSq = TNumericLimits<float>::Max();
-		const FVector EnclosureLoc = Enclosure->GetActorLocation();
+		const FVector AnimalLoc = Animal->GetActorLocation();
 
-		for (AActor* Actor : Feeders)
+		for (const TWeakObjectPtr<AFeederActor>& Candidate : Enclosure->GetFeeders())
 		{
-			AFeederActor* CandidateFeeder = Cast<AFeederActor>(Actor);
+			AFeederActor* CandidateFeeder = Candidate.Get();
 			if (!CandidateFeeder || CandidateFeeder->IsEmpty())
 			{
 				continue;
 			}
 
-			const float DistSq = FVector::DistSquared(EnclosureLoc, CandidateFeeder->GetActorLocation());
+			const float DistSq = FVector::DistSquared(AnimalLoc, CandidateFeeder->GetActorLocation());
 			if (DistSq < NearestDistSq)
 			{
 				NearestDistSq = DistSq;
@@ -1,22 +1,46 @@
 #include "BuildingPlacementComponent.h"
 #include "ZooBuildingActor.h"
+#include "BuildingPreviewActor.h"
+#include "PathNetworkActor.h"
 #include "ZooKeeper/ZooKeeper.h"
 #include "ZooKeeper/Subsystems/EconomySubsystem.h"
-#include "Components/StaticMeshComponent.h"
+#include "ZooKeeper/Subsystems/BuildingManagerSubsystem.h"
+#include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "CollisionQueryParams.h"
 
+/** Cache key for a footprint. With a fixed footprint size, the min cell and width identify its cells and orientation. */
+static FIntVector GetFootprintKey(const FIntRect& Cells)
+{
+	return FIntVector(Cells.Min.X, Cells.Min.Y, Cells.Width());
+}
+
 UBuildingPlacementComponent::UBuildingPlacementComponent()
 	: bIsInBuildMode(false)
 	, GridSize(100.0f)
 	, RotationStep(90.0f)
+	, bIsInPathMode(false)
+	, PathDragShape(EPathDragShape::Line)
+	, MaxPathDragCells(4096)
 	, CurrentPlacementYaw(0.0f)
 	, bLastPlacementValid(false)
+	, bGhostOnGround(false)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	CursorTraceDelegate.BindUObject(this, &UBuildingPlacementComponent::HandleCursorTraceCompleted);
+	FootprintOverlapDelegate.BindUObject(this, &UBuildingPlacementComponent::HandleFootprintOverlapCompleted);
+}
+
+void UBuildingPlacementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ExitPathMode();
+	DestroyGhostPreview();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UBuildingPlacementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
@@ -28,6 +52,10 @@ void UBuildingPlacementComponent::TickComponent(float DeltaTime, ELevelTick Tick
 	{
 		UpdatePlacement();
 	}
+	else if (bIsInPathMode)
+	{
+		UpdatePathPainting();
+	}
 }
 
 // -------------------------------------------------------------------
@@ -48,9 +76,16 @@ void UBuildingPlacementComponent::EnterBuildMode()
 		return;
 	}
 
+	if (bIsInPathMode)
+	{
+		ExitPathMode();
+	}
+
 	bIsInBuildMode = true;
 	CurrentPlacementYaw = 0.0f;
 	bLastPlacementValid = false;
+	bGhostOnGround = false;
+	ResetPlacementQueries();
 
 	SpawnGhostPreview();
 
@@ -70,7 +105,13 @@ void UBuildingPlacementComponent::ExitBuildMode()
 	}
 
 	bIsInBuildMode = false;
-	DestroyGhostPreview();
+	ResetPlacementQueries();
+
+	// Keep the preview around for the next build mode; it holds nothing but meshes.
+	if (GhostPreviewActor)
+	{
+		GhostPreviewActor->SetActorHiddenInGame(true);
+	}
 
 	// Disable ticking when not in build mode
 	PrimaryComponentTick.SetTickFunctionEnable(false);
@@ -89,11 +130,11 @@ void UBuildingPlacementComponent::SelectBuilding(TSubclassOf<AZooBuildingActor>
 
 	SelectedBuildingClass = NewBuildingClass;
 	CurrentPlacementYaw = 0.0f;
+	ResetPlacementQueries();
 
-	// If already in build mode, respawn the ghost with the new class
+	// If already in build mode, show the new class on the existing ghost
 	if (bIsInBuildMode)
 	{
-		DestroyGhostPreview();
 		SpawnGhostPreview();
 	}
 
@@ -108,14 +149,30 @@ void UBuildingPlacementComponent::UpdatePlacement()
 		return;
 	}
 
+	// The ghost was moved by last frame's trace; validate where it is now.
+	RequestFootprintCheck();
+
+	const bool bValid = IsPlacementValid();
+	if (bValid != bLastPlacementValid)
+	{
+		UpdateGhostMaterial(bValid);
+		bLastPlacementValid = bValid;
+	}
+
+	QueueCursorTrace();
+}
+
+void UBuildingPlacementComponent::QueueCursorTrace()
+{
 	// Get the player controller that owns this component
 	APlayerController* PC = Cast<APlayerController>(GetOwner());
-	if (!PC)
+	UWorld* World = GetWorld();
+	if (!PC || !World)
 	{
 		return;
 	}
 
-	// Get the camera location and direction for the ground trace
+	// The result arrives next frame. Only the latest trace is applied.
 	FVector CameraLocation;
 	FRotator CameraRotation;
 	PC->GetPlayerViewPoint(CameraLocation, CameraRotation);
@@ -123,43 +180,15 @@ void UBuildingPlacementComponent::UpdatePlacement()
 	const FVector TraceStart = CameraLocation;
 	const FVector TraceEnd = TraceStart + (CameraRotation.Vector() * MaxTraceDistance);
 
-	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GhostPreviewActor);
-	QueryParams.AddIgnoredActor(PC->GetPawn());
-
-	UWorld* World = GetWorld();
-	if (!World)
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BuildingPlacement), false, PC->GetPawn());
+	if (GhostPreviewActor)
 	{
-		return;
+		QueryParams.AddIgnoredActor(GhostPreviewActor);
 	}
 
-	const bool bHit = World->LineTraceSingleByChannel(
-		HitResult,
-		TraceStart,
-		TraceEnd,
-		GroundTraceChannel,
-		QueryParams
-	);
-
-	if (bHit)
-	{
-		// Snap the hit location to the grid
-		FVector SnappedLocation = SnapToGrid(HitResult.Location);
-
-		// Apply current rotation
-		FRotator PlacementRotation = FRotator(0.0f, CurrentPlacementYaw, 0.0f);
-
-		GhostPreviewActor->SetActorLocationAndRotation(SnappedLocation, PlacementRotation);
-
-		// Update validity and ghost material
-		const bool bValid = IsPlacementValid();
-		if (bValid != bLastPlacementValid)
-		{
-			UpdateGhostMaterial(bValid);
-			bLastPlacementValid = bValid;
-		}
-	}
+	CursorTraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+		TraceStart, TraceEnd, GroundTraceChannel, QueryParams,
+		FCollisionResponseParams::DefaultResponseParam, &CursorTraceDelegate);
 }
 
 void UBuildingPlacementComponent::RotatePlacement(float Direction)
@@ -195,46 +224,42 @@ bool UBuildingPlacementComponent::ConfirmPlacement()
 		return false;
 	}
 
+	UBuildingManagerSubsystem* BuildingManager = World->GetSubsystem<UBuildingManagerSubsystem>();
+	if (!BuildingManager)
+	{
+		UE_LOG(LogZooKeeper, Error, TEXT("BuildingPlacement: No BuildingManagerSubsystem to place the building."));
+		return false;
+	}
+
 	// Deduct cost via EconomySubsystem
-	if (AZooBuildingActor* GhostBuilding = Cast<AZooBuildingActor>(GhostPreviewActor))
+	if (const AZooBuildingActor* BuildingDefaults = GetSelectedBuildingDefaults())
 	{
-		const int32 BuildCost = GhostBuilding->PurchaseCost;
+		const int32 BuildCost = BuildingDefaults->PurchaseCost;
 		if (BuildCost > 0)
 		{
 			if (UEconomySubsystem* Economy = World->GetSubsystem<UEconomySubsystem>())
 			{
-				if (!Economy->TrySpend(BuildCost, FString::Printf(TEXT("Building: %s"), *GhostBuilding->BuildingName)))
+				if (!Economy->TrySpend(BuildCost, FString::Printf(TEXT("Building: %s"), *BuildingDefaults->BuildingName), ETransactionCategory::BuildingPurchase))
 				{
 					UE_LOG(LogZooKeeper, Warning, TEXT("BuildingPlacement: Cannot afford building '%s' (cost: %d)."),
-						*GhostBuilding->BuildingName, BuildCost);
+						*BuildingDefaults->BuildingName, BuildCost);
 					return false;
 				}
 			}
 		}
 	}
 
-	// Spawn the real building actor at the ghost's location and rotation
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
+	// Place the real building at the ghost's location and rotation. The manager claims its grid cells.
 	const FVector SpawnLocation = GhostPreviewActor->GetActorLocation();
 	const FRotator SpawnRotation = GhostPreviewActor->GetActorRotation();
 
-	AZooBuildingActor* NewBuilding = World->SpawnActor<AZooBuildingActor>(
-		SelectedBuildingClass,
-		SpawnLocation,
-		SpawnRotation,
-		SpawnParams
-	);
-
+	AZooBuildingActor* NewBuilding = BuildingManager->PlaceBuilding(SelectedBuildingClass, FTransform(SpawnRotation, SpawnLocation));
 	if (!NewBuilding)
 	{
 		UE_LOG(LogZooKeeper, Error, TEXT("BuildingPlacement: Failed to spawn building actor."));
 		return false;
 	}
 
-	NewBuilding->bIsPlaced = true;
-
 	OnBuildingPlacementConfirmed.Broadcast(NewBuilding);
 	UE_LOG(LogZooKeeper, Log, TEXT("BuildingPlacement: Placed building '%s' at %s."),
 		*NewBuilding->BuildingName, *SpawnLocation.ToString());
@@ -264,39 +289,22 @@ bool UBuildingPlacementComponent::IsPlacementValid() const
 		return false;
 	}
 
-	// Check 1: Overlap test - ensure the ghost is not overlapping with existing buildings
-	TArray<AActor*> OverlappingActors;
-	GhostPreviewActor->GetOverlappingActors(OverlappingActors, AZooBuildingActor::StaticClass());
-
-	if (OverlappingActors.Num() > 0)
+	// Check 1: Verify the ghost is on valid terrain (not floating in the air)
+	if (!bGhostOnGround)
 	{
 		return false;
 	}
 
-	// Check 2: Verify the ghost is on valid terrain (not floating in the air)
-	// A simple downward trace from the ghost's position should hit the ground
-	const FVector GhostLocation = GhostPreviewActor->GetActorLocation();
-	FHitResult GroundHit;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GhostPreviewActor);
-
-	const bool bOnGround = World->LineTraceSingleByChannel(
-		GroundHit,
-		GhostLocation + FVector(0.0f, 0.0f, 50.0f),
-		GhostLocation - FVector(0.0f, 0.0f, 200.0f),
-		GroundTraceChannel,
-		QueryParams
-	);
-
-	if (!bOnGround)
+	// Check 2: Ensure the footprint is not occupied by existing buildings
+	if (!IsFootprintClear())
 	{
 		return false;
 	}
 
 	// Check 3: Verify the player can afford the building
-	if (AZooBuildingActor* GhostBuilding = Cast<AZooBuildingActor>(GhostPreviewActor))
+	if (const AZooBuildingActor* BuildingDefaults = GetSelectedBuildingDefaults())
 	{
-		const int32 BuildCost = GhostBuilding->PurchaseCost;
+		const int32 BuildCost = BuildingDefaults->PurchaseCost;
 		if (BuildCost > 0)
 		{
 			if (UEconomySubsystem* Economy = World->GetSubsystem<UEconomySubsystem>())
@@ -313,100 +321,531 @@ bool UBuildingPlacementComponent::IsPlacementValid() const
 }
 
 // -------------------------------------------------------------------
-//  Private Helpers
+//  Path Painting
 // -------------------------------------------------------------------
 
-FVector UBuildingPlacementComponent::SnapToGrid(FVector InLocation) const
+void UBuildingPlacementComponent::EnterPathMode(FName StyleID)
 {
-	if (GridSize <= 0.0f)
+	APathNetworkActor* Network = GetOrSpawnPathNetwork();
+	if (!Network)
 	{
-		return InLocation;
+		return;
 	}
 
-	FVector Snapped;
-	Snapped.X = FMath::RoundToFloat(InLocation.X / GridSize) * GridSize;
-	Snapped.Y = FMath::RoundToFloat(InLocation.Y / GridSize) * GridSize;
-	Snapped.Z = InLocation.Z; // Keep original Z (ground height)
+	const int32 StyleIndex = Network->FindStyleIndex(StyleID);
+	if (StyleIndex == INDEX_NONE)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("BuildingPlacement: Unknown path style '%s'."), *StyleID.ToString());
+		return;
+	}
 
-	return Snapped;
+	if (bIsInBuildMode)
+	{
+		ExitBuildMode();
+	}
+
+	// Switching style mid-drag drops the drag.
+	CancelPathDrag();
+
+	PaintingNetwork = Network;
+	PathStyleIndex = StyleIndex;
+	bPathPreviewDirty = true;
+
+	if (!bIsInPathMode)
+	{
+		bIsInPathMode = true;
+		bCursorOnGround = false;
+		CursorTraceHandle = FTraceHandle();
+		PrimaryComponentTick.SetTickFunctionEnable(true);
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("BuildingPlacement: Painting paths with style '%s'."), *StyleID.ToString());
 }
 
-void UBuildingPlacementComponent::UpdateGhostMaterial(bool bValid)
+void UBuildingPlacementComponent::ExitPathMode()
 {
-	if (!GhostPreviewActor)
+	if (!bIsInPathMode)
 	{
 		return;
 	}
 
-	UMaterialInterface* MaterialToApply = bValid ? ValidPlacementMaterial.Get() : InvalidPlacementMaterial.Get();
-	if (!MaterialToApply)
+	if (APathNetworkActor* Network = PaintingNetwork.Get())
+	{
+		Network->ClearPreview();
+	}
+
+	bIsInPathMode = false;
+	bIsDraggingPath = false;
+	bErasingPath = false;
+	PaintingNetwork.Reset();
+	PathStyleIndex = INDEX_NONE;
+	CursorTraceHandle = FTraceHandle();
+
+	PrimaryComponentTick.SetTickFunctionEnable(false);
+
+	UE_LOG(LogZooKeeper, Log, TEXT("BuildingPlacement: Exited path mode."));
+}
+
+void UBuildingPlacementComponent::BeginPathDrag(bool bErase)
+{
+	if (!bIsInPathMode || !bCursorOnGround)
 	{
 		return;
 	}
 
-	// Apply the material to all static mesh components on the ghost preview
-	TArray<UStaticMeshComponent*> MeshComponents;
-	GhostPreviewActor->GetComponents<UStaticMeshComponent>(MeshComponents);
+	// The hover cell and its height become the start of the drag.
+	bIsDraggingPath = true;
+	bErasingPath = bErase;
+	PathDragStart = PathDragEnd;
+	bPathPreviewDirty = true;
+}
+
+bool UBuildingPlacementComponent::EndPathDrag()
+{
+	if (!bIsInPathMode || !bIsDraggingPath)
+	{
+		return false;
+	}
+
+	TArray<FIntPoint> Cells;
+	const bool bWithinLimit = GetPathDragCells(Cells);
+
+	const bool bErase = bErasingPath;
+	bIsDraggingPath = false;
+	bErasingPath = false;
+	bPathPreviewDirty = true;
 
-	for (UStaticMeshComponent* MeshComp : MeshComponents)
+	if (!bWithinLimit)
 	{
-		if (MeshComp)
+		UE_LOG(LogZooKeeper, Warning, TEXT("BuildingPlacement: Path drag covers more than %d cells."), MaxPathDragCells);
+		return false;
+	}
+
+	APathNetworkActor* Network = PaintingNetwork.Get();
+	if (!Network || Cells.Num() == 0)
+	{
+		return false;
+	}
+
+	if (bErase)
+	{
+		const int32 NumRemoved = Network->RemoveTiles(Cells);
+		OnPathsPainted.Broadcast(-NumRemoved);
+		UE_LOG(LogZooKeeper, Log, TEXT("BuildingPlacement: Erased %d path tiles."), NumRemoved);
+		return NumRemoved > 0;
+	}
+
+	// The whole drag is one purchase.
+	const FZooPathStyle& Style = Network->Styles[PathStyleIndex];
+	const int32 Cost = Cells.Num() * Style.CostPerTile;
+	if (Cost > 0)
+	{
+		if (UEconomySubsystem* Economy = GetWorld()->GetSubsystem<UEconomySubsystem>())
 		{
-			const int32 NumMaterials = MeshComp->GetNumMaterials();
-			for (int32 i = 0; i < NumMaterials; ++i)
+			if (!Economy->TrySpend(Cost, FString::Printf(TEXT("Paths: %d %s tiles"), Cells.Num(), *Style.DisplayName.ToString()), ETransactionCategory::BuildingPurchase))
 			{
-				MeshComp->SetMaterial(i, MaterialToApply);
+				UE_LOG(LogZooKeeper, Warning, TEXT("BuildingPlacement: Cannot afford %d path tiles (cost: %d)."), Cells.Num(), Cost);
+				return false;
 			}
 		}
 	}
+
+	const int32 NumAdded = Network->AddTiles(Cells, PathStyleIndex, PathDragHeight);
+	OnPathsPainted.Broadcast(NumAdded);
+	UE_LOG(LogZooKeeper, Log, TEXT("BuildingPlacement: Laid %d path tiles for %d."), NumAdded, Cost);
+	return NumAdded > 0;
 }
 
-void UBuildingPlacementComponent::DestroyGhostPreview()
+void UBuildingPlacementComponent::CancelPathDrag()
 {
-	if (GhostPreviewActor)
+	if (!bIsDraggingPath)
 	{
-		GhostPreviewActor->Destroy();
-		GhostPreviewActor = nullptr;
+		return;
 	}
+
+	bIsDraggingPath = false;
+	bErasingPath = false;
+	bPathPreviewDirty = true;
 }
 
-void UBuildingPlacementComponent::SpawnGhostPreview()
+int32 UBuildingPlacementComponent::GetPathDragCost() const
 {
-	DestroyGhostPreview();
+	const APathNetworkActor* Network = PaintingNetwork.Get();
+	if (!bIsDraggingPath || bErasingPath || !Network)
+	{
+		return 0;
+	}
 
-	UWorld* World = GetWorld();
-	if (!World || !SelectedBuildingClass)
+	TArray<FIntPoint> Cells;
+	if (!GetPathDragCells(Cells))
+	{
+		return 0;
+	}
+	return Cells.Num() * Network->Styles[PathStyleIndex].CostPerTile;
+}
+
+void UBuildingPlacementComponent::UpdatePathPainting()
+{
+	const UWorld* World = GetWorld();
+	const UBuildingManagerSubsystem* BuildingManager = World ? World->GetSubsystem<UBuildingManagerSubsystem>() : nullptr;
+
+	// The preview is only rebuilt when the cursor enters another cell.
+	if (bCursorOnGround && BuildingManager)
+	{
+		const FIntPoint Cell = BuildingManager->GetFootprintCells(CursorLocation, 0.0f, FIntPoint(1, 1)).Min;
+		if (Cell != PathDragEnd || bPathPreviewDirty)
+		{
+			PathDragEnd = Cell;
+			if (!bIsDraggingPath)
+			{
+				PathDragStart = Cell;
+				PathDragHeight = CursorLocation.Z;
+			}
+			RefreshPathPreview();
+		}
+	}
+
+	QueueCursorTrace();
+}
+
+void UBuildingPlacementComponent::RefreshPathPreview()
+{
+	bPathPreviewDirty = false;
+
+	APathNetworkActor* Network = PaintingNetwork.Get();
+	if (!Network)
 	{
 		return;
 	}
 
+	TArray<FIntPoint> Cells;
+	const bool bWithinLimit = GetPathDragCells(Cells);
+	Network->SetPreview(Cells, PathStyleIndex, PathDragHeight, bWithinLimit);
+}
+
+bool UBuildingPlacementComponent::GetPathDragCells(TArray<FIntPoint>& OutCells) const
+{
+	OutCells.Reset();
+
+	const APathNetworkActor* Network = PaintingNetwork.Get();
+	const UWorld* World = GetWorld();
+	const UBuildingManagerSubsystem* BuildingManager = World ? World->GetSubsystem<UBuildingManagerSubsystem>() : nullptr;
+	if (!Network || !BuildingManager)
+	{
+		return true;
+	}
+
+	// Returns false once the drag has covered MaxPathDragCells.
+	int32 NumVisited = 0;
+	auto Visit = [&](const FIntPoint& Cell)
+	{
+		if (++NumVisited > MaxPathDragCells)
+		{
+			return false;
+		}
+
+		// Laying also checks the cell against enclosure boundaries, which are not in the grid.
+		const bool bHasTile = Network->HasTile(Cell);
+		if (bErasingPath ? bHasTile : (!bHasTile && BuildingManager->IsFootprintFree(FIntRect(Cell, Cell + FIntPoint(1, 1)))))
+		{
+			OutCells.Add(Cell);
+		}
+		return true;
+	};
+
+	if (PathDragShape == EPathDragShape::Area)
+	{
+		const FIntPoint Min = PathDragStart.ComponentMin(PathDragEnd);
+		const FIntPoint Max = PathDragStart.ComponentMax(PathDragEnd);
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				if (!Visit(FIntPoint(X, Y)))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Along X at the start row, then along Y at the end column.
+	const int32 StepX = PathDragEnd.X >= PathDragStart.X ? 1 : -1;
+	const int32 StepY = PathDragEnd.Y >= PathDragStart.Y ? 1 : -1;
+	for (int32 X = PathDragStart.X; ; X += StepX)
+	{
+		if (!Visit(FIntPoint(X, PathDragStart.Y)))
+		{
+			return false;
+		}
+		if (X == PathDragEnd.X)
+		{
+			break;
+		}
+	}
+	for (int32 Y = PathDragStart.Y; Y != PathDragEnd.Y; )
+	{
+		Y += StepY;
+		if (!Visit(FIntPoint(PathDragEnd.X, Y)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+APathNetworkActor* UBuildingPlacementComponent::GetOrSpawnPathNetwork()
+{
+	UWorld* World = GetWorld();
+	UBuildingManagerSubsystem* BuildingManager = World ? World->GetSubsystem<UBuildingManagerSubsystem>() : nullptr;
+	if (!BuildingManager)
+	{
+		UE_LOG(LogZooKeeper, Error, TEXT("BuildingPlacement: No BuildingManagerSubsystem to paint paths on."));
+		return nullptr;
+	}
+
+	if (APathNetworkActor* Network = BuildingManager->GetPathNetwork())
+	{
+		return Network;
+	}
+
+	if (!PathNetworkClass)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("BuildingPlacement: The level has no path network and no PathNetworkClass is set."));
+		return nullptr;
+	}
+
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-	GhostPreviewActor = World->SpawnActor<AZooBuildingActor>(
-		SelectedBuildingClass,
-		FVector::ZeroVector,
-		FRotator::ZeroRotator,
-		SpawnParams
-	);
+	// The network registers itself with the building manager in BeginPlay.
+	APathNetworkActor* Network = World->SpawnActor<APathNetworkActor>(PathNetworkClass, FTransform::Identity, SpawnParams);
+	if (!Network)
+	{
+		UE_LOG(LogZooKeeper, Error, TEXT("BuildingPlacement: Failed to spawn path network."));
+	}
+	return Network;
+}
 
-	if (!GhostPreviewActor)
+// -------------------------------------------------------------------
+//  Private Helpers
+// -------------------------------------------------------------------
+
+bool UBuildingPlacementComponent::IsFootprintClear() const
+{
+	const UWorld* World = GetWorld();
+	const UBuildingManagerSubsystem* BuildingManager = World ? World->GetSubsystem<UBuildingManagerSubsystem>() : nullptr;
+	if (!BuildingManager || FootprintResultsVersion != BuildingManager->GetOccupancyVersion())
+	{
+		return false;
+	}
+
+	const bool* bClear = FootprintResults.Find(GetFootprintKey(GhostCells));
+	return bClear && *bClear;
+}
+
+void UBuildingPlacementComponent::RequestFootprintCheck()
+{
+	const AZooBuildingActor* BuildingDefaults = GetSelectedBuildingDefaults();
+	UWorld* World = GetWorld();
+	const UBuildingManagerSubsystem* BuildingManager = World ? World->GetSubsystem<UBuildingManagerSubsystem>() : nullptr;
+	if (!GhostPreviewActor || !BuildingDefaults || !BuildingManager)
+	{
+		return;
+	}
+
+	// Anything placed or demolished invalidates every cached result.
+	if (FootprintResultsVersion != BuildingManager->GetOccupancyVersion())
+	{
+		ResetPlacementQueries();
+		FootprintResultsVersion = BuildingManager->GetOccupancyVersion();
+	}
+
+	const FVector GhostLocation = GhostPreviewActor->GetActorLocation();
+	GhostCells = BuildingManager->GetFootprintCells(GhostLocation, CurrentPlacementYaw, BuildingDefaults->GridFootprint);
+
+	const FIntVector Key = GetFootprintKey(GhostCells);
+	if (FootprintResults.Contains(Key))
 	{
-		UE_LOG(LogZooKeeper, Error, TEXT("BuildingPlacement: Failed to spawn ghost preview actor."));
 		return;
 	}
 
-	// Disable collision on the ghost so it doesn't block placement
-	GhostPreviewActor->SetActorEnableCollision(false);
+	if (!BuildingDefaults->bIrregularFootprint)
+	{
+		FootprintResults.Add(Key, BuildingManager->IsFootprintFree(GhostCells, BuildingDefaults->bPlaceableInEnclosures));
+		return;
+	}
 
-	// Mark the ghost as not placed (it's just a preview)
-	if (AZooBuildingActor* GhostBuilding = Cast<AZooBuildingActor>(GhostPreviewActor))
+	// The overlap only looks for buildings; path tiles are checked on the grid.
+	if (BuildingManager->HasPathTileInCells(GhostCells))
 	{
-		GhostBuilding->bIsPlaced = false;
+		FootprintResults.Add(Key, false);
+		return;
 	}
 
+	if (FootprintOverlapHandle.IsValid() && PendingFootprintKey == Key)
+	{
+		return;
+	}
+
+	// Irregular shapes are not in the grid; fall back to a box overlap over the footprint cells.
+	// The preview has no collision, so the query runs against the world directly.
+	const float CellSize = UBuildingManagerSubsystem::GridCellSize;
+	const FVector2D CellCenter = FVector2D(GhostCells.Min + GhostCells.Max) * 0.5f;
+	const FVector BoxCenter(CellCenter.X * CellSize, CellCenter.Y * CellSize, GhostLocation.Z + CellSize * 0.5f);
+	const FVector BoxExtent(GhostCells.Width() * CellSize * 0.5f, GhostCells.Height() * CellSize * 0.5f, CellSize * 0.5f);
+
+	// Issuing a new overlap supersedes one still in flight for cells the cursor has left.
+	PendingFootprintKey = Key;
+	FootprintOverlapHandle = World->AsyncOverlapByObjectType(BoxCenter, FQuat::Identity,
+		FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllObjects),
+		FCollisionShape::MakeBox(BoxExtent),
+		FCollisionQueryParams(SCENE_QUERY_STAT(BuildingFootprint)), &FootprintOverlapDelegate);
+}
+
+void UBuildingPlacementComponent::ResetPlacementQueries()
+{
+	FootprintResults.Reset();
+	CursorTraceHandle = FTraceHandle();
+	FootprintOverlapHandle = FTraceHandle();
+}
+
+void UBuildingPlacementComponent::HandleCursorTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	if (Handle != CursorTraceHandle)
+	{
+		return;
+	}
+
+	CursorTraceHandle = FTraceHandle();
+
+	const FHitResult* HitResult = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit ? &Datum.OutHits[0] : nullptr;
+
+	bCursorOnGround = HitResult != nullptr;
+	if (HitResult)
+	{
+		CursorLocation = HitResult->Location;
+	}
+
+	if (!bIsInBuildMode || !GhostPreviewActor)
+	{
+		return;
+	}
+
+	// The cursor trace doubles as the ground check: a hit means there is a surface to build on.
+	bGhostOnGround = HitResult != nullptr;
+
+	if (HitResult)
+	{
+		// Snap the hit location to the grid
+		const FVector SnappedLocation = SnapToGrid(HitResult->Location);
+
+		// Apply current rotation
+		const FRotator PlacementRotation = FRotator(0.0f, CurrentPlacementYaw, 0.0f);
+
+		// Within a grid cell the snapped transform does not change, so the ghost is only moved across cells.
+		if (!GhostPreviewActor->GetActorLocation().Equals(SnappedLocation) || !GhostPreviewActor->GetActorRotation().Equals(PlacementRotation))
+		{
+			GhostPreviewActor->SetActorLocationAndRotation(SnappedLocation, PlacementRotation);
+		}
+	}
+}
+
+void UBuildingPlacementComponent::HandleFootprintOverlapCompleted(const FTraceHandle& Handle, FOverlapDatum& Datum)
+{
+	// A different handle means the cursor moved to other cells, or the grid changed, since this was issued.
+	if (Handle != FootprintOverlapHandle)
+	{
+		return;
+	}
+
+	FootprintOverlapHandle = FTraceHandle();
+
+	bool bClear = true;
+	for (const FOverlapResult& Overlap : Datum.OutOverlaps)
+	{
+		if (Cast<AZooBuildingActor>(Overlap.GetActor()))
+		{
+			bClear = false;
+			break;
+		}
+	}
+
+	FootprintResults.Add(PendingFootprintKey, bClear);
+}
+
+FVector UBuildingPlacementComponent::SnapToGrid(FVector InLocation) const
+{
+	if (GridSize <= 0.0f)
+	{
+		return InLocation;
+	}
+
+	FVector Snapped;
+	Snapped.X = FMath::RoundToFloat(InLocation.X / GridSize) * GridSize;
+	Snapped.Y = FMath::RoundToFloat(InLocation.Y / GridSize) * GridSize;
+	Snapped.Z = InLocation.Z; // Keep original Z (ground height)
+
+	return Snapped;
+}
+
+void UBuildingPlacementComponent::UpdateGhostMaterial(bool bValid)
+{
+	if (GhostPreviewActor)
+	{
+		GhostPreviewActor->SetPlacementValid(bValid);
+	}
+}
+
+void UBuildingPlacementComponent::DestroyGhostPreview()
+{
+	if (GhostPreviewActor)
+	{
+		GhostPreviewActor->Destroy();
+		GhostPreviewActor = nullptr;
+	}
+}
+
+void UBuildingPlacementComponent::SpawnGhostPreview()
+{
+	UWorld* World = GetWorld();
+	if (!World || !SelectedBuildingClass)
+	{
+		return;
+	}
+
+	if (!GhostPreviewActor)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		GhostPreviewActor = World->SpawnActor<ABuildingPreviewActor>(
+			ABuildingPreviewActor::StaticClass(),
+			FVector::ZeroVector,
+			FRotator::ZeroRotator,
+			SpawnParams
+		);
+
+		if (!GhostPreviewActor)
+		{
+			UE_LOG(LogZooKeeper, Error, TEXT("BuildingPlacement: Failed to spawn ghost preview actor."));
+			return;
+		}
+
+		GhostPreviewActor->SetPreviewMaterial(PreviewMaterial);
+		UE_LOG(LogZooKeeper, Verbose, TEXT("BuildingPlacement: Ghost preview spawned."));
+	}
+
+	GhostPreviewActor->ShowBuilding(SelectedBuildingClass);
+	GhostPreviewActor->SetActorHiddenInGame(false);
+
 	// Apply the initial ghost material
 	UpdateGhostMaterial(false);
+}
 
-	UE_LOG(LogZooKeeper, Verbose, TEXT("BuildingPlacement: Ghost preview spawned."));
+const AZooBuildingActor* UBuildingPlacementComponent::GetSelectedBuildingDefaults() const
+{
+	return SelectedBuildingClass ? SelectedBuildingClass->GetDefaultObject<AZooBuildingActor>() : nullptr;
 }
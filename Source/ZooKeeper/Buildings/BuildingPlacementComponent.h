@@ -2,17 +2,34 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "WorldCollision.h"
 #include "BuildingPlacementComponent.generated.h"
 
 class AZooBuildingActor;
+class ABuildingPreviewActor;
+class APathNetworkActor;
 class UMaterialInterface;
 
+/** How a path drag turns its start and end cells into tiles. */
+UENUM(BlueprintType)
+enum class EPathDragShape : uint8
+{
+	/** An L-shaped line: along X from the start, then along Y to the end. */
+	Line	UMETA(DisplayName = "Line"),
+
+	/** Every cell of the rectangle between the start and end. */
+	Area	UMETA(DisplayName = "Area")
+};
+
 /** Broadcast when placement build mode is entered or exited. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlacementBuildModeChanged, bool, bIsInBuildMode);
 
 /** Broadcast when a building placement is confirmed. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBuildingPlacementConfirmed, AZooBuildingActor*, PlacedBuilding);
 
+/** Broadcast when a path drag is applied. NumTiles is negative for tiles erased. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPathsPainted, int32, NumTiles);
+
 /**
  * UBuildingPlacementComponent
  *
@@ -20,6 +37,24 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBuildingPlacementConfirmed, AZooB
  * building placement workflow: entering build mode, showing a translucent
  * ghost preview, snapping to a grid, validating placement, and spawning
  * the final building actor.
+ *
+ * The ghost is an ABuildingPreviewActor that only draws the selected
+ * building's meshes. It is spawned once, reused across selections and
+ * hidden outside build mode, so browsing buildings creates no gameplay
+ * actors.
+ *
+ * Placement runs on async physics queries with one frame of latency: each
+ * tick queues the cursor trace whose result moves the ghost next frame.
+ * Footprints are validated against the BuildingManagerSubsystem's occupancy
+ * grid, or with an async overlap for irregular footprints, and the results
+ * are cached per footprint until the grid changes, so hovering over a cell
+ * already checked costs nothing. Results that arrive after the cursor has
+ * moved on are discarded.
+ *
+ * Path mode paints path tiles instead of placing buildings. A drag from one
+ * grid cell to another lays a line or fills an area of tiles in the zoo's
+ * APathNetworkActor, previewed as instances while dragging and paid for as
+ * one transaction when the drag ends. Tiles are never actors.
  */
 UCLASS(ClassGroup = (Zoo), meta = (BlueprintSpawnableComponent, DisplayName = "Building Placement"))
 class ZOOKEEPER_API UBuildingPlacementComponent : public UActorComponent
@@ -30,6 +65,7 @@ public:
 	UBuildingPlacementComponent();
 
 	//~ Begin UActorComponent Interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	//~ End UActorComponent Interface
 
@@ -59,15 +95,68 @@ public:
 
 	/** The translucent preview actor shown during placement. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Building|Placement")
-	TObjectPtr<AActor> GhostPreviewActor;
+	TObjectPtr<ABuildingPreviewActor> GhostPreviewActor;
 
-	/** Material applied to the ghost when placement is valid. */
+	/**
+	 * Material applied to the ghost. Its "PlacementValid" scalar parameter is set
+	 * to 1 when placement is valid and 0 when it is not.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Placement|Materials")
-	TObjectPtr<UMaterialInterface> ValidPlacementMaterial;
+	TObjectPtr<UMaterialInterface> PreviewMaterial;
 
-	/** Material applied to the ghost when placement is invalid. */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Placement|Materials")
-	TObjectPtr<UMaterialInterface> InvalidPlacementMaterial;
+	// -------------------------------------------------------------------
+	//  Path Painting
+	// -------------------------------------------------------------------
+
+	/** Whether the player is currently painting paths. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Building|Paths")
+	bool bIsInPathMode;
+
+	/** Path network spawned when the level does not have one. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Paths")
+	TSubclassOf<APathNetworkActor> PathNetworkClass;
+
+	/** How drags lay tiles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Paths")
+	EPathDragShape PathDragShape;
+
+	/** Largest number of cells one drag can cover. Larger drags are shown as invalid and not applied. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Paths", meta = (ClampMin = "1"))
+	int32 MaxPathDragCells;
+
+	/**
+	 * Enters path mode with a path style, leaving build mode.
+	 * @param StyleID  A style of the zoo's path network.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Paths")
+	void EnterPathMode(FName StyleID);
+
+	/** Exits path mode, dropping any drag in progress. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Paths")
+	void ExitPathMode();
+
+	/**
+	 * Starts a drag at the cell under the cursor.
+	 * @param bErase  Remove the tiles under the drag instead of laying them.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Paths")
+	void BeginPathDrag(bool bErase = false);
+
+	/**
+	 * Ends the drag at the cell under the cursor and applies it. Laying tiles is
+	 * charged as one transaction and fails as a whole if the zoo cannot afford it.
+	 * @return true if any tile was laid or erased.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Paths")
+	bool EndPathDrag();
+
+	/** Drops the drag in progress without applying it. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Paths")
+	void CancelPathDrag();
+
+	/** Returns the cost of the drag in progress, or 0 when erasing, not dragging, or the drag is too large. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Building|Paths")
+	int32 GetPathDragCost() const;
 
 	// -------------------------------------------------------------------
 	//  Build Mode Functions
@@ -80,22 +169,22 @@ public:
 	void EnterBuildMode();
 
 	/**
-	 * Exits build mode and destroys the ghost preview actor.
+	 * Exits build mode and hides the ghost preview actor.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Placement")
 	void ExitBuildMode();
 
 	/**
-	 * Changes the selected building class and respawns the ghost preview.
+	 * Changes the selected building class and updates the ghost preview.
 	 * @param NewBuildingClass  The new building class to select.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Placement")
 	void SelectBuilding(TSubclassOf<AZooBuildingActor> NewBuildingClass);
 
 	/**
-	 * Updates the ghost preview position and validity each frame.
-	 * Ray traces from the camera to the ground, snaps to grid, and
-	 * updates the ghost material based on placement validity.
+	 * Updates the ghost preview validity each frame and queues the next
+	 * cursor trace. The ghost moves to the grid-snapped hit when the trace
+	 * completes, and the material follows placement validity.
 	 * Called automatically during TickComponent when in build mode.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Building|Placement")
@@ -124,7 +213,7 @@ public:
 
 	/**
 	 * Checks whether the current ghost position is a valid placement location.
-	 * Validates against overlaps, terrain, and available funds.
+	 * Validates against occupied grid cells, terrain, and available funds.
 	 * @return true if placement is valid.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Building|Placement")
@@ -140,6 +229,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Building|Placement|Events")
 	FOnBuildingPlacementConfirmed OnBuildingPlacementConfirmed;
 
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Building|Paths|Events")
+	FOnPathsPainted OnPathsPainted;
+
 private:
 	/**
 	 * Snaps a world position to the placement grid.
@@ -150,22 +242,104 @@ private:
 
 	/**
 	 * Updates the ghost preview's material to reflect validity.
-	 * @param bValid  true to apply ValidPlacementMaterial, false for InvalidPlacementMaterial.
+	 * @param bValid  Whether placement is valid.
 	 */
 	void UpdateGhostMaterial(bool bValid);
 
 	/** Destroys the ghost preview actor if it exists. */
 	void DestroyGhostPreview();
 
-	/** Spawns the ghost preview actor from the selected building class. */
+	/** Shows the selected building on the ghost preview, spawning the preview actor on first use. */
 	void SpawnGhostPreview();
 
+	/** Returns the class defaults of the selected building, or nullptr if none is selected. */
+	const AZooBuildingActor* GetSelectedBuildingDefaults() const;
+
+	/**
+	 * Checks that the ghost's footprint is clear of other buildings, from the cached
+	 * result for its cells. A footprint still being checked is not clear.
+	 */
+	bool IsFootprintClear() const;
+
+	/** Fills the footprint cache for the ghost's cells, queuing an async overlap for irregular footprints. */
+	void RequestFootprintCheck();
+
+	/** Drops cached footprint results and ignores queries still in flight. */
+	void ResetPlacementQueries();
+
+	/** Queues the async trace under the cursor. Only the latest trace is applied. */
+	void QueueCursorTrace();
+
+	/** Follows the cursor with the path drag and queues the next cursor trace. */
+	void UpdatePathPainting();
+
+	/** Shows the cells of the current drag on the path network's preview. */
+	void RefreshPathPreview();
+
+	/**
+	 * Collects the cells the current drag would change: free cells outside enclosures when laying,
+	 * path cells when erasing.
+	 * @return false if the drag covers more than MaxPathDragCells; OutCells then only holds the cells visited up to the limit.
+	 */
+	bool GetPathDragCells(TArray<FIntPoint>& OutCells) const;
+
+	/** Returns the zoo's path network, spawning one from PathNetworkClass if there is none. */
+	APathNetworkActor* GetOrSpawnPathNetwork();
+
+	/** Called by the async trace system when the cursor trace completes. */
+	void HandleCursorTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** Called by the async trace system when a footprint overlap completes. */
+	void HandleFootprintOverlapCompleted(const FTraceHandle& Handle, FOverlapDatum& Datum);
+
 	/** The current rotation applied to the ghost preview. */
 	float CurrentPlacementYaw;
 
 	/** Cached result of the last validity check. */
 	bool bLastPlacementValid;
 
+	/** Whether the last placement trace found ground under the cursor. */
+	bool bGhostOnGround;
+
+	/** Where the last cursor trace hit, valid while bCursorOnGround. */
+	FVector CursorLocation = FVector::ZeroVector;
+	bool bCursorOnGround = false;
+
+	/** Network and style index being painted. */
+	TWeakObjectPtr<APathNetworkActor> PaintingNetwork;
+	int32 PathStyleIndex = INDEX_NONE;
+
+	/** Cells at the ends of the drag; the end follows the cursor. */
+	FIntPoint PathDragStart = FIntPoint::ZeroValue;
+	FIntPoint PathDragEnd = FIntPoint::ZeroValue;
+
+	/** Ground height the drag started at; every tile of a drag is laid at it. */
+	float PathDragHeight = 0.0f;
+
+	bool bIsDraggingPath = false;
+	bool bErasingPath = false;
+
+	/** Set when the preview must be rebuilt even if the cursor stays in its cell. */
+	bool bPathPreviewDirty = false;
+
+	/** Cells covered by the ghost at its current location and rotation. */
+	FIntRect GhostCells;
+
+	/** Whether each footprint checked is clear, keyed by its cells, for the grid version below. */
+	TMap<FIntVector, bool> FootprintResults;
+	uint32 FootprintResultsVersion = 0;
+
+	/** Latest queries; completions with any other handle are stale and dropped. */
+	FTraceHandle CursorTraceHandle;
+	FTraceHandle FootprintOverlapHandle;
+
+	/** Footprint the in-flight overlap was issued for. */
+	FIntVector PendingFootprintKey;
+
+	/** Delegates bound once and reused for every query. */
+	FTraceDelegate CursorTraceDelegate;
+	FOverlapDelegate FootprintOverlapDelegate;
+
 	/** Trace channel used for ground detection. */
 	static constexpr ECollisionChannel GroundTraceChannel = ECC_Visibility;
 
@@ -0,0 +1,225 @@
+#include "BuildingPreviewActor.h"
+#include "ZooBuildingActor.h"
+#include "ZooKeeper/ZooKeeper.h"
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+const FName ABuildingPreviewActor::PlacementValidParameter(TEXT("PlacementValid"));
+
+ABuildingPreviewActor::ABuildingPreviewActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetActorEnableCollision(false);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ABuildingPreviewActor::SetPreviewMaterial(UMaterialInterface* Material)
+{
+	PreviewMID = Material ? UMaterialInstanceDynamic::Create(Material, this) : nullptr;
+	LastPlacementValid = -1;
+
+	for (int32 Index = 0; Index < NumActiveMeshes; ++Index)
+	{
+		if (UStaticMeshComponent* MeshComp = MeshPool[Index])
+		{
+			for (int32 Slot = 0; Slot < MeshComp->GetNumMaterials(); ++Slot)
+			{
+				MeshComp->SetMaterial(Slot, PreviewMID);
+			}
+		}
+	}
+}
+
+void ABuildingPreviewActor::ShowBuilding(TSubclassOf<AZooBuildingActor> BuildingClass)
+{
+	const UClass* Class = BuildingClass.Get();
+	if (!Class)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("BuildingPreviewActor: Attempted to show a null building class."));
+		return;
+	}
+
+	const TArray<FPreviewPart>* Parts = PartsByClass.Find(Class);
+	if (!Parts)
+	{
+		TArray<FPreviewPart> NewParts;
+		GatherPreviewParts(BuildingClass, NewParts);
+		Parts = &PartsByClass.Add(Class, MoveTemp(NewParts));
+	}
+
+	for (int32 Index = 0; Index < Parts->Num(); ++Index)
+	{
+		const FPreviewPart& Part = (*Parts)[Index];
+		UStaticMeshComponent* MeshComp = GetPooledMesh(Index);
+		MeshComp->SetStaticMesh(Part.Mesh);
+		MeshComp->SetRelativeTransform(Part.RelativeTransform);
+
+		if (PreviewMID)
+		{
+			for (int32 Slot = 0; Slot < MeshComp->GetNumMaterials(); ++Slot)
+			{
+				MeshComp->SetMaterial(Slot, PreviewMID);
+			}
+		}
+
+		MeshComp->SetVisibility(true);
+	}
+
+	for (int32 Index = Parts->Num(); Index < NumActiveMeshes; ++Index)
+	{
+		MeshPool[Index]->SetVisibility(false);
+	}
+
+	NumActiveMeshes = Parts->Num();
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("BuildingPreviewActor: Showing '%s' with %d meshes (pool: %d)."),
+		*Class->GetName(), NumActiveMeshes, MeshPool.Num());
+}
+
+void ABuildingPreviewActor::SetPlacementValid(bool bValid)
+{
+	const int8 NewValue = bValid ? 1 : 0;
+	if (!PreviewMID || NewValue == LastPlacementValid)
+	{
+		return;
+	}
+
+	PreviewMID->SetScalarParameterValue(PlacementValidParameter, static_cast<float>(NewValue));
+	LastPlacementValid = NewValue;
+}
+
+/** Returns a native component's transform relative to the actor's root, composed up its attach parents. */
+static FTransform GetNativeTransformInRoot(const USceneComponent* Component, const USceneComponent* Root)
+{
+	FTransform Transform = FTransform::Identity;
+	for (const USceneComponent* Current = Component; Current && Current != Root; Current = Current->GetAttachParent())
+	{
+		Transform *= Current->GetRelativeTransform();
+	}
+	return Transform;
+}
+
+/**
+ * Returns a construction script node's transform relative to the actor's root. Nodes hang off another node
+ * of their script, a node of a parent Blueprint by variable name, or a native component by name.
+ */
+static FTransform GetNodeTransformInRoot(const USCS_Node* Node, UBlueprintGeneratedClass* ActualClass, const AActor* Defaults,
+	const TMap<const USCS_Node*, const USCS_Node*>& ParentNodes, const TMap<FName, const USCS_Node*>& NodesByName)
+{
+	const USceneComponent* Template = Cast<USceneComponent>(Node->GetActualComponentTemplate(ActualClass));
+	const FTransform Transform = Template ? Template->GetRelativeTransform() : FTransform::Identity;
+
+	if (const USCS_Node* const* Parent = ParentNodes.Find(Node))
+	{
+		return Transform * GetNodeTransformInRoot(*Parent, ActualClass, Defaults, ParentNodes, NodesByName);
+	}
+
+	// A root node without a parent attaches to the native root.
+	if (Node->ParentComponentOrVariableName.IsNone())
+	{
+		return Transform;
+	}
+
+	if (Node->bIsParentComponentNative)
+	{
+		TInlineComponentArray<USceneComponent*> NativeComponents;
+		Defaults->GetComponents(NativeComponents);
+		for (const USceneComponent* Component : NativeComponents)
+		{
+			if (Component && Component->GetFName() == Node->ParentComponentOrVariableName)
+			{
+				return Transform * GetNativeTransformInRoot(Component, Defaults->GetRootComponent());
+			}
+		}
+		return Transform;
+	}
+
+	if (const USCS_Node* const* Parent = NodesByName.Find(Node->ParentComponentOrVariableName))
+	{
+		return Transform * GetNodeTransformInRoot(*Parent, ActualClass, Defaults, ParentNodes, NodesByName);
+	}
+	return Transform;
+}
+
+void ABuildingPreviewActor::GatherPreviewParts(TSubclassOf<AZooBuildingActor> BuildingClass, TArray<FPreviewPart>& OutParts)
+{
+	const AZooBuildingActor* Defaults = BuildingClass->GetDefaultObject<AZooBuildingActor>();
+	if (!Defaults)
+	{
+		return;
+	}
+
+	// Native components live on the class defaults. The root sits at the preview's origin.
+	const USceneComponent* Root = Defaults->GetRootComponent();
+	TInlineComponentArray<UStaticMeshComponent*> NativeMeshes;
+	Defaults->GetComponents(NativeMeshes);
+	for (const UStaticMeshComponent* MeshComp : NativeMeshes)
+	{
+		if (MeshComp && MeshComp->GetStaticMesh())
+		{
+			OutParts.Add({ MeshComp->GetStaticMesh(), GetNativeTransformInRoot(MeshComp, Root) });
+		}
+	}
+
+	// Components added in Blueprints only exist as construction script templates, spread over the class chain.
+	TArray<const USCS_Node*> Nodes;
+	TMap<const USCS_Node*, const USCS_Node*> ParentNodes;
+	TMap<FName, const USCS_Node*> NodesByName;
+	for (const UClass* Class = BuildingClass; Class; Class = Class->GetSuperClass())
+	{
+		const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Class);
+		if (!BlueprintClass || !BlueprintClass->SimpleConstructionScript)
+		{
+			continue;
+		}
+
+		for (const USCS_Node* Node : BlueprintClass->SimpleConstructionScript->GetAllNodes())
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			Nodes.Add(Node);
+			NodesByName.Add(Node->GetVariableName(), Node);
+			for (const USCS_Node* Child : Node->GetChildNodes())
+			{
+				ParentNodes.Add(Child, Node);
+			}
+		}
+	}
+
+	// Subclasses can override an inherited template; the most derived class has the final say.
+	UBlueprintGeneratedClass* ActualClass = Cast<UBlueprintGeneratedClass>(BuildingClass.Get());
+	for (const USCS_Node* Node : Nodes)
+	{
+		const UStaticMeshComponent* Template = Cast<UStaticMeshComponent>(Node->GetActualComponentTemplate(ActualClass));
+		if (Template && Template->GetStaticMesh())
+		{
+			OutParts.Add({ Template->GetStaticMesh(), GetNodeTransformInRoot(Node, ActualClass, Defaults, ParentNodes, NodesByName) });
+		}
+	}
+}
+
+UStaticMeshComponent* ABuildingPreviewActor::GetPooledMesh(int32 Index)
+{
+	while (MeshPool.Num() <= Index)
+	{
+		UStaticMeshComponent* MeshComp = NewObject<UStaticMeshComponent>(this);
+		MeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		MeshComp->SetGenerateOverlapEvents(false);
+		MeshComp->SetCanEverAffectNavigation(false);
+		MeshComp->SetCastShadow(false);
+		MeshComp->SetupAttachment(RootComponent);
+		MeshComp->RegisterComponent();
+		MeshPool.Add(MeshComp);
+	}
+
+	return MeshPool[Index];
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "BuildingPreviewActor.generated.h"
+
+class AZooBuildingActor;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * ABuildingPreviewActor
+ *
+ * Placement ghost shown while in build mode. It holds nothing but a pool of
+ * static mesh components with collision, overlaps and shadows off, and it
+ * never registers with gameplay systems. Showing a building copies the
+ * static meshes of its class defaults onto the pooled components, so one
+ * preview actor serves every building selection.
+ *
+ * All components share one dynamic material instance. Validity is shown
+ * by its "PlacementValid" scalar parameter (1 valid, 0 invalid), which is
+ * only written when it changes.
+ */
+UCLASS(NotBlueprintable, NotPlaceable, meta = (DisplayName = "Building Preview"))
+class ZOOKEEPER_API ABuildingPreviewActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ABuildingPreviewActor();
+
+	/**
+	 * Sets up the material shared by all preview meshes.
+	 * @param Material  Material with a PlacementValid scalar parameter.
+	 */
+	void SetPreviewMaterial(UMaterialInterface* Material);
+
+	/**
+	 * Shows the static meshes of a building class. Pooled components are reused
+	 * and the ones left over are hidden.
+	 * @param BuildingClass  The building to preview.
+	 */
+	void ShowBuilding(TSubclassOf<AZooBuildingActor> BuildingClass);
+
+	/** Shows placement as valid or invalid. */
+	void SetPlacementValid(bool bValid);
+
+	/** Name of the scalar parameter that drives the valid/invalid look. */
+	static const FName PlacementValidParameter;
+
+private:
+	/** A mesh of a building class and its transform relative to the building's root. */
+	struct FPreviewPart
+	{
+		TObjectPtr<UStaticMesh> Mesh;
+		FTransform RelativeTransform;
+	};
+
+	/** Collects the static meshes of a building class, from native and Blueprint components. */
+	static void GatherPreviewParts(TSubclassOf<AZooBuildingActor> BuildingClass, TArray<FPreviewPart>& OutParts);
+
+	/** Returns the pooled component at Index, creating components as needed. */
+	UStaticMeshComponent* GetPooledMesh(int32 Index);
+
+	/** Pooled mesh components; the first NumActiveMeshes show the current building. */
+	UPROPERTY()
+	TArray<TObjectPtr<UStaticMeshComponent>> MeshPool;
+
+	/** Material instance shared by every pooled component. */
+	UPROPERTY()
+	TObjectPtr<UMaterialInstanceDynamic> PreviewMID;
+
+	/** Parts gathered per building class. */
+	TMap<const UClass*, TArray<FPreviewPart>> PartsByClass;
+
+	int32 NumActiveMeshes = 0;
+
+	/** Last value written to the PlacementValid parameter, or -1 if never written. */
+	int8 LastPlacementValid = -1;
+};
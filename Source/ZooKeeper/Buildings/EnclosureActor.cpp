@@ -1,15 +1,43 @@
 #include "EnclosureActor.h"
 #include "EnclosureVolumeComponent.h"
+#include "EnrichmentItemActor.h"
+#include "FeederActor.h"
 #include "ZooKeeper/ZooKeeper.h"
+#include "ZooKeeper/Animals/AnimalBase.h"
 #include "ZooKeeper/Subsystems/BuildingManagerSubsystem.h"
 #include "ZooKeeper/Subsystems/AnimalManagerSubsystem.h"
+#include "ZooKeeper/Subsystems/ZooModifierSubsystem.h"
 #include "ZooKeeper/Data/ZooDataTypes.h"
 #include "Engine/DataTable.h"
+#include "EngineUtils.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enclosure Quality"), STAT_ZooEnclosureQuality, STATGROUP_ZooKeeper);
+
+/** Weights of the quality components in the overall score. They sum to 1. */
+static constexpr float QualityWeightSpace = 0.2f;
+static constexpr float QualityWeightBiome = 0.2f;
+static constexpr float QualityWeightCrowding = 0.1f;
+static constexpr float QualityWeightCondition = 0.2f;
+static constexpr float QualityWeightEnrichment = 0.15f;
+static constexpr float QualityWeightFood = 0.15f;
+
+/** Combined enrichment happiness boost that earns the full enrichment score. */
+static constexpr float EnrichmentBoostTarget = 0.3f;
+
+/** Happiness decay multiplier of the residents at quality 0 and quality 1. */
+static constexpr float HappinessDecayAtWorstQuality = 1.5f;
+static constexpr float HappinessDecayAtBestQuality = 0.5f;
 
 AEnclosureActor::AEnclosureActor()
 	: EnclosureArea(0.0f)
 	, MaxAnimalCapacity(5)
 {
+	Category = EBuildingCategory::Enclosure;
+
+	// An enclosure is bounded by its polygon, which placement tests through the spatial index, not by grid cells.
+	bIrregularFootprint = true;
+
 	// Create the enclosure volume component
 	EnclosureVolume = CreateDefaultSubobject<UEnclosureVolumeComponent>(TEXT("EnclosureVolume"));
 	EnclosureVolume->SetupAttachment(BuildingMesh);
@@ -23,8 +51,13 @@ void AEnclosureActor::BeginPlay()
 	if (EnclosureVolume)
 	{
 		EnclosureArea = EnclosureVolume->CalculateArea();
+		EnclosureVolume->OnEnclosureBoundsChanged.AddDynamic(this, &AEnclosureActor::HandleBoundsChanged);
 	}
 
+	OnConditionChanged.AddDynamic(this, &AEnclosureActor::HandleOwnConditionChanged);
+	QualityModifierSource = FName(TEXT("EnclosureQuality"), GetUniqueID());
+	MarkQualityDirty();
+
 	// Register specifically as an enclosure with the BuildingManagerSubsystem
 	if (UWorld* World = GetWorld())
 	{
@@ -35,6 +68,42 @@ void AEnclosureActor::BeginPlay()
 				*BuildingName, *BiomeType.ToString(), EnclosureArea);
 		}
 	}
+
+	// Feeders and enrichment that began play first could not find this enclosure.
+	RefreshContents();
+}
+
+void AEnclosureActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (EnclosureVolume)
+	{
+		EnclosureVolume->OnEnclosureBoundsChanged.RemoveDynamic(this, &AEnclosureActor::HandleBoundsChanged);
+	}
+	OnConditionChanged.RemoveDynamic(this, &AEnclosureActor::HandleOwnConditionChanged);
+
+	for (const TWeakObjectPtr<AFeederActor>& Feeder : Feeders)
+	{
+		if (AFeederActor* FeederActor = Feeder.Get())
+		{
+			FeederActor->OnFoodDepleted.RemoveDynamic(this, &AEnclosureActor::HandleFeederStockChanged);
+			FeederActor->OnFeederRestocked.RemoveDynamic(this, &AEnclosureActor::HandleFeederRestocked);
+		}
+	}
+	Feeders.Empty();
+	EnrichmentItems.Empty();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+		bQualityRefreshScheduled = false;
+
+		if (UZooModifierSubsystem* Modifiers = World->GetSubsystem<UZooModifierSubsystem>())
+		{
+			Modifiers->RemoveSource(QualityModifierSource);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEnclosureActor::AddAnimal(AAnimalBase* Animal)
@@ -59,6 +128,7 @@ void AEnclosureActor::AddAnimal(AAnimalBase* Animal)
 	}
 
 	ContainedAnimals.Add(Animal);
+	MarkQualityDirty();
 	OnAnimalAddedToEnclosure.Broadcast(this, Animal);
 
 	UE_LOG(LogZooKeeper, Log, TEXT("Enclosure '%s': Animal added (%d/%d)."),
@@ -76,6 +146,7 @@ void AEnclosureActor::RemoveAnimal(AAnimalBase* Animal)
 	const int32 RemovedCount = ContainedAnimals.Remove(Animal);
 	if (RemovedCount > 0)
 	{
+		MarkQualityDirty();
 		OnAnimalRemovedFromEnclosure.Broadcast(this, Animal);
 		UE_LOG(LogZooKeeper, Log, TEXT("Enclosure '%s': Animal removed (%d/%d)."),
 			*BuildingName, ContainedAnimals.Num(), MaxAnimalCapacity);
@@ -146,3 +217,277 @@ bool AEnclosureActor::IsSuitableForSpecies(FName SpeciesID) const
 	// Fallback: allow if we can't look up the species data.
 	return true;
 }
+
+// -------------------------------------------------------------------
+//  Quality
+// -------------------------------------------------------------------
+
+FEnclosureQuality AEnclosureActor::GetQuality() const
+{
+	if (bQualityDirty)
+	{
+		EvaluateQuality();
+	}
+
+	return CachedQuality;
+}
+
+void AEnclosureActor::MarkQualityDirty()
+{
+	bQualityDirty = true;
+
+	if (bQualityRefreshScheduled)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	bQualityRefreshScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &AEnclosureActor::RefreshQuality));
+}
+
+void AEnclosureActor::RegisterEnrichment(AEnrichmentItemActor* Item)
+{
+	if (!Item || EnrichmentItems.Contains(Item))
+	{
+		return;
+	}
+
+	EnrichmentItems.Add(Item);
+	MarkQualityDirty();
+}
+
+void AEnclosureActor::UnregisterEnrichment(AEnrichmentItemActor* Item)
+{
+	if (EnrichmentItems.Remove(Item) > 0)
+	{
+		MarkQualityDirty();
+	}
+}
+
+void AEnclosureActor::RegisterFeeder(AFeederActor* Feeder)
+{
+	if (!Feeder || Feeders.Contains(Feeder))
+	{
+		return;
+	}
+
+	Feeders.Add(Feeder);
+	Feeder->OnFoodDepleted.AddDynamic(this, &AEnclosureActor::HandleFeederStockChanged);
+	Feeder->OnFeederRestocked.AddDynamic(this, &AEnclosureActor::HandleFeederRestocked);
+	MarkQualityDirty();
+}
+
+void AEnclosureActor::UnregisterFeeder(AFeederActor* Feeder)
+{
+	if (Feeders.Remove(Feeder) == 0)
+	{
+		return;
+	}
+
+	if (Feeder)
+	{
+		Feeder->OnFoodDepleted.RemoveDynamic(this, &AEnclosureActor::HandleFeederStockChanged);
+		Feeder->OnFeederRestocked.RemoveDynamic(this, &AEnclosureActor::HandleFeederRestocked);
+	}
+	MarkQualityDirty();
+}
+
+void AEnclosureActor::RefreshQuality()
+{
+	bQualityRefreshScheduled = false;
+
+	const float Quality = GetQualityScore();
+	if (FMath::IsNearlyEqual(LastBroadcastQuality, Quality, 0.01f))
+	{
+		return;
+	}
+
+	LastBroadcastQuality = Quality;
+
+	// Residents lose happiness faster in a poor enclosure and slower in a good one.
+	if (UWorld* World = GetWorld())
+	{
+		if (UZooModifierSubsystem* Modifiers = World->GetSubsystem<UZooModifierSubsystem>())
+		{
+			FZooModifier Modifier = FZooModifier::Make(EZooModifierStat::HappinessDecay, EZooModifierOp::Multiply,
+				FMath::Lerp(HappinessDecayAtWorstQuality, HappinessDecayAtBestQuality, Quality));
+			Modifier.Scope = EZooModifierScope::Enclosure;
+			Modifier.Target = this;
+			Modifiers->SetSourceModifiers(QualityModifierSource, { Modifier });
+		}
+	}
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("Enclosure '%s': Quality changed to %.2f."), *BuildingName, Quality);
+	OnQualityChanged.Broadcast(this, Quality);
+}
+
+void AEnclosureActor::EvaluateQuality() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooEnclosureQuality);
+
+	struct FResidentSpecies
+	{
+		int32 Count = 0;
+		int32 MaxGroupSize = MAX_int32;
+	};
+
+	TMap<FName, FResidentSpecies, TInlineSetAllocator<8>> ResidentSpecies;
+	int32 NumResidents = 0;
+	int32 NumInPreferredBiome = 0;
+	float RequiredArea = 0.0f;
+
+	for (const AAnimalBase* Animal : ContainedAnimals)
+	{
+		if (!Animal)
+		{
+			continue;
+		}
+
+		NumResidents++;
+		FResidentSpecies& Species = ResidentSpecies.FindOrAdd(Animal->SpeciesID);
+		Species.Count++;
+
+		// Residents without species data count as content with their surroundings.
+		const FAnimalSpeciesRow* Row = Animal->GetSpeciesData();
+		if (!Row)
+		{
+			NumInPreferredBiome++;
+			continue;
+		}
+
+		RequiredArea += Row->MinEnclosureArea;
+		Species.MaxGroupSize = Row->MaxGroupSize;
+		if (Row->PreferredBiome.IsNone() || Row->PreferredBiome == BiomeType)
+		{
+			NumInPreferredBiome++;
+		}
+	}
+
+	FEnclosureQuality Quality;
+	Quality.Condition = Condition;
+
+	if (NumResidents > 0)
+	{
+		Quality.Space = RequiredArea > 0.0f ? FMath::Clamp(EnclosureArea / RequiredArea, 0.0f, 1.0f) : 1.0f;
+		Quality.Biome = static_cast<float>(NumInPreferredBiome) / NumResidents;
+
+		int32 NumWithinGroupSize = 0;
+		for (const TPair<FName, FResidentSpecies>& Species : ResidentSpecies)
+		{
+			NumWithinGroupSize += FMath::Min(Species.Value.Count, Species.Value.MaxGroupSize);
+		}
+		const float CapacityFactor = MaxAnimalCapacity > 0 ? FMath::Min(1.0f, static_cast<float>(MaxAnimalCapacity) / NumResidents) : 1.0f;
+		Quality.Crowding = static_cast<float>(NumWithinGroupSize) / NumResidents * CapacityFactor;
+	}
+
+	// Enrichment counts when at least one resident can use it; an empty enclosure counts everything.
+	float EnrichmentBoost = 0.0f;
+	for (const TWeakObjectPtr<AEnrichmentItemActor>& Item : EnrichmentItems)
+	{
+		const AEnrichmentItemActor* ItemActor = Item.Get();
+		if (!ItemActor)
+		{
+			continue;
+		}
+
+		bool bUsable = NumResidents == 0;
+		for (const TPair<FName, FResidentSpecies>& Species : ResidentSpecies)
+		{
+			if (ItemActor->IsCompatibleWithSpecies(Species.Key))
+			{
+				bUsable = true;
+				break;
+			}
+		}
+
+		if (bUsable)
+		{
+			EnrichmentBoost += ItemActor->HappinessBoost;
+		}
+	}
+	Quality.Enrichment = FMath::Clamp(EnrichmentBoost / EnrichmentBoostTarget, 0.0f, 1.0f);
+
+	// Without a feeder the residents have to forage, which only matters if there are any.
+	int32 NumFeeders = 0;
+	int32 NumStockedFeeders = 0;
+	for (const TWeakObjectPtr<AFeederActor>& Feeder : Feeders)
+	{
+		if (const AFeederActor* FeederActor = Feeder.Get())
+		{
+			NumFeeders++;
+			NumStockedFeeders += FeederActor->IsEmpty() ? 0 : 1;
+		}
+	}
+	Quality.Food = NumFeeders > 0 ? static_cast<float>(NumStockedFeeders) / NumFeeders : (NumResidents > 0 ? 0.0f : 1.0f);
+
+	Quality.Overall = FMath::Clamp(
+		Quality.Space * QualityWeightSpace +
+		Quality.Biome * QualityWeightBiome +
+		Quality.Crowding * QualityWeightCrowding +
+		Quality.Condition * QualityWeightCondition +
+		Quality.Enrichment * QualityWeightEnrichment +
+		Quality.Food * QualityWeightFood,
+		0.0f, 1.0f);
+
+	CachedQuality = Quality;
+	bQualityDirty = false;
+}
+
+void AEnclosureActor::HandleBoundsChanged()
+{
+	if (EnclosureVolume)
+	{
+		EnclosureArea = EnclosureVolume->CalculateArea();
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UBuildingManagerSubsystem* BuildingManager = World->GetSubsystem<UBuildingManagerSubsystem>())
+		{
+			BuildingManager->UpdateEnclosureBounds(this);
+		}
+	}
+
+	RefreshContents();
+	MarkQualityDirty();
+}
+
+void AEnclosureActor::RefreshContents()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// Items are few, and this only runs when an enclosure forms or changes shape.
+	for (TActorIterator<AFeederActor> It(World); It; ++It)
+	{
+		It->UpdateOwningEnclosure();
+	}
+	for (TActorIterator<AEnrichmentItemActor> It(World); It; ++It)
+	{
+		It->UpdateOwningEnclosure();
+	}
+}
+
+void AEnclosureActor::HandleOwnConditionChanged(AZooBuildingActor* Building, float NewCondition)
+{
+	MarkQualityDirty();
+}
+
+void AEnclosureActor::HandleFeederStockChanged(AFeederActor* Feeder)
+{
+	MarkQualityDirty();
+}
+
+void AEnclosureActor::HandleFeederRestocked(AFeederActor* Feeder, int32 NewStock)
+{
+	MarkQualityDirty();
+}
@@ -5,6 +5,8 @@
 #include "EnclosureActor.generated.h"
 
 class AAnimalBase;
+class AEnrichmentItemActor;
+class AFeederActor;
 class UEnclosureVolumeComponent;
 
 /** Broadcast when an animal is added to this enclosure. */
@@ -13,12 +15,61 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAnimalAddedToEnclosure, AEnclosu
 /** Broadcast when an animal is removed from this enclosure. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAnimalRemovedFromEnclosure, AEnclosureActor*, Enclosure, AAnimalBase*, Animal);
 
+/** Broadcast when an enclosure's overall quality score changes. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEnclosureQualityChanged, AEnclosureActor*, Enclosure, float, NewQuality);
+
+/**
+ * FEnclosureQuality
+ *
+ * Breakdown of an enclosure's quality. Every component is in the 0-1 range.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FEnclosureQuality
+{
+	GENERATED_BODY()
+
+	/** Weighted combination of the components below. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Overall = 0.0f;
+
+	/** Area relative to the combined MinEnclosureArea of the residents. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Space = 1.0f;
+
+	/** Fraction of residents whose preferred biome matches the enclosure. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Biome = 1.0f;
+
+	/** Fraction of residents within their species' group size and the enclosure capacity. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Crowding = 1.0f;
+
+	/** Structural condition of the enclosure. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Condition = 1.0f;
+
+	/** Happiness boost of the enrichment items residents can use, against a target. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Enrichment = 0.0f;
+
+	/** Fraction of the enclosure's feeders that still hold food. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enclosure|Quality")
+	float Food = 1.0f;
+};
+
 /**
  * AEnclosureActor
  *
  * A building that contains animals within a defined polygon volume.
  * Manages a list of contained animals, enforces capacity limits,
  * and provides spatial queries for animal AI navigation.
+ *
+ * The enclosure keeps a cached quality score built from its area, biome,
+ * residents, condition, enrichment items and feeders. Any change to those
+ * inputs marks the score dirty; it is recomputed on the next query or at
+ * the end of the frame, whichever comes first, so a burst of changes costs
+ * one evaluation. The score scales the happiness decay of the residents,
+ * the satisfaction visitors get from viewing them, and the zoo rating.
  */
 UCLASS(BlueprintType, Blueprintable, meta = (DisplayName = "Enclosure"))
 class ZOOKEEPER_API AEnclosureActor : public AZooBuildingActor
@@ -104,6 +155,37 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Enclosure|Animals")
 	bool IsSuitableForSpecies(FName SpeciesID) const;
 
+	// -------------------------------------------------------------------
+	//  Quality
+	// -------------------------------------------------------------------
+
+	/** Returns the quality breakdown, recomputing it first if an input changed. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Enclosure|Quality")
+	FEnclosureQuality GetQuality() const;
+
+	/** Returns the overall quality score (0-1). */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Enclosure|Quality")
+	float GetQualityScore() const { return GetQuality().Overall; }
+
+	/** Flags the quality score for recomputation. Call when an input changed without an event. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Enclosure|Quality")
+	void MarkQualityDirty();
+
+	/** Adds an enrichment item placed inside this enclosure. */
+	void RegisterEnrichment(AEnrichmentItemActor* Item);
+
+	/** Removes an enrichment item from this enclosure. */
+	void UnregisterEnrichment(AEnrichmentItemActor* Item);
+
+	/** Adds a feeder placed inside this enclosure and follows its stock. */
+	void RegisterFeeder(AFeederActor* Feeder);
+
+	/** Removes a feeder from this enclosure. */
+	void UnregisterFeeder(AFeederActor* Feeder);
+
+	/** Returns the feeders placed inside this enclosure. */
+	const TArray<TWeakObjectPtr<AFeederActor>>& GetFeeders() const { return Feeders; }
+
 	// -------------------------------------------------------------------
 	//  Delegates
 	// -------------------------------------------------------------------
@@ -114,6 +196,53 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Enclosure|Events")
 	FOnAnimalRemovedFromEnclosure OnAnimalRemovedFromEnclosure;
 
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Enclosure|Events")
+	FOnEnclosureQualityChanged OnQualityChanged;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Recomputes a dirty score, then broadcasts and updates the residents' modifier if it moved. */
+	void RefreshQuality();
+
+	/** Builds the quality breakdown from the current inputs. */
+	void EvaluateQuality() const;
+
+	/**
+	 * Re-resolves the enclosure of every feeder and enrichment item, so items inside the
+	 * polygon are adopted and items left outside it are released. Called after the building
+	 * manager's index has this enclosure's current bounds.
+	 */
+	void RefreshContents();
+
+	UFUNCTION()
+	void HandleBoundsChanged();
+
+	UFUNCTION()
+	void HandleOwnConditionChanged(AZooBuildingActor* Building, float NewCondition);
+
+	UFUNCTION()
+	void HandleFeederStockChanged(AFeederActor* Feeder);
+
+	UFUNCTION()
+	void HandleFeederRestocked(AFeederActor* Feeder, int32 NewStock);
+
+	/** Enrichment items and feeders inside the enclosure. */
+	TArray<TWeakObjectPtr<AEnrichmentItemActor>> EnrichmentItems;
+	TArray<TWeakObjectPtr<AFeederActor>> Feeders;
+
+	/** Cached breakdown, valid while bQualityDirty is false. */
+	mutable FEnclosureQuality CachedQuality;
+	mutable bool bQualityDirty = true;
+
+	/** Whether a refresh is already queued for the end of the frame. */
+	bool bQualityRefreshScheduled = false;
+
+	/** Score at the last OnQualityChanged broadcast. */
+	float LastBroadcastQuality = -1.0f;
+
+	/** Modifier source this enclosure pushes its residents' happiness decay under. */
+	FName QualityModifierSource;
 };
@@ -0,0 +1,314 @@
+#include "EnclosureSpatialIndex.h"
+#include "EnclosureActor.h"
+
+/** Half the perimeter of a box; the cost the tree minimizes when inserting. */
+static double GetHalfPerimeter(const FBox2D& Box)
+{
+	const FVector2D Size = Box.GetSize();
+	return Size.X + Size.Y;
+}
+
+void FZooEnclosureSpatialIndex::Update(AEnclosureActor* Enclosure, const FBox2D& Bounds)
+{
+	if (!Enclosure || !Bounds.bIsValid)
+	{
+		return;
+	}
+
+	if (const int32* ExistingLeaf = LeafByEnclosure.Find(Enclosure))
+	{
+		if (Nodes[*ExistingLeaf].Bounds == Bounds)
+		{
+			return;
+		}
+
+		// Bounds changes are rare (fence edits), so a moved leaf is simply reinserted.
+		RemoveLeaf(*ExistingLeaf);
+		Nodes[*ExistingLeaf].Bounds = Bounds;
+		InsertLeaf(*ExistingLeaf);
+		return;
+	}
+
+	const int32 Leaf = AllocateNode();
+	Nodes[Leaf].Bounds = Bounds;
+	Nodes[Leaf].Enclosure = Enclosure;
+	InsertLeaf(Leaf);
+
+	LeafByEnclosure.Add(Enclosure, Leaf);
+}
+
+void FZooEnclosureSpatialIndex::Remove(const AEnclosureActor* Enclosure)
+{
+	int32 Leaf = INDEX_NONE;
+	if (!LeafByEnclosure.RemoveAndCopyValue(Enclosure, Leaf))
+	{
+		return;
+	}
+
+	RemoveLeaf(Leaf);
+	FreeNode(Leaf);
+}
+
+void FZooEnclosureSpatialIndex::Reset()
+{
+	Nodes.Reset();
+	LeafByEnclosure.Reset();
+	Root = INDEX_NONE;
+	FreeList = INDEX_NONE;
+}
+
+void FZooEnclosureSpatialIndex::ForEachAtPoint(const FVector2D& Point, TFunctionRef<bool(AEnclosureActor*)> Visitor) const
+{
+	ForEachOverlapping(FBox2D(Point, Point), Visitor);
+}
+
+void FZooEnclosureSpatialIndex::ForEachOverlapping(const FBox2D& Box, TFunctionRef<bool(AEnclosureActor*)> Visitor) const
+{
+	if (Root == INDEX_NONE)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(Root);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!Node.Bounds.Intersect(Box))
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			AEnclosureActor* Enclosure = Node.Enclosure.Get();
+			if (Enclosure && !Visitor(Enclosure))
+			{
+				return;
+			}
+		}
+		else
+		{
+			Stack.Add(Node.Child1);
+			Stack.Add(Node.Child2);
+		}
+	}
+}
+
+// -------------------------------------------------------------------
+//  Tree Maintenance
+// -------------------------------------------------------------------
+
+int32 FZooEnclosureSpatialIndex::AllocateNode()
+{
+	if (FreeList == INDEX_NONE)
+	{
+		return Nodes.AddDefaulted();
+	}
+
+	const int32 Index = FreeList;
+	FreeList = Nodes[Index].Parent;
+	Nodes[Index] = FNode();
+	return Index;
+}
+
+void FZooEnclosureSpatialIndex::FreeNode(int32 Index)
+{
+	Nodes[Index] = FNode();
+	Nodes[Index].Parent = FreeList;
+	FreeList = Index;
+}
+
+void FZooEnclosureSpatialIndex::InsertLeaf(int32 Leaf)
+{
+	if (Root == INDEX_NONE)
+	{
+		Root = Leaf;
+		Nodes[Root].Parent = INDEX_NONE;
+		return;
+	}
+
+	// Walk down to the sibling that is cheapest to pair the leaf with.
+	const FBox2D LeafBounds = Nodes[Leaf].Bounds;
+	int32 Index = Root;
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FNode& Node = Nodes[Index];
+		const double CombinedCost = GetHalfPerimeter(Node.Bounds + LeafBounds);
+
+		// Pairing here creates a parent over this whole subtree.
+		const double PairHereCost = 2.0 * CombinedCost;
+
+		// Descending still grows every node on the way down by this much.
+		const double InheritedCost = 2.0 * (CombinedCost - GetHalfPerimeter(Node.Bounds));
+
+		auto DescendCost = [this, &LeafBounds, InheritedCost](int32 Child)
+		{
+			const FNode& ChildNode = Nodes[Child];
+			const double Grown = GetHalfPerimeter(ChildNode.Bounds + LeafBounds);
+			return InheritedCost + (ChildNode.IsLeaf() ? Grown : Grown - GetHalfPerimeter(ChildNode.Bounds));
+		};
+
+		const double Cost1 = DescendCost(Node.Child1);
+		const double Cost2 = DescendCost(Node.Child2);
+		if (PairHereCost < Cost1 && PairHereCost < Cost2)
+		{
+			break;
+		}
+
+		Index = Cost1 < Cost2 ? Node.Child1 : Node.Child2;
+	}
+
+	const int32 Sibling = Index;
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocateNode();
+
+	FNode& ParentNode = Nodes[NewParent];
+	ParentNode.Parent = OldParent;
+	ParentNode.Bounds = Nodes[Sibling].Bounds + LeafBounds;
+	ParentNode.Height = Nodes[Sibling].Height + 1;
+	ParentNode.Child1 = Sibling;
+	ParentNode.Child2 = Leaf;
+
+	if (OldParent == INDEX_NONE)
+	{
+		Root = NewParent;
+	}
+	else if (Nodes[OldParent].Child1 == Sibling)
+	{
+		Nodes[OldParent].Child1 = NewParent;
+	}
+	else
+	{
+		Nodes[OldParent].Child2 = NewParent;
+	}
+
+	Nodes[Sibling].Parent = NewParent;
+	Nodes[Leaf].Parent = NewParent;
+
+	RefitAncestors(NewParent);
+}
+
+void FZooEnclosureSpatialIndex::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = INDEX_NONE;
+		return;
+	}
+
+	// The leaf's parent goes away and its sibling takes the parent's place.
+	const int32 Parent = Nodes[Leaf].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Sibling = Nodes[Parent].Child1 == Leaf ? Nodes[Parent].Child2 : Nodes[Parent].Child1;
+
+	Nodes[Sibling].Parent = GrandParent;
+	Nodes[Leaf].Parent = INDEX_NONE;
+	FreeNode(Parent);
+
+	if (GrandParent == INDEX_NONE)
+	{
+		Root = Sibling;
+		return;
+	}
+
+	if (Nodes[GrandParent].Child1 == Parent)
+	{
+		Nodes[GrandParent].Child1 = Sibling;
+	}
+	else
+	{
+		Nodes[GrandParent].Child2 = Sibling;
+	}
+
+	RefitAncestors(GrandParent);
+}
+
+void FZooEnclosureSpatialIndex::RefitAncestors(int32 Index)
+{
+	while (Index != INDEX_NONE)
+	{
+		Index = Balance(Index);
+
+		FNode& Node = Nodes[Index];
+		const FNode& Child1 = Nodes[Node.Child1];
+		const FNode& Child2 = Nodes[Node.Child2];
+		Node.Height = 1 + FMath::Max(Child1.Height, Child2.Height);
+		Node.Bounds = Child1.Bounds + Child2.Bounds;
+
+		Index = Node.Parent;
+	}
+}
+
+int32 FZooEnclosureSpatialIndex::Balance(int32 IndexA)
+{
+	FNode& A = Nodes[IndexA];
+	if (A.IsLeaf() || A.Height < 2)
+	{
+		return IndexA;
+	}
+
+	const int32 IndexB = A.Child1;
+	const int32 IndexC = A.Child2;
+	FNode& B = Nodes[IndexB];
+	FNode& C = Nodes[IndexC];
+	const int32 Imbalance = C.Height - B.Height;
+
+	// Promotes the taller child (Up) into A's place. A keeps its other child (Kept) and takes
+	// the shorter grandchild; Up keeps the taller grandchild.
+	auto Rotate = [this, IndexA, &A](int32 IndexUp, FNode& Up, const FNode& Kept, bool bKeptIsChild1)
+	{
+		const int32 IndexTall = Nodes[Up.Child1].Height > Nodes[Up.Child2].Height ? Up.Child1 : Up.Child2;
+		const int32 IndexShort = IndexTall == Up.Child1 ? Up.Child2 : Up.Child1;
+
+		Up.Child1 = IndexA;
+		Up.Child2 = IndexTall;
+		Up.Parent = A.Parent;
+		A.Parent = IndexUp;
+
+		if (Up.Parent == INDEX_NONE)
+		{
+			Root = IndexUp;
+		}
+		else if (Nodes[Up.Parent].Child1 == IndexA)
+		{
+			Nodes[Up.Parent].Child1 = IndexUp;
+		}
+		else
+		{
+			Nodes[Up.Parent].Child2 = IndexUp;
+		}
+
+		if (bKeptIsChild1)
+		{
+			A.Child2 = IndexShort;
+		}
+		else
+		{
+			A.Child1 = IndexShort;
+		}
+		Nodes[IndexShort].Parent = IndexA;
+
+		const FNode& Tall = Nodes[IndexTall];
+		const FNode& Short = Nodes[IndexShort];
+		A.Bounds = Kept.Bounds + Short.Bounds;
+		A.Height = 1 + FMath::Max(Kept.Height, Short.Height);
+		Up.Bounds = A.Bounds + Tall.Bounds;
+		Up.Height = 1 + FMath::Max(A.Height, Tall.Height);
+
+		return IndexUp;
+	};
+
+	if (Imbalance > 1)
+	{
+		return Rotate(IndexC, C, B, true);
+	}
+
+	if (Imbalance < -1)
+	{
+		return Rotate(IndexB, B, C, false);
+	}
+
+	return IndexA;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AEnclosureActor;
+
+/**
+ * FZooEnclosureSpatialIndex
+ *
+ * Dynamic AABB tree over the 2D bounds of enclosures. Leaves hold one
+ * enclosure each; inner nodes hold the union of their children's bounds.
+ * Leaves are inserted next to the sibling that grows the tree's perimeter
+ * least, and nodes are rotated on the way back up so no subtree is more
+ * than one level taller than its sibling. Point and box queries therefore
+ * visit O(log n) nodes.
+ *
+ * The index only narrows by bounds; callers test exact containment on the
+ * candidates it returns.
+ */
+class ZOOKEEPER_API FZooEnclosureSpatialIndex
+{
+public:
+	/** Inserts an enclosure, or moves it if it is already indexed. */
+	void Update(AEnclosureActor* Enclosure, const FBox2D& Bounds);
+
+	/** Removes an enclosure. Does nothing if it is not indexed. */
+	void Remove(const AEnclosureActor* Enclosure);
+
+	/** Removes every enclosure. */
+	void Reset();
+
+	/**
+	 * Calls Visitor for each enclosure whose bounds contain the point, edges included.
+	 * Visitor returns false to stop the query.
+	 */
+	void ForEachAtPoint(const FVector2D& Point, TFunctionRef<bool(AEnclosureActor*)> Visitor) const;
+
+	/**
+	 * Calls Visitor for each enclosure whose bounds overlap the box.
+	 * Visitor returns false to stop the query.
+	 */
+	void ForEachOverlapping(const FBox2D& Box, TFunctionRef<bool(AEnclosureActor*)> Visitor) const;
+
+	/** Returns the number of indexed enclosures. */
+	int32 Num() const { return LeafByEnclosure.Num(); }
+
+	/** Returns the height of the tree; 0 when empty, 1 for a single leaf. */
+	int32 GetHeight() const { return Root != INDEX_NONE ? Nodes[Root].Height + 1 : 0; }
+
+private:
+	struct FNode
+	{
+		FBox2D Bounds = FBox2D(ForceInit);
+
+		/** Parent node, or the next free node while on the free list. */
+		int32 Parent = INDEX_NONE;
+		int32 Child1 = INDEX_NONE;
+		int32 Child2 = INDEX_NONE;
+
+		/** 0 for leaves. */
+		int32 Height = 0;
+
+		/** Set on leaves only. */
+		TWeakObjectPtr<AEnclosureActor> Enclosure;
+
+		bool IsLeaf() const { return Child1 == INDEX_NONE; }
+	};
+
+	int32 AllocateNode();
+	void FreeNode(int32 Index);
+
+	void InsertLeaf(int32 Leaf);
+	void RemoveLeaf(int32 Leaf);
+
+	/** Recomputes bounds and heights from Index up to the root, rebalancing along the way. */
+	void RefitAncestors(int32 Index);
+
+	/** Rotates the subtree at Index if its children's heights differ by more than one. Returns the new subtree root. */
+	int32 Balance(int32 Index);
+
+	/** Nodes; freed ones are chained through Parent from FreeList. */
+	TArray<FNode> Nodes;
+	int32 Root = INDEX_NONE;
+	int32 FreeList = INDEX_NONE;
+
+	/** Leaf node of each indexed enclosure. */
+	TMap<TObjectKey<AEnclosureActor>, int32> LeafByEnclosure;
+};
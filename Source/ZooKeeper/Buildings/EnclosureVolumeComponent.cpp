@@ -1,17 +1,72 @@
 #include "EnclosureVolumeComponent.h"
 #include "ZooKeeper/ZooKeeper.h"
 
+/** Returns true if the segment from A to B passes through the inside of the box (Liang-Barsky clipping). */
+static bool SegmentCrossesBox(const FVector2D& A, const FVector2D& B, const FBox2D& Box)
+{
+	const FVector2D Delta = B - A;
+	double TEnter = 0.0;
+	double TExit = 1.0;
+	for (int32 Axis = 0; Axis < 2; ++Axis)
+	{
+		if (Delta[Axis] == 0.0)
+		{
+			if (A[Axis] <= Box.Min[Axis] || A[Axis] >= Box.Max[Axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		double TNear = (Box.Min[Axis] - A[Axis]) / Delta[Axis];
+		double TFar = (Box.Max[Axis] - A[Axis]) / Delta[Axis];
+		if (TNear > TFar)
+		{
+			Swap(TNear, TFar);
+		}
+
+		TEnter = FMath::Max(TEnter, TNear);
+		TExit = FMath::Min(TExit, TFar);
+		if (TEnter >= TExit)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 UEnclosureVolumeComponent::UEnclosureVolumeComponent()
 	: EnclosureHeight(300.0f)
 	, CachedArea(0.0f)
+	, WorldBounds(ForceInit)
 {
 	PrimaryComponentTick.bCanEverTick = false;
 }
 
+void UEnclosureVolumeComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	CachedArea = CalculateArea();
+	RebuildWorldPolygon();
+}
+
+void UEnclosureVolumeComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	RebuildWorldPolygon();
+
+	// The building manager indexes enclosures by their world bounds.
+	OnEnclosureBoundsChanged.Broadcast();
+}
+
 void UEnclosureVolumeComponent::SetBoundaryPoints(const TArray<FVector>& InPoints)
 {
 	BoundaryPoints = InPoints;
 	CachedArea = CalculateArea();
+	RebuildWorldPolygon();
 
 	OnEnclosureBoundsChanged.Broadcast();
 
@@ -41,38 +96,67 @@ float UEnclosureVolumeComponent::CalculateArea() const
 
 bool UEnclosureVolumeComponent::IsPointInside(FVector Point) const
 {
-	const int32 NumPoints = BoundaryPoints.Num();
-	if (NumPoints < 3)
+	return IsWorldPointInside(Point);
+}
+
+int32 UEnclosureVolumeComponent::TestPointsInside(TConstArrayView<FVector> Points, TArrayView<bool> OutInside) const
+{
+	check(OutInside.Num() >= Points.Num());
+
+	int32 NumInside = 0;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
 	{
-		return false;
+		OutInside[Index] = IsWorldPointInside(Points[Index]);
+		NumInside += OutInside[Index] ? 1 : 0;
 	}
 
-	// Transform the test point into local space
-	const FTransform ComponentTransform = GetComponentTransform();
-	const FVector LocalPoint = ComponentTransform.InverseTransformPosition(Point);
+	return NumInside;
+}
 
-	// Ray casting algorithm for 2D point-in-polygon (ignoring Z)
-	bool bInside = false;
-	for (int32 i = 0, j = NumPoints - 1; i < NumPoints; j = i++)
+TArray<bool> UEnclosureVolumeComponent::ArePointsInside(const TArray<FVector>& Points) const
+{
+	TArray<bool> Result;
+	Result.SetNumUninitialized(Points.Num());
+	TestPointsInside(Points, Result);
+	return Result;
+}
+
+bool UEnclosureVolumeComponent::OverlapsBox(const FBox2D& Box) const
+{
+	if (BandEdgeStarts.Num() < 2
+		|| Box.Max.X <= WorldBounds.Min.X || Box.Min.X >= WorldBounds.Max.X
+		|| Box.Max.Y <= WorldBounds.Min.Y || Box.Min.Y >= WorldBounds.Max.Y)
 	{
-		const FVector& PointI = BoundaryPoints[i];
-		const FVector& PointJ = BoundaryPoints[j];
+		return false;
+	}
 
-		if (((PointI.Y > LocalPoint.Y) != (PointJ.Y > LocalPoint.Y)) &&
-			(LocalPoint.X < (PointJ.X - PointI.X) * (LocalPoint.Y - PointI.Y) / (PointJ.Y - PointI.Y) + PointI.X))
+	// Either a corner of the box is inside the polygon, or the fence crosses the box.
+	const FVector2D Corners[] = { Box.Min, FVector2D(Box.Max.X, Box.Min.Y), Box.Max, FVector2D(Box.Min.X, Box.Max.Y) };
+	for (const FVector2D& Corner : Corners)
+	{
+		if (IsWorldPointInside(FVector(Corner, 0.0)))
 		{
-			bInside = !bInside;
+			return true;
 		}
 	}
 
-	return bInside;
+	// Every edge, horizontal ones included, which the crossing test leaves out of WorldEdges.
+	for (int32 i = 0, j = WorldVertices.Num() - 1; i < WorldVertices.Num(); j = i++)
+	{
+		if (SegmentCrossesBox(WorldVertices[j], WorldVertices[i], Box))
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
 FVector UEnclosureVolumeComponent::GetRandomPointInside() const
 {
-	const FBox Bounds = GetBoundingBox();
+	const FBox& Bounds = WorldBounds;
 
-	if (!Bounds.IsValid || BoundaryPoints.Num() < 3)
+	if (!Bounds.IsValid || WorldEdges.Num() < 2)
 	{
 		UE_LOG(LogZooKeeper, Warning, TEXT("EnclosureVolume: Cannot get random point - insufficient boundary points."));
 		return GetComponentLocation();
@@ -83,7 +167,7 @@ FVector UEnclosureVolumeComponent::GetRandomPointInside() const
 	{
 		const FVector RandomPoint = FMath::RandPointInBox(Bounds);
 
-		if (IsPointInside(RandomPoint))
+		if (IsWorldPointInside(RandomPoint))
 		{
 			return RandomPoint;
 		}
@@ -108,19 +192,119 @@ bool UEnclosureVolumeComponent::IsClosedPolygon() const
 
 FBox UEnclosureVolumeComponent::GetBoundingBox() const
 {
-	if (BoundaryPoints.Num() == 0)
+	return WorldBounds;
+}
+
+// -------------------------------------------------------------------
+//  World Polygon Cache
+// -------------------------------------------------------------------
+
+void UEnclosureVolumeComponent::RebuildWorldPolygon()
+{
+	WorldBounds = FBox(ForceInit);
+	WorldVertices.Reset();
+	WorldEdges.Reset();
+	BandEdgeStarts.Reset();
+	BandEdgeIndices.Reset();
+
+	const int32 NumPoints = BoundaryPoints.Num();
+	if (NumPoints == 0)
 	{
-		return FBox(ForceInit);
+		return;
 	}
 
 	const FTransform ComponentTransform = GetComponentTransform();
 
-	FBox Bounds(ForceInit);
+	TArray<FVector, TInlineAllocator<64>> WorldPoints;
+	WorldPoints.Reserve(NumPoints);
 	for (const FVector& LocalPoint : BoundaryPoints)
 	{
-		const FVector WorldPoint = ComponentTransform.TransformPosition(LocalPoint);
-		Bounds += WorldPoint;
+		WorldBounds += WorldPoints.Add_GetRef(ComponentTransform.TransformPosition(LocalPoint));
+	}
+
+	if (NumPoints < 3)
+	{
+		return;
+	}
+
+	WorldVertices.Reserve(NumPoints);
+	for (const FVector& WorldPoint : WorldPoints)
+	{
+		WorldVertices.Add(FVector2D(WorldPoint));
+	}
+
+	// Horizontal edges never straddle the test ray, so they are left out.
+	for (int32 i = 0, j = NumPoints - 1; i < NumPoints; j = i++)
+	{
+		const FVector& PointI = WorldPoints[i];
+		const FVector& PointJ = WorldPoints[j];
+		if (PointI.Y != PointJ.Y)
+		{
+			WorldEdges.Add({ PointI.X, PointI.Y, PointJ.Y, (PointJ.X - PointI.X) / (PointJ.Y - PointI.Y) });
+		}
+	}
+
+	const int32 NumBands = FMath::Clamp(WorldEdges.Num(), 1, MaxPolygonBands);
+	const double Height = WorldBounds.Max.Y - WorldBounds.Min.Y;
+	BandOriginY = WorldBounds.Min.Y;
+	BandsPerUnit = Height > 0.0 ? NumBands / Height : 0.0;
+
+	// Count the edges of each band, turn the counts into offsets, then fill.
+	BandEdgeStarts.SetNumZeroed(NumBands + 1);
+	for (const FPolygonEdge& Edge : WorldEdges)
+	{
+		const int32 LastBand = GetBandIndex(FMath::Max(Edge.Y0, Edge.Y1));
+		for (int32 Band = GetBandIndex(FMath::Min(Edge.Y0, Edge.Y1)); Band <= LastBand; ++Band)
+		{
+			BandEdgeStarts[Band + 1]++;
+		}
+	}
+
+	for (int32 Band = 0; Band < NumBands; ++Band)
+	{
+		BandEdgeStarts[Band + 1] += BandEdgeStarts[Band];
 	}
 
-	return Bounds;
+	BandEdgeIndices.SetNumUninitialized(BandEdgeStarts[NumBands]);
+	TArray<int32, TInlineAllocator<MaxPolygonBands>> FillCursors(BandEdgeStarts.GetData(), NumBands);
+	for (int32 EdgeIndex = 0; EdgeIndex < WorldEdges.Num(); ++EdgeIndex)
+	{
+		const FPolygonEdge& Edge = WorldEdges[EdgeIndex];
+		const int32 LastBand = GetBandIndex(FMath::Max(Edge.Y0, Edge.Y1));
+		for (int32 Band = GetBandIndex(FMath::Min(Edge.Y0, Edge.Y1)); Band <= LastBand; ++Band)
+		{
+			BandEdgeIndices[FillCursors[Band]++] = EdgeIndex;
+		}
+	}
+}
+
+bool UEnclosureVolumeComponent::IsWorldPointInside(const FVector& Point) const
+{
+	if (BandEdgeStarts.Num() < 2
+		|| Point.X < WorldBounds.Min.X || Point.X > WorldBounds.Max.X
+		|| Point.Y < WorldBounds.Min.Y || Point.Y > WorldBounds.Max.Y)
+	{
+		return false;
+	}
+
+	// Ray casting along +X, against only the edges that span the point's band.
+	const int32 Band = GetBandIndex(Point.Y);
+	bool bInside = false;
+	for (int32 Slot = BandEdgeStarts[Band]; Slot < BandEdgeStarts[Band + 1]; ++Slot)
+	{
+		const FPolygonEdge& Edge = WorldEdges[BandEdgeIndices[Slot]];
+		if (((Edge.Y0 > Point.Y) != (Edge.Y1 > Point.Y)) &&
+			(Point.X < Edge.X0 + (Point.Y - Edge.Y0) * Edge.DxDy))
+		{
+			bInside = !bInside;
+		}
+	}
+
+	return bInside;
+}
+
+int32 UEnclosureVolumeComponent::GetBandIndex(double Y) const
+{
+	const int32 NumBands = BandEdgeStarts.Num() - 1;
+	return FMath::Clamp(FMath::FloorToInt32((Y - BandOriginY) * BandsPerUnit), 0, NumBands - 1);
 }
@@ -4,7 +4,7 @@
 #include "Components/SceneComponent.h"
 #include "EnclosureVolumeComponent.generated.h"
 
-/** Broadcast when the enclosure boundary points are modified. */
+/** Broadcast when the enclosure boundary points are modified or the enclosure moves. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnclosureBoundsChanged);
 
 /**
@@ -13,6 +13,12 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnclosureBoundsChanged);
  * Defines the walkable volume of an animal enclosure as a 2D polygon
  * extruded to a configurable height. Provides spatial queries such as
  * point-in-polygon testing and random point generation for AI movement.
+ *
+ * The polygon is cached in world space, with its bounds and edges, whenever
+ * the boundary is set or the component moves. Edges are bucketed into
+ * horizontal bands over the bounds, so a containment test only crosses the
+ * edges of the point's band rather than the whole fence. Change the
+ * boundary through SetBoundaryPoints so the cache follows.
  */
 UCLASS(ClassGroup = (Zoo), meta = (BlueprintSpawnableComponent, DisplayName = "Enclosure Volume"))
 class ZOOKEEPER_API UEnclosureVolumeComponent : public USceneComponent
@@ -22,6 +28,10 @@ class ZOOKEEPER_API UEnclosureVolumeComponent : public USceneComponent
 public:
 	UEnclosureVolumeComponent();
 
+	//~ Begin UActorComponent Interface
+	virtual void OnRegister() override;
+	//~ End UActorComponent Interface
+
 	// -------------------------------------------------------------------
 	//  Configuration
 	// -------------------------------------------------------------------
@@ -60,6 +70,30 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Enclosure|Volume")
 	bool IsPointInside(FVector Point) const;
 
+	/**
+	 * Tests many world-space points against the polygon at once (2D, ignores Z).
+	 * @param Points     The points to test.
+	 * @param OutInside  Receives one result per point; must be at least as long as Points.
+	 * @return The number of points inside.
+	 */
+	int32 TestPointsInside(TConstArrayView<FVector> Points, TArrayView<bool> OutInside) const;
+
+	/**
+	 * Blueprint access to TestPointsInside.
+	 * @param Points  The world-space points to test.
+	 * @return Whether each point is inside, in the same order.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Enclosure|Volume")
+	TArray<bool> ArePointsInside(const TArray<FVector>& Points) const;
+
+	/**
+	 * Tests whether the polygon and a world-space box share any area (2D, ignores Z).
+	 * Touching along an edge does not count.
+	 * @param Box  The box to test.
+	 * @return true if part of the box is inside the polygon.
+	 */
+	bool OverlapsBox(const FBox2D& Box) const;
+
 	/**
 	 * Returns a random world-space point inside the enclosure polygon
 	 * using rejection sampling within the bounding box.
@@ -89,10 +123,55 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Enclosure|Volume")
 	FOnEnclosureBoundsChanged OnEnclosureBoundsChanged;
 
+protected:
+	//~ Begin USceneComponent Interface
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
+	//~ End USceneComponent Interface
+
 private:
+	/** A non-horizontal polygon edge in world space, set up for the crossing test. */
+	struct FPolygonEdge
+	{
+		double X0;
+		double Y0;
+		double Y1;
+
+		/** Change in X per unit of Y along the edge. */
+		double DxDy;
+	};
+
+	/** Rebuilds the world-space polygon, bounds and edge bands from BoundaryPoints and the component transform. */
+	void RebuildWorldPolygon();
+
+	/** Containment test against the cached world polygon. */
+	bool IsWorldPointInside(const FVector& Point) const;
+
+	/** Returns the band a world Y coordinate falls in, clamped to the bounds. */
+	int32 GetBandIndex(double Y) const;
+
 	/** Cached area value, updated when boundary points change. */
 	float CachedArea;
 
+	/** World-space bounds of the boundary points. */
+	FBox WorldBounds;
+
+	/** Vertices of the world-space polygon, in order; empty when it has fewer than three. */
+	TArray<FVector2D> WorldVertices;
+
+	/** Edges of the world-space polygon. */
+	TArray<FPolygonEdge> WorldEdges;
+
+	/** Edges of band B are BandEdgeIndices[BandEdgeStarts[B] .. BandEdgeStarts[B + 1]). */
+	TArray<int32> BandEdgeStarts;
+	TArray<int32> BandEdgeIndices;
+
+	/** Maps world Y to a band: Band = (Y - BandOriginY) * BandsPerUnit. */
+	double BandOriginY = 0.0;
+	double BandsPerUnit = 0.0;
+
+	/** Upper limit on the number of edge bands. */
+	static constexpr int32 MaxPolygonBands = 256;
+
 	/** Threshold distance for considering the polygon closed. */
 	static constexpr float ClosedPolygonThreshold = 10.0f;
 
@@ -1,6 +1,8 @@
 #include "EnrichmentItemActor.h"
+#include "EnclosureActor.h"
 #include "Components/StaticMeshComponent.h"
 #include "ZooKeeper/ZooKeeper.h"
+#include "ZooKeeper/Subsystems/BuildingManagerSubsystem.h"
 
 AEnrichmentItemActor::AEnrichmentItemActor()
 	: HappinessBoost(0.1f)
@@ -12,6 +14,57 @@ AEnrichmentItemActor::AEnrichmentItemActor()
 	RootComponent = MeshComp;
 }
 
+void AEnrichmentItemActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdateOwningEnclosure();
+	if (!OwningEnclosure.IsValid())
+	{
+		// The enclosure may begin play later, and adopts the item then.
+		UE_LOG(LogZooKeeper, Log, TEXT("EnrichmentItemActor: '%s' is not inside an enclosure yet."), *ItemID.ToString());
+	}
+}
+
+void AEnrichmentItemActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AEnclosureActor* Enclosure = OwningEnclosure.Get())
+	{
+		Enclosure->UnregisterEnrichment(this);
+	}
+	OwningEnclosure = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AEnrichmentItemActor::UpdateOwningEnclosure()
+{
+	AEnclosureActor* NewEnclosure = nullptr;
+	if (UWorld* World = GetWorld())
+	{
+		if (UBuildingManagerSubsystem* BuildingManager = World->GetSubsystem<UBuildingManagerSubsystem>())
+		{
+			NewEnclosure = BuildingManager->FindEnclosureAtLocation(GetActorLocation());
+		}
+	}
+
+	AEnclosureActor* OldEnclosure = OwningEnclosure.Get();
+	if (NewEnclosure == OldEnclosure)
+	{
+		return;
+	}
+
+	if (OldEnclosure)
+	{
+		OldEnclosure->UnregisterEnrichment(this);
+	}
+	if (NewEnclosure)
+	{
+		NewEnclosure->RegisterEnrichment(this);
+	}
+	OwningEnclosure = NewEnclosure;
+}
+
 FText AEnrichmentItemActor::GetInteractionPrompt_Implementation() const
 {
 	return FText::FromString(FString::Printf(TEXT("Enrichment: %s (+%.0f%% Happiness)"),
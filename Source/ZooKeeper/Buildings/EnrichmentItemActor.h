@@ -5,12 +5,16 @@
 #include "Interaction/InteractableInterface.h"
 #include "EnrichmentItemActor.generated.h"
 
+class AEnclosureActor;
+
 /**
  * AEnrichmentItemActor
  *
  * Placeable enrichment item (climbing frame, tire swing, pool, etc.)
  * that boosts animal happiness when placed inside an enclosure.
- * Reads configuration from DT_EnrichmentItems.
+ * Reads configuration from DT_EnrichmentItems. On BeginPlay the item
+ * registers with the enclosure it stands in, where it counts toward
+ * enclosure quality.
  */
 UCLASS(Blueprintable, meta = (DisplayName = "Enrichment Item Actor"))
 class ZOOKEEPER_API AEnrichmentItemActor : public AActor, public IInteractable
@@ -48,7 +52,20 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Enrichment")
 	bool IsCompatibleWithSpecies(FName SpeciesID) const;
 
+	/**
+	 * Moves the item to the enclosure it now stands in, if that changed. Called when play
+	 * begins and when an enclosure forms or changes shape around it.
+	 */
+	void UpdateOwningEnclosure();
+
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Enrichment")
 	TObjectPtr<UStaticMeshComponent> MeshComp;
+
+private:
+	/** The enclosure this item was placed in, if any. */
+	TWeakObjectPtr<AEnclosureActor> OwningEnclosure;
 };
@@ -1,14 +1,65 @@
 #include "FeederActor.h"
+#include "EnclosureActor.h"
 #include "Subsystems/EconomySubsystem.h"
+#include "Subsystems/BuildingManagerSubsystem.h"
 #include "ZooKeeper.h"
 
 AFeederActor::AFeederActor()
 {
+	Category            = EBuildingCategory::FoodStation;
 	FoodType            = EFoodType::Grain;
 	MaxCapacity         = 10;
 	CurrentStock        = 10;
 	RestockCostPerUnit  = 5;
 	HungerRestorePerUse = 0.3f;
+
+	bPlaceableInEnclosures = true;
+}
+
+void AFeederActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdateOwningEnclosure();
+}
+
+void AFeederActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AEnclosureActor* Enclosure = OwningEnclosure.Get())
+	{
+		Enclosure->UnregisterFeeder(this);
+	}
+	OwningEnclosure = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFeederActor::UpdateOwningEnclosure()
+{
+	AEnclosureActor* NewEnclosure = nullptr;
+	if (UWorld* World = GetWorld())
+	{
+		if (UBuildingManagerSubsystem* BuildingManager = World->GetSubsystem<UBuildingManagerSubsystem>())
+		{
+			NewEnclosure = BuildingManager->FindEnclosureAtLocation(GetActorLocation());
+		}
+	}
+
+	AEnclosureActor* OldEnclosure = OwningEnclosure.Get();
+	if (NewEnclosure == OldEnclosure)
+	{
+		return;
+	}
+
+	if (OldEnclosure)
+	{
+		OldEnclosure->UnregisterFeeder(this);
+	}
+	if (NewEnclosure)
+	{
+		NewEnclosure->RegisterFeeder(this);
+	}
+	OwningEnclosure = NewEnclosure;
 }
 
 // ---------------------------------------------------------------------------
@@ -49,7 +100,7 @@ void AFeederActor::OnInteract_Implementation(AActor* Interactor)
 		return;
 	}
 
-	if (EconSys->TrySpend(Cost, FString::Printf(TEXT("Restock feeder (%d units)"), UnitsToAdd)))
+	if (EconSys->TrySpend(Cost, FString::Printf(TEXT("Restock feeder (%d units)"), UnitsToAdd), ETransactionCategory::AnimalFood))
 	{
 		Restock(UnitsToAdd);
 		UE_LOG(LogZooKeeper, Log, TEXT("Feeder [%s] restocked %d units for $%d."), *GetName(), UnitsToAdd, Cost);
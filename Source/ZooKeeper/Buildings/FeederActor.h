@@ -5,6 +5,8 @@
 #include "Data/ZooDataTypes.h"
 #include "FeederActor.generated.h"
 
+class AEnclosureActor;
+
 /** Broadcast when the feeder runs out of food. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFoodDepleted, AFeederActor*, Feeder);
 
@@ -16,7 +18,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFeederRestocked, AFeederActor*,
  *
  * Placeable feeder that holds food for animals. Animals consume food from the
  * feeder through their BTTask_AnimalEat behavior. Players can restock the
- * feeder via the interaction system (costs money).
+ * feeder via the interaction system (costs money). A feeder placed inside an
+ * enclosure registers with it, so its stock counts toward enclosure quality.
  */
 UCLASS(BlueprintType, Blueprintable, meta = (DisplayName = "Feeder"))
 class ZOOKEEPER_API AFeederActor : public AZooBuildingActor
@@ -80,6 +83,12 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Feeder")
 	bool IsEmpty() const;
 
+	/**
+	 * Moves the feeder to the enclosure it now stands in, if that changed. Called when play
+	 * begins and when an enclosure forms or changes shape around it.
+	 */
+	void UpdateOwningEnclosure();
+
 	// -------------------------------------------------------------------
 	//  Delegates
 	// -------------------------------------------------------------------
@@ -89,4 +98,12 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Feeder")
 	FOnFeederRestocked OnFeederRestocked;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** The enclosure this feeder was placed in, if any. */
+	TWeakObjectPtr<AEnclosureActor> OwningEnclosure;
 };
@@ -0,0 +1,392 @@
+#include "PathNetworkActor.h"
+#include "ZooKeeper/ZooKeeper.h"
+#include "ZooKeeper/Subsystems/BuildingManagerSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+/** Scalar parameter of PreviewMaterial set to 0 while the drag cannot be applied. */
+static const FName PreviewValidParameter(TEXT("PlacementValid"));
+
+/** Neighbor offsets in NeighborMask bit order: +X, +Y, -X, -Y. */
+static const FIntPoint PathNeighborOffsets[4] = { FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(-1, 0), FIntPoint(0, -1) };
+
+/** Shape and yaw of a tile for each neighbor mask. Yaw turns +X toward +Y. */
+struct FPathTileLayout
+{
+	EPathTileShape Shape;
+	float Yaw;
+};
+
+static const FPathTileLayout PathTileLayouts[16] =
+{
+	{ EPathTileShape::Isolated,  0.0f },	// none
+	{ EPathTileShape::End,       0.0f },	// +X
+	{ EPathTileShape::End,      90.0f },	// +Y
+	{ EPathTileShape::Corner,    0.0f },	// +X +Y
+	{ EPathTileShape::End,     180.0f },	// -X
+	{ EPathTileShape::Straight,  0.0f },	// +X -X
+	{ EPathTileShape::Corner,   90.0f },	// +Y -X
+	{ EPathTileShape::TJunction, 0.0f },	// +X +Y -X
+	{ EPathTileShape::End,     270.0f },	// -Y
+	{ EPathTileShape::Corner,  270.0f },	// +X -Y
+	{ EPathTileShape::Straight, 90.0f },	// +Y -Y
+	{ EPathTileShape::TJunction, 270.0f },	// +X +Y -Y
+	{ EPathTileShape::Corner,  180.0f },	// -X -Y
+	{ EPathTileShape::TJunction, 180.0f },	// +X -X -Y
+	{ EPathTileShape::TJunction, 90.0f },	// +Y -X -Y
+	{ EPathTileShape::Cross,     0.0f },	// all
+};
+
+/** Returns the building manager of an actor's world, or nullptr. */
+static UBuildingManagerSubsystem* GetBuildingManager(const AActor* Actor)
+{
+	const UWorld* World = Actor->GetWorld();
+	return World ? World->GetSubsystem<UBuildingManagerSubsystem>() : nullptr;
+}
+
+APathNetworkActor::APathNetworkActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetActorEnableCollision(false);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void APathNetworkActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CreateStyleComponents();
+
+	if (UBuildingManagerSubsystem* BuildingManager = GetBuildingManager(this))
+	{
+		BuildingManager->RegisterPathNetwork(this);
+	}
+}
+
+void APathNetworkActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UBuildingManagerSubsystem* BuildingManager = GetBuildingManager(this))
+	{
+		BuildingManager->UnregisterPathNetwork(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+int32 APathNetworkActor::FindStyleIndex(FName StyleID) const
+{
+	return Styles.IndexOfByPredicate([StyleID](const FZooPathStyle& Style) { return Style.StyleID == StyleID; });
+}
+
+// -------------------------------------------------------------------
+//  Tiles
+// -------------------------------------------------------------------
+
+int32 APathNetworkActor::AddTiles(TConstArrayView<FIntPoint> Cells, int32 StyleIndex, float Height)
+{
+	if (!StyleComponents.IsValidIndex(StyleIndex) || !StyleComponents[StyleIndex])
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("PathNetwork: Cannot add tiles of unknown style %d."), StyleIndex);
+		return 0;
+	}
+
+	// Claim every cell first so the new tiles see each other as neighbors.
+	TArray<FIntPoint> NewCells;
+	NewCells.Reserve(Cells.Num());
+	for (const FIntPoint& Cell : Cells)
+	{
+		if (!Tiles.Contains(Cell))
+		{
+			FPathTile& Tile = Tiles.Add(Cell);
+			Tile.Style = static_cast<uint8>(StyleIndex);
+			Tile.Height = Height;
+			NewCells.Add(Cell);
+		}
+	}
+
+	if (NewCells.Num() == 0)
+	{
+		return 0;
+	}
+
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(NewCells.Num());
+	for (const FIntPoint& Cell : NewCells)
+	{
+		FPathTile& Tile = Tiles[Cell];
+		Tile.NeighborMask = ComputeNeighborMask(Cell);
+		Transforms.Add(GetTileTransform(Cell, Height, Tile.NeighborMask));
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* Component = StyleComponents[StyleIndex];
+	TArray<FIntPoint>& InstanceCells = StyleInstanceCells[StyleIndex];
+	const TArray<int32> Instances = Component->AddInstances(Transforms, true, true);
+
+	for (int32 Index = 0; Index < Instances.Num(); ++Index)
+	{
+		const FIntPoint& Cell = NewCells[Index];
+		FPathTile& Tile = Tiles[Cell];
+		Tile.Instance = Instances[Index];
+
+		if (InstanceCells.Num() <= Tile.Instance)
+		{
+			InstanceCells.SetNum(Tile.Instance + 1);
+		}
+		InstanceCells[Tile.Instance] = Cell;
+
+		Component->SetCustomDataValue(Tile.Instance, 0, static_cast<float>(PathTileLayouts[Tile.NeighborMask].Shape), false);
+	}
+	Component->MarkRenderStateDirty();
+
+	// Existing tiles next to the new ones gain a neighbor.
+	TSet<FIntPoint> Neighbors;
+	for (const FIntPoint& Cell : NewCells)
+	{
+		for (const FIntPoint& Offset : PathNeighborOffsets)
+		{
+			Neighbors.Add(Cell + Offset);
+		}
+	}
+	RefreshShapes(Neighbors);
+
+	if (UBuildingManagerSubsystem* BuildingManager = GetBuildingManager(this))
+	{
+		BuildingManager->NotifyPathTilesChanged();
+	}
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("PathNetwork: Added %d tiles (total: %d)."), NewCells.Num(), Tiles.Num());
+	return NewCells.Num();
+}
+
+int32 APathNetworkActor::RemoveTiles(TConstArrayView<FIntPoint> Cells)
+{
+	TArray<bool, TInlineAllocator<8>> DirtyStyles;
+	DirtyStyles.SetNumZeroed(StyleComponents.Num());
+
+	TSet<FIntPoint> Neighbors;
+	int32 NumRemoved = 0;
+
+	for (const FIntPoint& Cell : Cells)
+	{
+		FPathTile Tile;
+		if (!Tiles.RemoveAndCopyValue(Cell, Tile))
+		{
+			continue;
+		}
+
+		// Components remove by swapping the last instance into the hole; follow it.
+		UHierarchicalInstancedStaticMeshComponent* Component = StyleComponents[Tile.Style];
+		TArray<FIntPoint>& InstanceCells = StyleInstanceCells[Tile.Style];
+		Component->RemoveInstance(Tile.Instance);
+
+		const int32 LastInstance = InstanceCells.Num() - 1;
+		if (Tile.Instance != LastInstance)
+		{
+			const FIntPoint MovedCell = InstanceCells[LastInstance];
+			InstanceCells[Tile.Instance] = MovedCell;
+			Tiles[MovedCell].Instance = Tile.Instance;
+		}
+		InstanceCells.Pop(EAllowShrinking::No);
+
+		DirtyStyles[Tile.Style] = true;
+		NumRemoved++;
+
+		for (const FIntPoint& Offset : PathNeighborOffsets)
+		{
+			Neighbors.Add(Cell + Offset);
+		}
+	}
+
+	for (int32 StyleIndex = 0; StyleIndex < DirtyStyles.Num(); ++StyleIndex)
+	{
+		if (DirtyStyles[StyleIndex])
+		{
+			StyleComponents[StyleIndex]->MarkRenderStateDirty();
+		}
+	}
+
+	if (NumRemoved == 0)
+	{
+		return 0;
+	}
+
+	RefreshShapes(Neighbors);
+
+	if (UBuildingManagerSubsystem* BuildingManager = GetBuildingManager(this))
+	{
+		BuildingManager->NotifyPathTilesChanged();
+	}
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("PathNetwork: Removed %d tiles (total: %d)."), NumRemoved, Tiles.Num());
+	return NumRemoved;
+}
+
+int32 APathNetworkActor::GetDailyMaintenanceCost() const
+{
+	TArray<int32, TInlineAllocator<8>> TilesPerStyle;
+	TilesPerStyle.SetNumZeroed(Styles.Num());
+	for (const TPair<FIntPoint, FPathTile>& Entry : Tiles)
+	{
+		if (TilesPerStyle.IsValidIndex(Entry.Value.Style))
+		{
+			TilesPerStyle[Entry.Value.Style]++;
+		}
+	}
+
+	float Total = 0.0f;
+	for (int32 StyleIndex = 0; StyleIndex < Styles.Num(); ++StyleIndex)
+	{
+		Total += TilesPerStyle[StyleIndex] * Styles[StyleIndex].MaintenancePerTilePerDay;
+	}
+	return FMath::RoundToInt(Total);
+}
+
+// -------------------------------------------------------------------
+//  Preview
+// -------------------------------------------------------------------
+
+void APathNetworkActor::SetPreview(TConstArrayView<FIntPoint> Cells, int32 StyleIndex, float Height, bool bValid)
+{
+	if (!PreviewComponent || !Styles.IsValidIndex(StyleIndex))
+	{
+		return;
+	}
+
+	if (!PreviewMID && PreviewMaterial)
+	{
+		PreviewMID = UMaterialInstanceDynamic::Create(PreviewMaterial, this);
+	}
+
+	if (PreviewComponent->GetStaticMesh() != Styles[StyleIndex].TileMesh)
+	{
+		PreviewComponent->SetStaticMesh(Styles[StyleIndex].TileMesh);
+		if (PreviewMID)
+		{
+			for (int32 Slot = 0; Slot < PreviewComponent->GetNumMaterials(); ++Slot)
+			{
+				PreviewComponent->SetMaterial(Slot, PreviewMID);
+			}
+		}
+	}
+
+	if (PreviewMID)
+	{
+		PreviewMID->SetScalarParameterValue(PreviewValidParameter, bValid ? 1.0f : 0.0f);
+	}
+
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(Cells.Num());
+	for (const FIntPoint& Cell : Cells)
+	{
+		Transforms.Add(GetTileTransform(Cell, Height, 0));
+	}
+
+	PreviewComponent->ClearInstances();
+	PreviewComponent->AddInstances(Transforms, false, true);
+}
+
+void APathNetworkActor::ClearPreview()
+{
+	if (PreviewComponent)
+	{
+		PreviewComponent->ClearInstances();
+	}
+}
+
+// -------------------------------------------------------------------
+//  Private Helpers
+// -------------------------------------------------------------------
+
+void APathNetworkActor::CreateStyleComponents()
+{
+	auto CreateInstancedMesh = [this](UStaticMesh* Mesh)
+	{
+		UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+		Component->SetStaticMesh(Mesh);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetGenerateOverlapEvents(false);
+		Component->SetCanEverAffectNavigation(false);
+		Component->SetRemoveSwap();
+		Component->SetupAttachment(RootComponent);
+		Component->RegisterComponent();
+		return Component;
+	};
+
+	StyleComponents.Reset(Styles.Num());
+	StyleInstanceCells.SetNum(Styles.Num());
+
+	for (const FZooPathStyle& Style : Styles)
+	{
+		UHierarchicalInstancedStaticMeshComponent* Component = CreateInstancedMesh(Style.TileMesh);
+		Component->SetNumCustomDataFloats(1);
+		StyleComponents.Add(Component);
+
+		if (!Style.TileMesh)
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("PathNetwork: Style '%s' has no tile mesh."), *Style.StyleID.ToString());
+		}
+	}
+
+	PreviewComponent = CreateInstancedMesh(nullptr);
+	PreviewComponent->SetCastShadow(false);
+}
+
+uint8 APathNetworkActor::ComputeNeighborMask(FIntPoint Cell) const
+{
+	uint8 Mask = 0;
+	for (int32 Side = 0; Side < 4; ++Side)
+	{
+		if (Tiles.Contains(Cell + PathNeighborOffsets[Side]))
+		{
+			Mask |= 1 << Side;
+		}
+	}
+	return Mask;
+}
+
+void APathNetworkActor::RefreshShapes(const TSet<FIntPoint>& Cells)
+{
+	TArray<bool, TInlineAllocator<8>> DirtyStyles;
+	DirtyStyles.SetNumZeroed(StyleComponents.Num());
+
+	for (const FIntPoint& Cell : Cells)
+	{
+		FPathTile* Tile = Tiles.Find(Cell);
+		if (!Tile)
+		{
+			continue;
+		}
+
+		const uint8 Mask = ComputeNeighborMask(Cell);
+		if (Mask == Tile->NeighborMask)
+		{
+			continue;
+		}
+
+		Tile->NeighborMask = Mask;
+
+		UHierarchicalInstancedStaticMeshComponent* Component = StyleComponents[Tile->Style];
+		Component->UpdateInstanceTransform(Tile->Instance, GetTileTransform(Cell, Tile->Height, Mask), true, false, true);
+		Component->SetCustomDataValue(Tile->Instance, 0, static_cast<float>(PathTileLayouts[Mask].Shape), false);
+		DirtyStyles[Tile->Style] = true;
+	}
+
+	for (int32 StyleIndex = 0; StyleIndex < DirtyStyles.Num(); ++StyleIndex)
+	{
+		if (DirtyStyles[StyleIndex])
+		{
+			StyleComponents[StyleIndex]->MarkRenderStateDirty();
+		}
+	}
+}
+
+FTransform APathNetworkActor::GetTileTransform(FIntPoint Cell, float Height, uint8 NeighborMask)
+{
+	const float CellSize = UBuildingManagerSubsystem::GridCellSize;
+	return FTransform(
+		FRotator(0.0f, PathTileLayouts[NeighborMask].Yaw, 0.0f),
+		FVector(Cell.X * CellSize, Cell.Y * CellSize, Height));
+}
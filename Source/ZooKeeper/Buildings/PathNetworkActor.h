@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "PathNetworkActor.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UStaticMesh;
+
+/** Shape of a path tile, from the tiles next to it. Written to per-instance custom data 0. */
+UENUM(BlueprintType)
+enum class EPathTileShape : uint8
+{
+	Isolated	UMETA(DisplayName = "Isolated"),
+	End			UMETA(DisplayName = "End"),
+	Straight	UMETA(DisplayName = "Straight"),
+	Corner		UMETA(DisplayName = "Corner"),
+	TJunction	UMETA(DisplayName = "T-Junction"),
+	Cross		UMETA(DisplayName = "Cross")
+};
+
+/**
+ * FZooPathStyle
+ *
+ * One kind of path surface that can be painted.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooPathStyle
+{
+	GENERATED_BODY()
+
+	/** Unique identifier for this style. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path")
+	FName StyleID;
+
+	/** Localized name shown in the build menu. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path")
+	FText DisplayName;
+
+	/**
+	 * Mesh of one grid cell of path. Its material picks the pattern from per-instance
+	 * custom data 0 (an EPathTileShape); instances are rotated to fit their neighbors.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path")
+	TObjectPtr<UStaticMesh> TileMesh;
+
+	/** Cost of painting one tile. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path", meta = (ClampMin = "0"))
+	int32 CostPerTile = 10;
+
+	/** Daily upkeep of one tile, charged by the building manager's maintenance pass. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path", meta = (ClampMin = "0.0"))
+	float MaintenancePerTilePerDay = 0.1f;
+};
+
+/**
+ * APathNetworkActor
+ *
+ * Holds every path tile in the zoo as a cell of the building manager's
+ * placement grid. Tiles are not actors: each style is drawn by a single
+ * hierarchical instanced mesh component, so a park-wide path network costs
+ * a few draw calls however many tiles it has.
+ *
+ * Tiles auto-tile. A tile's shape (end, straight, corner, junction) follows
+ * from which of its four neighbors are paths, of any style. The shape is
+ * written to the instance's custom data and its rotation to the instance
+ * transform. Adding or removing tiles only re-shapes the tiles around them.
+ *
+ * One network is placed in the level, or spawned by the placement
+ * component, and registers with the UBuildingManagerSubsystem.
+ */
+UCLASS(Blueprintable, meta = (DisplayName = "Path Network"))
+class ZOOKEEPER_API APathNetworkActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	APathNetworkActor();
+
+	// -------------------------------------------------------------------
+	//  Configuration
+	// -------------------------------------------------------------------
+
+	/** Styles that can be painted. A style's index in this list identifies it in the network. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path")
+	TArray<FZooPathStyle> Styles;
+
+	/** Material for the drag preview, with a PlacementValid scalar parameter that is 0 for a drag that cannot be applied. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Path")
+	TObjectPtr<UMaterialInterface> PreviewMaterial;
+
+	// -------------------------------------------------------------------
+	//  Tiles
+	// -------------------------------------------------------------------
+
+	/** Returns the index of a style, or INDEX_NONE if there is no such style. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Path")
+	int32 FindStyleIndex(FName StyleID) const;
+
+	/**
+	 * Lays tiles of a style on grid cells. Cells that already have a path are skipped.
+	 * @param Cells       Grid cells of the building manager's occupancy grid.
+	 * @param StyleIndex  Index into Styles.
+	 * @param Height      World Z of the new tiles.
+	 * @return The number of tiles added.
+	 */
+	int32 AddTiles(TConstArrayView<FIntPoint> Cells, int32 StyleIndex, float Height);
+
+	/**
+	 * Removes the tiles on grid cells. Cells without a path are skipped.
+	 * @return The number of tiles removed.
+	 */
+	int32 RemoveTiles(TConstArrayView<FIntPoint> Cells);
+
+	/** Returns true if a grid cell has a path tile. */
+	bool HasTile(FIntPoint Cell) const { return Tiles.Contains(Cell); }
+
+	/** Returns the number of path tiles. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Path")
+	int32 GetTileCount() const { return Tiles.Num(); }
+
+	/** Returns the daily upkeep of every tile. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Path")
+	int32 GetDailyMaintenanceCost() const;
+
+	// -------------------------------------------------------------------
+	//  Preview
+	// -------------------------------------------------------------------
+
+	/**
+	 * Shows plain preview tiles of a style on grid cells, replacing any previous preview.
+	 * @param bValid  Whether the drag can be applied; drives the preview material's PlacementValid parameter.
+	 */
+	void SetPreview(TConstArrayView<FIntPoint> Cells, int32 StyleIndex, float Height, bool bValid = true);
+
+	/** Hides the preview. */
+	void ClearPreview();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FPathTile
+	{
+		/** Index in its style's instance list. */
+		int32 Instance = INDEX_NONE;
+		float Height = 0.0f;
+		uint8 Style = 0;
+
+		/** Bit per neighbor holding a path: 1 +X, 2 +Y, 4 -X, 8 -Y. */
+		uint8 NeighborMask = 0;
+	};
+
+	/** Creates the instanced mesh component of each style. */
+	void CreateStyleComponents();
+
+	/** Returns the neighbor mask of a cell from the current tiles. */
+	uint8 ComputeNeighborMask(FIntPoint Cell) const;
+
+	/** Re-shapes the tiles on the given cells whose neighbors changed. Cells without a tile are skipped. */
+	void RefreshShapes(const TSet<FIntPoint>& Cells);
+
+	/** Returns the instance transform of a tile. */
+	static FTransform GetTileTransform(FIntPoint Cell, float Height, uint8 NeighborMask);
+
+	/** One instanced mesh per style, indexed like Styles. */
+	UPROPERTY()
+	TArray<TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> StyleComponents;
+
+	/** Instanced mesh used for the drag preview. */
+	UPROPERTY()
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> PreviewComponent;
+
+	/** Instance of PreviewMaterial on the preview tiles. */
+	UPROPERTY()
+	TObjectPtr<UMaterialInstanceDynamic> PreviewMID;
+
+	/** Cell of each instance, per style, so swapped-in instances can be traced back to their tile. */
+	TArray<TArray<FIntPoint>> StyleInstanceCells;
+
+	/** Every path tile by grid cell. */
+	TMap<FIntPoint, FPathTile> Tiles;
+};
@@ -3,11 +3,21 @@
 #include "Components/BoxComponent.h"
 #include "ZooKeeper/ZooKeeper.h"
 #include "ZooKeeper/Subsystems/BuildingManagerSubsystem.h"
+#include "ZooKeeper/Subsystems/VisitorSubsystem.h"
 
 AZooBuildingActor::AZooBuildingActor()
-	: Condition(1.0f)
+	: Category(EBuildingCategory::Facility)
+	, Condition(1.0f)
+	, ConditionDecayPerDay(0.01f)
 	, PurchaseCost(0)
 	, MaintenanceCostPerDay(0.0f)
+	, GridFootprint(1, 1)
+	, bIrregularFootprint(false)
+	, bPlaceableInEnclosures(false)
+	, bIsPointOfInterest(false)
+	, VisitorServers(1)
+	, VisitorServiceRate(0.2f)
+	, VisitorQueueCapacity(8)
 	, bIsPlaced(false)
 {
 	PrimaryActorTick.bCanEverTick = false;
@@ -41,6 +51,15 @@ void AZooBuildingActor::BeginPlay()
 		{
 			UE_LOG(LogZooKeeper, Warning, TEXT("Building '%s': BuildingManagerSubsystem not found."), *BuildingName);
 		}
+
+		// Queues are pruned by the subsystem once the building is destroyed.
+		if (bIsPointOfInterest)
+		{
+			if (UVisitorSubsystem* VisitorSubsystem = World->GetSubsystem<UVisitorSubsystem>())
+			{
+				VisitorSubsystem->ConfigurePointOfInterest(this, VisitorServers, VisitorServiceRate, VisitorQueueCapacity);
+			}
+		}
 	}
 }
 
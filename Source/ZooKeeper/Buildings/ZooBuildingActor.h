@@ -4,6 +4,7 @@
 #include "GameFramework/Actor.h"
 #include "ZooKeeper/Interaction/InteractableInterface.h"
 #include "ZooKeeper/SaveLoad/ZooSaveable.h"
+#include "ZooKeeper/Data/BuildingDefinition.h"
 #include "ZooBuildingActor.generated.h"
 
 class UStaticMeshComponent;
@@ -56,10 +57,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Identity")
 	FString BuildingName;
 
+	/** The category this building belongs to. Daily upkeep is charged per category. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Identity")
+	EBuildingCategory Category;
+
 	/** Current condition of the building, 0.0 (ruined) to 1.0 (pristine). */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|State", meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float Condition;
 
+	/** Condition lost each day by the building manager's maintenance pass, before modifiers. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|State", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float ConditionDecayPerDay;
+
 	/** One-time cost to place this building. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Economy", meta = (ClampMin = "0"))
 	int32 PurchaseCost;
@@ -68,6 +77,44 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Economy", meta = (ClampMin = "0.0"))
 	float MaintenanceCostPerDay;
 
+	/** Grid footprint of this building in placement grid cells (X columns, Y rows). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Placement", meta = (ClampMin = "1"))
+	FIntPoint GridFootprint;
+
+	/**
+	 * Whether this building's shape does not fill its grid footprint, like an enclosure
+	 * that other buildings are placed inside. Such buildings are left out of the occupancy
+	 * grid and their placement is validated with a physics overlap instead.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Placement")
+	bool bIrregularFootprint;
+
+	/**
+	 * Whether this building may be placed inside an enclosure's fence, like a feeder. Other
+	 * buildings are kept off enclosures, which are not in the occupancy grid.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Placement")
+	bool bPlaceableInEnclosures;
+
+	/**
+	 * Whether visitors queue here, like a food stall, bench or attraction. Points of interest
+	 * register their queue with the VisitorSubsystem when play begins.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Visitors")
+	bool bIsPointOfInterest;
+
+	/** Number of visitors served at once. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Visitors", meta = (ClampMin = "1", EditCondition = "bIsPointOfInterest"))
+	int32 VisitorServers;
+
+	/** Visitors served per second by each server. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Visitors", meta = (ClampMin = "0.001", EditCondition = "bIsPointOfInterest"))
+	float VisitorServiceRate;
+
+	/** Maximum number of visitors waiting in line. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Building|Visitors", meta = (ClampMin = "0", EditCondition = "bIsPointOfInterest"))
+	int32 VisitorQueueCapacity;
+
 	/** Whether this building has been placed in the world (vs. being a ghost preview). */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Building|State")
 	bool bIsPlaced;
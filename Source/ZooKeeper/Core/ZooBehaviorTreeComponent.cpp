@@ -0,0 +1,24 @@
+#include "ZooBehaviorTreeComponent.h"
+
+UZooBehaviorTreeComponent::UZooBehaviorTreeComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UZooBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	SkippedTime += DeltaTime;
+	if (SkippedTime < DecisionInterval)
+	{
+		return;
+	}
+
+	const float ElapsedTime = SkippedTime;
+	SkippedTime = 0.0f;
+	Super::TickComponent(ElapsedTime, TickType, ThisTickFunction);
+}
+
+void UZooBehaviorTreeComponent::SetDecisionInterval(float Interval)
+{
+	DecisionInterval = FMath::Max(Interval, 0.0f);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "ZooBehaviorTreeComponent.generated.h"
+
+/**
+ * UZooBehaviorTreeComponent
+ *
+ * Behavior tree component whose decisions can be throttled by the
+ * UCharacterLODSubsystem. The engine component picks its own tick interval
+ * every time it ticks, so an interval set from outside does not hold.
+ * Instead this component skips ticks until its decision interval has
+ * passed, then ticks once with all the skipped time, so tasks and services
+ * that count time still see real seconds.
+ *
+ * The zoo's AI controllers create it as their brain component, and
+ * RunBehaviorTree reuses it.
+ */
+UCLASS(ClassGroup = AI, meta = (DisplayName = "Zoo Behavior Tree"))
+class ZOOKEEPER_API UZooBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	UZooBehaviorTreeComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	//~ Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+	/** Sets the minimum seconds between ticks of the tree. 0 ticks whenever the tree asks to. */
+	void SetDecisionInterval(float Interval);
+
+	/** Returns the minimum seconds between ticks of the tree. */
+	float GetDecisionInterval() const { return DecisionInterval; }
+
+private:
+	float DecisionInterval = 0.0f;
+
+	/** Seconds skipped since the tree last ticked, handed to it on the next tick. */
+	float SkippedTime = 0.0f;
+};
@@ -0,0 +1,48 @@
+#include "ZooCrowdManager.h"
+
+#include "AIController.h"
+#include "ZooKeeper.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Simulation"), STAT_ZooCrowdSimulation, STATGROUP_ZooKeeper);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Agents"), STAT_ZooCrowdAgents, STATGROUP_ZooKeeper);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Crowd Cost Per Agent (us)"), STAT_ZooCrowdCostPerAgent, STATGROUP_ZooKeeper);
+
+void UZooCrowdManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooCrowdSimulation);
+
+	const double StartTime = FPlatformTime::Seconds();
+	Super::Tick(DeltaTime);
+	const double ElapsedMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1.0e6;
+
+	const int32 AgentCount = ActiveAgents.Num();
+	if (AgentCount > 0)
+	{
+		const float CostPerAgent = static_cast<float>(ElapsedMicroseconds / AgentCount);
+		SmoothedCostPerAgent = FMath::Lerp(SmoothedCostPerAgent, CostPerAgent, CostSmoothing);
+	}
+
+	SET_DWORD_STAT(STAT_ZooCrowdAgents, AgentCount);
+	SET_FLOAT_STAT(STAT_ZooCrowdCostPerAgent, SmoothedCostPerAgent);
+}
+
+void UZooCrowdManager::ConfigureAgent(AAIController* Controller, const FZooCrowdAgentSettings& Settings, bool bObstacleOnly)
+{
+	UCrowdFollowingComponent* CrowdComponent = Controller ? Cast<UCrowdFollowingComponent>(Controller->GetPathFollowingComponent()) : nullptr;
+	if (!CrowdComponent)
+	{
+		return;
+	}
+
+	if (!Settings.bUseCrowdAvoidance)
+	{
+		CrowdComponent->SetCrowdSimulationState(ECrowdSimulationState::Disabled);
+		return;
+	}
+
+	CrowdComponent->SetCrowdSimulationState(bObstacleOnly ? ECrowdSimulationState::ObstacleOnly : ECrowdSimulationState::Enabled);
+	CrowdComponent->SetCrowdAvoidanceQuality(Settings.AvoidanceQuality);
+	CrowdComponent->SetCrowdSeparation(Settings.SeparationWeight > 0.0f);
+	CrowdComponent->SetCrowdSeparationWeight(Settings.SeparationWeight);
+	CrowdComponent->SetCrowdCollisionQueryRange(Settings.CollisionQueryRange);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Navigation/CrowdManager.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "ZooCrowdManager.generated.h"
+
+class AAIController;
+
+/**
+ * FZooCrowdAgentSettings
+ *
+ * Per-controller DetourCrowd settings, applied to the controller's
+ * UCrowdFollowingComponent when it possesses a pawn.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooCrowdAgentSettings
+{
+	GENERATED_BODY()
+
+	/** Whether the agent is simulated by DetourCrowd. When false it follows paths without local avoidance. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|AI|Crowd")
+	bool bUseCrowdAvoidance = true;
+
+	/** Avoidance sampling tier; indexes the crowd manager's AvoidanceConfig. Higher tiers cost more per agent. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|AI|Crowd")
+	TEnumAsByte<ECrowdAvoidanceQuality::Type> AvoidanceQuality = ECrowdAvoidanceQuality::Medium;
+
+	/** How strongly the agent keeps its distance from neighbours. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|AI|Crowd", meta = (ClampMin = "0.0"))
+	float SeparationWeight = 2.0f;
+
+	/** Radius (cm) in which neighbours are considered for avoidance and separation. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|AI|Crowd", meta = (ClampMin = "0.0"))
+	float CollisionQueryRange = 600.0f;
+};
+
+/**
+ * UZooCrowdManager
+ *
+ * DetourCrowd manager used by the zoo (set as the AI system's crowd manager
+ * class in DefaultEngine.ini). Behaves exactly like UCrowdManager, but
+ * reports the agent count and the simulation cost per agent to the
+ * ZooKeeper stat group ("stat ZooKeeper") so agent limits can be tuned.
+ * The agent limit itself is the MaxAgents config value.
+ */
+UCLASS(meta = (DisplayName = "Zoo Crowd Manager"))
+class ZOOKEEPER_API UZooCrowdManager : public UCrowdManager
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UCrowdManagerBase Interface
+	virtual void Tick(float DeltaTime) override;
+	//~ End UCrowdManagerBase Interface
+
+	/** Returns the number of agents registered with the crowd simulation. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|AI|Crowd")
+	int32 GetAgentCount() const { return ActiveAgents.Num(); }
+
+	/** Returns the smoothed simulation cost per agent in microseconds. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|AI|Crowd")
+	float GetCostPerAgentMicroseconds() const { return SmoothedCostPerAgent; }
+
+	/**
+	 * Applies crowd settings to a controller's path following component. Does nothing
+	 * if the controller does not use a UCrowdFollowingComponent.
+	 * @param bObstacleOnly  Register as an obstacle others avoid, without simulating the agent itself.
+	 */
+	static void ConfigureAgent(AAIController* Controller, const FZooCrowdAgentSettings& Settings, bool bObstacleOnly = false);
+
+private:
+	/** Per-agent cost in microseconds, smoothed across frames. */
+	float SmoothedCostPerAgent = 0.0f;
+
+	/** Weight of each frame's measurement in SmoothedCostPerAgent. */
+	static constexpr float CostSmoothing = 0.1f;
+};
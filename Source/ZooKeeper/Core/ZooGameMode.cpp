@@ -8,10 +8,16 @@
 #include "ZooPlayerController.h"
 
 #include "Engine/Engine.h"
+#include "Subsystems/AnimalViewingSubsystem.h"
+#include "Subsystems/CharacterLODSubsystem.h"
+#include "Subsystems/VisitorSubsystem.h"
 #include "UI/ZooHUD.h"
 #include "UObject/ConstructorHelpers.h"
 
 AZooGameMode::AZooGameMode() {
+  // Drives the per-frame simulation subsystems
+  PrimaryActorTick.bCanEverTick = true;
+
   // Set default classes
   DefaultPawnClass = AZooKeeperCharacter::StaticClass();
   PlayerControllerClass = AZooPlayerController::StaticClass();
@@ -72,6 +78,29 @@ void AZooGameMode::StartPlay() {
   }
 }
 
+void AZooGameMode::Tick(float DeltaSeconds) {
+  Super::Tick(DeltaSeconds);
+
+  UWorld *World = GetWorld();
+  if (!World) {
+    return;
+  }
+
+  if (UVisitorSubsystem *VisitorSys = World->GetSubsystem<UVisitorSubsystem>()) {
+    VisitorSys->Tick(DeltaSeconds);
+  }
+
+  if (UAnimalViewingSubsystem *ViewingSys =
+          World->GetSubsystem<UAnimalViewingSubsystem>()) {
+    ViewingSys->Tick(DeltaSeconds);
+  }
+
+  if (UCharacterLODSubsystem *LODSys =
+          World->GetSubsystem<UCharacterLODSubsystem>()) {
+    LODSys->Tick(DeltaSeconds);
+  }
+}
+
 void AZooGameMode::InitializeGameEconomy() {
   AZooGameState *ZooState = GetGameState<AZooGameState>();
   if (ZooState) {
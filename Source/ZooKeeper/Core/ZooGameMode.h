@@ -25,6 +25,7 @@ public:
   virtual void InitGame(const FString &MapName, const FString &Options,
                         FString &ErrorMessage) override;
   virtual void StartPlay() override;
+  virtual void Tick(float DeltaSeconds) override;
   //~ End AGameModeBase Interface
 
   /** The amount of funds the player starts with at the beginning of a new game.
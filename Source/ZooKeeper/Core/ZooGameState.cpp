@@ -62,6 +62,20 @@ bool AZooGameState::RemoveFunds(int32 Amount)
 	return true;
 }
 
+void AZooGameState::SetFunds(int32 NewFunds)
+{
+	if (NewFunds == CurrentFunds)
+	{
+		return;
+	}
+
+	const int32 Delta = NewFunds - CurrentFunds;
+	CurrentFunds = NewFunds;
+	OnFundsChanged.Broadcast(CurrentFunds, Delta);
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("ZooGameState::SetFunds %+d -> %d"), Delta, CurrentFunds);
+}
+
 // ---------------------------------------------------------------------------
 //  Reputation
 // ---------------------------------------------------------------------------
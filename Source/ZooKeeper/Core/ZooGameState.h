@@ -54,6 +54,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
 	bool RemoveFunds(int32 Amount);
 
+	/**
+	 * Sets the current funds, broadcasting OnFundsChanged once if they changed.
+	 * The economy subsystem uses this to mirror its balance once per transaction batch.
+	 * @param NewFunds  The new balance.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
+	void SetFunds(int32 NewFunds);
+
 	/** Returns the current funds. */
 	UFUNCTION(BlueprintPure, Category = "Zoo|Economy")
 	int32 GetCurrentFunds() const { return CurrentFunds; }
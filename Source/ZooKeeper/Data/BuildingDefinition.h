@@ -86,7 +86,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Building|Economy", meta = (ClampMin = "0"))
 	int32 MaintenanceCostPerDay;
 
-	/** Grid footprint of this building in grid cells (X columns, Y rows). */
+	/** Grid footprint of this building in grid cells (X columns, Y rows). Should match ActorClass's GridFootprint. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Building|Placement", meta = (ClampMin = "1"))
 	FIntPoint GridFootprint = FIntPoint(1, 1);
 
@@ -71,6 +71,31 @@ enum class EDangerLevel : uint8
 	Dangerous	UMETA(DisplayName = "Dangerous")
 };
 
+/** Zoo-wide values that milestone conditions can test. */
+UENUM(BlueprintType)
+enum class EMilestoneStat : uint8
+{
+	AnimalCount			UMETA(DisplayName = "Animal Count"),
+	SpeciesCount		UMETA(DisplayName = "Species Count"),
+	EnclosureCount		UMETA(DisplayName = "Enclosure Count"),
+	VisitorCount		UMETA(DisplayName = "Visitor Count"),
+	Funds				UMETA(DisplayName = "Funds"),
+	Rating				UMETA(DisplayName = "Zoo Rating"),
+	StaffCount			UMETA(DisplayName = "Staff Count"),
+	Day					UMETA(DisplayName = "Day"),
+	ResearchCompleted	UMETA(DisplayName = "Research Completed"),
+
+	Count				UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EMilestoneComparison : uint8
+{
+	AtLeast		UMETA(DisplayName = ">="),
+	AtMost		UMETA(DisplayName = "<="),
+	Equal		UMETA(DisplayName = "==")
+};
+
 // ===================================================================
 //  Data Table Row Structs
 // ===================================================================
@@ -391,6 +416,12 @@ struct ZOOKEEPER_API FVisitorTypeRow : public FTableRowBase
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors", meta = (ClampMin = "0.0"))
 	float StayDuration = 600.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Group", meta = (ClampMin = "1"))
+	int32 MinGroupSize = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Group", meta = (ClampMin = "1"))
+	int32 MaxGroupSize = 4;
 };
 
 // ===================================================================
@@ -461,3 +492,41 @@ struct ZOOKEEPER_API FBiomeConfig : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Biome|Species")
 	TArray<FName> NativeSpecies;
 };
+
+// ===================================================================
+//  FMilestoneDefinitionRow
+// ===================================================================
+
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FMilestoneCondition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones")
+	EMilestoneStat Stat = EMilestoneStat::AnimalCount;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones")
+	EMilestoneComparison Comparison = EMilestoneComparison::AtLeast;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones")
+	float Threshold = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FMilestoneDefinitionRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones|Identity")
+	FName MilestoneID;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones|Identity")
+	FText DisplayName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones|Identity", meta = (MultiLine = "true"))
+	FText Description;
+
+	/** The milestone is achieved as soon as all of these hold. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones|Conditions")
+	TArray<FMilestoneCondition> Conditions;
+};
@@ -62,8 +62,9 @@ struct ZOOKEEPER_API FZooTransaction
 /**
  * FZooDailyFinanceReport
  *
- * Aggregated financial summary for a single in-game day.
- * Contains totals and the list of individual transactions that occurred.
+ * Aggregated financial summary for a single in-game day, with totals
+ * broken down by category. Individual transactions are available through
+ * UEconomySubsystem::GetDailyTransactions.
  */
 USTRUCT(BlueprintType)
 struct ZOOKEEPER_API FZooDailyFinanceReport
@@ -86,7 +87,162 @@ struct ZOOKEEPER_API FZooDailyFinanceReport
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
 	int32 NetProfit = 0;
 
-	/** All individual transactions that occurred during this day. */
+	/** Number of transactions recorded during this day. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 NumTransactions = 0;
+
+	/** Income per category. Categories without income are omitted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	TMap<ETransactionCategory, int32> IncomeByCategory;
+
+	/** Expenses per category. Categories without expenses are omitted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	TMap<ETransactionCategory, int32> ExpensesByCategory;
+};
+
+/**
+ * FZooFinanceHistoryBucket
+ *
+ * Income and expense totals over a range of in-game days, used to chart
+ * financial history.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooFinanceHistoryBucket
+{
+	GENERATED_BODY()
+
+	/** First in-game day covered by this bucket. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 FirstDay = 0;
+
+	/** Last in-game day covered by this bucket (inclusive). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 LastDay = 0;
+
+	/** Total income over the covered days. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 TotalIncome = 0;
+
+	/** Total expenses over the covered days. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 TotalExpenses = 0;
+
+	/** Net profit over the covered days (TotalIncome - TotalExpenses). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 NetProfit = 0;
+};
+
+/**
+ * FZooTransactionBatch
+ *
+ * All transactions completed during one frame, with their aggregated
+ * effect on the balance. Economy listeners receive one batch per frame
+ * instead of one event per transaction.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooTransactionBatch
+{
+	GENERATED_BODY()
+
+	/** Total income in this batch. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 TotalIncome = 0;
+
+	/** Total expenses in this batch. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 TotalExpenses = 0;
+
+	/** Net balance change over the batch, including changes without a transaction (e.g. loading). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 NetChange = 0;
+
+	/** Balance after the batch. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	int32 NewBalance = 0;
+
+	/** Net change per category (income positive, expenses negative). Untouched categories are omitted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
+	TMap<ETransactionCategory, int32> CategoryDeltas;
+
+	/** The individual transactions, in the order they completed. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy")
 	TArray<FZooTransaction> Transactions;
 };
+
+/**
+ * FZooForecastDay
+ *
+ * Projected balance distribution at the end of one forecast day.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooForecastDay
+{
+	GENERATED_BODY()
+
+	/** The in-game day this projection is for. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 Day = 0;
+
+	/** 5th percentile of the end-of-day balance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 P5 = 0;
+
+	/** 25th percentile of the end-of-day balance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 P25 = 0;
+
+	/** Median end-of-day balance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 P50 = 0;
+
+	/** 75th percentile of the end-of-day balance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 P75 = 0;
+
+	/** 95th percentile of the end-of-day balance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 P95 = 0;
+
+	/** Fraction of projections that went bankrupt on or before this day (0-1). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	float BankruptcyProbability = 0.0f;
+};
+
+/**
+ * FZooFinanceForecast
+ *
+ * Result of a Monte Carlo finance forecast: percentile bands of the
+ * projected balance for each upcoming day and the chance of bankruptcy.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooFinanceForecast
+{
+	GENERATED_BODY()
+
+	/** In-game day the forecast was taken on. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 StartDay = 0;
+
+	/** Balance when the forecast was taken. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 StartingBalance = 0;
+
+	/** Number of projections simulated. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 NumTrials = 0;
+
+	/** Fraction of projections that went bankrupt within the forecast horizon (0-1). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	float BankruptcyProbability = 0.0f;
+
+	/** Expected daily income and expenses the projections were based on. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 ExpectedDailyIncome = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	int32 ExpectedDailyExpenses = 0;
+
+	/** One entry per forecast day, starting with the day after StartDay. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast")
+	TArray<FZooForecastDay> Days;
+};
@@ -0,0 +1,205 @@
+#include "FinanceForecast.h"
+#include "Algo/Sort.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "ZooKeeper.h"
+
+DECLARE_CYCLE_STAT(TEXT("Finance Forecast"), STAT_ZooFinanceForecast, STATGROUP_ZooKeeper);
+
+/** Standard normal sample (Box-Muller). */
+static float SampleStandardNormal(FRandomStream& Stream)
+{
+	const float U1 = FMath::Max(Stream.GetFraction(), KINDA_SMALL_NUMBER);
+	const float U2 = Stream.GetFraction();
+	return FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(UE_TWO_PI * U2);
+}
+
+/** Poisson sample: Knuth's method for small means, a normal approximation for large ones. */
+static int32 SamplePoisson(FRandomStream& Stream, float Mean)
+{
+	if (Mean <= 0.0f)
+	{
+		return 0;
+	}
+
+	if (Mean < 30.0f)
+	{
+		const float Limit = FMath::Exp(-Mean);
+		int32 Count = 0;
+		float Product = Stream.GetFraction();
+		while (Product > Limit)
+		{
+			Count++;
+			Product *= Stream.GetFraction();
+		}
+		return Count;
+	}
+
+	return FMath::Max(0, FMath::RoundToInt(Mean + FMath::Sqrt(Mean) * SampleStandardNormal(Stream)));
+}
+
+FZooFinanceForecastJob::FZooFinanceForecastJob(FZooForecastInputs&& InInputs)
+	: Inputs(MoveTemp(InInputs))
+{
+	Inputs.NumDays = FMath::Max(Inputs.NumDays, 1);
+	Inputs.NumTrials = FMath::Max(Inputs.NumTrials, 1);
+}
+
+void FZooFinanceForecastJob::Launch(TFunction<void(FZooFinanceForecast&&)> OnComplete)
+{
+	Balances.SetNumUninitialized(Inputs.NumDays * Inputs.NumTrials);
+	BankruptDays.SetNumUninitialized(Inputs.NumTrials);
+
+	TArray<UE::Tasks::FTask> Batches;
+	for (int32 FirstTrial = 0; FirstTrial < Inputs.NumTrials; FirstTrial += TrialsPerBatch)
+	{
+		const int32 NumBatchTrials = FMath::Min(TrialsPerBatch, Inputs.NumTrials - FirstTrial);
+		Batches.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job = AsShared(), FirstTrial, NumBatchTrials]()
+		{
+			Job->RunBatch(FirstTrial, NumBatchTrials);
+		}));
+	}
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job = AsShared(), OnComplete = MoveTemp(OnComplete)]() mutable
+	{
+		if (Job->IsCancelled())
+		{
+			return;
+		}
+
+		FZooFinanceForecast Forecast;
+		Job->Reduce(Forecast);
+
+		AsyncTask(ENamedThreads::GameThread, [Job, Forecast = MoveTemp(Forecast), OnComplete = MoveTemp(OnComplete)]() mutable
+		{
+			if (!Job->IsCancelled())
+			{
+				OnComplete(MoveTemp(Forecast));
+			}
+		});
+	}, UE::Tasks::Prerequisites(Batches));
+}
+
+void FZooFinanceForecastJob::RunBatch(int32 FirstTrial, int32 NumBatchTrials)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooFinanceForecast);
+
+	// Seeding per batch keeps results independent of how batches are scheduled.
+	FRandomStream Stream(static_cast<int32>(HashCombine(static_cast<uint32>(Inputs.Seed), static_cast<uint32>(FirstTrial))));
+
+	// Shifts the log-normal multiplier so its mean stays at 1.
+	const float Sigma = Inputs.ArrivalVolatility;
+	const float MeanCorrection = -0.5f * Sigma * Sigma;
+	const int64 FixedCosts = static_cast<int64>(Inputs.DailySalaries) + Inputs.DailyFoodCost;
+
+	for (int32 Trial = FirstTrial; Trial < FirstTrial + NumBatchTrials; ++Trial)
+	{
+		if (IsCancelled())
+		{
+			return;
+		}
+
+		int64 Balance = Inputs.StartingBalance;
+		int64 Loan = Inputs.LoanBalance;
+		int32 BankruptDay = INDEX_NONE;
+
+		for (int32 Day = 0; Day < Inputs.NumDays; ++Day)
+		{
+			// Income through the day: admissions from Poisson arrivals around a noisy daily rate.
+			const float ArrivalRate = Inputs.ExpectedDailyArrivals * FMath::Exp(Sigma * SampleStandardNormal(Stream) + MeanCorrection);
+			Balance += FMath::RoundToInt(SamplePoisson(Stream, ArrivalRate) * Inputs.AverageAdmission);
+
+			if (Inputs.OtherDailyNet.Num() > 0)
+			{
+				Balance += Inputs.OtherDailyNet[Stream.RandHelper(Inputs.OtherDailyNet.Num())];
+			}
+
+			// Day change, in the order of UEconomySubsystem::HandleDayChanged. The balance may go
+			// negative here; a zoo that cannot cover its running costs counts as bankrupt.
+			Balance -= FixedCosts;
+
+			if (Loan > 0)
+			{
+				const int64 Repayment = FMath::Max(Loan / 10, FMath::Min<int64>(500, Loan));
+				if (Balance >= Repayment)
+				{
+					Balance -= Repayment;
+					Loan -= Repayment;
+				}
+			}
+
+			if (BankruptDay == INDEX_NONE && Balance <= 0)
+			{
+				BankruptDay = Day;
+			}
+
+			Balances[Day * Inputs.NumTrials + Trial] = static_cast<int32>(FMath::Clamp<int64>(Balance, MIN_int32, MAX_int32));
+		}
+
+		BankruptDays[Trial] = BankruptDay;
+	}
+}
+
+void FZooFinanceForecastJob::Reduce(FZooFinanceForecast& OutForecast)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooFinanceForecast);
+
+	const int32 NumTrials = Inputs.NumTrials;
+
+	OutForecast.StartDay = Inputs.StartDay;
+	OutForecast.StartingBalance = Inputs.StartingBalance;
+	OutForecast.NumTrials = NumTrials;
+
+	int64 OtherNetSum = 0;
+	for (const int32 DayNet : Inputs.OtherDailyNet)
+	{
+		OtherNetSum += DayNet;
+	}
+	const int32 OtherNet = Inputs.OtherDailyNet.Num() > 0 ? static_cast<int32>(OtherNetSum / Inputs.OtherDailyNet.Num()) : 0;
+
+	OutForecast.ExpectedDailyIncome = FMath::RoundToInt(Inputs.ExpectedDailyArrivals * Inputs.AverageAdmission) + FMath::Max(OtherNet, 0);
+	OutForecast.ExpectedDailyExpenses = Inputs.DailySalaries + Inputs.DailyFoodCost + FMath::Max(-OtherNet, 0);
+
+	// Bankruptcies per day, accumulated into the chance of having gone bankrupt by each day.
+	TArray<int32> NewBankruptcies;
+	NewBankruptcies.SetNumZeroed(Inputs.NumDays);
+	for (const int32 BankruptDay : BankruptDays)
+	{
+		if (BankruptDay != INDEX_NONE)
+		{
+			NewBankruptcies[BankruptDay]++;
+		}
+	}
+
+	auto Percentile = [NumTrials](const TArrayView<int32>& Sorted, float Fraction)
+	{
+		return Sorted[FMath::Clamp(FMath::RoundToInt(Fraction * (NumTrials - 1)), 0, NumTrials - 1)];
+	};
+
+	int32 Bankruptcies = 0;
+	OutForecast.Days.SetNum(Inputs.NumDays);
+	for (int32 Day = 0; Day < Inputs.NumDays; ++Day)
+	{
+		if (IsCancelled())
+		{
+			return;
+		}
+
+		// Each day's balances are contiguous and only needed here, so they are sorted in place.
+		TArrayView<int32> DayBalances(Balances.GetData() + Day * NumTrials, NumTrials);
+		Algo::Sort(DayBalances);
+
+		Bankruptcies += NewBankruptcies[Day];
+
+		FZooForecastDay& ForecastDay = OutForecast.Days[Day];
+		ForecastDay.Day = Inputs.StartDay + Day + 1;
+		ForecastDay.P5 = Percentile(DayBalances, 0.05f);
+		ForecastDay.P25 = Percentile(DayBalances, 0.25f);
+		ForecastDay.P50 = Percentile(DayBalances, 0.5f);
+		ForecastDay.P75 = Percentile(DayBalances, 0.75f);
+		ForecastDay.P95 = Percentile(DayBalances, 0.95f);
+		ForecastDay.BankruptcyProbability = static_cast<float>(Bankruptcies) / NumTrials;
+	}
+
+	OutForecast.BankruptcyProbability = static_cast<float>(Bankruptcies) / NumTrials;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Economy/EconomyTypes.h"
+#include <atomic>
+
+/**
+ * FZooForecastInputs
+ *
+ * Snapshot of the economy a forecast projects from. Taken on the game
+ * thread, so the simulation never reads live game state.
+ */
+struct FZooForecastInputs
+{
+	int32 StartDay = 0;
+	int32 StartingBalance = 0;
+	int32 LoanBalance = 0;
+
+	/** Costs charged at every day change. */
+	int32 DailySalaries = 0;
+	int32 DailyFoodCost = 0;
+
+	/** Expected visitors per day under current conditions, and mean admission per visitor. */
+	float ExpectedDailyArrivals = 0.0f;
+	float AverageAdmission = 0.0f;
+
+	/** Log-normal spread of each day's arrival rate around the expected one. */
+	float ArrivalVolatility = 0.3f;
+
+	/** Net of all other recurring flows on recent days; each projected day draws one at random. */
+	TArray<int32> OtherDailyNet;
+
+	int32 NumDays = 30;
+	int32 NumTrials = 4096;
+	int32 Seed = 0;
+};
+
+/**
+ * FZooFinanceForecastJob
+ *
+ * Monte Carlo projection of the zoo's balance, run entirely on worker
+ * threads. Trials are split into batches launched as UE::Tasks, each with
+ * its own random stream; a final task that depends on every batch reduces
+ * the trials into percentile bands and posts the result to the game thread.
+ *
+ * Cancel() may be called from any thread. Batches check the flag between
+ * trials, and a cancelled job never calls back.
+ */
+class ZOOKEEPER_API FZooFinanceForecastJob : public TSharedFromThis<FZooFinanceForecastJob, ESPMode::ThreadSafe>
+{
+public:
+	explicit FZooFinanceForecastJob(FZooForecastInputs&& InInputs);
+
+	/** Starts the job. OnComplete runs on the game thread, unless the job was cancelled first. */
+	void Launch(TFunction<void(FZooFinanceForecast&&)> OnComplete);
+
+	void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+	bool IsCancelled() const { return bCancelled.load(std::memory_order_relaxed); }
+
+private:
+	/** Trials simulated by one task. */
+	static constexpr int32 TrialsPerBatch = 256;
+
+	/** Simulates NumBatchTrials trials starting at FirstTrial. */
+	void RunBatch(int32 FirstTrial, int32 NumBatchTrials);
+
+	/** Turns the simulated trials into percentile bands and bankruptcy odds. */
+	void Reduce(FZooFinanceForecast& OutForecast);
+
+	FZooForecastInputs Inputs;
+
+	/** End-of-day balance of every trial, day-major: Balances[Day * NumTrials + Trial]. */
+	TArray<int32> Balances;
+
+	/** Forecast day on which each trial first went bankrupt, or INDEX_NONE. */
+	TArray<int32> BankruptDays;
+
+	std::atomic<bool> bCancelled { false };
+};
@@ -0,0 +1,405 @@
+#include "TransactionArchive.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ZooKeeper.h"
+
+FZooTransactionArchive::FZooTransactionArchive() = default;
+
+FZooTransactionArchive::~FZooTransactionArchive()
+{
+	Close();
+}
+
+bool FZooTransactionArchive::Open(const FString& InPath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const int64 FileSize = PlatformFile.FileSize(*InPath);
+
+	if (FileSize <= 0)
+	{
+		// New archive: write the header so the file is valid even before the first flush.
+		PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InPath));
+
+		TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*InPath));
+		if (!Handle)
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Open - Cannot create '%s'."), *InPath);
+			return false;
+		}
+
+		FHeader Header;
+		Header.Magic = ArchiveMagic;
+		Header.Version = ArchiveVersion;
+		Header.RecordSize = sizeof(FZooArchivedTransaction);
+		Handle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(FHeader));
+
+		IFileManager::Get().Delete(*GetReasonsPath(InPath), false, false, true);
+		Path = InPath;
+		return true;
+	}
+
+	FHeader Header;
+	{
+		TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*InPath));
+		if (!Handle || !Handle->Read(reinterpret_cast<uint8*>(&Header), sizeof(FHeader)))
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Open - Cannot read '%s'."), *InPath);
+			return false;
+		}
+	}
+
+	if (Header.Magic != ArchiveMagic || Header.Version != ArchiveVersion || Header.RecordSize != sizeof(FZooArchivedTransaction))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Open - '%s' is not a version %u transaction archive."),
+			*InPath, ArchiveVersion);
+		return false;
+	}
+
+	Path = InPath;
+
+	// A partially written trailing record is not counted.
+	NumRecords = (FileSize - static_cast<int64>(sizeof(FHeader))) / static_cast<int64>(sizeof(FZooArchivedTransaction));
+
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *GetReasonsPath(Path));
+	for (FString& Line : Lines)
+	{
+		ReasonIds.Add(Line, Reasons.Num());
+		Reasons.Add(MoveTemp(Line));
+	}
+	NumWrittenReasons = Reasons.Num();
+
+	if (!BuildDayIndex())
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Open - Cannot map the records of '%s'."), *InPath);
+		Close();
+		return false;
+	}
+
+	// Anything past the valid records (a torn write, or records out of day order) is cut off,
+	// so the next Flush appends right after the last indexed record.
+	const int64 ValidSize = static_cast<int64>(sizeof(FHeader)) + NumRecords * static_cast<int64>(sizeof(FZooArchivedTransaction));
+	if (FileSize > ValidSize)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Open - Dropping %lld trailing bytes of '%s'."),
+			FileSize - ValidSize, *Path);
+		if (!TruncateRecords(NumRecords))
+		{
+			Close();
+			return false;
+		}
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("TransactionArchive::Open - '%s': %lld records, days %d-%d."),
+		*Path, NumRecords, GetFirstDay(), GetLastDay());
+	return true;
+}
+
+void FZooTransactionArchive::Close()
+{
+	if (IsOpen())
+	{
+		Flush();
+	}
+
+	MappedFile.Reset();
+	bMappingStale = true;
+	Path.Reset();
+	NumRecords = 0;
+	DayIndex.Reset();
+	FirstDay = 0;
+	PendingRecords.Reset();
+	Reasons.Reset();
+	ReasonIds.Reset();
+	NumWrittenReasons = 0;
+}
+
+void FZooTransactionArchive::Add(int32 Day, int32 SignedAmount, uint16 Minute, ETransactionCategory Category, const FString& Reason)
+{
+	const int32 LastDay = PendingRecords.Num() > 0 ? PendingRecords.Last().Day : GetLastDay();
+	if (LastDay != INDEX_NONE && Day < LastDay)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Add - Day %d is before the last archived day %d; skipped."),
+			Day, LastDay);
+		return;
+	}
+
+	uint32 ReasonId;
+	if (const uint32* Existing = ReasonIds.Find(Reason))
+	{
+		ReasonId = *Existing;
+	}
+	else
+	{
+		// Reasons are stored one per line.
+		FString Line = Reason.Replace(TEXT("\n"), TEXT(" ")).Replace(TEXT("\r"), TEXT(" "));
+		ReasonId = static_cast<uint32>(Reasons.Num());
+		ReasonIds.Add(Reason, ReasonId);
+		Reasons.Add(MoveTemp(Line));
+	}
+
+	FZooArchivedTransaction& Record = PendingRecords.AddDefaulted_GetRef();
+	Record.Day = Day;
+	Record.Amount = SignedAmount;
+	Record.ReasonId = ReasonId;
+	Record.Minute = Minute;
+	Record.Category = Category;
+}
+
+bool FZooTransactionArchive::Flush()
+{
+	if (!IsOpen() || (PendingRecords.Num() == 0 && NumWrittenReasons == Reasons.Num()))
+	{
+		return true;
+	}
+
+	// Reasons first, so every record on disk can be resolved.
+	if (NumWrittenReasons < Reasons.Num())
+	{
+		FString NewLines;
+		for (int32 i = NumWrittenReasons; i < Reasons.Num(); ++i)
+		{
+			NewLines += Reasons[i];
+			NewLines += LINE_TERMINATOR;
+		}
+
+		if (!FFileHelper::SaveStringToFile(NewLines, *GetReasonsPath(Path), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+			&IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Flush - Cannot write reasons for '%s'."), *Path);
+			return false;
+		}
+		NumWrittenReasons = Reasons.Num();
+	}
+
+	if (PendingRecords.Num() == 0)
+	{
+		return true;
+	}
+
+	// The mapping must not outlive the file size it was created with.
+	MappedFile.Reset();
+	bMappingStale = true;
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true));
+	if (!Handle || !Handle->Seek(sizeof(FHeader) + NumRecords * sizeof(FZooArchivedTransaction)))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Flush - Cannot append to '%s'."), *Path);
+		return false;
+	}
+
+	if (!Handle->Write(reinterpret_cast<const uint8*>(PendingRecords.GetData()),
+		static_cast<int64>(PendingRecords.Num()) * sizeof(FZooArchivedTransaction)))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::Flush - Write to '%s' failed."), *Path);
+		return false;
+	}
+
+	for (const FZooArchivedTransaction& Record : PendingRecords)
+	{
+		IndexDay(Record.Day, NumRecords);
+		NumRecords++;
+	}
+
+	PendingRecords.Reset();
+	return true;
+}
+
+bool FZooTransactionArchive::RemoveDaysFrom(int32 Day)
+{
+	if (!Flush())
+	{
+		return false;
+	}
+
+	const int32 LastDay = GetLastDay();
+	if (LastDay == INDEX_NONE || Day > LastDay)
+	{
+		return true;
+	}
+
+	const int32 KeptDays = FMath::Max(Day - FirstDay, 0);
+	if (!TruncateRecords(DayIndex[KeptDays]))
+	{
+		return false;
+	}
+
+	DayIndex.SetNum(KeptDays);
+	return true;
+}
+
+void FZooTransactionArchive::ForEachRecord(int32 QueryFirstDay, int32 QueryLastDay, TFunctionRef<void(const FZooArchivedTransaction&)> Visitor) const
+{
+	if (DayIndex.Num() == 0 || QueryLastDay < QueryFirstDay)
+	{
+		return;
+	}
+
+	const int32 FirstIndex = FMath::Max(QueryFirstDay - FirstDay, 0);
+	const int32 LastIndex = FMath::Min(QueryLastDay - FirstDay, DayIndex.Num() - 1);
+	if (FirstIndex > LastIndex)
+	{
+		return;
+	}
+
+	const int64 BeginRecord = DayIndex[FirstIndex];
+	const int64 EndRecord = DayIndex.IsValidIndex(LastIndex + 1) ? DayIndex[LastIndex + 1] : NumRecords;
+	if (BeginRecord >= EndRecord)
+	{
+		return;
+	}
+
+	IMappedFileHandle* Mapped = GetMappedFile();
+	if (!Mapped)
+	{
+		return;
+	}
+
+	for (int64 WindowBegin = BeginRecord; WindowBegin < EndRecord; WindowBegin += MappedWindowRecords)
+	{
+		const int64 WindowCount = FMath::Min(MappedWindowRecords, EndRecord - WindowBegin);
+		TUniquePtr<IMappedFileRegion> Region(Mapped->MapRegion(
+			sizeof(FHeader) + WindowBegin * sizeof(FZooArchivedTransaction),
+			WindowCount * sizeof(FZooArchivedTransaction)));
+		if (!Region)
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::ForEachRecord - Cannot map records of '%s'."), *Path);
+			return;
+		}
+
+		const FZooArchivedTransaction* Records = reinterpret_cast<const FZooArchivedTransaction*>(Region->GetMappedPtr());
+		for (int64 i = 0; i < WindowCount; ++i)
+		{
+			Visitor(Records[i]);
+		}
+	}
+}
+
+const FString& FZooTransactionArchive::GetReason(uint32 ReasonId) const
+{
+	static const FString Unknown(TEXT("Unknown"));
+	return Reasons.IsValidIndex(ReasonId) ? Reasons[ReasonId] : Unknown;
+}
+
+FString FZooTransactionArchive::GetReasonsPath(const FString& ArchivePath)
+{
+	return FPaths::ChangeExtension(ArchivePath, TEXT("reasons"));
+}
+
+bool FZooTransactionArchive::CopyArchive(const FString& FromPath, const FString& ToPath)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	DeleteArchive(ToPath);
+
+	if (FileManager.Copy(*ToPath, *FromPath) != COPY_OK)
+	{
+		return false;
+	}
+
+	const FString FromReasons = GetReasonsPath(FromPath);
+	return !FileManager.FileExists(*FromReasons) || FileManager.Copy(*GetReasonsPath(ToPath), *FromReasons) == COPY_OK;
+}
+
+void FZooTransactionArchive::DeleteArchive(const FString& ArchivePath)
+{
+	IFileManager::Get().Delete(*ArchivePath, false, false, true);
+	IFileManager::Get().Delete(*GetReasonsPath(ArchivePath), false, false, true);
+}
+
+bool FZooTransactionArchive::BuildDayIndex()
+{
+	DayIndex.Reset();
+	FirstDay = 0;
+
+	// Days are contiguous runs, so one pass over the mapped records finds each day's start.
+	const int64 TotalRecords = NumRecords;
+	NumRecords = 0;
+
+	if (TotalRecords == 0)
+	{
+		return true;
+	}
+
+	IMappedFileHandle* Mapped = GetMappedFile();
+	if (!Mapped)
+	{
+		return false;
+	}
+
+	int32 PreviousDay = INDEX_NONE;
+	for (int64 WindowBegin = 0; WindowBegin < TotalRecords; WindowBegin += MappedWindowRecords)
+	{
+		const int64 WindowCount = FMath::Min(MappedWindowRecords, TotalRecords - WindowBegin);
+		TUniquePtr<IMappedFileRegion> Region(Mapped->MapRegion(
+			sizeof(FHeader) + WindowBegin * sizeof(FZooArchivedTransaction),
+			WindowCount * sizeof(FZooArchivedTransaction)));
+		if (!Region)
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::BuildDayIndex - Cannot map records of '%s'."), *Path);
+			return false;
+		}
+
+		const FZooArchivedTransaction* Records = reinterpret_cast<const FZooArchivedTransaction*>(Region->GetMappedPtr());
+		for (int64 i = 0; i < WindowCount; ++i)
+		{
+			if (Records[i].Day < PreviousDay)
+			{
+				UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::BuildDayIndex - '%s' is out of order at record %lld; ignoring the rest."),
+					*Path, WindowBegin + i);
+				return true;
+			}
+
+			PreviousDay = Records[i].Day;
+			IndexDay(Records[i].Day, NumRecords);
+			NumRecords++;
+		}
+	}
+
+	return true;
+}
+
+bool FZooTransactionArchive::TruncateRecords(int64 KeptRecords)
+{
+	// The mapping must not outlive the file size it was created with.
+	MappedFile.Reset();
+	bMappingStale = true;
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true));
+	if (!Handle || !Handle->Truncate(sizeof(FHeader) + KeptRecords * sizeof(FZooArchivedTransaction)))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("TransactionArchive::TruncateRecords - Cannot truncate '%s'."), *Path);
+		return false;
+	}
+
+	NumRecords = KeptRecords;
+	return true;
+}
+
+void FZooTransactionArchive::IndexDay(int32 Day, int64 RecordIndex)
+{
+	if (DayIndex.Num() == 0)
+	{
+		FirstDay = Day;
+	}
+
+	// Days without records start where the next day starts.
+	while (FirstDay + DayIndex.Num() <= Day)
+	{
+		DayIndex.Add(RecordIndex);
+	}
+}
+
+IMappedFileHandle* FZooTransactionArchive::GetMappedFile() const
+{
+	if (bMappingStale)
+	{
+		MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+		bMappingStale = false;
+	}
+	return MappedFile.Get();
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Economy/EconomyTypes.h"
+
+class IMappedFileHandle;
+
+/**
+ * FZooArchivedTransaction
+ *
+ * On-disk record of one archived transaction. Fixed size, so a record's
+ * offset follows from its index.
+ */
+struct FZooArchivedTransaction
+{
+	int32 Day = 0;
+
+	/** Signed amount; negative for expenses. */
+	int32 Amount = 0;
+
+	/** Index into the archive's reason table. */
+	uint32 ReasonId = 0;
+
+	/** Minute of the day (0-1439). */
+	uint16 Minute = 0;
+
+	ETransactionCategory Category = ETransactionCategory::Miscellaneous;
+
+	uint8 Reserved = 0;
+};
+
+static_assert(sizeof(FZooArchivedTransaction) == 16, "Archived transactions are stored as 16-byte records.");
+
+/**
+ * FZooTransactionArchive
+ *
+ * Append-only binary file of transactions that have aged out of the
+ * in-memory ledger. Records are fixed-size and written in day order, and a
+ * small in-memory day index maps each day to its first record. Range
+ * queries memory-map the file through IMappedFileHandle one window at a
+ * time, so reading months of history costs a bounded amount of memory.
+ *
+ * Reasons are interned into a text sidecar next to the record file, one
+ * reason per line.
+ */
+class ZOOKEEPER_API FZooTransactionArchive
+{
+public:
+	FZooTransactionArchive();
+	~FZooTransactionArchive();
+
+	/**
+	 * Opens or creates the archive at the given path and rebuilds the day index.
+	 * @return false if an existing file is not a valid archive.
+	 */
+	bool Open(const FString& InPath);
+
+	/** Writes pending records and closes the archive. */
+	void Close();
+
+	bool IsOpen() const { return !Path.IsEmpty(); }
+
+	/** Queues a transaction; it is written on the next Flush. Days must not go backwards. */
+	void Add(int32 Day, int32 SignedAmount, uint16 Minute, ETransactionCategory Category, const FString& Reason);
+
+	/** Appends queued records and new reasons to disk. */
+	bool Flush();
+
+	/** Writes pending records, then deletes every record from Day on and shrinks the file to match. */
+	bool RemoveDaysFrom(int32 Day);
+
+	/** Calls Visitor for every archived record from FirstDay to LastDay inclusive, in order. */
+	void ForEachRecord(int32 FirstDay, int32 LastDay, TFunctionRef<void(const FZooArchivedTransaction&)> Visitor) const;
+
+	/** Returns the reason text of a record. */
+	const FString& GetReason(uint32 ReasonId) const;
+
+	/** Returns the first and last archived day, or INDEX_NONE when empty. */
+	int32 GetFirstDay() const { return DayIndex.Num() > 0 ? FirstDay : INDEX_NONE; }
+	int32 GetLastDay() const { return DayIndex.Num() > 0 ? FirstDay + DayIndex.Num() - 1 : INDEX_NONE; }
+
+	/** Returns the number of records on disk. */
+	int64 GetNumRecords() const { return NumRecords; }
+
+	/** Returns the sidecar path holding the reasons of an archive. */
+	static FString GetReasonsPath(const FString& ArchivePath);
+
+	/** Copies an archive and its reasons between paths, replacing the destination. */
+	static bool CopyArchive(const FString& FromPath, const FString& ToPath);
+
+	/** Deletes an archive and its reasons. */
+	static void DeleteArchive(const FString& ArchivePath);
+
+private:
+	/** File header, followed by the records. */
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint32 RecordSize = 0;
+		uint32 Reserved = 0;
+	};
+
+	static constexpr uint32 ArchiveMagic = 0x41465A5A; // "ZZFA"
+	static constexpr uint32 ArchiveVersion = 1;
+
+	/** Records mapped at once by range queries. */
+	static constexpr int64 MappedWindowRecords = 64 * 1024;
+
+	/**
+	 * Maps the whole file once to rebuild the day index. Stops at the first record out of
+	 * day order, leaving NumRecords at the valid prefix.
+	 * @return false if the records cannot be mapped.
+	 */
+	bool BuildDayIndex();
+
+	/** Shrinks the file to its first KeptRecords records. */
+	bool TruncateRecords(int64 KeptRecords);
+
+	/** Appends a day to the index, filling any gap with empty days. */
+	void IndexDay(int32 Day, int64 RecordIndex);
+
+	/** Opens the mapped file handle if the file changed since it was last mapped. */
+	IMappedFileHandle* GetMappedFile() const;
+
+	/** Path of the record file; empty when closed. */
+	FString Path;
+
+	/** Number of records on disk. */
+	int64 NumRecords = 0;
+
+	/** First record of each day, starting at FirstDay. */
+	TArray<int64> DayIndex;
+	int32 FirstDay = 0;
+
+	/** Records waiting to be written. */
+	TArray<FZooArchivedTransaction> PendingRecords;
+
+	/** Interned reasons; the first NumWrittenReasons are on disk. */
+	TArray<FString> Reasons;
+	TMap<FString, uint32> ReasonIds;
+	int32 NumWrittenReasons = 0;
+
+	/** Mapping of the record file, reopened after appends. */
+	mutable TUniquePtr<IMappedFileHandle> MappedFile;
+	mutable bool bMappingStale = true;
+};
@@ -0,0 +1,287 @@
+#include "TransactionLedger.h"
+#include "ZooKeeper.h"
+
+void FZooTransactionLedger::Record(int32 Amount, bool bIsExpense, ETransactionCategory Category, const FString& Reason, int32 Day, float GameTime)
+{
+	// Entries must stay in day order; a day going backwards (e.g. a loaded save) starts a fresh ledger.
+	if (DayRollups.Num() > 0 && Day < FirstRollupDay + DayRollups.Num() - 1)
+	{
+		UE_LOG(LogZooKeeper, Log, TEXT("TransactionLedger::Record - Day went back to %d, clearing the ledger."), Day);
+		Reset();
+	}
+
+	if (DayRollups.Num() == 0)
+	{
+		FirstRollupDay = Day;
+	}
+
+	while (FirstRollupDay + DayRollups.Num() <= Day)
+	{
+		DayRollups.AddDefaulted_GetRef().FirstEntry = EndEntry;
+	}
+
+	const int32 LocalIndex = static_cast<int32>((EndEntry - FirstEntry) % ChunkCapacity);
+	if (LocalIndex == 0)
+	{
+		Chunks.Add(MakeUnique<FChunk>());
+	}
+
+	FChunk& Chunk = *Chunks.Last();
+	Chunk.Amounts[LocalIndex] = bIsExpense ? -Amount : Amount;
+	Chunk.ReasonIds[LocalIndex] = InternReason(Reason);
+	Chunk.Minutes[LocalIndex] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(GameTime * 60.0f), 0, 24 * 60 - 1));
+	Chunk.Categories[LocalIndex] = Category;
+	EndEntry++;
+
+	FDayRollup& Rollup = DayRollups.Last();
+	const int32 CategoryIndex = static_cast<int32>(Category);
+	Rollup.NumEntries++;
+	if (bIsExpense)
+	{
+		Rollup.TotalExpenses += Amount;
+		Rollup.Expenses[CategoryIndex] += Amount;
+	}
+	else
+	{
+		Rollup.TotalIncome += Amount;
+		Rollup.Income[CategoryIndex] += Amount;
+	}
+}
+
+void FZooTransactionLedger::GetDayReport(int32 Day, FZooDailyFinanceReport& OutReport) const
+{
+	OutReport.Day = Day;
+
+	const FDayRollup* Rollup = FindRollup(Day);
+	if (!Rollup)
+	{
+		return;
+	}
+
+	OutReport.TotalIncome = Rollup->TotalIncome;
+	OutReport.TotalExpenses = Rollup->TotalExpenses;
+	OutReport.NetProfit = Rollup->TotalIncome - Rollup->TotalExpenses;
+	OutReport.NumTransactions = Rollup->NumEntries;
+
+	for (int32 i = 0; i < NumCategories; ++i)
+	{
+		if (Rollup->Income[i] != 0)
+		{
+			OutReport.IncomeByCategory.Add(static_cast<ETransactionCategory>(i), Rollup->Income[i]);
+		}
+		if (Rollup->Expenses[i] != 0)
+		{
+			OutReport.ExpensesByCategory.Add(static_cast<ETransactionCategory>(i), Rollup->Expenses[i]);
+		}
+	}
+}
+
+int32 FZooTransactionLedger::GetDayTransactions(int32 Day, TArray<FZooTransaction>& OutTransactions) const
+{
+	const FDayRollup* Rollup = FindRollup(Day);
+	if (!Rollup)
+	{
+		return 0;
+	}
+
+	const int64 Begin = FMath::Max(Rollup->FirstEntry, FirstEntry);
+	const int64 End = Rollup->FirstEntry + Rollup->NumEntries;
+	if (Begin >= End)
+	{
+		return 0;
+	}
+
+	OutTransactions.Reserve(OutTransactions.Num() + static_cast<int32>(End - Begin));
+	for (int64 Entry = Begin; Entry < End; ++Entry)
+	{
+		const int64 Offset = Entry - FirstEntry;
+		const FChunk& Chunk = *Chunks[static_cast<int32>(Offset / ChunkCapacity)];
+		const int32 LocalIndex = static_cast<int32>(Offset % ChunkCapacity);
+
+		FZooTransaction& Transaction = OutTransactions.AddDefaulted_GetRef();
+		Transaction.Amount = FMath::Abs(Chunk.Amounts[LocalIndex]);
+		Transaction.bIsExpense = Chunk.Amounts[LocalIndex] < 0;
+		Transaction.Reason = Reasons[Chunk.ReasonIds[LocalIndex]];
+		Transaction.GameTime = Chunk.Minutes[LocalIndex] / 60.0f;
+		Transaction.Day = Day;
+		Transaction.Category = Chunk.Categories[LocalIndex];
+	}
+
+	return static_cast<int32>(End - Begin);
+}
+
+void FZooTransactionLedger::ForEachDayEntry(int32 Day, TFunctionRef<void(int32 SignedAmount, uint16 Minute, ETransactionCategory Category, const FString& Reason)> Visitor) const
+{
+	const FDayRollup* Rollup = FindRollup(Day);
+	if (!Rollup)
+	{
+		return;
+	}
+
+	const int64 End = Rollup->FirstEntry + Rollup->NumEntries;
+	for (int64 Entry = FMath::Max(Rollup->FirstEntry, FirstEntry); Entry < End; ++Entry)
+	{
+		const int64 Offset = Entry - FirstEntry;
+		const FChunk& Chunk = *Chunks[static_cast<int32>(Offset / ChunkCapacity)];
+		const int32 LocalIndex = static_cast<int32>(Offset % ChunkCapacity);
+
+		Visitor(Chunk.Amounts[LocalIndex], Chunk.Minutes[LocalIndex], Chunk.Categories[LocalIndex], Reasons[Chunk.ReasonIds[LocalIndex]]);
+	}
+}
+
+bool FZooTransactionLedger::GetDayTotals(int32 Day, int32& OutIncome, int32& OutExpenses) const
+{
+	const FDayRollup* Rollup = FindRollup(Day);
+	if (!Rollup)
+	{
+		return false;
+	}
+
+	OutIncome = Rollup->TotalIncome;
+	OutExpenses = Rollup->TotalExpenses;
+	return true;
+}
+
+int32 FZooTransactionLedger::GetDayCategoryTotal(int32 Day, ETransactionCategory Category, bool bIsExpense) const
+{
+	const FDayRollup* Rollup = FindRollup(Day);
+	if (!Rollup)
+	{
+		return 0;
+	}
+
+	const int32 CategoryIndex = static_cast<int32>(Category);
+	return bIsExpense ? Rollup->Expenses[CategoryIndex] : Rollup->Income[CategoryIndex];
+}
+
+int64 FZooTransactionLedger::GetLifetimeCategoryTotal(ETransactionCategory Category, bool bIsExpense) const
+{
+	const int32 CategoryIndex = static_cast<int32>(Category);
+
+	int64 Total = bIsExpense ? ArchivedExpenses[CategoryIndex] : ArchivedIncome[CategoryIndex];
+	for (const FDayRollup& Rollup : DayRollups)
+	{
+		Total += bIsExpense ? Rollup.Expenses[CategoryIndex] : Rollup.Income[CategoryIndex];
+	}
+	return Total;
+}
+
+void FZooTransactionLedger::Trim(int32 CurrentDay, int32 EntryDays, int32 RollupDays)
+{
+	if (DayRollups.Num() == 0)
+	{
+		return;
+	}
+
+	// Drop whole chunks that only hold entries from before the entry window.
+	const int32 EntryCutoffDay = CurrentDay - FMath::Max(EntryDays, 1) + 1;
+	const FDayRollup* CutoffRollup = FindRollup(EntryCutoffDay);
+	const int64 CutoffEntry = CutoffRollup ? CutoffRollup->FirstEntry
+		: (EntryCutoffDay >= FirstRollupDay + DayRollups.Num() ? EndEntry : FirstEntry);
+
+	int32 ChunksToDrop = 0;
+	while (ChunksToDrop < Chunks.Num() && FirstEntry + static_cast<int64>(ChunksToDrop + 1) * ChunkCapacity <= CutoffEntry)
+	{
+		ChunksToDrop++;
+	}
+
+	if (ChunksToDrop > 0)
+	{
+		Chunks.RemoveAt(0, ChunksToDrop);
+		FirstEntry += static_cast<int64>(ChunksToDrop) * ChunkCapacity;
+
+		if (Reasons.Num() > ReasonCompactionThreshold)
+		{
+			CompactReasons();
+		}
+	}
+
+	// Fold rollups that fell out of the rollup window into the lifetime totals.
+	const int32 RollupCutoffDay = CurrentDay - FMath::Max(RollupDays, EntryDays) + 1;
+	const int32 RollupsToFold = FMath::Clamp(RollupCutoffDay - FirstRollupDay, 0, DayRollups.Num() - 1);
+	for (int32 i = 0; i < RollupsToFold; ++i)
+	{
+		for (int32 CategoryIndex = 0; CategoryIndex < NumCategories; ++CategoryIndex)
+		{
+			ArchivedIncome[CategoryIndex] += DayRollups[i].Income[CategoryIndex];
+			ArchivedExpenses[CategoryIndex] += DayRollups[i].Expenses[CategoryIndex];
+		}
+	}
+
+	if (RollupsToFold > 0)
+	{
+		DayRollups.RemoveAt(0, RollupsToFold);
+		FirstRollupDay += RollupsToFold;
+	}
+}
+
+void FZooTransactionLedger::Reset()
+{
+	Chunks.Empty();
+	FirstEntry = 0;
+	EndEntry = 0;
+	DayRollups.Empty();
+	FirstRollupDay = 0;
+	FMemory::Memzero(ArchivedIncome);
+	FMemory::Memzero(ArchivedExpenses);
+	Reasons.Empty();
+	ReasonIds.Empty();
+}
+
+SIZE_T FZooTransactionLedger::GetAllocatedSize() const
+{
+	SIZE_T Size = Chunks.GetAllocatedSize() + Chunks.Num() * sizeof(FChunk)
+		+ DayRollups.GetAllocatedSize() + Reasons.GetAllocatedSize() + ReasonIds.GetAllocatedSize();
+
+	for (const FString& Reason : Reasons)
+	{
+		Size += Reason.GetAllocatedSize() * 2; // Held by both the table and the lookup map.
+	}
+	return Size;
+}
+
+const FZooTransactionLedger::FDayRollup* FZooTransactionLedger::FindRollup(int32 Day) const
+{
+	const int32 Index = Day - FirstRollupDay;
+	return DayRollups.IsValidIndex(Index) ? &DayRollups[Index] : nullptr;
+}
+
+uint32 FZooTransactionLedger::InternReason(const FString& Reason)
+{
+	if (const uint32* Existing = ReasonIds.Find(Reason))
+	{
+		return *Existing;
+	}
+
+	const uint32 NewId = static_cast<uint32>(Reasons.Add(Reason));
+	ReasonIds.Add(Reason, NewId);
+	return NewId;
+}
+
+void FZooTransactionLedger::CompactReasons()
+{
+	TArray<uint32> Remap;
+	Remap.Init(MAX_uint32, Reasons.Num());
+
+	TArray<FString> KeptReasons;
+	ReasonIds.Reset();
+
+	for (int64 Entry = FirstEntry; Entry < EndEntry; ++Entry)
+	{
+		const int64 Offset = Entry - FirstEntry;
+		FChunk& Chunk = *Chunks[static_cast<int32>(Offset / ChunkCapacity)];
+		uint32& ReasonId = Chunk.ReasonIds[static_cast<int32>(Offset % ChunkCapacity)];
+
+		if (Remap[ReasonId] == MAX_uint32)
+		{
+			Remap[ReasonId] = static_cast<uint32>(KeptReasons.Add(MoveTemp(Reasons[ReasonId])));
+			ReasonIds.Add(KeptReasons.Last(), Remap[ReasonId]);
+		}
+		ReasonId = Remap[ReasonId];
+	}
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("TransactionLedger::CompactReasons - %d -> %d interned reasons."),
+		Reasons.Num(), KeptReasons.Num());
+
+	Reasons = MoveTemp(KeptReasons);
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Economy/EconomyTypes.h"
+
+/**
+ * FZooTransactionLedger
+ *
+ * Compact, columnar store of the zoo's transactions. Each entry keeps only
+ * a signed amount, the minute of the day, its category, and an interned
+ * reason ID, in fixed-size chunks. Entries are recorded in time order, so
+ * the entries of a day are contiguous and located through that day's
+ * rollup.
+ *
+ * Running per-day and per-category totals are updated on every record, so
+ * daily reports never scan entries. Entries older than the entry retention
+ * window are dropped a chunk at a time; day rollups older than the rollup
+ * retention window are folded into lifetime totals.
+ */
+class ZOOKEEPER_API FZooTransactionLedger
+{
+public:
+	/** Number of transaction categories. */
+	static constexpr int32 NumCategories = static_cast<int32>(ETransactionCategory::Miscellaneous) + 1;
+
+	/**
+	 * Appends a transaction.
+	 * @param Amount    Positive amount of the transaction.
+	 * @param GameTime  Hours since midnight of Day.
+	 */
+	void Record(int32 Amount, bool bIsExpense, ETransactionCategory Category, const FString& Reason, int32 Day, float GameTime);
+
+	/** Fills the totals and per-category breakdown for a day. Days without transactions report zeros. */
+	void GetDayReport(int32 Day, FZooDailyFinanceReport& OutReport) const;
+
+	/**
+	 * Appends the retained transactions of a day to OutTransactions, oldest first.
+	 * @return Number of transactions appended; fewer than the day's count once entries are trimmed.
+	 */
+	int32 GetDayTransactions(int32 Day, TArray<FZooTransaction>& OutTransactions) const;
+
+	/**
+	 * Calls Visitor for each retained transaction of a day, oldest first.
+	 * The amount is signed: negative for expenses.
+	 */
+	void ForEachDayEntry(int32 Day, TFunctionRef<void(int32 SignedAmount, uint16 Minute, ETransactionCategory Category, const FString& Reason)> Visitor) const;
+
+	/** Returns a day's income and expense totals. Returns false if the day has no rollup. */
+	bool GetDayTotals(int32 Day, int32& OutIncome, int32& OutExpenses) const;
+
+	/** Returns the earliest day with a rollup, or INDEX_NONE if nothing was recorded. */
+	int32 GetFirstRollupDay() const { return DayRollups.Num() > 0 ? FirstRollupDay : INDEX_NONE; }
+
+	/** Returns the income or expense total of a category on a day. */
+	int32 GetDayCategoryTotal(int32 Day, ETransactionCategory Category, bool bIsExpense) const;
+
+	/** Returns the income or expense total of a category over everything ever recorded. */
+	int64 GetLifetimeCategoryTotal(ETransactionCategory Category, bool bIsExpense) const;
+
+	/**
+	 * Drops entries and rollups that fell out of the retention windows.
+	 * @param CurrentDay     The current in-game day.
+	 * @param EntryDays      Days of individual transactions to keep, including the current one.
+	 * @param RollupDays     Days of daily totals to keep; older days only contribute to lifetime totals.
+	 */
+	void Trim(int32 CurrentDay, int32 EntryDays, int32 RollupDays);
+
+	/** Removes everything, including lifetime totals. */
+	void Reset();
+
+	/** Returns the number of transactions currently retained. */
+	int32 GetNumRetained() const { return static_cast<int32>(EndEntry - FirstEntry); }
+
+	/** Returns the number of transactions recorded since the last reset. */
+	int64 GetNumRecorded() const { return EndEntry; }
+
+	/** Returns the memory used by entries, rollups, and interned reasons. */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Entries per chunk. */
+	static constexpr int32 ChunkCapacity = 512;
+
+	/** Interned reasons beyond which unreferenced ones are discarded when trimming. */
+	static constexpr int32 ReasonCompactionThreshold = 1024;
+
+	/** A fixed-size block of entries in columnar layout. */
+	struct FChunk
+	{
+		/** Signed amount; negative for expenses. */
+		int32 Amounts[ChunkCapacity];
+		uint32 ReasonIds[ChunkCapacity];
+		uint16 Minutes[ChunkCapacity];
+		ETransactionCategory Categories[ChunkCapacity];
+	};
+
+	/** Running totals for one day. */
+	struct FDayRollup
+	{
+		/** Absolute index of the day's first entry. */
+		int64 FirstEntry = 0;
+		int32 NumEntries = 0;
+		int32 TotalIncome = 0;
+		int32 TotalExpenses = 0;
+		int32 Income[NumCategories] = {};
+		int32 Expenses[NumCategories] = {};
+	};
+
+	/** Returns the rollup of a day, or nullptr if it is not retained. */
+	const FDayRollup* FindRollup(int32 Day) const;
+
+	/** Returns the ID of a reason, interning it on first use. */
+	uint32 InternReason(const FString& Reason);
+
+	/** Discards interned reasons no retained entry refers to. */
+	void CompactReasons();
+
+	/** Entry chunks; Chunks[0] starts at FirstEntry. */
+	TArray<TUniquePtr<FChunk>> Chunks;
+
+	/** Absolute index of the first retained entry. Always a multiple of ChunkCapacity. */
+	int64 FirstEntry = 0;
+
+	/** Absolute index one past the last recorded entry. */
+	int64 EndEntry = 0;
+
+	/** Rollups of consecutive days starting at FirstRollupDay. */
+	TArray<FDayRollup> DayRollups;
+	int32 FirstRollupDay = 0;
+
+	/** Totals of days whose rollups were folded away. */
+	int64 ArchivedIncome[NumCategories] = {};
+	int64 ArchivedExpenses[NumCategories] = {};
+
+	/** Interned reasons, indexed by reason ID. */
+	TArray<FString> Reasons;
+	TMap<FString, uint32> ReasonIds;
+};
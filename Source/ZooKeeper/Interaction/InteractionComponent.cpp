@@ -1,6 +1,7 @@
 #include "InteractionComponent.h"
 #include "InteractableInterface.h"
 #include "ZooKeeper.h"
+#include "Subsystems/CharacterLODSubsystem.h"
 
 #include "Camera/CameraComponent.h"
 #include "Camera/PlayerCameraManager.h"
@@ -139,4 +140,10 @@ void UInteractionComponent::SetFocusedActor(AActor* NewActor)
 
 	FocusedActor = NewActor;
 	OnInteractableFocusChanged.Broadcast(NewActor);
+
+	// Whatever the player is looking at stays at full simulation detail.
+	if (UCharacterLODSubsystem* LODSubsystem = GetWorld()->GetSubsystem<UCharacterLODSubsystem>())
+	{
+		LODSubsystem->SetSelectedActor(NewActor);
+	}
 }
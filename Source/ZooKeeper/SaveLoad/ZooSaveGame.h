@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
+#include "Subsystems/ZooMetricsSubsystem.h"
 #include "ZooSaveGame.generated.h"
 
 /**
@@ -93,6 +94,52 @@ struct ZOOKEEPER_API FZooStaffSaveData
 	float Skill = 0.5f;
 };
 
+/**
+ * FZooMetricSeriesSaveData
+ *
+ * Serializable snapshot of one metric series at one resolution for save/load.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooMetricSeriesSaveData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	uint8 Metric = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	uint8 Resolution = 0;
+
+	/** Closed samples, oldest first. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	TArray<FZooMetricSample> Samples;
+
+	/** Summary of the period still in progress, and how many values it holds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	FZooMetricSample OpenSample;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	int32 OpenCount = 0;
+};
+
+/**
+ * FZooMetricsSaveData
+ *
+ * Serializable snapshot of the recorded gameplay metrics for save/load.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooMetricsSaveData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	TArray<FZooMetricSeriesSaveData> Series;
+
+	/** Last recorded value of each metric that has one. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	TMap<uint8, float> CurrentValues;
+};
+
 /**
  * UZooSaveGame
  *
@@ -163,6 +210,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
 	int32 LoanBalance;
 
+	// --- Metrics ---
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
+	FZooMetricsSaveData Metrics;
+
 	// --- Player ---
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|SaveLoad")
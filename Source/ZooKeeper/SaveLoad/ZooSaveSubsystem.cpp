@@ -7,6 +7,8 @@
 #include "Subsystems/ResearchSubsystem.h"
 #include "Subsystems/MilestoneSubsystem.h"
 #include "Subsystems/WeatherSubsystem.h"
+#include "Subsystems/ZooRatingSubsystem.h"
+#include "Subsystems/ZooMetricsSubsystem.h"
 #include "Animals/AnimalBase.h"
 #include "Animals/AnimalNeedsComponent.h"
 #include "ZooKeeper.h"
@@ -147,6 +149,12 @@ void UZooSaveSubsystem::SaveGame(FString SlotName)
 		SaveGameInstance->SavedWeatherState = static_cast<uint8>(WeatherSys->CurrentWeather);
 	}
 
+	// --- Metrics ---
+	if (UZooMetricsSubsystem* MetricsSys = World->GetSubsystem<UZooMetricsSubsystem>())
+	{
+		MetricsSys->SaveMetrics(SaveGameInstance->Metrics);
+	}
+
 	// --- Player ---
 	if (APlayerController* PC = World->GetFirstPlayerController())
 	{
@@ -161,6 +169,12 @@ void UZooSaveSubsystem::SaveGame(FString SlotName)
 	{
 		CachedSaveGame = SaveGameInstance;
 
+		// The transaction archive is too large for the save object and lives next to it.
+		if (UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>())
+		{
+			EconSys->SaveArchiveToSlot(SlotName);
+		}
+
 		UE_LOG(LogZooKeeper, Log, TEXT("ZooSaveSubsystem - Game saved to slot '%s'."), *SlotName);
 	}
 	else
@@ -208,11 +222,18 @@ bool UZooSaveSubsystem::LoadGame(FString SlotName)
 			TimeSys->CurrentSeason = ZooSave->SavedSeason;
 		}
 
+		// --- Metrics ---
+		// Restored before the other subsystems so the values they report on load land in the restored history.
+		if (UZooMetricsSubsystem* MetricsSys = World->GetSubsystem<UZooMetricsSubsystem>())
+		{
+			MetricsSys->LoadMetrics(ZooSave->Metrics);
+		}
+
 		// --- Economy ---
 		if (UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>())
 		{
-			EconSys->CurrentFunds = ZooSave->SavedFunds;
-			EconSys->OnFundsChanged.Broadcast(EconSys->CurrentFunds);
+			EconSys->LoadArchiveFromSlot(SlotName);
+			EconSys->SetBalance(ZooSave->SavedFunds);
 		}
 
 		// --- Weather ---
@@ -229,6 +250,20 @@ bool UZooSaveSubsystem::LoadGame(FString SlotName)
 				Pawn->SetActorTransform(ZooSave->PlayerTransform);
 			}
 		}
+
+		// --- Rating ---
+		// Restored state bypasses the events the rating aggregates follow.
+		if (UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+		{
+			RatingSub->RecalculateRating();
+		}
+
+		// --- Milestones ---
+		if (UMilestoneSubsystem* MilestoneSys = World->GetSubsystem<UMilestoneSubsystem>())
+		{
+			MilestoneSys->RestoreAchievedMilestones(ZooSave->AchievedMilestones);
+			MilestoneSys->CheckMilestones();
+		}
 	}
 
 	UE_LOG(LogZooKeeper, Log, TEXT("ZooSaveSubsystem - Game loaded from slot '%s': Zoo='%s', Day=%d, Time=%.2f, Funds=%d, Animals=%d, Staff=%d"),
@@ -249,6 +284,7 @@ void UZooSaveSubsystem::DeleteSave(FString SlotName)
 	if (UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex))
 	{
 		UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+		UEconomySubsystem::DeleteArchiveForSlot(SlotName);
 
 		UE_LOG(LogZooKeeper, Log, TEXT("ZooSaveSubsystem - Deleted save in slot '%s'."), *SlotName);
 	}
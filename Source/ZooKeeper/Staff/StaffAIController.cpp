@@ -6,18 +6,29 @@
 #include "Buildings/FeederActor.h"
 #include "Animals/AnimalBase.h"
 #include "Animals/AnimalNeedsComponent.h"
+#include "Navigation/CrowdFollowingComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Core/ZooBehaviorTreeComponent.h"
 #include "ZooKeeper.h"
 
-AStaffAIController::AStaffAIController()
+AStaffAIController::AStaffAIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCrowdFollowingComponent>(TEXT("PathFollowingComponent")))
 {
 	StaffBehaviorTree = nullptr;
+
+	// RunBehaviorTree reuses this, so the LOD subsystem can throttle decisions.
+	BrainComponent = CreateDefaultSubobject<UZooBehaviorTreeComponent>(TEXT("BehaviorTreeComponent"));
+
+	// Staff are few and must get through crowds; give them better avoidance than visitors.
+	CrowdSettings.AvoidanceQuality = ECrowdAvoidanceQuality::Good;
 }
 
 void AStaffAIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
 
+	UZooCrowdManager::ConfigureAgent(this, CrowdSettings);
+
 	if (StaffBehaviorTree)
 	{
 		RunBehaviorTree(StaffBehaviorTree);
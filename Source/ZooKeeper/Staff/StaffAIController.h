@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "Core/ZooCrowdManager.h"
 #include "StaffAIController.generated.h"
 
 class UBehaviorTree;
@@ -11,7 +12,8 @@ class UBehaviorTree;
  *
  * AI controller that drives staff member behavior using a behavior tree.
  * Provides utility functions for the behavior tree to locate tasks
- * within the staff member's assigned enclosure.
+ * within the staff member's assigned enclosure. Path following uses
+ * DetourCrowd so staff move smoothly through visitor crowds.
  */
 UCLASS(Blueprintable, meta = (DisplayName = "Staff AI Controller"))
 class ZOOKEEPER_API AStaffAIController : public AAIController
@@ -19,7 +21,7 @@ class ZOOKEEPER_API AStaffAIController : public AAIController
 	GENERATED_BODY()
 
 public:
-	AStaffAIController();
+	AStaffAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	//~ Begin AAIController Interface
 	virtual void OnPossess(APawn* InPawn) override;
@@ -50,4 +52,8 @@ protected:
 	/** The behavior tree asset that drives this staff member's AI logic. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Staff|AI")
 	TObjectPtr<UBehaviorTree> StaffBehaviorTree;
+
+	/** DetourCrowd avoidance settings. Disable avoidance to fall back to plain path following. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Staff|AI")
+	FZooCrowdAgentSettings CrowdSettings;
 };
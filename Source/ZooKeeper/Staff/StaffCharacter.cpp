@@ -1,5 +1,6 @@
 #include "StaffCharacter.h"
 #include "Subsystems/StaffSubsystem.h"
+#include "Subsystems/CharacterLODSubsystem.h"
 #include "Buildings/EnclosureActor.h"
 #include "Buildings/FeederActor.h"
 #include "Animals/AnimalBase.h"
@@ -32,6 +33,11 @@ void AStaffCharacter::BeginPlay()
 			UE_LOG(LogZooKeeper, Log, TEXT("StaffCharacter [%s] (%s) registered with StaffSubsystem."),
 				*StaffName, *UEnum::GetValueAsString(StaffType));
 		}
+
+		if (UCharacterLODSubsystem* LODSubsystem = World->GetSubsystem<UCharacterLODSubsystem>())
+		{
+			LODSubsystem->RegisterCharacter(this);
+		}
 	}
 }
 
@@ -47,6 +53,11 @@ void AStaffCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 			UE_LOG(LogZooKeeper, Log, TEXT("StaffCharacter [%s] (%s) unregistered from StaffSubsystem."),
 				*StaffName, *UEnum::GetValueAsString(StaffType));
 		}
+
+		if (UCharacterLODSubsystem* LODSubsystem = World->GetSubsystem<UCharacterLODSubsystem>())
+		{
+			LODSubsystem->UnregisterCharacter(this);
+		}
 	}
 
 	Super::EndPlay(EndPlayReason);
@@ -0,0 +1,346 @@
+#include "AnimalViewingSubsystem.h"
+#include "VisitorSubsystem.h"
+#include "BuildingManagerSubsystem.h"
+#include "Animals/AnimalBase.h"
+#include "Buildings/EnclosureActor.h"
+#include "Data/ZooDataTypes.h"
+#include "Visitors/VisitorCharacter.h"
+#include "Engine/World.h"
+#include "ZooKeeper.h"
+
+bool UAnimalViewingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return true;
+}
+
+void UAnimalViewingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ViewingRadius = 2000.0f;
+	EvaluationInterval = 2.0f;
+	MaxTracesPerFrame = 32;
+	MaxPendingCandidates = 1024;
+	BaseViewingSatisfaction = 0.05f;
+	SpeciesViewCooldown = 60.0f;
+	ViewingTraceChannel = ECC_Visibility;
+
+	TracesIssued = 0;
+	SuccessfulViews = 0;
+	DroppedCandidates = 0;
+
+	TraceDelegate.BindUObject(this, &UAnimalViewingSubsystem::HandleTraceCompleted);
+
+	UE_LOG(LogZooKeeper, Log, TEXT("AnimalViewingSubsystem::Initialize - Radius: %.0f, MaxTracesPerFrame: %d"),
+		ViewingRadius, MaxTracesPerFrame);
+}
+
+void UAnimalViewingSubsystem::Deinitialize()
+{
+	UE_LOG(LogZooKeeper, Log, TEXT("AnimalViewingSubsystem::Deinitialize - %d traces issued, %d successful views."),
+		TracesIssued, SuccessfulViews);
+
+	TraceDelegate.Unbind();
+	CandidateHeap.Empty();
+	InFlightTraces.Empty();
+	FreeTraceSlots.Empty();
+	LastViewTimes.Empty();
+	SpeciesPopularityCache.Empty();
+
+	Super::Deinitialize();
+}
+
+void UAnimalViewingSubsystem::Tick(float DeltaTime)
+{
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	GatherCandidates(DeltaTime);
+	IssueTraces();
+}
+
+void UAnimalViewingSubsystem::GatherCandidates(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	const UVisitorSubsystem* VisitorSys = World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+	if (!VisitorSys)
+	{
+		return;
+	}
+
+	const double Now = World->GetTimeSeconds();
+
+	// Forget destroyed visitors now and then.
+	if (Now - LastStaleViewerSweep >= StaleViewerSweepInterval)
+	{
+		LastStaleViewerSweep = Now;
+		for (auto It = LastViewTimes.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	const TArray<TObjectPtr<AVisitorCharacter>>& Visitors = VisitorSys->GetAllVisitors();
+	if (Visitors.Num() == 0)
+	{
+		EvaluationCarry = 0.0f;
+		return;
+	}
+
+	// Spread evaluations so each visitor is visited once per EvaluationInterval.
+	EvaluationCarry += Visitors.Num() * DeltaTime / EvaluationInterval;
+	const int32 NumToEvaluate = FMath::Min(FMath::FloorToInt(EvaluationCarry), Visitors.Num());
+	EvaluationCarry -= NumToEvaluate;
+
+	if (NumToEvaluate == 0)
+	{
+		return;
+	}
+
+	CacheEnclosureBounds();
+	if (EnclosureBounds.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < NumToEvaluate; ++i)
+	{
+		VisitorCursor = (VisitorCursor + 1) % Visitors.Num();
+
+		AVisitorCharacter* Visitor = Visitors[VisitorCursor];
+		if (Visitor && Visitor->IsGroupLeader())
+		{
+			GatherCandidatesForVisitor(Visitor, Now);
+		}
+	}
+}
+
+void UAnimalViewingSubsystem::CacheEnclosureBounds()
+{
+	EnclosureBounds.Reset();
+
+	const UBuildingManagerSubsystem* BuildingManager = GetWorld()->GetSubsystem<UBuildingManagerSubsystem>();
+	if (!BuildingManager)
+	{
+		return;
+	}
+
+	for (AEnclosureActor* Enclosure : BuildingManager->GetAllEnclosures())
+	{
+		if (Enclosure && Enclosure->ContainedAnimals.Num() > 0)
+		{
+			EnclosureBounds.Emplace(Enclosure, Enclosure->GetComponentsBoundingBox());
+		}
+	}
+}
+
+void UAnimalViewingSubsystem::GatherCandidatesForVisitor(AVisitorCharacter* Visitor, double Now)
+{
+	const FVector VisitorLocation = Visitor->GetActorLocation();
+	const float RadiusSq = FMath::Square(ViewingRadius);
+
+	// Only the closest animal of each species is worth a trace; one view starts the cooldown.
+	TArray<FViewingCandidate, TInlineAllocator<8>> ClosestPerSpecies;
+	TArray<FName, TInlineAllocator<8>> CandidateSpecies;
+
+	for (const TPair<TObjectPtr<AEnclosureActor>, FBox>& Entry : EnclosureBounds)
+	{
+		AEnclosureActor* Enclosure = Entry.Key;
+		if (!IsValid(Enclosure) || Entry.Value.ComputeSquaredDistanceToPoint(VisitorLocation) > RadiusSq)
+		{
+			continue;
+		}
+
+		for (AAnimalBase* Animal : Enclosure->ContainedAnimals)
+		{
+			if (!Animal)
+			{
+				continue;
+			}
+
+			const float DistanceSq = FVector::DistSquared(VisitorLocation, Animal->GetActorLocation());
+			if (DistanceSq > RadiusSq || IsSpeciesOnCooldown(Visitor, Animal->SpeciesID, Now))
+			{
+				continue;
+			}
+
+			const int32 SpeciesIndex = CandidateSpecies.Find(Animal->SpeciesID);
+			if (SpeciesIndex != INDEX_NONE)
+			{
+				if (DistanceSq < ClosestPerSpecies[SpeciesIndex].DistanceSq)
+				{
+					ClosestPerSpecies[SpeciesIndex].Animal = Animal;
+					ClosestPerSpecies[SpeciesIndex].DistanceSq = DistanceSq;
+				}
+				continue;
+			}
+
+			FViewingCandidate& Candidate = ClosestPerSpecies.AddDefaulted_GetRef();
+			Candidate.Visitor = Visitor;
+			Candidate.Animal = Animal;
+			Candidate.DistanceSq = DistanceSq;
+			Candidate.QueuedTime = Now;
+			CandidateSpecies.Add(Animal->SpeciesID);
+		}
+	}
+
+	for (const FViewingCandidate& Candidate : ClosestPerSpecies)
+	{
+		if (CandidateHeap.Num() >= MaxPendingCandidates)
+		{
+			DroppedCandidates++;
+			continue;
+		}
+
+		CandidateHeap.HeapPush(Candidate, &UAnimalViewingSubsystem::CandidateIsCloser);
+	}
+}
+
+void UAnimalViewingSubsystem::IssueTraces()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const double Now = World->GetTimeSeconds();
+
+	int32 Issued = 0;
+	while (Issued < MaxTracesPerFrame && CandidateHeap.Num() > 0)
+	{
+		FViewingCandidate Candidate;
+		CandidateHeap.HeapPop(Candidate, &UAnimalViewingSubsystem::CandidateIsCloser, EAllowShrinking::No);
+
+		AVisitorCharacter* Visitor = Candidate.Visitor.Get();
+		AAnimalBase* Animal = Candidate.Animal.Get();
+		if (!Visitor || !Animal)
+		{
+			continue;
+		}
+
+		// The visitor has likely moved on; a fresher candidate will follow.
+		if (Now - Candidate.QueuedTime > EvaluationInterval || IsSpeciesOnCooldown(Visitor, Animal->SpeciesID, Now))
+		{
+			DroppedCandidates++;
+			continue;
+		}
+
+		int32 Slot;
+		if (FreeTraceSlots.Num() > 0)
+		{
+			Slot = FreeTraceSlots.Pop(EAllowShrinking::No);
+		}
+		else
+		{
+			Slot = InFlightTraces.AddDefaulted();
+		}
+
+		FInFlightTrace& Trace = InFlightTraces[Slot];
+		Trace.Visitor = Visitor;
+		Trace.Animal = Animal;
+		Trace.Distance = FMath::Sqrt(Candidate.DistanceSq);
+		Trace.bActive = true;
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(AnimalViewing), false, Visitor);
+
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single,
+			Visitor->GetPawnViewLocation(), Animal->GetActorLocation(),
+			ViewingTraceChannel, Params, FCollisionResponseParams::DefaultResponseParam,
+			&TraceDelegate, static_cast<uint32>(Slot));
+
+		TracesIssued++;
+		Issued++;
+	}
+}
+
+void UAnimalViewingSubsystem::HandleTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const int32 Slot = static_cast<int32>(Datum.UserData);
+	if (!InFlightTraces.IsValidIndex(Slot) || !InFlightTraces[Slot].bActive)
+	{
+		return;
+	}
+
+	FInFlightTrace Trace = InFlightTraces[Slot];
+	InFlightTraces[Slot] = FInFlightTrace();
+	FreeTraceSlots.Add(Slot);
+
+	AVisitorCharacter* Visitor = Trace.Visitor.Get();
+	AAnimalBase* Animal = Trace.Animal.Get();
+	if (!Visitor || !Animal)
+	{
+		return;
+	}
+
+	// The view is clear if nothing blocks the line or the first blocker is the animal itself.
+	for (const FHitResult& Hit : Datum.OutHits)
+	{
+		if (Hit.bBlockingHit && Hit.GetActor() != Animal)
+		{
+			return;
+		}
+	}
+
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+	if (IsSpeciesOnCooldown(Visitor, Animal->SpeciesID, Now))
+	{
+		return;
+	}
+
+	// Closer views are worth more; popular species and well-kept enclosures are worth more.
+	const float DistanceFactor = 1.0f - 0.5f * FMath::Clamp(Trace.Distance / ViewingRadius, 0.0f, 1.0f);
+	const float QualityFactor = Animal->CurrentEnclosure ? 0.5f + Animal->CurrentEnclosure->GetQualityScore() : 1.0f;
+	const float Gain = BaseViewingSatisfaction * GetSpeciesPopularity(Animal) * DistanceFactor * QualityFactor;
+
+	// Satisfaction is pooled per group, so the leader's view is scaled to benefit every member equally.
+	int32 GroupSize = 1;
+	if (Visitor->GroupID != INDEX_NONE && World)
+	{
+		if (const UVisitorSubsystem* VisitorSys = World->GetSubsystem<UVisitorSubsystem>())
+		{
+			GroupSize = FMath::Max(1, VisitorSys->GetGroupSize(Visitor->GroupID));
+		}
+	}
+
+	Visitor->UpdateSatisfaction(Gain * GroupSize);
+	LastViewTimes.FindOrAdd(Visitor).Add(Animal->SpeciesID, Now);
+	SuccessfulViews++;
+
+	OnAnimalViewed.Broadcast(Visitor, Animal, Gain);
+}
+
+float UAnimalViewingSubsystem::GetSpeciesPopularity(const AAnimalBase* Animal)
+{
+	if (const float* Cached = SpeciesPopularityCache.Find(Animal->SpeciesID))
+	{
+		return *Cached;
+	}
+
+	float Popularity = 1.0f;
+	if (const FAnimalSpeciesRow* Row = Animal->GetSpeciesData())
+	{
+		Popularity = Row->VisitorAttractionScore;
+	}
+
+	SpeciesPopularityCache.Add(Animal->SpeciesID, Popularity);
+	return Popularity;
+}
+
+bool UAnimalViewingSubsystem::IsSpeciesOnCooldown(AVisitorCharacter* Visitor, FName SpeciesID, double Now) const
+{
+	const TMap<FName, double>* ViewTimes = LastViewTimes.Find(Visitor);
+	if (!ViewTimes)
+	{
+		return false;
+	}
+
+	const double* LastView = ViewTimes->Find(SpeciesID);
+	return LastView && Now - *LastView < SpeciesViewCooldown;
+}
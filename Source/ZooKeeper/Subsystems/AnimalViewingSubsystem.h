@@ -0,0 +1,180 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "AnimalViewingSubsystem.generated.h"
+
+class AAnimalBase;
+class AEnclosureActor;
+class AVisitorCharacter;
+
+/** Broadcast when a visitor gets a clear view of an animal and gains satisfaction from it. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAnimalViewed, AVisitorCharacter*, Visitor, AAnimalBase*, Animal, float, SatisfactionGain);
+
+/**
+ * UAnimalViewingSubsystem
+ *
+ * World subsystem that rewards visitors for actually seeing animals.
+ * Visitors near enclosures are re-evaluated on a fixed interval (spread
+ * across frames); each nearby visitor-animal pair becomes a line-of-sight
+ * candidate prioritized by distance. Candidates are resolved through
+ * batched AsyncLineTraceByChannel requests capped per frame, so results
+ * arrive a frame later without blocking the game thread. A clear view
+ * raises satisfaction in proportion to the species' popularity and the
+ * quality of its enclosure.
+ *
+ * Only group leaders and solo visitors are checked; a leader's view
+ * counts for the whole group since satisfaction is pooled.
+ */
+UCLASS(meta = (DisplayName = "Animal Viewing Subsystem"))
+class ZOOKEEPER_API UAnimalViewingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Gathers viewing candidates and issues this frame's line-of-sight traces.
+	 * Should be called once per frame from the game mode.
+	 * @param DeltaTime  Real-world seconds since the last frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Viewing")
+	void Tick(float DeltaTime);
+
+	// -------------------------------------------------------------------
+	//  Delegates
+	// -------------------------------------------------------------------
+
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Visitors|Viewing")
+	FOnAnimalViewed OnAnimalViewed;
+
+	// -------------------------------------------------------------------
+	//  Tuning
+	// -------------------------------------------------------------------
+
+	/** Maximum distance (cm) from a visitor to an enclosure and its animals for a viewing check. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing", meta = (ClampMin = "0.0"))
+	float ViewingRadius;
+
+	/** Seconds between viewing evaluations of the same visitor. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing", meta = (ClampMin = "0.1"))
+	float EvaluationInterval;
+
+	/** Maximum async line traces issued per frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing", meta = (ClampMin = "1"))
+	int32 MaxTracesPerFrame;
+
+	/** Maximum candidates waiting for a trace; new candidates are dropped while full. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing", meta = (ClampMin = "1"))
+	int32 MaxPendingCandidates;
+
+	/** Satisfaction (0-1 scale) gained from seeing a species with popularity 1 at point-blank range. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing", meta = (ClampMin = "0.0"))
+	float BaseViewingSatisfaction;
+
+	/** Seconds before the same visitor can gain satisfaction from the same species again. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing", meta = (ClampMin = "0.0"))
+	float SpeciesViewCooldown;
+
+	/** Collision channel used for line-of-sight traces. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Viewing")
+	TEnumAsByte<ECollisionChannel> ViewingTraceChannel;
+
+	// -------------------------------------------------------------------
+	//  Stats
+	// -------------------------------------------------------------------
+
+	/** Line-of-sight traces issued this session. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Viewing")
+	int32 TracesIssued;
+
+	/** Traces that found a clear view. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Viewing")
+	int32 SuccessfulViews;
+
+	/** Candidates dropped because the pending queue was full or they went stale. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Viewing")
+	int32 DroppedCandidates;
+
+private:
+	/** A visitor-animal pair waiting for a line-of-sight trace. */
+	struct FViewingCandidate
+	{
+		TWeakObjectPtr<AVisitorCharacter> Visitor;
+		TWeakObjectPtr<AAnimalBase> Animal;
+		float DistanceSq = 0.0f;
+		double QueuedTime = 0.0;
+	};
+
+	/** A trace in flight, indexed by the trace's UserData. */
+	struct FInFlightTrace
+	{
+		TWeakObjectPtr<AVisitorCharacter> Visitor;
+		TWeakObjectPtr<AAnimalBase> Animal;
+		float Distance = 0.0f;
+		bool bActive = false;
+	};
+
+	/** Evaluates the next slice of visitors and pushes their viewing candidates. */
+	void GatherCandidates(float DeltaTime);
+
+	/** Pushes candidates for every animal a visitor could see, skipping species on cooldown. */
+	void GatherCandidatesForVisitor(AVisitorCharacter* Visitor, double Now);
+
+	/** Caches enclosures that hold animals, with their bounds, for this frame's evaluations. */
+	void CacheEnclosureBounds();
+
+	/** Pops the closest candidates and issues async traces for them. */
+	void IssueTraces();
+
+	/** Called by the async trace system when a line-of-sight trace completes. */
+	void HandleTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** Returns the animal's species popularity (VisitorAttractionScore), cached per species. */
+	float GetSpeciesPopularity(const AAnimalBase* Animal);
+
+	/** Returns true if the visitor recently gained satisfaction from the species. */
+	bool IsSpeciesOnCooldown(AVisitorCharacter* Visitor, FName SpeciesID, double Now) const;
+
+	/** Min-heap predicate: closer candidates come first. */
+	static bool CandidateIsCloser(const FViewingCandidate& A, const FViewingCandidate& B) { return A.DistanceSq < B.DistanceSq; }
+
+	/** Delegate bound once and reused for every trace. */
+	FTraceDelegate TraceDelegate;
+
+	/** Candidates ordered as a min-heap on distance. */
+	TArray<FViewingCandidate> CandidateHeap;
+
+	/** Slots for traces in flight; the slot index travels with the trace as UserData. */
+	TArray<FInFlightTrace> InFlightTraces;
+
+	/** Free slot indices in InFlightTraces. */
+	TArray<int32> FreeTraceSlots;
+
+	/** Last time each visitor gained satisfaction from each species. */
+	TMap<TWeakObjectPtr<AVisitorCharacter>, TMap<FName, double>> LastViewTimes;
+
+	/** Occupied enclosures and their bounds, rebuilt each frame that evaluates visitors. */
+	TArray<TPair<TObjectPtr<AEnclosureActor>, FBox>> EnclosureBounds;
+
+	/** Species popularity cached from the species DataTable. */
+	TMap<FName, float> SpeciesPopularityCache;
+
+	/** Round-robin cursor into the visitor list. */
+	int32 VisitorCursor = 0;
+
+	/** Fractional visitors carried over between frames when slicing evaluations. */
+	float EvaluationCarry = 0.0f;
+
+	/** Seconds between sweeps that forget destroyed visitors. */
+	static constexpr double StaleViewerSweepInterval = 30.0;
+
+	/** World time of the last stale viewer sweep. */
+	double LastStaleViewerSweep = 0.0;
+};
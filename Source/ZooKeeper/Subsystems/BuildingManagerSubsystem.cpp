@@ -1,9 +1,47 @@
 #include "BuildingManagerSubsystem.h"
 #include "Buildings/ZooBuildingActor.h"
 #include "Buildings/EnclosureActor.h"
+#include "Buildings/EnclosureVolumeComponent.h"
+#include "Buildings/PathNetworkActor.h"
+#include "Subsystems/EconomySubsystem.h"
+#include "Subsystems/TimeSubsystem.h"
+#include "Subsystems/ZooModifierSubsystem.h"
 #include "ZooKeeper.h"
 #include "Engine/World.h"
 
+DECLARE_CYCLE_STAT(TEXT("Enclosure Lookup"), STAT_ZooEnclosureLookup, STATGROUP_ZooKeeper);
+DECLARE_CYCLE_STAT(TEXT("Building Maintenance"), STAT_ZooBuildingMaintenance, STATGROUP_ZooKeeper);
+
+/** Conditions at which a building's displayed state changes (e.g. worn, damaged, ruined). */
+static constexpr float ConditionBandThresholds[] = { 0.25f, 0.5f, 0.75f };
+
+/** Distance (cm) a footprint is shrunk by before testing it against enclosure fences. */
+static constexpr float FootprintEdgeTolerance = 1.0f;
+
+/** Decay multiplier for buildings of a category whose upkeep could not be paid. */
+static constexpr float UnpaidUpkeepDecayMultiplier = 2.0f;
+
+/** Returns true if the enclosure has a boundary polygon to test against. */
+static bool HasBoundaryPolygon(const AEnclosureActor* Enclosure)
+{
+	return Enclosure->EnclosureVolume && Enclosure->EnclosureVolume->BoundaryPoints.Num() >= 3;
+}
+
+/** Bounds an enclosure is indexed by: its boundary polygon, or its actor bounds if it has none. */
+static FBox2D GetEnclosureBounds2D(const AEnclosureActor* Enclosure)
+{
+	if (HasBoundaryPolygon(Enclosure))
+	{
+		const FBox Bounds = Enclosure->EnclosureVolume->GetBoundingBox();
+		return FBox2D(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+	}
+
+	FVector Origin;
+	FVector Extent;
+	Enclosure->GetActorBounds(false, Origin, Extent);
+	return FBox2D(FVector2D(Origin - Extent), FVector2D(Origin + Extent));
+}
+
 bool UBuildingManagerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	return true;
@@ -13,6 +51,12 @@ void UBuildingManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	TimeSubsystem = Collection.InitializeDependency<UTimeSubsystem>();
+	if (TimeSubsystem)
+	{
+		TimeSubsystem->OnDayChanged.AddDynamic(this, &UBuildingManagerSubsystem::HandleDayChanged);
+	}
+
 	UE_LOG(LogZooKeeper, Log, TEXT("BuildingManagerSubsystem::Initialize"));
 }
 
@@ -23,6 +67,13 @@ void UBuildingManagerSubsystem::Deinitialize()
 
 	AllBuildings.Empty();
 	AllEnclosures.Empty();
+	EnclosureIndex.Reset();
+	OccupiedCells.Empty();
+	BuildingCells.Empty();
+	UpkeepRecords.Empty();
+	UpkeepRecordIndex.Empty();
+	PathNetwork = nullptr;
+	TimeSubsystem = nullptr;
 
 	Super::Deinitialize();
 }
@@ -42,6 +93,13 @@ void UBuildingManagerSubsystem::RegisterBuilding(AZooBuildingActor* Building)
 	}
 
 	AllBuildings.Add(Building);
+	AddUpkeepRecord(Building);
+
+	// Buildings that start out placed, e.g. from the level, claim their cells here.
+	if (Building->bIsPlaced)
+	{
+		OccupyCells(Building);
+	}
 
 	UE_LOG(LogZooKeeper, Log, TEXT("BuildingManagerSubsystem - Building registered. Total: %d"), AllBuildings.Num());
 }
@@ -55,6 +113,13 @@ void UBuildingManagerSubsystem::UnregisterBuilding(AZooBuildingActor* Building)
 	}
 
 	const int32 Removed = AllBuildings.Remove(Building);
+	RemoveUpkeepRecord(Building);
+	if (AEnclosureActor* Enclosure = Cast<AEnclosureActor>(Building))
+	{
+		AllEnclosures.Remove(Enclosure);
+		EnclosureIndex.Remove(Enclosure);
+	}
+	ReleaseCells(Building);
 	if (Removed > 0)
 	{
 		UE_LOG(LogZooKeeper, Log, TEXT("BuildingManagerSubsystem - Building unregistered. Total: %d"), AllBuildings.Num());
@@ -80,11 +145,59 @@ void UBuildingManagerSubsystem::RegisterEnclosure(AEnclosureActor* Enclosure)
 	}
 
 	AllEnclosures.Add(Enclosure);
+	EnclosureIndex.Update(Enclosure, GetEnclosureBounds2D(Enclosure));
+
+	// Enclosures placed in the level never pass through OccupyCells, so footprints are re-checked here.
+	OccupancyVersion++;
 	OnEnclosureFormed.Broadcast(Enclosure);
 
 	UE_LOG(LogZooKeeper, Log, TEXT("BuildingManagerSubsystem - Enclosure registered. Total: %d"), AllEnclosures.Num());
 }
 
+void UBuildingManagerSubsystem::UpdateEnclosureBounds(AEnclosureActor* Enclosure)
+{
+	if (!Enclosure || !AllEnclosures.Contains(Enclosure))
+	{
+		return;
+	}
+
+	EnclosureIndex.Update(Enclosure, GetEnclosureBounds2D(Enclosure));
+
+	// Footprints checked against the old boundary are stale.
+	OccupancyVersion++;
+}
+
+// -------------------------------------------------------------------
+//  Path Network
+// -------------------------------------------------------------------
+
+void UBuildingManagerSubsystem::RegisterPathNetwork(APathNetworkActor* Network)
+{
+	if (!Network)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("BuildingManagerSubsystem::RegisterPathNetwork - Null network passed."));
+		return;
+	}
+
+	if (PathNetwork && PathNetwork != Network)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("BuildingManagerSubsystem::RegisterPathNetwork - Replacing path network '%s' with '%s'."),
+			*PathNetwork->GetName(), *Network->GetName());
+	}
+
+	PathNetwork = Network;
+	OccupancyVersion++;
+}
+
+void UBuildingManagerSubsystem::UnregisterPathNetwork(APathNetworkActor* Network)
+{
+	if (Network && PathNetwork == Network)
+	{
+		PathNetwork = nullptr;
+		OccupancyVersion++;
+	}
+}
+
 TArray<AEnclosureActor*> UBuildingManagerSubsystem::GetAllEnclosures() const
 {
 	TArray<AEnclosureActor*> Result;
@@ -98,34 +211,187 @@ TArray<AEnclosureActor*> UBuildingManagerSubsystem::GetAllEnclosures() const
 	return Result;
 }
 
+int32 UBuildingManagerSubsystem::GetEnclosureCount() const
+{
+	return AllEnclosures.Num();
+}
+
 AEnclosureActor* UBuildingManagerSubsystem::FindEnclosureAtLocation(FVector Location) const
 {
-	// Iterate through all enclosures and check if the location is within their bounds.
-	// This relies on AEnclosureActor having a bounding volume. When AEnclosureActor is
-	// fully defined, this should use its GetComponentsBoundingBox or a custom containment check.
-	for (AEnclosureActor* Enclosure : AllEnclosures)
+	SCOPE_CYCLE_COUNTER(STAT_ZooEnclosureLookup);
+
+	AEnclosureActor* Found = nullptr;
+	EnclosureIndex.ForEachAtPoint(FVector2D(Location), [&Found, &Location](AEnclosureActor* Enclosure)
 	{
-		if (!Enclosure)
+		// Without a polygon the bounds are all there is to test.
+		if (!HasBoundaryPolygon(Enclosure) || Enclosure->EnclosureVolume->IsPointInside(Location))
 		{
-			continue;
+			Found = Enclosure;
+			return false;
+		}
+		return true;
+	});
+
+	return Found;
+}
+
+TArray<AEnclosureActor*> UBuildingManagerSubsystem::FindEnclosuresInBox(FBox Box) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooEnclosureLookup);
+
+	const FBox2D Box2D(FVector2D(Box.Min), FVector2D(Box.Max));
+
+	TArray<AEnclosureActor*> Result;
+	EnclosureIndex.ForEachOverlapping(Box2D, [&Result, &Box2D](AEnclosureActor* Enclosure)
+	{
+		// Without a polygon the bounds are all there is to test.
+		if (!HasBoundaryPolygon(Enclosure) || Enclosure->EnclosureVolume->OverlapsBox(Box2D))
+		{
+			Result.Add(Enclosure);
+		}
+		return true;
+	});
+
+	return Result;
+}
+
+// -------------------------------------------------------------------
+//  Occupancy Grid
+// -------------------------------------------------------------------
+
+FIntRect UBuildingManagerSubsystem::GetFootprintCells(const FVector& Location, float Yaw, FIntPoint Footprint) const
+{
+	const int32 QuarterTurns = FMath::RoundToInt(FRotator::NormalizeAxis(Yaw) / 90.0f);
+	if (QuarterTurns % 2 != 0)
+	{
+		Swap(Footprint.X, Footprint.Y);
+	}
+	Footprint.X = FMath::Max(Footprint.X, 1);
+	Footprint.Y = FMath::Max(Footprint.Y, 1);
+
+	// The footprint's center sits on the location; even sizes lean toward positive cells.
+	const FIntPoint Min(
+		FMath::FloorToInt(Location.X / GridCellSize - (Footprint.X - 1) * 0.5f + 0.5f),
+		FMath::FloorToInt(Location.Y / GridCellSize - (Footprint.Y - 1) * 0.5f + 0.5f));
+
+	return FIntRect(Min, Min + Footprint);
+}
+
+bool UBuildingManagerSubsystem::IsFootprintFree(const FIntRect& Cells, bool bAllowEnclosures) const
+{
+	for (int32 Y = Cells.Min.Y; Y < Cells.Max.Y; ++Y)
+	{
+		for (int32 X = Cells.Min.X; X < Cells.Max.X; ++X)
+		{
+			const FIntPoint Cell(X, Y);
+			const TWeakObjectPtr<AZooBuildingActor>* Occupant = OccupiedCells.Find(Cell);
+			if ((Occupant && Occupant->IsValid()) || (PathNetwork && PathNetwork->HasTile(Cell)))
+			{
+				return false;
+			}
+		}
+	}
+
+	if (bAllowEnclosures)
+	{
+		return true;
+	}
+
+	// Shrunk a little so a fence running along the footprint's edge does not count as overlapping.
+	const FVector Min(Cells.Min.X * GridCellSize + FootprintEdgeTolerance, Cells.Min.Y * GridCellSize + FootprintEdgeTolerance, 0.0f);
+	const FVector Max(Cells.Max.X * GridCellSize - FootprintEdgeTolerance, Cells.Max.Y * GridCellSize - FootprintEdgeTolerance, 0.0f);
+	return FindEnclosuresInBox(FBox(Min, Max)).Num() == 0;
+}
+
+bool UBuildingManagerSubsystem::HasPathTileInCells(const FIntRect& Cells) const
+{
+	if (!PathNetwork)
+	{
+		return false;
+	}
+
+	for (int32 Y = Cells.Min.Y; Y < Cells.Max.Y; ++Y)
+	{
+		for (int32 X = Cells.Min.X; X < Cells.Max.X; ++X)
+		{
+			if (PathNetwork->HasTile(FIntPoint(X, Y)))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+AZooBuildingActor* UBuildingManagerSubsystem::GetBuildingAtCell(FIntPoint Cell) const
+{
+	const TWeakObjectPtr<AZooBuildingActor>* Occupant = OccupiedCells.Find(Cell);
+	return Occupant ? Occupant->Get() : nullptr;
+}
+
+void UBuildingManagerSubsystem::OccupyCells(AZooBuildingActor* Building)
+{
+	if (!Building || BuildingCells.Contains(Building))
+	{
+		return;
+	}
+
+	if (Building->bIrregularFootprint)
+	{
+		// Not in the grid, but it still changes which space is free.
+		OccupancyVersion++;
+		return;
+	}
+
+	const FIntRect Cells = GetFootprintCells(Building->GetActorLocation(), Building->GetActorRotation().Yaw, Building->GridFootprint);
+	for (int32 Y = Cells.Min.Y; Y < Cells.Max.Y; ++Y)
+	{
+		for (int32 X = Cells.Min.X; X < Cells.Max.X; ++X)
+		{
+			OccupiedCells.Add(FIntPoint(X, Y), Building);
 		}
+	}
+
+	BuildingCells.Add(Building, Cells);
+	OccupancyVersion++;
+}
 
-		// Use the actor's bounding box for a basic containment test.
-		FBox BoundingBox;
-		FVector Origin;
-		FVector Extent;
-		static_cast<AActor*>(Enclosure)->GetActorBounds(false, Origin, Extent);
-		BoundingBox = FBox(Origin - Extent, Origin + Extent);
+void UBuildingManagerSubsystem::ReleaseCells(AZooBuildingActor* Building)
+{
+	if (Building && Building->bIrregularFootprint)
+	{
+		OccupancyVersion++;
+		return;
+	}
 
-		if (BoundingBox.IsInsideOrOn(Location))
+	FIntRect Cells;
+	if (!BuildingCells.RemoveAndCopyValue(Building, Cells))
+	{
+		return;
+	}
+
+	for (int32 Y = Cells.Min.Y; Y < Cells.Max.Y; ++Y)
+	{
+		for (int32 X = Cells.Min.X; X < Cells.Max.X; ++X)
 		{
-			return Enclosure;
+			// Only release cells still held by this building.
+			const FIntPoint Cell(X, Y);
+			const TWeakObjectPtr<AZooBuildingActor>* Occupant = OccupiedCells.Find(Cell);
+			if (Occupant && (Occupant->Get() == Building || !Occupant->IsValid()))
+			{
+				OccupiedCells.Remove(Cell);
+			}
 		}
 	}
 
-	return nullptr;
+	OccupancyVersion++;
 }
 
+// -------------------------------------------------------------------
+//  Placement & Demolition
+// -------------------------------------------------------------------
+
 AZooBuildingActor* UBuildingManagerSubsystem::PlaceBuilding(TSubclassOf<AZooBuildingActor> BuildingClass, FTransform SpawnTransform)
 {
 	if (!BuildingClass)
@@ -147,11 +413,14 @@ AZooBuildingActor* UBuildingManagerSubsystem::PlaceBuilding(TSubclassOf<AZooBuil
 	AZooBuildingActor* NewBuilding = World->SpawnActor<AZooBuildingActor>(BuildingClass, SpawnTransform, SpawnParams);
 	if (NewBuilding)
 	{
+		NewBuilding->bIsPlaced = true;
+
 		if (!AllBuildings.Contains(NewBuilding))
 		{
 			RegisterBuilding(NewBuilding);
 		}
 
+		OccupyCells(NewBuilding);
 		OnBuildingPlaced.Broadcast(NewBuilding);
 
 		UE_LOG(LogZooKeeper, Log, TEXT("BuildingManagerSubsystem - Placed building of class %s."), *BuildingClass->GetName());
@@ -179,6 +448,13 @@ bool UBuildingManagerSubsystem::DemolishBuilding(AZooBuildingActor* Building)
 	}
 
 	AllBuildings.Remove(Building);
+	RemoveUpkeepRecord(Building);
+	if (AEnclosureActor* Enclosure = Cast<AEnclosureActor>(Building))
+	{
+		AllEnclosures.Remove(Enclosure);
+		EnclosureIndex.Remove(Enclosure);
+	}
+	ReleaseCells(Building);
 	OnBuildingDemolished.Broadcast(Building);
 
 	// Destroy the actor from the world
@@ -188,3 +464,180 @@ bool UBuildingManagerSubsystem::DemolishBuilding(AZooBuildingActor* Building)
 
 	return true;
 }
+
+// -------------------------------------------------------------------
+//  Maintenance
+// -------------------------------------------------------------------
+
+void UBuildingManagerSubsystem::RunDailyMaintenance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooBuildingMaintenance);
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// Total the upkeep of each category.
+	int64 CategoryCost[NumBuildingCategories] = {};
+	int32 CategoryCount[NumBuildingCategories] = {};
+	for (const FUpkeepRecord& Record : UpkeepRecords)
+	{
+		const int32 CategoryIndex = static_cast<int32>(Record.Category);
+		CategoryCost[CategoryIndex] += Record.CostPerDay;
+		CategoryCount[CategoryIndex]++;
+	}
+
+	// Path tiles are charged with the Path category but have no condition to lose.
+	if (PathNetwork)
+	{
+		const int32 PathIndex = static_cast<int32>(EBuildingCategory::Path);
+		CategoryCost[PathIndex] += PathNetwork->GetDailyMaintenanceCost();
+		CategoryCount[PathIndex] += PathNetwork->GetTileCount();
+	}
+
+	// The BuildingConditionDecay stat scales every building's decay, from a base of 1.
+	const UZooModifierSubsystem* Modifiers = World->GetSubsystem<UZooModifierSubsystem>();
+	const float GlobalDecayScale = Modifiers ? Modifiers->GetModifiedValue(EZooModifierStat::BuildingConditionDecay, 1.0f) : 1.0f;
+
+	// One transaction per category.
+	UEconomySubsystem* Economy = World->GetSubsystem<UEconomySubsystem>();
+	float CategoryDecayScale[NumBuildingCategories];
+	int64 TotalCharged = 0;
+	for (int32 CategoryIndex = 0; CategoryIndex < NumBuildingCategories; ++CategoryIndex)
+	{
+		CategoryDecayScale[CategoryIndex] = GlobalDecayScale;
+
+		const int32 Cost = static_cast<int32>(FMath::Min<int64>(CategoryCost[CategoryIndex], MAX_int32));
+		if (Cost <= 0 || !Economy)
+		{
+			continue;
+		}
+
+		const EBuildingCategory Category = static_cast<EBuildingCategory>(CategoryIndex);
+		const FString Reason = FString::Printf(TEXT("%s upkeep (%d placed)"),
+			*UEnum::GetDisplayValueAsText(Category).ToString(), CategoryCount[CategoryIndex]);
+
+		if (Economy->TrySpend(Cost, Reason, ETransactionCategory::BuildingMaintenance))
+		{
+			TotalCharged += Cost;
+		}
+		else
+		{
+			CategoryDecayScale[CategoryIndex] *= UnpaidUpkeepDecayMultiplier;
+			UE_LOG(LogZooKeeper, Warning, TEXT("BuildingManagerSubsystem::RunDailyMaintenance - Could not pay %s (%d)."), *Reason, Cost);
+		}
+	}
+
+	// Degrade every building, broadcasting only the changes that cross a display threshold.
+	int32 NumCrossings = 0;
+	int32 NumStale = 0;
+	for (const FUpkeepRecord& Record : UpkeepRecords)
+	{
+		AZooBuildingActor* Building = Record.Building.Get();
+		if (!Building)
+		{
+			NumStale++;
+			continue;
+		}
+
+		const float Decay = Record.DecayPerDay * CategoryDecayScale[static_cast<int32>(Record.Category)];
+		const float OldCondition = Building->Condition;
+		if (Decay <= 0.0f || OldCondition <= 0.0f)
+		{
+			continue;
+		}
+
+		Building->Condition = FMath::Max(OldCondition - Decay, 0.0f);
+		if (GetConditionBand(OldCondition) != GetConditionBand(Building->Condition))
+		{
+			Building->OnConditionChanged.Broadcast(Building, Building->Condition);
+			NumCrossings++;
+		}
+		else if (AEnclosureActor* Enclosure = Cast<AEnclosureActor>(Building))
+		{
+			// Enclosure quality includes condition; the refresh it queues updates the zoo rating.
+			Enclosure->MarkQualityDirty();
+		}
+	}
+
+	// Drop records of buildings destroyed without being unregistered.
+	if (NumStale > 0)
+	{
+		for (int32 Index = UpkeepRecords.Num() - 1; Index >= 0; --Index)
+		{
+			if (!UpkeepRecords[Index].Building.IsValid())
+			{
+				RemoveUpkeepRecordAt(Index);
+			}
+		}
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("BuildingManagerSubsystem::RunDailyMaintenance - %d buildings, upkeep charged: %lld, %d condition changes."),
+		UpkeepRecords.Num(), TotalCharged, NumCrossings);
+}
+
+int32 UBuildingManagerSubsystem::GetDailyMaintenanceCost() const
+{
+	int64 Total = 0;
+	for (const FUpkeepRecord& Record : UpkeepRecords)
+	{
+		Total += Record.CostPerDay;
+	}
+	if (PathNetwork)
+	{
+		Total += PathNetwork->GetDailyMaintenanceCost();
+	}
+	return static_cast<int32>(FMath::Min<int64>(Total, MAX_int32));
+}
+
+int32 UBuildingManagerSubsystem::GetConditionBand(float Condition)
+{
+	int32 Band = 0;
+	for (const float Threshold : ConditionBandThresholds)
+	{
+		Band += Condition >= Threshold ? 1 : 0;
+	}
+	return Band;
+}
+
+void UBuildingManagerSubsystem::AddUpkeepRecord(AZooBuildingActor* Building)
+{
+	if (UpkeepRecordIndex.Contains(Building))
+	{
+		return;
+	}
+
+	FUpkeepRecord& Record = UpkeepRecords.AddDefaulted_GetRef();
+	Record.Building = Building;
+	Record.CostPerDay = Building->GetMaintenanceCost();
+	Record.DecayPerDay = Building->ConditionDecayPerDay;
+	Record.Category = Building->Category;
+
+	UpkeepRecordIndex.Add(Building, UpkeepRecords.Num() - 1);
+}
+
+void UBuildingManagerSubsystem::RemoveUpkeepRecord(AZooBuildingActor* Building)
+{
+	if (const int32* Index = UpkeepRecordIndex.Find(Building))
+	{
+		RemoveUpkeepRecordAt(*Index);
+	}
+}
+
+void UBuildingManagerSubsystem::RemoveUpkeepRecordAt(int32 Index)
+{
+	UpkeepRecordIndex.Remove(UpkeepRecords[Index].Building);
+	UpkeepRecords.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (UpkeepRecords.IsValidIndex(Index))
+	{
+		UpkeepRecordIndex.Add(UpkeepRecords[Index].Building, Index);
+	}
+}
+
+void UBuildingManagerSubsystem::HandleDayChanged(int32 NewDay)
+{
+	RunDailyMaintenance();
+}
@@ -2,10 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Buildings/EnclosureSpatialIndex.h"
+#include "Data/BuildingDefinition.h"
 #include "BuildingManagerSubsystem.generated.h"
 
 class AZooBuildingActor;
 class AEnclosureActor;
+class APathNetworkActor;
+class UTimeSubsystem;
 
 /** Broadcast when a building is placed in the zoo. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBuildingPlaced, AZooBuildingActor*, Building);
@@ -21,6 +25,28 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnclosureFormed, AEnclosureActor*
  *
  * World subsystem that tracks all buildings and enclosures placed in the zoo.
  * Provides placement, demolition, and spatial lookup utilities.
+ *
+ * Placed buildings are also recorded in an occupancy grid of GridCellSize
+ * cells, keyed by cell coordinate. A building claims the cells of its
+ * GridFootprint when it is placed and releases them when it is demolished,
+ * so placement validation is a lookup per footprint cell with no physics
+ * queries. Buildings with an irregular footprint, such as enclosures that
+ * other buildings go inside, are not recorded in the grid.
+ *
+ * Enclosures are indexed by the 2D bounds of their boundary polygon in a
+ * dynamic AABB tree, kept current as enclosures form, change shape and are
+ * demolished. Location lookups narrow to the few enclosures whose bounds
+ * contain the point before running the exact polygon test.
+ *
+ * Once a day the manager runs a maintenance pass over a compact upkeep
+ * record per building. Upkeep is charged as one transaction per building
+ * category, and every building loses condition. OnConditionChanged is
+ * only broadcast when a building's condition crosses a display threshold,
+ * so thousands of path tiles and fences cost one tight loop a day.
+ *
+ * Path tiles are not buildings; they live in the level's APathNetworkActor,
+ * which registers here. Path cells block building footprints, and the
+ * network's upkeep is charged with the Path category.
  */
 UCLASS(meta = (DisplayName = "Building Manager Subsystem"))
 class ZOOKEEPER_API UBuildingManagerSubsystem : public UWorldSubsystem
@@ -54,6 +80,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Buildings")
 	void RegisterEnclosure(AEnclosureActor* Enclosure);
 
+	/** Re-indexes a registered enclosure after its boundary changed. */
+	void UpdateEnclosureBounds(AEnclosureActor* Enclosure);
+
+	// -------------------------------------------------------------------
+	//  Path Network
+	// -------------------------------------------------------------------
+
+	/** Registers the zoo's path network. Only one network is tracked. */
+	void RegisterPathNetwork(APathNetworkActor* Network);
+
+	/** Unregisters the path network if it is the registered one. */
+	void UnregisterPathNetwork(APathNetworkActor* Network);
+
+	/** Called by the path network when tiles are added or removed, so cached footprint checks are redone. */
+	void NotifyPathTilesChanged() { OccupancyVersion++; }
+
+	/** Returns the registered path network, or nullptr. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings")
+	APathNetworkActor* GetPathNetwork() const { return PathNetwork; }
+
 	// -------------------------------------------------------------------
 	//  Queries
 	// -------------------------------------------------------------------
@@ -62,14 +108,61 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings")
 	TArray<AEnclosureActor*> GetAllEnclosures() const;
 
+	/** Returns the number of registered enclosures. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings")
+	int32 GetEnclosureCount() const;
+
 	/**
-	 * Finds the enclosure whose bounds contain the given world location.
+	 * Finds the enclosure whose boundary polygon contains the given world location (2D, ignores Z).
+	 * Enclosures without a boundary polygon are matched by their actor bounds.
 	 * @param Location  The world-space position to query.
 	 * @return The enclosure at that location, or nullptr if none.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings")
 	AEnclosureActor* FindEnclosureAtLocation(FVector Location) const;
 
+	/**
+	 * Finds the enclosures whose boundary polygon overlaps a world-space box (2D, ignores Z).
+	 * Enclosures without a boundary polygon are matched by their actor bounds.
+	 * @param Box  The box to query.
+	 * @return The overlapping enclosures, in no particular order.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings")
+	TArray<AEnclosureActor*> FindEnclosuresInBox(FBox Box) const;
+
+	// -------------------------------------------------------------------
+	//  Occupancy Grid
+	// -------------------------------------------------------------------
+
+	/**
+	 * Returns the cells a footprint covers when centered at a location.
+	 * Yaw is rounded to the nearest quarter turn; 90 and 270 degrees swap the footprint's axes.
+	 * @return Half-open rectangle of cell coordinates (Max is exclusive).
+	 */
+	FIntRect GetFootprintCells(const FVector& Location, float Yaw, FIntPoint Footprint) const;
+
+	/**
+	 * Returns true if no placed building or path tile occupies any cell of the rectangle.
+	 * Enclosures are not in the grid, so their boundary polygons are tested as well.
+	 * @param bAllowEnclosures  Whether the footprint may overlap enclosures, for buildings such as feeders.
+	 */
+	bool IsFootprintFree(const FIntRect& Cells, bool bAllowEnclosures = false) const;
+
+	/** Returns true if any cell of the rectangle has a path tile. */
+	bool HasPathTileInCells(const FIntRect& Cells) const;
+
+	/** Returns the building occupying a cell, or nullptr. */
+	AZooBuildingActor* GetBuildingAtCell(FIntPoint Cell) const;
+
+	/**
+	 * Returns a counter that changes whenever the occupancy grid or the path tiles change,
+	 * an irregular building comes or goes, or an enclosure's boundary changes.
+	 */
+	uint32 GetOccupancyVersion() const { return OccupancyVersion; }
+
+	/** World size of one occupancy grid cell. Should match the placement grid size. */
+	static constexpr float GridCellSize = 100.0f;
+
 	// -------------------------------------------------------------------
 	//  Placement & Demolition
 	// -------------------------------------------------------------------
@@ -91,6 +184,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Buildings")
 	bool DemolishBuilding(AZooBuildingActor* Building);
 
+	// -------------------------------------------------------------------
+	//  Maintenance
+	// -------------------------------------------------------------------
+
+	/**
+	 * Charges a day of upkeep per building category and degrades every building.
+	 * Categories the zoo cannot pay for degrade faster that day. Called automatically
+	 * when the day changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Buildings|Maintenance")
+	void RunDailyMaintenance();
+
+	/** Returns the total daily upkeep of all registered buildings and paths. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings|Maintenance")
+	int32 GetDailyMaintenanceCost() const;
+
+	/**
+	 * Returns the display band of a condition value: 0 below the first threshold up to 3 at or
+	 * above the last. The maintenance pass only broadcasts changes that move a building between bands.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Buildings|Maintenance")
+	static int32 GetConditionBand(float Condition);
+
 	// -------------------------------------------------------------------
 	//  Delegates
 	// -------------------------------------------------------------------
@@ -112,4 +228,54 @@ private:
 	/** All enclosures currently in the zoo. */
 	UPROPERTY()
 	TArray<TObjectPtr<AEnclosureActor>> AllEnclosures;
+
+	/** The zoo's path tiles. */
+	UPROPERTY()
+	TObjectPtr<APathNetworkActor> PathNetwork;
+
+	static constexpr int32 NumBuildingCategories = static_cast<int32>(EBuildingCategory::WaterStation) + 1;
+
+	/** What the maintenance pass needs of one building, copied at registration. */
+	struct FUpkeepRecord
+	{
+		TWeakObjectPtr<AZooBuildingActor> Building;
+		int32 CostPerDay = 0;
+		float DecayPerDay = 0.0f;
+		EBuildingCategory Category = EBuildingCategory::Facility;
+	};
+
+	void AddUpkeepRecord(AZooBuildingActor* Building);
+	void RemoveUpkeepRecord(AZooBuildingActor* Building);
+
+	/** Removes a record by swapping the last one into its place. */
+	void RemoveUpkeepRecordAt(int32 Index);
+
+	UFUNCTION()
+	void HandleDayChanged(int32 NewDay);
+
+	UPROPERTY()
+	TObjectPtr<UTimeSubsystem> TimeSubsystem;
+
+	/** Upkeep records of every registered building, in no particular order. */
+	TArray<FUpkeepRecord> UpkeepRecords;
+
+	/** Index of each building's record in UpkeepRecords. */
+	TMap<TWeakObjectPtr<AZooBuildingActor>, int32> UpkeepRecordIndex;
+
+	/** Spatial index over the enclosures' polygon bounds. */
+	FZooEnclosureSpatialIndex EnclosureIndex;
+
+	/** Claims the footprint cells of a placed building. */
+	void OccupyCells(AZooBuildingActor* Building);
+
+	/** Releases the cells claimed by a building. */
+	void ReleaseCells(AZooBuildingActor* Building);
+
+	/** Building occupying each claimed cell. */
+	TMap<FIntPoint, TWeakObjectPtr<AZooBuildingActor>> OccupiedCells;
+
+	/** Cells claimed by each building in the grid. */
+	TMap<TWeakObjectPtr<AZooBuildingActor>, FIntRect> BuildingCells;
+
+	uint32 OccupancyVersion = 0;
 };
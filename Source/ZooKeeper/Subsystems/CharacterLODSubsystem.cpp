@@ -0,0 +1,420 @@
+#include "CharacterLODSubsystem.h"
+#include "Visitors/VisitorCharacter.h"
+#include "AIController.h"
+#include "Core/ZooBehaviorTreeComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "ZooKeeper.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character LOD"), STAT_ZooCharacterLOD, STATGROUP_ZooKeeper);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Full"), STAT_ZooLODFull, STATGROUP_ZooKeeper);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Reduced"), STAT_ZooLODReduced, STATGROUP_ZooKeeper);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Minimal"), STAT_ZooLODMinimal, STATGROUP_ZooKeeper);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Dormant"), STAT_ZooLODDormant, STATGROUP_ZooKeeper);
+
+bool UCharacterLODSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return true;
+}
+
+void UCharacterLODSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bEnableLOD = true;
+	FullDistance = 3000.0f;
+	ReducedDistance = 7000.0f;
+	MinimalDistance = 15000.0f;
+	OffscreenDistanceScale = 3.0f;
+	TierHysteresis = 0.1f;
+	EvaluationInterval = 0.5f;
+	DormantStepInterval = 0.1f;
+
+	TierSettings.Add(ECharacterLODTier::Full, FZooCharacterLODSettings());
+
+	FZooCharacterLODSettings& Reduced = TierSettings.Add(ECharacterLODTier::Reduced);
+	Reduced.MovementTickInterval = 0.033f;
+	Reduced.AITickInterval = 0.1f;
+	Reduced.AnimationTickInterval = 0.033f;
+	Reduced.bMeshCollision = false;
+
+	FZooCharacterLODSettings& Minimal = TierSettings.Add(ECharacterLODTier::Minimal);
+	Minimal.MovementTickInterval = 0.1f;
+	Minimal.AITickInterval = 0.25f;
+	Minimal.AnimationTickInterval = 0.1f;
+	Minimal.bPawnCollision = false;
+	Minimal.bMeshCollision = false;
+
+	FZooCharacterLODSettings& Dormant = TierSettings.Add(ECharacterLODTier::Dormant);
+	Dormant.AITickInterval = 0.5f;
+	Dormant.AnimationTickInterval = 0.5f;
+	Dormant.bPawnCollision = false;
+	Dormant.bMeshCollision = false;
+
+	UE_LOG(LogZooKeeper, Log, TEXT("CharacterLODSubsystem::Initialize - Tier distances: %.0f / %.0f / %.0f"),
+		FullDistance, ReducedDistance, MinimalDistance);
+}
+
+void UCharacterLODSubsystem::Deinitialize()
+{
+	UE_LOG(LogZooKeeper, Log, TEXT("CharacterLODSubsystem::Deinitialize - %d characters registered."), Entries.Num());
+
+	Entries.Empty();
+	EntryIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCharacterLODSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooCharacterLOD);
+
+	if (DeltaTime <= 0.0f || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	if (!bEnableLOD)
+	{
+		if (TierCounts[static_cast<int32>(ECharacterLODTier::Full)] != Entries.Num())
+		{
+			for (FCharacterLODEntry& Entry : Entries)
+			{
+				ApplyTier(Entry, ECharacterLODTier::Full);
+			}
+		}
+		return;
+	}
+
+	FVector CameraLocation;
+	if (GetCameraLocation(CameraLocation))
+	{
+		// Spread evaluations so each character is visited once per EvaluationInterval.
+		EvaluationCarry += Entries.Num() * DeltaTime / EvaluationInterval;
+		const int32 NumToEvaluate = FMath::Min(FMath::FloorToInt(EvaluationCarry), Entries.Num());
+		EvaluationCarry -= NumToEvaluate;
+
+		for (int32 i = 0; i < NumToEvaluate; ++i)
+		{
+			EvaluationCursor = (EvaluationCursor + 1) % Entries.Num();
+
+			FCharacterLODEntry& Entry = Entries[EvaluationCursor];
+			if (const ACharacter* Character = Entry.Character.Get())
+			{
+				const ECharacterLODTier NewTier = ComputeTier(Character, Entry.Tier, CameraLocation);
+				if (NewTier != Entry.Tier)
+				{
+					ApplyTier(Entry, NewTier);
+				}
+			}
+		}
+	}
+
+	DormantStepAccumulator += DeltaTime;
+	if (DormantStepAccumulator >= DormantStepInterval)
+	{
+		if (TierCounts[static_cast<int32>(ECharacterLODTier::Dormant)] > 0)
+		{
+			for (FCharacterLODEntry& Entry : Entries)
+			{
+				if (Entry.Tier == ECharacterLODTier::Dormant)
+				{
+					StepDormant(Entry, DormantStepAccumulator);
+				}
+			}
+		}
+		DormantStepAccumulator = 0.0f;
+	}
+
+	SET_DWORD_STAT(STAT_ZooLODFull, TierCounts[static_cast<int32>(ECharacterLODTier::Full)]);
+	SET_DWORD_STAT(STAT_ZooLODReduced, TierCounts[static_cast<int32>(ECharacterLODTier::Reduced)]);
+	SET_DWORD_STAT(STAT_ZooLODMinimal, TierCounts[static_cast<int32>(ECharacterLODTier::Minimal)]);
+	SET_DWORD_STAT(STAT_ZooLODDormant, TierCounts[static_cast<int32>(ECharacterLODTier::Dormant)]);
+}
+
+// -------------------------------------------------------------------
+//  Registration
+// -------------------------------------------------------------------
+
+void UCharacterLODSubsystem::RegisterCharacter(ACharacter* Character)
+{
+	if (!Character)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("CharacterLODSubsystem::RegisterCharacter - Null character passed."));
+		return;
+	}
+
+	if (EntryIndices.Contains(Character))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("CharacterLODSubsystem::RegisterCharacter - Character already registered."));
+		return;
+	}
+
+	FCharacterLODEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = Character;
+	Entry.Tier = ECharacterLODTier::Full;
+
+	if (const UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+	{
+		Entry.PawnResponse = Capsule->GetCollisionResponseToChannel(ECC_Pawn);
+	}
+	if (const USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Entry.MeshCollision = Mesh->GetCollisionEnabled();
+		Entry.AnimTickOption = Mesh->VisibilityBasedAnimTickOption;
+	}
+
+	EntryIndices.Add(Character, Entries.Num() - 1);
+	TierCounts[static_cast<int32>(ECharacterLODTier::Full)]++;
+}
+
+void UCharacterLODSubsystem::UnregisterCharacter(ACharacter* Character)
+{
+	int32 Index = INDEX_NONE;
+	if (!Character || !EntryIndices.RemoveAndCopyValue(Character, Index))
+	{
+		return;
+	}
+
+	// Leave the character as we found it; it may be reused or inspected after EndPlay.
+	ApplyTier(Entries[Index], ECharacterLODTier::Full);
+	TierCounts[static_cast<int32>(ECharacterLODTier::Full)]--;
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Entries.IsValidIndex(Index))
+	{
+		EntryIndices.Add(Entries[Index].Character, Index);
+	}
+}
+
+// -------------------------------------------------------------------
+//  Queries
+// -------------------------------------------------------------------
+
+void UCharacterLODSubsystem::SetSelectedActor(AActor* Actor)
+{
+	SelectedActor = Actor;
+
+	// Bring the selection to full detail right away instead of waiting for its evaluation slot.
+	if (const int32* Index = EntryIndices.Find(Cast<ACharacter>(Actor)))
+	{
+		ApplyTier(Entries[*Index], ECharacterLODTier::Full);
+	}
+}
+
+ECharacterLODTier UCharacterLODSubsystem::GetCharacterTier(ACharacter* Character) const
+{
+	const int32* Index = EntryIndices.Find(Character);
+	return Index ? Entries[*Index].Tier : ECharacterLODTier::Full;
+}
+
+int32 UCharacterLODSubsystem::GetTierCount(ECharacterLODTier Tier) const
+{
+	return TierCounts[static_cast<int32>(Tier)];
+}
+
+// -------------------------------------------------------------------
+//  Tiers
+// -------------------------------------------------------------------
+
+ECharacterLODTier UCharacterLODSubsystem::ComputeTier(const ACharacter* Character, ECharacterLODTier CurrentTier, const FVector& CameraLocation) const
+{
+	if (Character == SelectedActor.Get())
+	{
+		return ECharacterLODTier::Full;
+	}
+
+	float Distance = FVector::Dist(CameraLocation, Character->GetActorLocation());
+	if (!Character->WasRecentlyRendered(0.2f))
+	{
+		Distance *= OffscreenDistanceScale;
+	}
+
+	// A character keeps its tier until it is clearly past the threshold.
+	const float Thresholds[] = { FullDistance, ReducedDistance, MinimalDistance };
+	for (int32 TierIndex = 0; TierIndex < static_cast<int32>(UE_ARRAY_COUNT(Thresholds)); ++TierIndex)
+	{
+		const float Threshold = static_cast<int32>(CurrentTier) <= TierIndex
+			? Thresholds[TierIndex] * (1.0f + TierHysteresis)
+			: Thresholds[TierIndex];
+
+		if (Distance <= Threshold)
+		{
+			return static_cast<ECharacterLODTier>(TierIndex);
+		}
+	}
+
+	return ECharacterLODTier::Dormant;
+}
+
+void UCharacterLODSubsystem::ApplyTier(FCharacterLODEntry& Entry, ECharacterLODTier NewTier)
+{
+	if (NewTier == Entry.Tier)
+	{
+		return;
+	}
+
+	TierCounts[static_cast<int32>(Entry.Tier)]--;
+	TierCounts[static_cast<int32>(NewTier)]++;
+	Entry.Tier = NewTier;
+	Entry.DormantPathIndex = INDEX_NONE;
+	Entry.DormantPath.Reset();
+
+	ACharacter* Character = Entry.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	const FZooCharacterLODSettings* Found = TierSettings.Find(NewTier);
+	const FZooCharacterLODSettings Settings = Found ? *Found : FZooCharacterLODSettings();
+	const bool bDormant = NewTier == ECharacterLODTier::Dormant;
+
+	// Movement: throttled, or handed over to the dormant stepper entirely.
+	if (UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+	{
+		if (bDormant)
+		{
+			Movement->StopMovementImmediately();
+			Movement->SetComponentTickEnabled(false);
+		}
+		else
+		{
+			Movement->SetComponentTickEnabled(true);
+			Movement->SetComponentTickInterval(Settings.MovementTickInterval);
+		}
+	}
+
+	// AI: the character's own logic and its behavior tree's decisions. The controller and path following
+	// only slow down while dormant: movement input from them, such as group followers steering
+	// with AddMovementInput, is consumed on the next movement tick and must be given every frame.
+	const float SteeringTickInterval = bDormant ? Settings.AITickInterval : 0.0f;
+	Character->SetActorTickInterval(Settings.AITickInterval);
+	if (AController* Controller = Character->GetController())
+	{
+		Controller->SetActorTickInterval(SteeringTickInterval);
+
+		if (const AAIController* AIController = Cast<AAIController>(Controller))
+		{
+			if (UPathFollowingComponent* PathFollowing = AIController->GetPathFollowingComponent())
+			{
+				PathFollowing->SetComponentTickInterval(SteeringTickInterval);
+			}
+
+			// The tree resets its own tick interval, so the throttle is held by the component itself.
+			if (UZooBehaviorTreeComponent* BehaviorTree = Cast<UZooBehaviorTreeComponent>(AIController->GetBrainComponent()))
+			{
+				BehaviorTree->SetDecisionInterval(Settings.AITickInterval);
+			}
+		}
+	}
+
+	// Animation: off-screen characters stop evaluating their pose.
+	if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Mesh->SetComponentTickInterval(Settings.AnimationTickInterval);
+		Mesh->VisibilityBasedAnimTickOption = NewTier == ECharacterLODTier::Full
+			? Entry.AnimTickOption
+			: EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+		Mesh->SetCollisionEnabled(Settings.bMeshCollision ? Entry.MeshCollision.GetValue() : ECollisionEnabled::NoCollision);
+	}
+
+	if (UCapsuleComponent* Capsule = Character->GetCapsuleComponent())
+	{
+		Capsule->SetCollisionResponseToChannel(ECC_Pawn, Settings.bPawnCollision ? Entry.PawnResponse.GetValue() : ECR_Ignore);
+	}
+}
+
+void UCharacterLODSubsystem::StepDormant(FCharacterLODEntry& Entry, float DeltaTime)
+{
+	ACharacter* Character = Entry.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	// Group followers simply keep their formation slot behind the leader.
+	if (const AVisitorCharacter* Visitor = Cast<AVisitorCharacter>(Character))
+	{
+		const AVisitorCharacter* Leader = Visitor->GetGroupLeader();
+		if (Leader && Leader != Visitor)
+		{
+			const FVector SlotLocation = Leader->GetActorLocation() + Leader->GetActorRotation().RotateVector(Visitor->FormationOffset);
+			Character->SetActorLocationAndRotation(SlotLocation, Leader->GetActorRotation());
+			return;
+		}
+	}
+
+	const AAIController* AIController = Cast<AAIController>(Character->GetController());
+	const UPathFollowingComponent* PathFollowing = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	if (!PathFollowing || PathFollowing->GetStatus() != EPathFollowingStatus::Moving)
+	{
+		return;
+	}
+
+	const FNavPathSharedPtr Path = PathFollowing->GetPath();
+	if (!Path.IsValid() || !Path->IsValid())
+	{
+		return;
+	}
+
+	if (Entry.DormantPath.Pin() != Path)
+	{
+		Entry.DormantPath = Path;
+		Entry.DormantPathIndex = PathFollowing->GetNextPathIndex();
+	}
+
+	const TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+	const UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+	const float HalfHeight = Character->GetCapsuleComponent() ? Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.0f;
+
+	// Walk the path segments at walking speed, snapping to the navmesh points.
+	float Remaining = (Movement ? Movement->GetMaxSpeed() : 150.0f) * DeltaTime;
+	FVector Location = Character->GetActorLocation();
+	FVector Direction = FVector::ZeroVector;
+
+	while (Remaining > 0.0f && Points.IsValidIndex(Entry.DormantPathIndex))
+	{
+		const FVector Target = Points[Entry.DormantPathIndex].Location + FVector(0.0f, 0.0f, HalfHeight);
+		const FVector ToTarget = Target - Location;
+		const float Distance = ToTarget.Size();
+		if (Distance <= Remaining)
+		{
+			Location = Target;
+			Remaining -= Distance;
+			Entry.DormantPathIndex++;
+		}
+		else
+		{
+			Direction = ToTarget / Distance;
+			Location += Direction * Remaining;
+			Remaining = 0.0f;
+		}
+	}
+
+	if (Direction.IsNearlyZero())
+	{
+		Character->SetActorLocation(Location);
+	}
+	else
+	{
+		Character->SetActorLocationAndRotation(Location, FRotator(0.0f, Direction.Rotation().Yaw, 0.0f));
+	}
+}
+
+bool UCharacterLODSubsystem::GetCameraLocation(FVector& OutLocation) const
+{
+	const UWorld* World = GetWorld();
+	const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PC || !PC->PlayerCameraManager)
+	{
+		return false;
+	}
+
+	OutLocation = PC->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
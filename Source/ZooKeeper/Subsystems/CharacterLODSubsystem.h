@@ -0,0 +1,214 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "CharacterLODSubsystem.generated.h"
+
+class ACharacter;
+
+/** Simulation detail tiers for characters, from most to least significant. */
+UENUM(BlueprintType)
+enum class ECharacterLODTier : uint8
+{
+	Full     UMETA(DisplayName = "Full"),
+	Reduced  UMETA(DisplayName = "Reduced"),
+	Minimal  UMETA(DisplayName = "Minimal"),
+	Dormant  UMETA(DisplayName = "Dormant")
+};
+
+/**
+ * FZooCharacterLODSettings
+ *
+ * Update rates and collision applied to a character while it is in a tier.
+ * Tick intervals of 0 tick every frame.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooCharacterLODSettings
+{
+	GENERATED_BODY()
+
+	/** Tick interval (seconds) of the CharacterMovementComponent. Ignored in the Dormant tier, where it does not tick. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float MovementTickInterval = 0.0f;
+
+	/**
+	 * Tick interval (seconds) of the character, and minimum seconds between behavior tree decisions
+	 * (see UZooBehaviorTreeComponent). Controllers and path following keep ticking every frame,
+	 * since they feed the movement component, except while dormant.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float AITickInterval = 0.0f;
+
+	/** Tick interval (seconds) of the skeletal mesh (animation). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float AnimationTickInterval = 0.0f;
+
+	/** Whether the capsule blocks other pawns. When false, characters pass through each other. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD")
+	bool bPawnCollision = true;
+
+	/** Whether the skeletal mesh keeps its own collision (physics asset queries). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD")
+	bool bMeshCollision = true;
+};
+
+/**
+ * UCharacterLODSubsystem
+ *
+ * World subsystem that scales the simulation cost of visitors, staff, and
+ * animals with their significance to the player. Significance comes from
+ * the distance to the camera, scaled up for characters that are off screen,
+ * and overridden by selection. Each tier changes movement, AI, and
+ * animation update rates and collision complexity.
+ *
+ * Characters in the Dormant tier stop running CharacterMovement entirely
+ * and are moved along their current navigation path by the subsystem,
+ * without sweeps or physics. Significance is re-evaluated a slice of
+ * characters per frame, so the cost of the manager itself stays bounded.
+ *
+ * Characters register themselves on BeginPlay and unregister on EndPlay.
+ */
+UCLASS(meta = (DisplayName = "Character LOD Subsystem"))
+class ZOOKEEPER_API UCharacterLODSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/**
+	 * Re-evaluates a slice of characters and advances dormant characters along their paths.
+	 * Should be called once per frame from the game mode.
+	 * @param DeltaTime  Real-world seconds since the last frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|LOD")
+	void Tick(float DeltaTime);
+
+	// -------------------------------------------------------------------
+	//  Registration
+	// -------------------------------------------------------------------
+
+	/** Registers a character for LOD management. It starts in the Full tier. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|LOD")
+	void RegisterCharacter(ACharacter* Character);
+
+	/** Unregisters a character and restores its full-detail settings. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|LOD")
+	void UnregisterCharacter(ACharacter* Character);
+
+	// -------------------------------------------------------------------
+	//  Queries
+	// -------------------------------------------------------------------
+
+	/** Marks an actor as selected (e.g. focused or inspected by the player); it always stays in the Full tier. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|LOD")
+	void SetSelectedActor(AActor* Actor);
+
+	/** Returns the tier a character is currently in (Full if not registered). */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|LOD")
+	ECharacterLODTier GetCharacterTier(ACharacter* Character) const;
+
+	/** Returns how many registered characters are in the given tier. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|LOD")
+	int32 GetTierCount(ECharacterLODTier Tier) const;
+
+	// -------------------------------------------------------------------
+	//  Tuning
+	// -------------------------------------------------------------------
+
+	/** Whether tiers are applied. When disabled every character runs at full detail. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD")
+	bool bEnableLOD;
+
+	/** Camera distance (cm) within which on-screen characters stay in the Full tier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float FullDistance;
+
+	/** Camera distance (cm) within which on-screen characters stay in the Reduced tier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float ReducedDistance;
+
+	/** Camera distance (cm) within which characters stay in the Minimal tier; beyond it they go dormant. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float MinimalDistance;
+
+	/** Distance multiplier for characters that were not rendered recently. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "1.0"))
+	float OffscreenDistanceScale;
+
+	/** Fraction past a threshold a character must go before dropping to a lower tier, to avoid flicker. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float TierHysteresis;
+
+	/** Seconds between significance evaluations of the same character. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.05"))
+	float EvaluationInterval;
+
+	/** Seconds between position updates of dormant characters. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD", meta = (ClampMin = "0.0"))
+	float DormantStepInterval;
+
+	/** Update rates and collision per tier. Missing tiers run at full detail. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|LOD")
+	TMap<ECharacterLODTier, FZooCharacterLODSettings> TierSettings;
+
+private:
+	/** Per-character LOD state. */
+	struct FCharacterLODEntry
+	{
+		TWeakObjectPtr<ACharacter> Character;
+		ECharacterLODTier Tier = ECharacterLODTier::Full;
+
+		/** Capsule response to pawns at registration, restored when pawn collision is re-enabled. */
+		TEnumAsByte<ECollisionResponse> PawnResponse = ECR_Block;
+
+		/** Mesh collision at registration, restored when mesh collision is re-enabled. */
+		TEnumAsByte<ECollisionEnabled::Type> MeshCollision = ECollisionEnabled::NoCollision;
+
+		/** Mesh animation tick option at registration, restored in the Full tier. */
+		EVisibilityBasedAnimTickOption AnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+
+		/** Path point the dormant character is walking towards, and the path it belongs to. */
+		int32 DormantPathIndex = INDEX_NONE;
+		FNavPathWeakPtr DormantPath;
+	};
+
+	/** Computes the tier a character should be in, given its current tier for hysteresis. */
+	ECharacterLODTier ComputeTier(const ACharacter* Character, ECharacterLODTier CurrentTier, const FVector& CameraLocation) const;
+
+	/** Applies the tier's update rates and collision to the character. */
+	void ApplyTier(FCharacterLODEntry& Entry, ECharacterLODTier NewTier);
+
+	/** Moves a dormant character along its navigation path (or to its group slot) without physics. */
+	void StepDormant(FCharacterLODEntry& Entry, float DeltaTime);
+
+	/** Returns the camera location of the local player, if any. */
+	bool GetCameraLocation(FVector& OutLocation) const;
+
+	/** Registered characters. */
+	TArray<FCharacterLODEntry> Entries;
+
+	/** Index into Entries by character, for registration and queries. */
+	TMap<TWeakObjectPtr<ACharacter>, int32> EntryIndices;
+
+	/** Number of registered characters per tier. */
+	int32 TierCounts[4] = { 0, 0, 0, 0 };
+
+	/** The actor currently selected by the player. */
+	TWeakObjectPtr<AActor> SelectedActor;
+
+	/** Round-robin cursor into Entries. */
+	int32 EvaluationCursor = 0;
+
+	/** Fractional evaluations carried over between frames. */
+	float EvaluationCarry = 0.0f;
+
+	/** Seconds accumulated towards the next dormant step. */
+	float DormantStepAccumulator = 0.0f;
+};
@@ -1,9 +1,15 @@
 #include "EconomySubsystem.h"
 #include "StaffSubsystem.h"
 #include "AnimalManagerSubsystem.h"
+#include "VisitorSubsystem.h"
 #include "TimeSubsystem.h"
+#include "Core/ZooGameState.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
 #include "ZooKeeper.h"
 
+const TCHAR* UEconomySubsystem::SessionArchiveName = TEXT("_Session");
+
 bool UEconomySubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	return true;
@@ -14,13 +20,44 @@ void UEconomySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	Super::Initialize(Collection);
 
 	CurrentFunds = 50000;
+	TransactionRetentionDays = 7;
+	ReportRetentionDays = 360;
+	ForecastDays = 30;
+	ForecastTrials = 4096;
+	ForecastArrivalVolatility = 0.3f;
+	ForecastHistoryDays = 14;
+	Ledger.Reset();
+
+	LastArchivedDay = INDEX_NONE;
+
+	PendingBatch = FZooTransactionBatch();
+	LastNotifiedFunds = CurrentFunds;
+	bFundsDirty = false;
+	bFlushScheduled = false;
+	bBankruptcyPending = false;
 
 	// Subscribe to day changes to trigger daily expense processing.
+	TimeSubsystem = Collection.InitializeDependency<UTimeSubsystem>();
+	if (TimeSubsystem)
+	{
+		TimeSubsystem->OnDayChanged.AddDynamic(this, &UEconomySubsystem::HandleDayChanged);
+	}
+
+	VisitorSpendingMultiplier = 1.0f;
+	ModifierSubsystem = Collection.InitializeDependency<UZooModifierSubsystem>();
+	if (ModifierSubsystem)
+	{
+		ModifierSubsystem->OnModifiersChanged.AddDynamic(this, &UEconomySubsystem::HandleModifiersChanged);
+		HandleModifiersChanged(EZooModifierStat::VisitorSpending);
+	}
+
 	if (UWorld* World = GetWorld())
 	{
-		if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
+		// A new session starts with an empty archive; loading a save replaces it with the slot's.
+		if (World->IsGameWorld())
 		{
-			TimeSys->OnDayChanged.AddDynamic(this, &UEconomySubsystem::HandleDayChanged);
+			FZooTransactionArchive::DeleteArchive(GetArchivePath(SessionArchiveName));
+			Archive.Open(GetArchivePath(SessionArchiveName));
 		}
 	}
 
@@ -29,16 +66,27 @@ void UEconomySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UEconomySubsystem::Deinitialize()
 {
-	UE_LOG(LogZooKeeper, Log, TEXT("EconomySubsystem::Deinitialize - Final balance: %d, Total transactions: %d"),
-		CurrentFunds, TransactionLog.Num());
+	UE_LOG(LogZooKeeper, Log, TEXT("EconomySubsystem::Deinitialize - Final balance: %d, Total transactions: %lld"),
+		CurrentFunds, Ledger.GetNumRecorded());
 
-	TransactionLog.Empty();
-	DailyExpenseLog.Empty();
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+	bFlushScheduled = false;
+	FlushEconomyEvents();
+
+	CancelForecast();
+
+	TimeSubsystem = nullptr;
+	ModifierSubsystem = nullptr;
+	Ledger.Reset();
+	Archive.Close();
 
 	Super::Deinitialize();
 }
 
-bool UEconomySubsystem::TrySpend(int32 Amount, FString Reason)
+bool UEconomySubsystem::TrySpend(int32 Amount, FString Reason, ETransactionCategory Category)
 {
 	if (Amount <= 0)
 	{
@@ -55,37 +103,20 @@ bool UEconomySubsystem::TrySpend(int32 Amount, FString Reason)
 
 	CurrentFunds -= Amount;
 
-	FZooTransaction Transaction;
-	Transaction.Amount = Amount;
-	Transaction.Reason = MoveTemp(Reason);
-	Transaction.bIsExpense = true;
-	// Set time from TimeSubsystem if available.
-	if (UWorld* World = GetWorld())
-	{
-		if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
-		{
-			Transaction.GameTime = TimeSys->CurrentTimeOfDay;
-			Transaction.Day = TimeSys->CurrentDay;
-		}
-	}
-
-	TransactionLog.Add(Transaction);
-	OnTransactionCompleted.Broadcast(Transaction);
-	OnFundsChanged.Broadcast(CurrentFunds);
-
 	UE_LOG(LogZooKeeper, Log, TEXT("EconomySubsystem - Spent %d for '%s'. Balance: %d"),
-		Transaction.Amount, *Transaction.Reason, CurrentFunds);
+		Amount, *Reason, CurrentFunds);
 
 	if (CurrentFunds <= 0)
 	{
-		UE_LOG(LogZooKeeper, Warning, TEXT("EconomySubsystem - BANKRUPTCY! Funds have reached zero."));
-		OnBankruptcy.Broadcast();
+		bBankruptcyPending = true;
 	}
 
+	RecordTransaction(Amount, true, Category, MoveTemp(Reason));
+
 	return true;
 }
 
-void UEconomySubsystem::AddIncome(int32 Amount, FString Reason)
+void UEconomySubsystem::AddIncome(int32 Amount, FString Reason, ETransactionCategory Category)
 {
 	if (Amount <= 0)
 	{
@@ -95,27 +126,130 @@ void UEconomySubsystem::AddIncome(int32 Amount, FString Reason)
 
 	CurrentFunds += Amount;
 
+	UE_LOG(LogZooKeeper, Log, TEXT("EconomySubsystem - Income of %d from '%s'. Balance: %d"),
+		Amount, *Reason, CurrentFunds);
+
+	RecordTransaction(Amount, false, Category, MoveTemp(Reason));
+}
+
+void UEconomySubsystem::RecordTransaction(int32 Amount, bool bIsExpense, ETransactionCategory Category, FString&& Reason)
+{
 	FZooTransaction Transaction;
 	Transaction.Amount = Amount;
 	Transaction.Reason = MoveTemp(Reason);
-	Transaction.bIsExpense = false;
+	Transaction.bIsExpense = bIsExpense;
+	Transaction.Category = Category;
 
 	// Set time from TimeSubsystem if available.
+	if (TimeSubsystem)
+	{
+		Transaction.GameTime = TimeSubsystem->CurrentTimeOfDay;
+		Transaction.Day = TimeSubsystem->CurrentDay;
+	}
+
+	Ledger.Record(Amount, bIsExpense, Category, Transaction.Reason, Transaction.Day, Transaction.GameTime);
+
+	if (bIsExpense)
+	{
+		PendingBatch.TotalExpenses += Amount;
+		PendingBatch.CategoryDeltas.FindOrAdd(Category) -= Amount;
+	}
+	else
+	{
+		PendingBatch.TotalIncome += Amount;
+		PendingBatch.CategoryDeltas.FindOrAdd(Category) += Amount;
+	}
+
+	// Individual transactions are only kept for listeners that want them.
+	if (OnTransactionCompleted.IsBound() || OnTransactionBatch.IsBound())
+	{
+		PendingBatch.Transactions.Add(MoveTemp(Transaction));
+	}
+
+	bFundsDirty = true;
+	ScheduleFlush();
+}
+
+void UEconomySubsystem::ScheduleFlush()
+{
+	if (bFlushScheduled)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld())
+	{
+		// Nothing ticks outside a game world, so there is no frame to coalesce over.
+		FlushEconomyEvents();
+		return;
+	}
+
+	bFlushScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UEconomySubsystem::FlushEconomyEvents));
+}
+
+void UEconomySubsystem::FlushEconomyEvents()
+{
+	bFlushScheduled = false;
+
+	if (!bFundsDirty)
+	{
+		return;
+	}
+
+	// Take the batch first so listeners that spend or earn start a new one.
+	FZooTransactionBatch Batch = MoveTemp(PendingBatch);
+	PendingBatch = FZooTransactionBatch();
+	bFundsDirty = false;
+
+	const bool bBankrupt = bBankruptcyPending && CurrentFunds <= 0;
+	bBankruptcyPending = false;
+
+	Batch.NewBalance = CurrentFunds;
+	Batch.NetChange = CurrentFunds - LastNotifiedFunds;
+	LastNotifiedFunds = CurrentFunds;
+
+	if (OnTransactionCompleted.IsBound())
+	{
+		for (const FZooTransaction& Transaction : Batch.Transactions)
+		{
+			OnTransactionCompleted.Broadcast(Transaction);
+		}
+	}
+
+	OnTransactionBatch.Broadcast(Batch);
+
+	if (Batch.NetChange != 0)
+	{
+		OnFundsChanged.Broadcast(Batch.NewBalance);
+	}
+
 	if (UWorld* World = GetWorld())
 	{
-		if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
+		if (AZooGameState* ZooState = World->GetGameState<AZooGameState>())
 		{
-			Transaction.GameTime = TimeSys->CurrentTimeOfDay;
-			Transaction.Day = TimeSys->CurrentDay;
+			ZooState->SetFunds(Batch.NewBalance);
 		}
 	}
 
-	TransactionLog.Add(Transaction);
-	OnTransactionCompleted.Broadcast(Transaction);
-	OnFundsChanged.Broadcast(CurrentFunds);
+	if (bBankrupt)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("EconomySubsystem - BANKRUPTCY! Funds have reached zero."));
+		OnBankruptcy.Broadcast();
+	}
+}
 
-	UE_LOG(LogZooKeeper, Log, TEXT("EconomySubsystem - Income of %d from '%s'. Balance: %d"),
-		Transaction.Amount, *Transaction.Reason, CurrentFunds);
+void UEconomySubsystem::SetBalance(int32 NewBalance)
+{
+	if (NewBalance == CurrentFunds)
+	{
+		return;
+	}
+
+	CurrentFunds = NewBalance;
+	bFundsDirty = true;
+	ScheduleFlush();
 }
 
 int32 UEconomySubsystem::GetBalance() const
@@ -123,6 +257,19 @@ int32 UEconomySubsystem::GetBalance() const
 	return CurrentFunds;
 }
 
+int32 UEconomySubsystem::ApplyVisitorSpending(int32 BasePrice) const
+{
+	return FMath::Max(0, FMath::RoundToInt(BasePrice * VisitorSpendingMultiplier));
+}
+
+void UEconomySubsystem::HandleModifiersChanged(EZooModifierStat Stat)
+{
+	if (Stat == EZooModifierStat::VisitorSpending && ModifierSubsystem)
+	{
+		VisitorSpendingMultiplier = FMath::Max(0.0f, ModifierSubsystem->GetModifiedValue(EZooModifierStat::VisitorSpending, 1.0f));
+	}
+}
+
 void UEconomySubsystem::ProcessDailyExpenses()
 {
 	UWorld* World = GetWorld();
@@ -131,29 +278,25 @@ void UEconomySubsystem::ProcessDailyExpenses()
 		return;
 	}
 
-	// Archive yesterday's transactions into the daily expense log.
-	DailyExpenseLog = TransactionLog;
-	TransactionLog.Empty();
-
 	// --- Staff Salaries ---
 	if (UStaffSubsystem* StaffSys = World->GetSubsystem<UStaffSubsystem>())
 	{
 		const int32 SalaryCost = StaffSys->GetDailySalaryCost();
 		if (SalaryCost > 0)
 		{
-			TrySpend(SalaryCost, TEXT("Staff salaries"));
+			TrySpend(SalaryCost, TEXT("Staff salaries"), ETransactionCategory::StaffSalary);
 		}
 	}
 
 	// --- Animal Food Costs ---
-	// Estimate daily food cost as $5 per animal.
+	// Estimate daily food cost as a flat amount per animal.
 	if (UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>())
 	{
 		const int32 AnimalCount = AnimalMgr->GetAnimalCount();
-		const int32 FoodCost = AnimalCount * 5;
+		const int32 FoodCost = AnimalCount * FoodCostPerAnimal;
 		if (FoodCost > 0)
 		{
-			TrySpend(FoodCost, FString::Printf(TEXT("Animal food (%d animals)"), AnimalCount));
+			TrySpend(FoodCost, FString::Printf(TEXT("Animal food (%d animals)"), AnimalCount), ETransactionCategory::AnimalFood);
 		}
 	}
 
@@ -162,33 +305,318 @@ void UEconomySubsystem::ProcessDailyExpenses()
 }
 
 FZooDailyFinanceReport UEconomySubsystem::GetDailyReport() const
+{
+	return GetReportForDay(GetCurrentDay());
+}
+
+FZooDailyFinanceReport UEconomySubsystem::GetReportForDay(int32 Day) const
 {
 	FZooDailyFinanceReport Report;
-	Report.Transactions = TransactionLog;
+	Ledger.GetDayReport(Day, Report);
+	return Report;
+}
+
+TArray<FZooTransaction> UEconomySubsystem::GetDailyTransactions(int32 Day) const
+{
+	TArray<FZooTransaction> Transactions;
+
+	// Archived days may have been trimmed from the ledger already.
+	if (Day <= LastArchivedDay)
+	{
+		Archive.ForEachRecord(Day, Day, [this, &Transactions](const FZooArchivedTransaction& Record)
+		{
+			FZooTransaction& Transaction = Transactions.AddDefaulted_GetRef();
+			Transaction.Amount = FMath::Abs(Record.Amount);
+			Transaction.bIsExpense = Record.Amount < 0;
+			Transaction.Reason = Archive.GetReason(Record.ReasonId);
+			Transaction.GameTime = Record.Minute / 60.0f;
+			Transaction.Day = Record.Day;
+			Transaction.Category = Record.Category;
+		});
+		return Transactions;
+	}
+
+	Ledger.GetDayTransactions(Day, Transactions);
+	return Transactions;
+}
+
+int64 UEconomySubsystem::GetLifetimeCategoryTotal(ETransactionCategory Category, bool bIsExpense) const
+{
+	return Ledger.GetLifetimeCategoryTotal(Category, bIsExpense);
+}
+
+TArray<FZooFinanceHistoryBucket> UEconomySubsystem::GetFinanceHistory(int32 FirstDay, int32 LastDay, int32 NumBuckets) const
+{
+	TArray<FZooFinanceHistoryBucket> Buckets;
+	if (LastDay < FirstDay)
+	{
+		return Buckets;
+	}
+
+	const int32 NumDays = LastDay - FirstDay + 1;
+	NumBuckets = FMath::Clamp(NumBuckets, 1, NumDays);
+	Buckets.SetNum(NumBuckets);
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Buckets[i].FirstDay = FirstDay + static_cast<int32>(static_cast<int64>(i) * NumDays / NumBuckets);
+		Buckets[i].LastDay = FirstDay + static_cast<int32>(static_cast<int64>(i + 1) * NumDays / NumBuckets) - 1;
+	}
 
-	for (const FZooTransaction& Transaction : TransactionLog)
+	auto BucketForDay = [&](int32 Day) -> FZooFinanceHistoryBucket&
 	{
-		if (Transaction.bIsExpense)
+		return Buckets[static_cast<int32>(static_cast<int64>(Day - FirstDay) * NumBuckets / NumDays)];
+	};
+
+	// Days the ledger still has totals for come from memory; anything older from the archive.
+	const int32 LedgerFirstDay = Ledger.GetFirstRollupDay();
+	const int32 ArchiveLastDay = LedgerFirstDay == INDEX_NONE ? LastDay : FMath::Min(LastDay, LedgerFirstDay - 1);
+
+	Archive.ForEachRecord(FirstDay, ArchiveLastDay, [&](const FZooArchivedTransaction& Record)
+	{
+		FZooFinanceHistoryBucket& Bucket = BucketForDay(Record.Day);
+		if (Record.Amount < 0)
 		{
-			Report.TotalExpenses += Transaction.Amount;
+			Bucket.TotalExpenses -= Record.Amount;
 		}
 		else
 		{
-			Report.TotalIncome += Transaction.Amount;
+			Bucket.TotalIncome += Record.Amount;
+		}
+	});
+
+	if (LedgerFirstDay != INDEX_NONE)
+	{
+		for (int32 Day = FMath::Max(FirstDay, LedgerFirstDay); Day <= LastDay; ++Day)
+		{
+			int32 Income = 0;
+			int32 Expenses = 0;
+			if (Ledger.GetDayTotals(Day, Income, Expenses))
+			{
+				FZooFinanceHistoryBucket& Bucket = BucketForDay(Day);
+				Bucket.TotalIncome += Income;
+				Bucket.TotalExpenses += Expenses;
+			}
 		}
 	}
 
-	Report.NetProfit = Report.TotalIncome - Report.TotalExpenses;
+	for (FZooFinanceHistoryBucket& Bucket : Buckets)
+	{
+		Bucket.NetProfit = Bucket.TotalIncome - Bucket.TotalExpenses;
+	}
+
+	return Buckets;
+}
+
+void UEconomySubsystem::RequestForecast()
+{
+	if (ForecastJob.IsValid())
+	{
+		bForecastRequested = true;
+		return;
+	}
+
+	bForecastRequested = false;
+	ForecastJob = MakeShared<FZooFinanceForecastJob, ESPMode::ThreadSafe>(SnapshotForecastInputs());
+
+	// The job pointer identifies the request, so a result from a cancelled or replaced job is ignored.
+	ForecastJob->Launch([WeakThis = TWeakObjectPtr<UEconomySubsystem>(this), Job = ForecastJob.Get()](FZooFinanceForecast&& Forecast)
+	{
+		UEconomySubsystem* Self = WeakThis.Get();
+		if (Self && Self->ForecastJob.Get() == Job)
+		{
+			Self->HandleForecastComplete(MoveTemp(Forecast));
+		}
+	});
+}
+
+void UEconomySubsystem::CancelForecast()
+{
+	if (ForecastJob.IsValid())
+	{
+		ForecastJob->Cancel();
+		ForecastJob.Reset();
+	}
+	bForecastRequested = false;
+}
+
+void UEconomySubsystem::HandleForecastComplete(FZooFinanceForecast&& Forecast)
+{
+	ForecastJob.Reset();
+	LatestForecast = MoveTemp(Forecast);
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("EconomySubsystem - Forecast from day %d: %.1f%% bankruptcy risk over %d days."),
+		LatestForecast.StartDay, LatestForecast.BankruptcyProbability * 100.0f, LatestForecast.Days.Num());
+
+	OnForecastUpdated.Broadcast(LatestForecast);
+
+	if (bForecastRequested)
+	{
+		RequestForecast();
+	}
+}
+
+FZooForecastInputs UEconomySubsystem::SnapshotForecastInputs() const
+{
+	FZooForecastInputs Inputs;
+	Inputs.StartDay = GetCurrentDay();
+	Inputs.StartingBalance = CurrentFunds;
+	Inputs.LoanBalance = LoanBalance;
+	Inputs.ArrivalVolatility = ForecastArrivalVolatility;
+	Inputs.NumDays = ForecastDays;
+	Inputs.NumTrials = ForecastTrials;
+	Inputs.Seed = FMath::Rand();
 
 	if (UWorld* World = GetWorld())
 	{
-		if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
+		if (const UStaffSubsystem* StaffSys = World->GetSubsystem<UStaffSubsystem>())
+		{
+			Inputs.DailySalaries = StaffSys->GetDailySalaryCost();
+		}
+
+		if (const UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>())
 		{
-			Report.Day = TimeSys->CurrentDay;
+			Inputs.DailyFoodCost = AnimalMgr->GetAnimalCount() * FoodCostPerAnimal;
+		}
+
+		if (const UVisitorSubsystem* VisitorSys = World->GetSubsystem<UVisitorSubsystem>())
+		{
+			Inputs.ExpectedDailyArrivals = VisitorSys->GetExpectedDailyArrivals();
+			Inputs.AverageAdmission = VisitorSys->GetAverageAdmission() * VisitorSpendingMultiplier;
 		}
 	}
 
-	return Report;
+	// Everything not modelled above comes from recent complete days. Purchases are left out as
+	// one-off decisions, and miscellaneous entries because loans are booked there.
+	for (int32 Day = Inputs.StartDay - ForecastHistoryDays; Day < Inputs.StartDay; ++Day)
+	{
+		int32 Income = 0;
+		int32 Expenses = 0;
+		if (!Ledger.GetDayTotals(Day, Income, Expenses))
+		{
+			continue;
+		}
+
+		int32 OtherNet = 0;
+		for (int32 CategoryIndex = 0; CategoryIndex < FZooTransactionLedger::NumCategories; ++CategoryIndex)
+		{
+			const ETransactionCategory Category = static_cast<ETransactionCategory>(CategoryIndex);
+			switch (Category)
+			{
+			case ETransactionCategory::VisitorTicket:
+			case ETransactionCategory::StaffSalary:
+			case ETransactionCategory::AnimalFood:
+			case ETransactionCategory::AnimalPurchase:
+			case ETransactionCategory::BuildingPurchase:
+			case ETransactionCategory::Miscellaneous:
+				break;
+			default:
+				OtherNet += Ledger.GetDayCategoryTotal(Day, Category, false) - Ledger.GetDayCategoryTotal(Day, Category, true);
+				break;
+			}
+		}
+		Inputs.OtherDailyNet.Add(OtherNet);
+	}
+
+	return Inputs;
+}
+
+void UEconomySubsystem::ArchiveDaysBefore(int32 CutoffDay)
+{
+	const int32 LedgerFirstDay = Ledger.GetFirstRollupDay();
+	if (LedgerFirstDay == INDEX_NONE || !Archive.IsOpen())
+	{
+		return;
+	}
+
+	const int32 FirstDay = FMath::Max(LastArchivedDay + 1, LedgerFirstDay);
+	for (int32 Day = FirstDay; Day < CutoffDay; ++Day)
+	{
+		Ledger.ForEachDayEntry(Day, [this, Day](int32 SignedAmount, uint16 Minute, ETransactionCategory Category, const FString& Reason)
+		{
+			Archive.Add(Day, SignedAmount, Minute, Category, Reason);
+		});
+	}
+
+	if (FirstDay < CutoffDay && Archive.Flush())
+	{
+		LastArchivedDay = CutoffDay - 1;
+	}
+}
+
+void UEconomySubsystem::SaveArchiveToSlot(const FString& SlotName)
+{
+	// Finished days still in memory are archived too, so the slot holds the full history.
+	const int32 Today = GetCurrentDay();
+	ArchiveDaysBefore(Today);
+
+	const FString SlotPath = GetArchivePath(SlotName);
+	if (!FZooTransactionArchive::CopyArchive(GetArchivePath(SessionArchiveName), SlotPath))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("EconomySubsystem::SaveArchiveToSlot - Failed to copy the transaction archive to slot '%s'."),
+			*SlotName);
+		return;
+	}
+
+	// The day in progress stays in this session's ledger, since it is still being recorded to,
+	// but the slot gets its transactions so far. LoadArchiveFromSlot moves them back into the ledger.
+	FZooTransactionArchive SlotArchive;
+	if (!SlotArchive.Open(SlotPath))
+	{
+		return;
+	}
+
+	Ledger.ForEachDayEntry(Today, [&SlotArchive, Today](int32 SignedAmount, uint16 Minute, ETransactionCategory Category, const FString& Reason)
+	{
+		SlotArchive.Add(Today, SignedAmount, Minute, Category, Reason);
+	});
+	SlotArchive.Close();
+}
+
+void UEconomySubsystem::LoadArchiveFromSlot(const FString& SlotName)
+{
+	// The ledger belongs to the session being replaced.
+	Ledger.Reset();
+	Archive.Close();
+
+	const FString SessionPath = GetArchivePath(SessionArchiveName);
+	const FString SlotPath = GetArchivePath(SlotName);
+	if (!FPaths::FileExists(SlotPath) || !FZooTransactionArchive::CopyArchive(SlotPath, SessionPath))
+	{
+		FZooTransactionArchive::DeleteArchive(SessionPath);
+	}
+
+	Archive.Open(SessionPath);
+
+	// The slot's last day may be the day it was saved on, which is still open: its transactions
+	// go back into the ledger so the rest of the day is recorded alongside them.
+	const int32 Today = GetCurrentDay();
+	const int32 ArchiveLastDay = Archive.GetLastDay();
+	if (ArchiveLastDay != INDEX_NONE && ArchiveLastDay >= Today)
+	{
+		Archive.ForEachRecord(Today, ArchiveLastDay, [this](const FZooArchivedTransaction& Record)
+		{
+			Ledger.Record(FMath::Abs(Record.Amount), Record.Amount < 0, Record.Category, Archive.GetReason(Record.ReasonId),
+				Record.Day, Record.Minute / 60.0f);
+		});
+		Archive.RemoveDaysFrom(Today);
+	}
+
+	LastArchivedDay = Archive.GetLastDay();
+}
+
+void UEconomySubsystem::DeleteArchiveForSlot(const FString& SlotName)
+{
+	FZooTransactionArchive::DeleteArchive(GetArchivePath(SlotName));
+}
+
+FString UEconomySubsystem::GetArchivePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / (SlotName + TEXT(".finance"));
+}
+
+int32 UEconomySubsystem::GetCurrentDay() const
+{
+	return TimeSubsystem ? TimeSubsystem->CurrentDay : 0;
 }
 
 void UEconomySubsystem::TakeLoan(int32 Amount)
@@ -221,6 +649,10 @@ void UEconomySubsystem::RepayLoan(int32 Amount)
 
 void UEconomySubsystem::HandleDayChanged(int32 NewDay)
 {
+	// Transactions leaving the in-memory window go to the archive first.
+	ArchiveDaysBefore(NewDay - FMath::Max(TransactionRetentionDays, 1) + 1);
+	Ledger.Trim(NewDay, TransactionRetentionDays, ReportRetentionDays);
+
 	ProcessDailyExpenses();
 
 	// Auto-repay a portion of the loan each day (10% of balance or $500, whichever is greater)
@@ -3,14 +3,27 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Economy/EconomyTypes.h"
+#include "Economy/TransactionLedger.h"
+#include "Economy/TransactionArchive.h"
+#include "Economy/FinanceForecast.h"
+#include "Subsystems/ZooModifierSubsystem.h"
 #include "EconomySubsystem.generated.h"
 
-/** Broadcast when the zoo's fund balance changes. */
+class UTimeSubsystem;
+class UZooModifierSubsystem;
+
+/** Broadcast once per frame in which the zoo's fund balance changed. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEconomyFundsChanged, int32, NewBalance);
 
-/** Broadcast when any transaction completes. */
+/** Broadcast for each completed transaction, when its batch is dispatched. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTransactionCompleted, const FZooTransaction&, Transaction);
 
+/** Broadcast once per frame with every transaction completed during it. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTransactionBatch, const FZooTransactionBatch&, Batch);
+
+/** Broadcast on the game thread when a finance forecast completes. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFinanceForecastUpdated, const FZooFinanceForecast&, Forecast);
+
 /** Broadcast when funds reach zero or below. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBankruptcy);
 
@@ -19,6 +32,21 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBankruptcy);
  *
  * World subsystem that manages the zoo's finances, including income, expenses,
  * transaction logging, and daily financial reports.
+ *
+ * Transactions are kept in a compact columnar ledger with running daily
+ * and per-category totals, so reports are cheap to produce. Individual
+ * transactions are kept in memory for TransactionRetentionDays; older ones
+ * are moved to an on-disk archive that is saved alongside each save slot
+ * and read back through memory mapping for history charts and audits.
+ *
+ * Balance changes take effect immediately, but notifications are coalesced:
+ * everything that happens within a frame is dispatched on the next tick as
+ * one OnTransactionBatch and one OnFundsChanged, and the game state's funds
+ * mirror is updated once.
+ *
+ * RequestForecast projects the balance forward with a Monte Carlo
+ * simulation on worker threads, from a snapshot of running costs, loan
+ * terms, and the visitor arrival model.
  */
 UCLASS(meta = (DisplayName = "Economy Subsystem"))
 class ZOOKEEPER_API UEconomySubsystem : public UWorldSubsystem
@@ -40,23 +68,41 @@ public:
 	 * Attempts to spend the given amount. Fails if insufficient funds.
 	 * @param Amount  The amount to spend (must be positive).
 	 * @param Reason  A description of the expense.
+	 * @param Category  The reporting category of the expense.
 	 * @return true if the funds were available and the expense was recorded.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
-	bool TrySpend(int32 Amount, FString Reason);
+	bool TrySpend(int32 Amount, FString Reason, ETransactionCategory Category = ETransactionCategory::Miscellaneous);
 
 	/**
 	 * Adds income to the zoo's balance.
 	 * @param Amount  The amount to add (must be positive).
 	 * @param Reason  A description of the income source.
+	 * @param Category  The reporting category of the income.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
-	void AddIncome(int32 Amount, FString Reason);
+	void AddIncome(int32 Amount, FString Reason, ETransactionCategory Category = ETransactionCategory::Miscellaneous);
+
+	/**
+	 * Applies the current visitor spending modifiers to a base price.
+	 * @param BasePrice  The unmodified price a visitor pays.
+	 * @return The price after modifiers, never negative.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy")
+	int32 ApplyVisitorSpending(int32 BasePrice) const;
 
 	/** Returns the current fund balance. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy")
 	int32 GetBalance() const;
 
+	/** Sets the balance without recording a transaction (e.g. when loading a save). */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
+	void SetBalance(int32 NewBalance);
+
+	/** Dispatches pending economy events now instead of on the next tick. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
+	void FlushEconomyEvents();
+
 	/**
 	 * Processes recurring daily expenses such as staff salaries, animal feed,
 	 * and maintenance costs. Should be called once per in-game day.
@@ -70,6 +116,73 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy")
 	FZooDailyFinanceReport GetDailyReport() const;
 
+	/** Returns the report of the given day. Days before the rollup retention window report zeros. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy")
+	FZooDailyFinanceReport GetReportForDay(int32 Day) const;
+
+	/** Returns the individual transactions of the given day, oldest first, from memory or the archive. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
+	TArray<FZooTransaction> GetDailyTransactions(int32 Day) const;
+
+	/** Returns the income or expense total of a category over the whole game. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy")
+	int64 GetLifetimeCategoryTotal(ETransactionCategory Category, bool bIsExpense) const;
+
+	/** Returns the transaction ledger. */
+	const FZooTransactionLedger& GetLedger() const { return Ledger; }
+
+	// -------------------------------------------------------------------
+	//  History
+	// -------------------------------------------------------------------
+
+	/**
+	 * Returns income and expense totals from FirstDay to LastDay, split into equal buckets.
+	 * Recent days come from memory and older days from the archive, reading a bounded window at a time.
+	 * @param NumBuckets  Number of buckets; clamped to the number of days.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy")
+	TArray<FZooFinanceHistoryBucket> GetFinanceHistory(int32 FirstDay, int32 LastDay, int32 NumBuckets) const;
+
+	/**
+	 * Copies the session's transaction archive to the archive of a save slot, followed by the
+	 * transactions of the current day. Called when saving.
+	 */
+	void SaveArchiveToSlot(const FString& SlotName);
+
+	/**
+	 * Replaces the session's transaction archive with a save slot's archive. The saved day's
+	 * transactions are moved back into the ledger. Called when loading, after the day is restored.
+	 */
+	void LoadArchiveFromSlot(const FString& SlotName);
+
+	/** Deletes the transaction archive of a save slot. */
+	static void DeleteArchiveForSlot(const FString& SlotName);
+
+	// -------------------------------------------------------------------
+	//  Forecast
+	// -------------------------------------------------------------------
+
+	/**
+	 * Starts a forecast of the balance over the next ForecastDays days. The economy is
+	 * snapshotted now and ForecastTrials projections run on worker threads; OnForecastUpdated
+	 * fires on the game thread with the result. While a forecast is running, further requests
+	 * are coalesced into one more run with a fresh snapshot once it completes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy|Forecast")
+	void RequestForecast();
+
+	/** Cancels the running forecast and any queued request. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Economy|Forecast")
+	void CancelForecast();
+
+	/** Returns whether a forecast is running. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy|Forecast")
+	bool IsForecastRunning() const { return ForecastJob.IsValid(); }
+
+	/** Returns the most recently completed forecast. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Economy|Forecast")
+	FZooFinanceForecast GetLatestForecast() const { return LatestForecast; }
+
 	// -------------------------------------------------------------------
 	//  Loan System
 	// -------------------------------------------------------------------
@@ -96,9 +209,15 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Economy")
 	FOnTransactionCompleted OnTransactionCompleted;
 
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Economy")
+	FOnTransactionBatch OnTransactionBatch;
+
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Economy")
 	FOnBankruptcy OnBankruptcy;
 
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Economy|Forecast")
+	FOnFinanceForecastUpdated OnForecastUpdated;
+
 	// -------------------------------------------------------------------
 	//  State
 	// -------------------------------------------------------------------
@@ -107,18 +226,109 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Economy")
 	int32 CurrentFunds;
 
+	/** Days of individual transactions to keep in memory, including the current day. Older ones are archived to disk. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy", meta = (ClampMin = "1"))
+	int32 TransactionRetentionDays;
+
+	/** Days of daily totals to keep for reports; older days only count towards lifetime totals. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy", meta = (ClampMin = "1"))
+	int32 ReportRetentionDays;
+
+	/** Days projected by a forecast. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast", meta = (ClampMin = "1", ClampMax = "365"))
+	int32 ForecastDays;
+
+	/** Projections simulated per forecast. More trials give steadier percentiles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast", meta = (ClampMin = "1", ClampMax = "65536"))
+	int32 ForecastTrials;
+
+	/** Log-normal spread of daily visitor arrivals around the expected rate (weather, word of mouth). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast", meta = (ClampMin = "0.0"))
+	float ForecastArrivalVolatility;
+
+	/** Recent days whose other income and expenses are resampled by the forecast. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Economy|Forecast", meta = (ClampMin = "0"))
+	int32 ForecastHistoryDays;
+
 private:
 	/** Called when the day changes — triggers daily expense processing. */
 	UFUNCTION()
 	void HandleDayChanged(int32 NewDay);
 
-	/** Log of all transactions for the current day. Cleared at the start of each new day. */
+	/** Refreshes the cached effective values of the modifiers the economy reads. */
+	UFUNCTION()
+	void HandleModifiersChanged(EZooModifierStat Stat);
+
+	/** Records a completed transaction in the ledger and adds it to the pending batch. */
+	void RecordTransaction(int32 Amount, bool bIsExpense, ETransactionCategory Category, FString&& Reason);
+
+	/** Schedules FlushEconomyEvents for the next tick, unless already scheduled. */
+	void ScheduleFlush();
+
+	/** Returns the current in-game day, or 0 without a time subsystem. */
+	int32 GetCurrentDay() const;
+
+	/** Moves every day before CutoffDay that is not archived yet from the ledger to the archive. */
+	void ArchiveDaysBefore(int32 CutoffDay);
+
+	/** Returns the archive path of a save slot. */
+	static FString GetArchivePath(const FString& SlotName);
+
+	/** Captures everything a forecast needs from the game thread. */
+	FZooForecastInputs SnapshotForecastInputs() const;
+
+	/** Stores a completed forecast, broadcasts it, and starts a queued request. */
+	void HandleForecastComplete(FZooFinanceForecast&& Forecast);
+
+	/** Estimated daily food cost per animal. */
+	static constexpr int32 FoodCostPerAnimal = 5;
+
+	/** Time subsystem, for stamping transactions. */
 	UPROPERTY()
-	TArray<FZooTransaction> TransactionLog;
+	TObjectPtr<UTimeSubsystem> TimeSubsystem;
 
-	/** Accumulated daily expense total used for reporting. */
+	/** Modifier subsystem, for visitor spending. */
 	UPROPERTY()
-	TArray<FZooTransaction> DailyExpenseLog;
+	TObjectPtr<UZooModifierSubsystem> ModifierSubsystem;
+
+	/** Visitor spending multiplier after modifiers, refreshed when they change. */
+	float VisitorSpendingMultiplier = 1.0f;
+
+	/** Transactions and balance changes since the last dispatch. */
+	FZooTransactionBatch PendingBatch;
+
+	/** Balance at the last dispatch. */
+	int32 LastNotifiedFunds = 0;
+
+	/** Whether the balance changed since the last dispatch. */
+	bool bFundsDirty = false;
+
+	/** Whether a dispatch is scheduled for the next tick. */
+	bool bFlushScheduled = false;
+
+	/** Whether spending in the pending batch drove the balance to zero or below. */
+	bool bBankruptcyPending = false;
+
+	/** Every transaction, with daily and per-category totals. */
+	FZooTransactionLedger Ledger;
+
+	/** Transactions that aged out of the ledger, for the current session. */
+	FZooTransactionArchive Archive;
+
+	/** Last day moved to the archive, or INDEX_NONE. */
+	int32 LastArchivedDay = INDEX_NONE;
+
+	/** Archive name of the current session, copied to save slots when saving. */
+	static const TCHAR* SessionArchiveName;
+
+	/** The running forecast, or null. */
+	TSharedPtr<FZooFinanceForecastJob, ESPMode::ThreadSafe> ForecastJob;
+
+	/** Whether a forecast was requested while one was running. */
+	bool bForecastRequested = false;
+
+	/** Most recently completed forecast. */
+	FZooFinanceForecast LatestForecast;
 
 	/** Current outstanding loan balance. */
 	UPROPERTY()
@@ -4,10 +4,30 @@
 #include "EconomySubsystem.h"
 #include "BuildingManagerSubsystem.h"
 #include "ZooRatingSubsystem.h"
+#include "StaffSubsystem.h"
+#include "ResearchSubsystem.h"
 #include "TimeSubsystem.h"
 #include "Animals/AnimalBase.h"
+#include "Engine/DataTable.h"
 #include "ZooKeeper.h"
 
+DECLARE_CYCLE_STAT(TEXT("Milestone Evaluation"), STAT_ZooMilestoneEvaluation, STATGROUP_ZooKeeper);
+
+/** Builds a built-in milestone definition from (stat, threshold) pairs, all compared with AtLeast. */
+static FMilestoneDefinitionRow MakeBuiltInMilestone(FName MilestoneID, std::initializer_list<TPair<EMilestoneStat, float>> Conditions)
+{
+	FMilestoneDefinitionRow Row;
+	Row.MilestoneID = MilestoneID;
+	for (const TPair<EMilestoneStat, float>& Condition : Conditions)
+	{
+		FMilestoneCondition& NewCondition = Row.Conditions.AddDefaulted_GetRef();
+		NewCondition.Stat = Condition.Key;
+		NewCondition.Comparison = EMilestoneComparison::AtLeast;
+		NewCondition.Threshold = Condition.Value;
+	}
+	return Row;
+}
+
 bool UMilestoneSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	return true;
@@ -17,133 +37,364 @@ void UMilestoneSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	if (UWorld* World = GetWorld())
+	if (UAnimalManagerSubsystem* AnimalMgr = Collection.InitializeDependency<UAnimalManagerSubsystem>())
 	{
-		if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
-		{
-			TimeSys->OnDayChanged.AddDynamic(this, &UMilestoneSubsystem::HandleDayChanged);
-		}
+		AnimalMgr->OnAnimalAdded.AddDynamic(this, &UMilestoneSubsystem::HandleAnimalAdded);
+		AnimalMgr->OnAnimalRemoved.AddDynamic(this, &UMilestoneSubsystem::HandleAnimalRemoved);
+	}
+
+	if (UBuildingManagerSubsystem* BuildingMgr = Collection.InitializeDependency<UBuildingManagerSubsystem>())
+	{
+		BuildingMgr->OnEnclosureFormed.AddDynamic(this, &UMilestoneSubsystem::HandleEnclosureFormed);
+		BuildingMgr->OnBuildingDemolished.AddDynamic(this, &UMilestoneSubsystem::HandleBuildingDemolished);
+	}
+
+	if (UVisitorSubsystem* VisitorSub = Collection.InitializeDependency<UVisitorSubsystem>())
+	{
+		VisitorSub->OnVisitorCountChanged.AddDynamic(this, &UMilestoneSubsystem::HandleVisitorCountChanged);
+	}
+
+	if (UEconomySubsystem* EconSub = Collection.InitializeDependency<UEconomySubsystem>())
+	{
+		EconSub->OnFundsChanged.AddDynamic(this, &UMilestoneSubsystem::HandleFundsChanged);
+	}
+
+	if (UZooRatingSubsystem* RatingSub = Collection.InitializeDependency<UZooRatingSubsystem>())
+	{
+		RatingSub->OnRatingChanged.AddDynamic(this, &UMilestoneSubsystem::HandleRatingChanged);
+	}
+
+	if (UStaffSubsystem* StaffSub = Collection.InitializeDependency<UStaffSubsystem>())
+	{
+		StaffSub->OnStaffHired.AddDynamic(this, &UMilestoneSubsystem::HandleStaffChanged);
+		StaffSub->OnStaffFired.AddDynamic(this, &UMilestoneSubsystem::HandleStaffChanged);
+	}
+
+	if (UTimeSubsystem* TimeSys = Collection.InitializeDependency<UTimeSubsystem>())
+	{
+		TimeSys->OnDayChanged.AddDynamic(this, &UMilestoneSubsystem::HandleDayChanged);
+	}
+
+	if (UResearchSubsystem* ResearchSub = Collection.InitializeDependency<UResearchSubsystem>())
+	{
+		ResearchSub->OnResearchCompleted.AddDynamic(this, &UMilestoneSubsystem::HandleResearchCompleted);
 	}
 
-	UE_LOG(LogZooKeeper, Log, TEXT("MilestoneSubsystem::Initialize"));
+	LoadMilestoneDefinitions();
+
+	// Stats are seeded here but only evaluated once play begins, so nothing is awarded before listeners bind.
+	RefreshAllStats();
+
+	UE_LOG(LogZooKeeper, Log, TEXT("MilestoneSubsystem::Initialize - %d milestones."), Milestones.Num());
 }
 
 void UMilestoneSubsystem::Deinitialize()
 {
 	UE_LOG(LogZooKeeper, Log, TEXT("MilestoneSubsystem::Deinitialize - %d milestones achieved."), AchievedMilestones.Num());
+
+	Milestones.Empty();
+	MilestoneIndices.Empty();
+	for (TArray<int32>& StatWatchers : Watchers)
+	{
+		StatWatchers.Empty();
+	}
+	SpeciesCounts.Empty();
+
 	Super::Deinitialize();
 }
 
-void UMilestoneSubsystem::CheckMilestones()
+void UMilestoneSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
-	UWorld* World = GetWorld();
-	if (!World)
-	{
-		return;
-	}
+	Super::OnWorldBeginPlay(InWorld);
+
+	CheckMilestones();
+}
 
-	// --- FirstSteps: Have at least 1 animal and 1 enclosure ---
-	if (!AchievedMilestones.Contains(FName("FirstSteps")))
+void UMilestoneSubsystem::LoadMilestoneDefinitions()
+{
+	Milestones.Empty();
+	MilestoneIndices.Empty();
+
+	if (MilestoneDataTable)
 	{
-		UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>();
-		UBuildingManagerSubsystem* BuildingMgr = World->GetSubsystem<UBuildingManagerSubsystem>();
-		if (AnimalMgr && AnimalMgr->GetAnimalCount() > 0 &&
-			BuildingMgr && BuildingMgr->GetAllEnclosures().Num() > 0)
+		TArray<FMilestoneDefinitionRow*> Rows;
+		MilestoneDataTable->GetAllRows<FMilestoneDefinitionRow>(TEXT("MilestoneSubsystem"), Rows);
+
+		for (const FMilestoneDefinitionRow* Row : Rows)
 		{
-			AwardMilestone(FName("FirstSteps"));
+			if (Row)
+			{
+				CompileMilestone(*Row);
+			}
 		}
+
+		UE_LOG(LogZooKeeper, Log, TEXT("MilestoneSubsystem - Loaded %d milestones from DataTable."), Milestones.Num());
+	}
+	else
+	{
+		// Fallback built-in milestones when no DataTable is assigned.
+		CompileMilestone(MakeBuiltInMilestone(FName(TEXT("FirstSteps")), { { EMilestoneStat::AnimalCount, 1.0f }, { EMilestoneStat::EnclosureCount, 1.0f } }));
+		CompileMilestone(MakeBuiltInMilestone(FName(TEXT("GrowingZoo")), { { EMilestoneStat::AnimalCount, 5.0f }, { EMilestoneStat::SpeciesCount, 3.0f } }));
+		CompileMilestone(MakeBuiltInMilestone(FName(TEXT("Popular")), { { EMilestoneStat::VisitorCount, 20.0f } }));
+		CompileMilestone(MakeBuiltInMilestone(FName(TEXT("Paradise")), { { EMilestoneStat::Rating, 4.0f } }));
+		CompileMilestone(MakeBuiltInMilestone(FName(TEXT("FiveStars")), { { EMilestoneStat::Rating, 4.95f } }));
+		CompileMilestone(MakeBuiltInMilestone(FName(TEXT("Tycoon")), { { EMilestoneStat::Funds, 50000.0f } }));
+
+		UE_LOG(LogZooKeeper, Warning, TEXT("MilestoneSubsystem - No DataTable assigned, using %d built-in milestones."), Milestones.Num());
 	}
 
-	// --- GrowingZoo: 5+ animals of 3+ species ---
-	if (!AchievedMilestones.Contains(FName("GrowingZoo")))
+	// Watch lists hold only milestones that can still be achieved.
+	for (TArray<int32>& StatWatchers : Watchers)
 	{
-		if (UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>())
+		StatWatchers.Reset();
+	}
+
+	for (int32 Index = 0; Index < Milestones.Num(); ++Index)
+	{
+		FCompiledMilestone& Milestone = Milestones[Index];
+		Milestone.bAchieved = AchievedMilestones.Contains(Milestone.MilestoneID);
+		if (Milestone.bAchieved)
 		{
-			TArray<AAnimalBase*> Animals = AnimalMgr->GetAnimalsInEnclosure(nullptr);
-			if (Animals.Num() >= 5)
-			{
-				TSet<FName> Species;
-				for (AAnimalBase* Animal : Animals)
-				{
-					if (Animal)
-					{
-						Species.Add(Animal->SpeciesID);
-					}
-				}
-				if (Species.Num() >= 3)
-				{
-					AwardMilestone(FName("GrowingZoo"));
-				}
-			}
+			continue;
+		}
+
+		for (const FCompiledCondition& Condition : Milestone.Conditions)
+		{
+			Watchers[Condition.StatIndex].AddUnique(Index);
 		}
 	}
+}
 
-	// --- Popular: 20+ visitors ---
-	if (!AchievedMilestones.Contains(FName("Popular")))
+void UMilestoneSubsystem::CompileMilestone(const FMilestoneDefinitionRow& Row)
+{
+	if (Row.MilestoneID.IsNone() || Row.Conditions.Num() == 0)
 	{
-		if (UVisitorSubsystem* VisitorSub = World->GetSubsystem<UVisitorSubsystem>())
+		UE_LOG(LogZooKeeper, Warning, TEXT("MilestoneSubsystem::CompileMilestone - Milestone '%s' has no ID or no conditions; skipped."),
+			*Row.MilestoneID.ToString());
+		return;
+	}
+
+	if (MilestoneIndices.Contains(Row.MilestoneID))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("MilestoneSubsystem::CompileMilestone - Duplicate milestone '%s'; skipped."),
+			*Row.MilestoneID.ToString());
+		return;
+	}
+
+	FCompiledMilestone Milestone;
+	Milestone.MilestoneID = Row.MilestoneID;
+
+	for (const FMilestoneCondition& Condition : Row.Conditions)
+	{
+		const int32 StatIndex = static_cast<int32>(Condition.Stat);
+		if (StatIndex < 0 || StatIndex >= NumStats)
 		{
-			if (VisitorSub->CurrentVisitorCount >= 20)
-			{
-				AwardMilestone(FName("Popular"));
-			}
+			UE_LOG(LogZooKeeper, Warning, TEXT("MilestoneSubsystem::CompileMilestone - Milestone '%s' has an invalid stat; skipped."),
+				*Row.MilestoneID.ToString());
+			return;
 		}
+
+		FCompiledCondition& Compiled = Milestone.Conditions.AddDefaulted_GetRef();
+		Compiled.StatIndex = StatIndex;
+		Compiled.Comparison = Condition.Comparison;
+		Compiled.Threshold = Condition.Threshold;
+	}
+
+	MilestoneIndices.Add(Milestone.MilestoneID, Milestones.Num());
+	Milestones.Add(MoveTemp(Milestone));
+}
+
+bool UMilestoneSubsystem::FCompiledCondition::Test(double Value) const
+{
+	switch (Comparison)
+	{
+	case EMilestoneComparison::AtMost:
+		return Value <= Threshold;
+	case EMilestoneComparison::Equal:
+		return FMath::IsNearlyEqual(Value, Threshold);
+	case EMilestoneComparison::AtLeast:
+	default:
+		return Value >= Threshold;
 	}
+}
 
-	// --- Paradise: 4.0+ zoo rating ---
-	if (!AchievedMilestones.Contains(FName("Paradise")))
+void UMilestoneSubsystem::CheckMilestones()
+{
+	RefreshAllStats();
+
+	TArray<int32> Candidates;
+	for (int32 Index = 0; Index < Milestones.Num(); ++Index)
 	{
-		if (UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+		if (!Milestones[Index].bAchieved)
 		{
-			if (RatingSub->GetRating() >= 4.0f)
-			{
-				AwardMilestone(FName("Paradise"));
-			}
+			Candidates.Add(Index);
 		}
 	}
 
-	// --- FiveStars: 5.0 zoo rating ---
-	if (!AchievedMilestones.Contains(FName("FiveStars")))
+	EvaluateMilestones(Candidates);
+}
+
+bool UMilestoneSubsystem::IsMilestoneAchieved(FName MilestoneID) const
+{
+	return AchievedMilestones.Contains(MilestoneID);
+}
+
+TArray<FName> UMilestoneSubsystem::GetAchievedMilestones() const
+{
+	return AchievedMilestones.Array();
+}
+
+float UMilestoneSubsystem::GetStatValue(EMilestoneStat Stat) const
+{
+	const int32 StatIndex = static_cast<int32>(Stat);
+	return StatIndex >= 0 && StatIndex < NumStats ? static_cast<float>(StatValues[StatIndex]) : 0.0f;
+}
+
+void UMilestoneSubsystem::RestoreAchievedMilestones(const TArray<FName>& MilestoneIDs)
+{
+	for (const FName& MilestoneID : MilestoneIDs)
 	{
-		if (UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+		// IDs no longer defined are kept, so they survive the next save.
+		AchievedMilestones.Add(MilestoneID);
+
+		if (const int32* Index = MilestoneIndices.Find(MilestoneID))
 		{
-			if (RatingSub->GetRating() >= 4.95f)
-			{
-				AwardMilestone(FName("FiveStars"));
-			}
+			MarkAchieved(*Index);
 		}
 	}
+}
+
+void UMilestoneSubsystem::SetStat(EMilestoneStat Stat, double Value)
+{
+	const int32 StatIndex = static_cast<int32>(Stat);
+	if (StatValues[StatIndex] == Value)
+	{
+		return;
+	}
+
+	StatValues[StatIndex] = Value;
+
+	if (Watchers[StatIndex].Num() > 0)
+	{
+		// Copied, since awarding removes milestones from the list being walked.
+		const TArray<int32, TInlineAllocator<16>> Candidates(Watchers[StatIndex]);
+		EvaluateMilestones(Candidates);
+	}
+}
+
+void UMilestoneSubsystem::RefreshAllStats()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
 
-	// --- Tycoon: $50,000+ funds ---
-	if (!AchievedMilestones.Contains(FName("Tycoon")))
+	SpeciesCounts.Reset();
+	if (UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>())
 	{
-		if (UEconomySubsystem* EconSub = World->GetSubsystem<UEconomySubsystem>())
+		for (AAnimalBase* Animal : AnimalMgr->GetAnimalsInEnclosure(nullptr))
 		{
-			if (EconSub->GetBalance() >= 50000)
+			if (Animal && !Animal->SpeciesID.IsNone())
 			{
-				AwardMilestone(FName("Tycoon"));
+				SpeciesCounts.FindOrAdd(Animal->SpeciesID)++;
 			}
 		}
+		StatValues[static_cast<int32>(EMilestoneStat::AnimalCount)] = AnimalMgr->GetAnimalCount();
+	}
+	StatValues[static_cast<int32>(EMilestoneStat::SpeciesCount)] = SpeciesCounts.Num();
+
+	if (UBuildingManagerSubsystem* BuildingMgr = World->GetSubsystem<UBuildingManagerSubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::EnclosureCount)] = BuildingMgr->GetEnclosureCount();
+	}
+
+	if (UVisitorSubsystem* VisitorSub = World->GetSubsystem<UVisitorSubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::VisitorCount)] = VisitorSub->CurrentVisitorCount;
+	}
+
+	if (UEconomySubsystem* EconSub = World->GetSubsystem<UEconomySubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::Funds)] = EconSub->GetBalance();
+	}
+
+	if (UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::Rating)] = RatingSub->GetRating();
+	}
+
+	if (UStaffSubsystem* StaffSub = World->GetSubsystem<UStaffSubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::StaffCount)] = StaffSub->GetStaffCount();
+	}
+
+	if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::Day)] = TimeSys->CurrentDay;
+	}
+
+	if (UResearchSubsystem* ResearchSub = World->GetSubsystem<UResearchSubsystem>())
+	{
+		StatValues[static_cast<int32>(EMilestoneStat::ResearchCompleted)] = ResearchSub->GetCompletedResearchCount();
 	}
 }
 
-bool UMilestoneSubsystem::IsMilestoneAchieved(FName MilestoneID) const
+void UMilestoneSubsystem::EvaluateMilestones(TArrayView<const int32> Candidates)
 {
-	return AchievedMilestones.Contains(MilestoneID);
+	SCOPE_CYCLE_COUNTER(STAT_ZooMilestoneEvaluation);
+
+	TArray<int32, TInlineAllocator<4>> Met;
+	for (const int32 Index : Candidates)
+	{
+		if (!Milestones[Index].bAchieved && AreConditionsMet(Milestones[Index]))
+		{
+			Met.Add(Index);
+		}
+	}
+
+	// Everything is marked before the first broadcast, so a listener that changes a stat sees consistent watch lists.
+	for (const int32 Index : Met)
+	{
+		MarkAchieved(Index);
+	}
+
+	for (const int32 Index : Met)
+	{
+		AwardMilestone(Index);
+	}
 }
 
-TArray<FName> UMilestoneSubsystem::GetAchievedMilestones() const
+bool UMilestoneSubsystem::AreConditionsMet(const FCompiledMilestone& Milestone) const
 {
-	return AchievedMilestones.Array();
+	for (const FCompiledCondition& Condition : Milestone.Conditions)
+	{
+		if (!Condition.Test(StatValues[Condition.StatIndex]))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
-void UMilestoneSubsystem::HandleDayChanged(int32 NewDay)
+void UMilestoneSubsystem::MarkAchieved(int32 MilestoneIndex)
 {
-	CheckMilestones();
+	FCompiledMilestone& Milestone = Milestones[MilestoneIndex];
+	if (Milestone.bAchieved)
+	{
+		return;
+	}
+
+	Milestone.bAchieved = true;
+	for (const FCompiledCondition& Condition : Milestone.Conditions)
+	{
+		Watchers[Condition.StatIndex].RemoveSwap(MilestoneIndex);
+	}
 }
 
-void UMilestoneSubsystem::AwardMilestone(FName MilestoneID)
+void UMilestoneSubsystem::AwardMilestone(int32 MilestoneIndex)
 {
+	const FName MilestoneID = Milestones[MilestoneIndex].MilestoneID;
 	if (AchievedMilestones.Contains(MilestoneID))
 	{
 		return;
@@ -155,3 +406,102 @@ void UMilestoneSubsystem::AwardMilestone(FName MilestoneID)
 	UE_LOG(LogZooKeeper, Log, TEXT("MilestoneSubsystem - Milestone achieved: '%s'! Total: %d"),
 		*MilestoneID.ToString(), AchievedMilestones.Num());
 }
+
+// ---------------------------------------------------------------------------
+//  Stat sources
+// ---------------------------------------------------------------------------
+
+void UMilestoneSubsystem::HandleAnimalAdded(AAnimalBase* Animal)
+{
+	if (Animal && !Animal->SpeciesID.IsNone())
+	{
+		SpeciesCounts.FindOrAdd(Animal->SpeciesID)++;
+	}
+
+	SetStat(EMilestoneStat::SpeciesCount, SpeciesCounts.Num());
+
+	if (UAnimalManagerSubsystem* AnimalMgr = GetWorld() ? GetWorld()->GetSubsystem<UAnimalManagerSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::AnimalCount, AnimalMgr->GetAnimalCount());
+	}
+}
+
+void UMilestoneSubsystem::HandleAnimalRemoved(AAnimalBase* Animal)
+{
+	if (Animal && !Animal->SpeciesID.IsNone())
+	{
+		if (int32* Count = SpeciesCounts.Find(Animal->SpeciesID))
+		{
+			if (--(*Count) <= 0)
+			{
+				SpeciesCounts.Remove(Animal->SpeciesID);
+			}
+		}
+	}
+
+	SetStat(EMilestoneStat::SpeciesCount, SpeciesCounts.Num());
+
+	if (UAnimalManagerSubsystem* AnimalMgr = GetWorld() ? GetWorld()->GetSubsystem<UAnimalManagerSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::AnimalCount, AnimalMgr->GetAnimalCount());
+	}
+}
+
+void UMilestoneSubsystem::HandleEnclosureFormed(AEnclosureActor* Enclosure)
+{
+	if (UBuildingManagerSubsystem* BuildingMgr = GetWorld() ? GetWorld()->GetSubsystem<UBuildingManagerSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::EnclosureCount, BuildingMgr->GetEnclosureCount());
+	}
+}
+
+void UMilestoneSubsystem::HandleBuildingDemolished(AZooBuildingActor* Building)
+{
+	if (UBuildingManagerSubsystem* BuildingMgr = GetWorld() ? GetWorld()->GetSubsystem<UBuildingManagerSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::EnclosureCount, BuildingMgr->GetEnclosureCount());
+	}
+}
+
+void UMilestoneSubsystem::HandleVisitorCountChanged(int32 NewCount)
+{
+	SetStat(EMilestoneStat::VisitorCount, NewCount);
+}
+
+void UMilestoneSubsystem::HandleFundsChanged(int32 NewBalance)
+{
+	SetStat(EMilestoneStat::Funds, NewBalance);
+}
+
+void UMilestoneSubsystem::HandleRatingChanged(float NewRating)
+{
+	SetStat(EMilestoneStat::Rating, NewRating);
+}
+
+void UMilestoneSubsystem::HandleStaffChanged(int32 StaffID)
+{
+	if (UStaffSubsystem* StaffSub = GetWorld() ? GetWorld()->GetSubsystem<UStaffSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::StaffCount, StaffSub->GetStaffCount());
+	}
+}
+
+void UMilestoneSubsystem::HandleDayChanged(int32 NewDay)
+{
+	SetStat(EMilestoneStat::Day, NewDay);
+
+	// OnRatingChanged skips moves under 0.05 stars, so a rating that settles just past a
+	// threshold is only seen here.
+	if (UZooRatingSubsystem* RatingSub = GetWorld() ? GetWorld()->GetSubsystem<UZooRatingSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::Rating, RatingSub->GetRating());
+	}
+}
+
+void UMilestoneSubsystem::HandleResearchCompleted(FName ResearchID)
+{
+	if (UResearchSubsystem* ResearchSub = GetWorld() ? GetWorld()->GetSubsystem<UResearchSubsystem>() : nullptr)
+	{
+		SetStat(EMilestoneStat::ResearchCompleted, ResearchSub->GetCompletedResearchCount());
+	}
+}
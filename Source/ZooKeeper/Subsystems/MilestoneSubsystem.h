@@ -2,24 +2,34 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Data/ZooDataTypes.h"
 #include "MilestoneSubsystem.generated.h"
 
+class AAnimalBase;
+class AEnclosureActor;
+class AZooBuildingActor;
+class UDataTable;
+
 /** Broadcast when a milestone is achieved for the first time. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMilestoneAchieved, FName, MilestoneID);
 
 /**
  * UMilestoneSubsystem
  *
- * World subsystem that tracks milestone achievements.
- * Checked on day change and key events.
+ * World subsystem that tracks milestone achievements. Milestones are loaded
+ * from a DataTable of FMilestoneDefinitionRow and compiled into conditions
+ * over a fixed set of zoo stats. The subsystem keeps a cached value of each
+ * stat, updated from the events of the subsystem that owns it, and a watch
+ * list per stat of the milestones still waiting on it. A change to one stat
+ * only tests the milestones that watch it, so milestones unlock on the event
+ * that completes them and there is no polling.
  *
- * Milestones:
+ * Without a DataTable the built-in milestones are used:
  *   FirstSteps     - Place your first enclosure and acquire your first animal.
  *   GrowingZoo     - Have 5+ animals of 3+ species.
  *   Popular        - Reach 20+ visitors.
  *   Paradise       - Achieve a 4.0+ zoo rating.
  *   FiveStars      - Achieve a 5.0 zoo rating.
- *   Breeding       - Successfully breed an animal.
  *   Tycoon         - Accumulate $50,000+ funds.
  */
 UCLASS(meta = (DisplayName = "Milestone Subsystem"))
@@ -34,7 +44,14 @@ public:
 	virtual void Deinitialize() override;
 	//~ End USubsystem Interface
 
-	/** Checks all milestones and awards any that are newly met. */
+	//~ Begin UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface
+
+	/**
+	 * Re-reads every stat from its subsystem and checks all unachieved milestones.
+	 * Only needed after state was changed without events, such as a loaded save.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Milestones")
 	void CheckMilestones();
 
@@ -46,6 +63,21 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Milestones")
 	TArray<FName> GetAchievedMilestones() const;
 
+	/** Returns the current value of a milestone stat. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Milestones")
+	float GetStatValue(EMilestoneStat Stat) const;
+
+	/** Marks milestones as achieved without broadcasting, e.g. when loading a save. */
+	void RestoreAchievedMilestones(const TArray<FName>& MilestoneIDs);
+
+	// -------------------------------------------------------------------
+	//  Data
+	// -------------------------------------------------------------------
+
+	/** DataTable of FMilestoneDefinitionRow. Falls back to the built-in milestones when unset. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Milestones")
+	TObjectPtr<UDataTable> MilestoneDataTable;
+
 	// -------------------------------------------------------------------
 	//  Delegates
 	// -------------------------------------------------------------------
@@ -54,12 +86,95 @@ public:
 	FOnMilestoneAchieved OnMilestoneAchieved;
 
 private:
-	/** Called when the day changes to check milestones. */
+	static constexpr int32 NumStats = static_cast<int32>(EMilestoneStat::Count);
+
+	/** One condition, resolved to a stat slot. */
+	struct FCompiledCondition
+	{
+		int32 StatIndex = 0;
+		EMilestoneComparison Comparison = EMilestoneComparison::AtLeast;
+		double Threshold = 0.0;
+
+		bool Test(double Value) const;
+	};
+
+	/** A milestone ready for evaluation: all conditions must hold. */
+	struct FCompiledMilestone
+	{
+		FName MilestoneID;
+		TArray<FCompiledCondition, TInlineAllocator<2>> Conditions;
+		bool bAchieved = false;
+	};
+
+	/** Loads and compiles the milestone definitions, then builds the watch lists. */
+	void LoadMilestoneDefinitions();
+
+	/** Compiles one definition. Rows without conditions are skipped. */
+	void CompileMilestone(const FMilestoneDefinitionRow& Row);
+
+	/** Stores a stat value and tests the milestones that watch it. */
+	void SetStat(EMilestoneStat Stat, double Value);
+
+	/** Reads every stat from its owning subsystem. */
+	void RefreshAllStats();
+
+	/** Tests the given milestones and awards those that are met. */
+	void EvaluateMilestones(TArrayView<const int32> Candidates);
+
+	bool AreConditionsMet(const FCompiledMilestone& Milestone) const;
+
+	/** Marks a milestone achieved and drops it from the watch lists. */
+	void MarkAchieved(int32 MilestoneIndex);
+
+	/** Awards a milestone if not already achieved. */
+	void AwardMilestone(int32 MilestoneIndex);
+
+	// --- Stat sources ---
+
+	UFUNCTION()
+	void HandleAnimalAdded(AAnimalBase* Animal);
+
+	UFUNCTION()
+	void HandleAnimalRemoved(AAnimalBase* Animal);
+
+	UFUNCTION()
+	void HandleEnclosureFormed(AEnclosureActor* Enclosure);
+
+	UFUNCTION()
+	void HandleBuildingDemolished(AZooBuildingActor* Building);
+
+	UFUNCTION()
+	void HandleVisitorCountChanged(int32 NewCount);
+
+	UFUNCTION()
+	void HandleFundsChanged(int32 NewBalance);
+
+	UFUNCTION()
+	void HandleRatingChanged(float NewRating);
+
+	UFUNCTION()
+	void HandleStaffChanged(int32 StaffID);
+
 	UFUNCTION()
 	void HandleDayChanged(int32 NewDay);
 
-	/** Awards a milestone if not already achieved. */
-	void AwardMilestone(FName MilestoneID);
+	UFUNCTION()
+	void HandleResearchCompleted(FName ResearchID);
+
+	/** Compiled milestones, indexed by the watch lists. */
+	TArray<FCompiledMilestone> Milestones;
+
+	/** Milestone index by ID. */
+	TMap<FName, int32> MilestoneIndices;
+
+	/** Per stat, the unachieved milestones with a condition on it. */
+	TArray<int32> Watchers[NumStats];
+
+	/** Last known value of each stat. */
+	double StatValues[NumStats] = {};
+
+	/** Animals per species, for SpeciesCount. */
+	TMap<FName, int32> SpeciesCounts;
 
 	/** Set of achieved milestone IDs. */
 	TSet<FName> AchievedMilestones;
@@ -18,32 +18,43 @@ void UResearchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	LoadResearchFromDataTable();
 
-	UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem::Initialize - %d research topics available."), AllResearchTopics.Num());
+	UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem::Initialize - %d research topics available."), Nodes.Num());
 }
 
 void UResearchSubsystem::LoadResearchFromDataTable()
 {
-	AllResearchTopics.Empty();
+	TArray<FResearchNodeData> Rows;
 
 	if (ResearchDataTable)
 	{
-		TArray<FResearchNodeData*> Rows;
-		ResearchDataTable->GetAllRows<FResearchNodeData>(TEXT("ResearchSubsystem"), Rows);
+		TArray<FResearchNodeData*> TableRows;
+		ResearchDataTable->GetAllRows<FResearchNodeData>(TEXT("ResearchSubsystem"), TableRows);
 
-		for (const FResearchNodeData* Row : Rows)
+		TSet<FName> SeenIDs;
+		for (const FResearchNodeData* Row : TableRows)
 		{
-			if (Row && !Row->ResearchID.IsNone())
+			if (!Row || Row->ResearchID.IsNone())
 			{
-				AllResearchTopics.Add(Row->ResearchID);
+				continue;
 			}
+
+			bool bAlreadySeen = false;
+			SeenIDs.Add(Row->ResearchID, &bAlreadySeen);
+			if (bAlreadySeen)
+			{
+				UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem - Duplicate research topic '%s' ignored."), *Row->ResearchID.ToString());
+				continue;
+			}
+
+			Rows.Add(*Row);
 		}
 
-		UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem - Loaded %d topics from DataTable."), AllResearchTopics.Num());
+		UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem - Loaded %d topics from DataTable."), Rows.Num());
 	}
 	else
 	{
 		// Fallback hardcoded list when no DataTable is assigned.
-		AllResearchTopics = {
+		const FName FallbackTopics[] = {
 			FName(TEXT("BetterFeed")),
 			FName(TEXT("VeterinaryMedicine")),
 			FName(TEXT("EnrichedEnclosures")),
@@ -56,16 +67,173 @@ void UResearchSubsystem::LoadResearchFromDataTable()
 			FName(TEXT("SustainableEnergy"))
 		};
 
-		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem - No DataTable assigned, using %d hardcoded topics."), AllResearchTopics.Num());
+		for (const FName& Topic : FallbackTopics)
+		{
+			FResearchNodeData& Row = Rows.AddDefaulted_GetRef();
+			Row.ResearchID = Topic;
+			Row.DisplayName = FText::FromName(Topic);
+			Row.ResearchDuration = 300.0f;
+		}
+
+		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem - No DataTable assigned, using %d hardcoded topics."), Rows.Num());
 	}
+
+	BuildResearchGraph(Rows);
+}
+
+void UResearchSubsystem::BuildResearchGraph(TArray<FResearchNodeData>& Rows)
+{
+	const int32 NumTopics = Rows.Num();
+
+	TMap<FName, int32> RowIndices;
+	RowIndices.Reserve(NumTopics);
+	for (int32 RowIndex = 0; RowIndex < NumTopics; ++RowIndex)
+	{
+		RowIndices.Add(Rows[RowIndex].ResearchID, RowIndex);
+	}
+
+	// Edges from each prerequisite to the rows that need it.
+	TArray<TArray<int32>> RowDependents;
+	RowDependents.SetNum(NumTopics);
+	TArray<int32> InDegree;
+	InDegree.SetNumZeroed(NumTopics);
+
+	for (int32 RowIndex = 0; RowIndex < NumTopics; ++RowIndex)
+	{
+		for (const FName& Prereq : Rows[RowIndex].Prerequisites)
+		{
+			const int32* PrereqIndex = RowIndices.Find(Prereq);
+			if (!PrereqIndex)
+			{
+				UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem - '%s' requires unknown topic '%s'; prerequisite ignored."),
+					*Rows[RowIndex].ResearchID.ToString(), *Prereq.ToString());
+				continue;
+			}
+
+			if (!RowDependents[*PrereqIndex].Contains(RowIndex))
+			{
+				RowDependents[*PrereqIndex].Add(RowIndex);
+				InDegree[RowIndex]++;
+			}
+		}
+	}
+
+	// Kahn's algorithm. Rows that never reach in-degree zero are in, or depend on, a cycle.
+	TArray<int32> Order;
+	Order.Reserve(NumTopics);
+	for (int32 RowIndex = 0; RowIndex < NumTopics; ++RowIndex)
+	{
+		if (InDegree[RowIndex] == 0)
+		{
+			Order.Add(RowIndex);
+		}
+	}
+
+	for (int32 Head = 0; Head < Order.Num(); ++Head)
+	{
+		for (const int32 Dependent : RowDependents[Order[Head]])
+		{
+			if (--InDegree[Dependent] == 0)
+			{
+				Order.Add(Dependent);
+			}
+		}
+	}
+
+	if (Order.Num() < NumTopics)
+	{
+		TArray<FString> Locked;
+		for (int32 RowIndex = 0; RowIndex < NumTopics; ++RowIndex)
+		{
+			if (InDegree[RowIndex] > 0)
+			{
+				Locked.Add(Rows[RowIndex].ResearchID.ToString());
+
+				// Kept at the end of the order; their prerequisites can never all complete.
+				Order.Add(RowIndex);
+			}
+		}
+
+		UE_LOG(LogZooKeeper, Error, TEXT("ResearchSubsystem - Prerequisite cycle found; these topics stay locked: %s"), *FString::Join(Locked, TEXT(", ")));
+	}
+
+	TArray<int32> RowToTopic;
+	RowToTopic.SetNumUninitialized(NumTopics);
+	for (int32 TopicIndex = 0; TopicIndex < NumTopics; ++TopicIndex)
+	{
+		RowToTopic[Order[TopicIndex]] = TopicIndex;
+	}
+
+	Nodes.Reset();
+	Nodes.SetNum(NumTopics);
+	TopicIndices.Reset();
+	TopicIndices.Reserve(NumTopics);
+
+	for (int32 TopicIndex = 0; TopicIndex < NumTopics; ++TopicIndex)
+	{
+		FResearchGraphNode& Node = Nodes[TopicIndex];
+		Node.Data = MoveTemp(Rows[Order[TopicIndex]]);
+		Node.Prerequisites.Init(false, NumTopics);
+		TopicIndices.Add(Node.Data.ResearchID, TopicIndex);
+	}
+
+	for (int32 RowIndex = 0; RowIndex < NumTopics; ++RowIndex)
+	{
+		const int32 PrereqTopic = RowToTopic[RowIndex];
+		for (const int32 DependentRow : RowDependents[RowIndex])
+		{
+			const int32 DependentTopic = RowToTopic[DependentRow];
+			Nodes[PrereqTopic].Dependents.Add(DependentTopic);
+			Nodes[DependentTopic].Prerequisites[PrereqTopic] = true;
+			Nodes[DependentTopic].RemainingPrerequisites++;
+		}
+	}
+
+	CompletedTopics.Init(false, NumTopics);
+	AvailableTopics.Init(false, NumTopics);
+	NumCompleted = 0;
+
+	for (int32 TopicIndex = 0; TopicIndex < NumTopics; ++TopicIndex)
+	{
+		AvailableTopics[TopicIndex] = Nodes[TopicIndex].RemainingPrerequisites == 0;
+	}
+}
+
+void UResearchSubsystem::CompleteTopic(int32 TopicIndex)
+{
+	if (!CompletedTopics.IsValidIndex(TopicIndex) || CompletedTopics[TopicIndex])
+	{
+		return;
+	}
+
+	CompletedTopics[TopicIndex] = true;
+	AvailableTopics[TopicIndex] = false;
+	NumCompleted++;
+
+	for (const int32 Dependent : Nodes[TopicIndex].Dependents)
+	{
+		if (--Nodes[Dependent].RemainingPrerequisites == 0 && !CompletedTopics[Dependent])
+		{
+			AvailableTopics[Dependent] = true;
+		}
+	}
+}
+
+int32 UResearchSubsystem::FindTopicIndex(FName ResearchID) const
+{
+	const int32* TopicIndex = TopicIndices.Find(ResearchID);
+	return TopicIndex ? *TopicIndex : INDEX_NONE;
 }
 
 void UResearchSubsystem::Deinitialize()
 {
-	UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem::Deinitialize - %d topics completed."), CompletedResearch.Num());
+	UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem::Deinitialize - %d topics completed."), NumCompleted);
 
-	CompletedResearch.Empty();
-	AllResearchTopics.Empty();
+	Nodes.Empty();
+	TopicIndices.Empty();
+	CompletedTopics.Empty();
+	AvailableTopics.Empty();
+	NumCompleted = 0;
 
 	Super::Deinitialize();
 }
@@ -85,33 +253,31 @@ void UResearchSubsystem::StartResearch(FName ResearchID)
 		return;
 	}
 
-	if (CompletedResearch.Contains(ResearchID))
+	const int32 TopicIndex = FindTopicIndex(ResearchID);
+	if (TopicIndex == INDEX_NONE)
 	{
-		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem::StartResearch - '%s' is already researched."),
+		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem::StartResearch - '%s' is not a valid research topic."),
 			*ResearchID.ToString());
 		return;
 	}
 
-	if (!AllResearchTopics.Contains(ResearchID))
+	if (CompletedTopics[TopicIndex])
 	{
-		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem::StartResearch - '%s' is not a valid research topic."),
+		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem::StartResearch - '%s' is already researched."),
 			*ResearchID.ToString());
 		return;
 	}
 
-	// Look up duration from DataTable if available.
-	float Duration = ResearchDuration;
-	if (ResearchDataTable)
+	if (!AvailableTopics[TopicIndex])
 	{
-		if (const FResearchNodeData* Row = ResearchDataTable->FindRow<FResearchNodeData>(ResearchID, TEXT("StartResearch")))
-		{
-			Duration = Row->ResearchDuration;
-		}
+		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchSubsystem::StartResearch - '%s' has unfinished prerequisites."),
+			*ResearchID.ToString());
+		return;
 	}
 
 	CurrentResearchID = ResearchID;
 	CurrentResearchProgress = 0.0f;
-	ResearchDuration = Duration;
+	ResearchDuration = Nodes[TopicIndex].Data.ResearchDuration;
 	bIsResearching = true;
 
 	OnResearchStarted.Broadcast(ResearchID);
@@ -133,7 +299,7 @@ void UResearchSubsystem::TickResearch(float DeltaTime)
 	{
 		// Research complete
 		const FName CompletedID = CurrentResearchID;
-		CompletedResearch.Add(CompletedID);
+		CompleteTopic(FindTopicIndex(CompletedID));
 
 		CurrentResearchID = NAME_None;
 		CurrentResearchProgress = 0.0f;
@@ -142,7 +308,7 @@ void UResearchSubsystem::TickResearch(float DeltaTime)
 		OnResearchCompleted.Broadcast(CompletedID);
 
 		UE_LOG(LogZooKeeper, Log, TEXT("ResearchSubsystem - Research completed: '%s'. Total completed: %d"),
-			*CompletedID.ToString(), CompletedResearch.Num());
+			*CompletedID.ToString(), NumCompleted);
 	}
 }
 
@@ -164,38 +330,29 @@ void UResearchSubsystem::CancelResearch()
 
 bool UResearchSubsystem::IsResearched(FName ResearchID) const
 {
-	return CompletedResearch.Contains(ResearchID);
+	const int32 TopicIndex = FindTopicIndex(ResearchID);
+	return TopicIndex != INDEX_NONE && CompletedTopics[TopicIndex];
+}
+
+int32 UResearchSubsystem::GetCompletedResearchCount() const
+{
+	return NumCompleted;
+}
+
+bool UResearchSubsystem::IsResearchAvailable(FName ResearchID) const
+{
+	const int32 TopicIndex = FindTopicIndex(ResearchID);
+	return TopicIndex != INDEX_NONE && AvailableTopics[TopicIndex] && ResearchID != CurrentResearchID;
 }
 
 TArray<FName> UResearchSubsystem::GetAvailableResearch() const
 {
 	TArray<FName> Available;
 
-	for (const FName& Topic : AllResearchTopics)
+	for (TConstSetBitIterator<> It(AvailableTopics); It; ++It)
 	{
-		if (CompletedResearch.Contains(Topic) || Topic == CurrentResearchID)
-		{
-			continue;
-		}
-
-		// Check prerequisites from DataTable
-		bool bPrerequisitesMet = true;
-		if (ResearchDataTable)
-		{
-			if (const FResearchNodeData* Row = ResearchDataTable->FindRow<FResearchNodeData>(Topic, TEXT("GetAvailableResearch")))
-			{
-				for (const FName& Prereq : Row->Prerequisites)
-				{
-					if (!CompletedResearch.Contains(Prereq))
-					{
-						bPrerequisitesMet = false;
-						break;
-					}
-				}
-			}
-		}
-
-		if (bPrerequisitesMet)
+		const FName& Topic = Nodes[It.GetIndex()].Data.ResearchID;
+		if (Topic != CurrentResearchID)
 		{
 			Available.Add(Topic);
 		}
@@ -204,6 +361,28 @@ TArray<FName> UResearchSubsystem::GetAvailableResearch() const
 	return Available;
 }
 
+TArray<FName> UResearchSubsystem::GetAllResearchTopics() const
+{
+	TArray<FName> Topics;
+	Topics.Reserve(Nodes.Num());
+	for (const FResearchGraphNode& Node : Nodes)
+	{
+		Topics.Add(Node.Data.ResearchID);
+	}
+	return Topics;
+}
+
+int32 UResearchSubsystem::GetNumResearchTopics() const
+{
+	return Nodes.Num();
+}
+
+const FResearchNodeData* UResearchSubsystem::GetResearchNode(FName ResearchID) const
+{
+	const int32 TopicIndex = FindTopicIndex(ResearchID);
+	return TopicIndex != INDEX_NONE ? &Nodes[TopicIndex].Data : nullptr;
+}
+
 FName UResearchSubsystem::GetCurrentResearchID() const
 {
 	return CurrentResearchID;
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Engine/DataTable.h"
+#include "Data/ZooDataTypes.h"
 #include "ResearchSubsystem.generated.h"
 
 /** Broadcast when a research project completes. */
@@ -16,6 +17,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnResearchStarted, FName, ResearchI
  *
  * World subsystem that manages the zoo's research tree. Tracks completed research,
  * the currently active research project, and progress toward completion.
+ *
+ * At load the research data is compiled into a DAG. Topics get dense indices
+ * in topological order, so prerequisites always come before the topics that
+ * need them, and a cycle is reported and its topics left locked. Completed
+ * and available topics are bit arrays over those indices. Each topic counts
+ * its unfinished prerequisites, and finishing a topic only updates its direct
+ * dependents, so availability never needs a full rescan.
  */
 UCLASS(meta = (DisplayName = "Research Subsystem"))
 class ZOOKEEPER_API UResearchSubsystem : public UWorldSubsystem
@@ -61,10 +69,29 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
 	bool IsResearched(FName ResearchID) const;
 
+	/** Returns the number of completed research topics. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
+	int32 GetCompletedResearchCount() const;
+
+	/** Returns true if the topic's prerequisites are complete and it is neither completed nor in progress. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
+	bool IsResearchAvailable(FName ResearchID) const;
+
 	/** Returns a list of all available (not yet completed and not in progress) research topics. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
 	TArray<FName> GetAvailableResearch() const;
 
+	/** Returns every research topic, prerequisites before the topics that need them. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
+	TArray<FName> GetAllResearchTopics() const;
+
+	/** Returns the number of research topics. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
+	int32 GetNumResearchTopics() const;
+
+	/** Returns the data of a research topic, or nullptr if it is unknown. */
+	const FResearchNodeData* GetResearchNode(FName ResearchID) const;
+
 	/** Returns the ID of the research currently in progress, or NAME_None if idle. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Research")
 	FName GetCurrentResearchID() const;
@@ -88,8 +115,35 @@ public:
 	TObjectPtr<UDataTable> ResearchDataTable;
 
 private:
-	/** Set of all completed research IDs. */
-	TSet<FName> CompletedResearch;
+	/** A research topic compiled into the prerequisite graph. */
+	struct FResearchGraphNode
+	{
+		/** Row data; synthesized for the hardcoded fallback topics. */
+		FResearchNodeData Data;
+
+		/** Prerequisites of this topic, as a bit per topic index. */
+		TBitArray<> Prerequisites;
+
+		/** Topics that list this one as a prerequisite. */
+		TArray<int32> Dependents;
+
+		/** Prerequisites not yet completed. */
+		int32 RemainingPrerequisites = 0;
+	};
+
+	/** Topics in topological order; a topic's index is its position here. */
+	TArray<FResearchGraphNode> Nodes;
+
+	/** Topic index by research ID. */
+	TMap<FName, int32> TopicIndices;
+
+	/** Completed topics, by index. */
+	TBitArray<> CompletedTopics;
+
+	/** Topics whose prerequisites are all complete and that are not completed themselves. */
+	TBitArray<> AvailableTopics;
+
+	int32 NumCompleted = 0;
 
 	/** The research currently being worked on (NAME_None if idle). */
 	FName CurrentResearchID;
@@ -103,9 +157,15 @@ private:
 	/** Whether research is currently active. */
 	bool bIsResearching;
 
-	/** Cached list of all research IDs loaded from DataTable. */
-	TArray<FName> AllResearchTopics;
-
 	/** Loads all research topics from the DataTable (or falls back to hardcoded list). */
 	void LoadResearchFromDataTable();
+
+	/** Compiles the loaded rows into the prerequisite graph. Rows are reordered topologically. */
+	void BuildResearchGraph(TArray<FResearchNodeData>& Rows);
+
+	/** Marks a topic completed and unlocks the dependents whose last prerequisite it was. */
+	void CompleteTopic(int32 TopicIndex);
+
+	/** Returns the index of a topic, or INDEX_NONE. */
+	int32 FindTopicIndex(FName ResearchID) const;
 };
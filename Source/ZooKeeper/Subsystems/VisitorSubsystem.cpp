@@ -1,9 +1,45 @@
 #include "VisitorSubsystem.h"
 #include "ZooRatingSubsystem.h"
+#include "TimeSubsystem.h"
+#include "WeatherSubsystem.h"
 #include "Visitors/VisitorCharacter.h"
+#include "Data/ZooDataTypes.h"
+#include "Engine/DataTable.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "ZooKeeper.h"
 
+DECLARE_CYCLE_STAT(TEXT("Visitor Needs"), STAT_ZooVisitorNeeds, STATGROUP_ZooKeeper);
+
+static TAutoConsoleVariable<bool> CVarCrowdAutoExportDaily(
+	TEXT("zoo.Crowd.AutoExportDaily"),
+	false,
+	TEXT("When true, the crowd heatmap (daily peaks) is exported as PNG and CSV at the end of every game day."));
+
+static FAutoConsoleCommandWithWorldAndArgs CrowdExportHeatmapCommand(
+	TEXT("zoo.Crowd.ExportHeatmap"),
+	TEXT("Exports the visitor crowd heatmap to Saved/Heatmaps. Usage: zoo.Crowd.ExportHeatmap [png|csv] [ema|peak]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UVisitorSubsystem* VisitorSys = World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+		if (!VisitorSys)
+		{
+			UE_LOG(LogZooKeeper, Warning, TEXT("zoo.Crowd.ExportHeatmap - No visitor subsystem in this world."));
+			return;
+		}
+
+		const ECrowdHeatmapFormat Format = (Args.Num() > 0 && Args[0].Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+			? ECrowdHeatmapFormat::Csv : ECrowdHeatmapFormat::Png;
+		const bool bPeak = !(Args.Num() > 1 && Args[1].Equals(TEXT("ema"), ESearchCase::IgnoreCase));
+		VisitorSys->ExportCrowdHeatmap(Format, bPeak);
+	}));
+
 bool UVisitorSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 {
 	return true;
@@ -17,17 +53,70 @@ void UVisitorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	CurrentVisitorCount = 0;
 	AverageSatisfaction = 50.0f;
 
-	// Find all actors tagged as visitor spawn points.
-	if (UWorld* World = GetWorld())
+	DefaultPOIServers = 1;
+	DefaultPOIServiceRate = 0.2f;
+	DefaultPOIQueueCapacity = 8;
+	QueueWaitSatisfactionPenalty = 0.002f;
+
+	NeedsUpdateRate = 4.0f;
+	StartingSatisfaction = 0.5f;
+	HungerDecayRate = 0.0017f;
+	EnergyDecayRate = 0.0012f;
+	FunDecayRate = 0.002f;
+	NeedRestoreRate = 0.05f;
+	PassiveSatisfactionDecay = 0.001f;
+	LowNeedThreshold = 0.25f;
+	LowNeedSatisfactionPenalty = 0.002f;
+	Needs = FVisitorNeedsStore();
+	SatisfactionSum = 0.0;
+	LastBroadcastSatisfaction = AverageSatisfaction;
+	NeedsAccumulator = 0.0f;
+	StepsSinceSatisfactionResync = 0;
+
+	CrowdGridOrigin = FVector2D(-16000.0f, -16000.0f);
+	CrowdGridSize = FIntPoint(64, 64);
+	CrowdCellSize = 500.0f;
+	CrowdSampleInterval = 0.5f;
+	CrowdSmoothing = 0.2f;
+	CrowdComfortCapacity = 12.0f;
+	CrowdingSatisfactionPenalty = 0.004f;
+	CrowdSampleAccumulator = 0.0f;
+	EnsureCrowdGrid();
+
+	VisitorTypeDataTable = nullptr;
+	DefaultMinGroupSize = 1;
+	DefaultMaxGroupSize = 4;
+
+	bEnableArrivalScheduler = true;
+	PeakArrivalsPerHour = 30.0f;
+	OpeningHour = 8.0f;
+	ClosingHour = 18.0f;
+	PeakArrivalHour = 12.5f;
+	MaxSpawnsPerFrame = 2;
+	SpawnBudgetMs = 2.0f;
+	TotalArrivals = 0;
+	TurnedAwayArrivals = 0;
+
+	WeatherArrivalMultipliers.Add(EWeatherState::Clear, 1.0f);
+	WeatherArrivalMultipliers.Add(EWeatherState::Cloudy, 0.9f);
+	WeatherArrivalMultipliers.Add(EWeatherState::Rain, 0.5f);
+	WeatherArrivalMultipliers.Add(EWeatherState::Storm, 0.15f);
+	WeatherArrivalMultipliers.Add(EWeatherState::Snow, 0.4f);
+	WeatherArrivalMultipliers.Add(EWeatherState::Fog, 0.7f);
+
+	PendingSpawns.Reset();
+	Groups.Reset();
+	NextGroupID = 0;
+	ArrivalHazard = 0.0f;
+	NextArrivalThreshold = SampleUnitExponential();
+
+	LoadVisitorTypes();
+	RefreshSpawnPoints();
+
+	// Crowd peaks are tracked per game day.
+	if (UTimeSubsystem* TimeSys = Collection.InitializeDependency<UTimeSubsystem>())
 	{
-		TArray<AActor*> FoundActors;
-		UGameplayStatics::GetAllActorsWithTag(World, FName(TEXT("VisitorSpawn")), FoundActors);
-		SpawnPoints.Empty(FoundActors.Num());
-		for (AActor* Actor : FoundActors)
-		{
-			SpawnPoints.Add(Actor);
-		}
-		UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem::Initialize - Found %d visitor spawn points."), SpawnPoints.Num());
+		TimeSys->OnDayChanged.AddDynamic(this, &UVisitorSubsystem::HandleDayChanged);
 	}
 
 	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem::Initialize - MaxVisitors: %d"), MaxVisitors);
@@ -38,10 +127,122 @@ void UVisitorSubsystem::Deinitialize()
 	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem::Deinitialize - %d visitors at shutdown."), CurrentVisitorCount);
 
 	AllVisitorCharacters.Empty();
+	POIQueues.Empty();
+	PendingSpawns.Empty();
+	Groups.Empty();
+	Needs = FVisitorNeedsStore();
+	SatisfactionSum = 0.0;
+	CrowdCounts.Empty();
+	CrowdDensity.Empty();
+	CrowdPeakDensity.Empty();
 
 	Super::Deinitialize();
 }
 
+void UVisitorSubsystem::Tick(float DeltaTime)
+{
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	ScheduleArrivals(DeltaTime);
+	DrainSpawnQueue();
+
+	// Needs advance in fixed steps so their rates are independent of the frame rate.
+	const float NeedsStep = 1.0f / FMath::Max(NeedsUpdateRate, 1.0f);
+	NeedsAccumulator += DeltaTime;
+	int32 NumSteps = 0;
+	while (NeedsAccumulator >= NeedsStep && NumSteps < MaxNeedsStepsPerFrame)
+	{
+		NeedsAccumulator -= NeedsStep;
+		StepNeeds(NeedsStep);
+		NumSteps++;
+	}
+	if (NumSteps == MaxNeedsStepsPerFrame)
+	{
+		NeedsAccumulator = FMath::Min(NeedsAccumulator, NeedsStep);
+	}
+
+	CrowdSampleAccumulator += DeltaTime;
+	if (CrowdSampleAccumulator >= CrowdSampleInterval)
+	{
+		CrowdSampleAccumulator = FMath::Fmod(CrowdSampleAccumulator, CrowdSampleInterval);
+		SampleCrowdDensity();
+	}
+
+	// Broadcast after the walk, since listeners may join queues or register points of interest.
+	TArray<TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AVisitorCharacter>>, TInlineAllocator<16>> Served;
+
+	for (auto It = POIQueues.CreateIterator(); It; ++It)
+	{
+		AActor* PointOfInterest = It.Key().Get();
+		if (!PointOfInterest)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		FPOIQueue& Queue = It.Value();
+
+		// Advance service; completed visitors free their server.
+		for (int32 i = Queue.InService.Num() - 1; i >= 0; --i)
+		{
+			AVisitorCharacter* Visitor = Queue.InService[i].Get();
+			if (!Visitor)
+			{
+				Queue.InService.RemoveAtSwap(i);
+				Queue.ServiceTimeRemaining.RemoveAtSwap(i);
+				continue;
+			}
+
+			Queue.ServiceTimeRemaining[i] -= DeltaTime;
+			if (Queue.ServiceTimeRemaining[i] <= 0.0f)
+			{
+				Queue.InService.RemoveAtSwap(i);
+				Queue.ServiceTimeRemaining.RemoveAtSwap(i);
+				Queue.TotalServed++;
+				Served.Emplace(PointOfInterest, Visitor);
+			}
+		}
+
+		AdmitFromQueue(Queue);
+
+		// Waiting in line is tedious.
+		if (QueueWaitSatisfactionPenalty > 0.0f)
+		{
+			const float Penalty = QueueWaitSatisfactionPenalty * DeltaTime;
+			for (int32 i = 0; i < Queue.Count; ++i)
+			{
+				if (AVisitorCharacter* Waiting = Queue.SlotAt(i).Get())
+				{
+					Waiting->UpdateSatisfaction(-Penalty);
+				}
+			}
+		}
+
+		// Update the smoothed arrival rate once per sample window.
+		Queue.WindowElapsed += DeltaTime;
+		if (Queue.WindowElapsed >= ArrivalSampleWindow)
+		{
+			const float Sample = static_cast<float>(Queue.WindowArrivals) / Queue.WindowElapsed;
+			Queue.ArrivalRate = FMath::Lerp(Queue.ArrivalRate, Sample, ArrivalRateSmoothing);
+			Queue.WindowArrivals = 0;
+			Queue.WindowElapsed = 0.0f;
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AVisitorCharacter>>& Entry : Served)
+	{
+		AActor* PointOfInterest = Entry.Key.Get();
+		AVisitorCharacter* Visitor = Entry.Value.Get();
+		if (PointOfInterest && Visitor)
+		{
+			OnVisitorServed.Broadcast(PointOfInterest, Visitor);
+		}
+	}
+}
+
 void UVisitorSubsystem::RegisterVisitor(AVisitorCharacter* Visitor)
 {
 	if (!Visitor)
@@ -57,6 +258,8 @@ void UVisitorSubsystem::RegisterVisitor(AVisitorCharacter* Visitor)
 	}
 
 	AllVisitorCharacters.Add(Visitor);
+	AddNeedsRow(Visitor);
+	AddToGroup(Visitor);
 	CurrentVisitorCount = AllVisitorCharacters.Num();
 	OnVisitorCountChanged.Broadcast(CurrentVisitorCount);
 
@@ -74,6 +277,17 @@ void UVisitorSubsystem::UnregisterVisitor(AVisitorCharacter* Visitor)
 	const int32 Removed = AllVisitorCharacters.Remove(Visitor);
 	if (Removed > 0)
 	{
+		RemoveFromGroup(Visitor);
+		RemoveNeedsRow(Visitor);
+
+		for (auto& Pair : POIQueues)
+		{
+			if (AActor* PointOfInterest = Pair.Key.Get())
+			{
+				LeaveQueue(PointOfInterest, Visitor);
+			}
+		}
+
 		CurrentVisitorCount = AllVisitorCharacters.Num();
 		OnVisitorCountChanged.Broadcast(CurrentVisitorCount);
 
@@ -88,7 +302,7 @@ void UVisitorSubsystem::SpawnVisitors(int32 Count)
 		return;
 	}
 
-	const int32 AvailableSlots = MaxVisitors - CurrentVisitorCount;
+	const int32 AvailableSlots = MaxVisitors - CurrentVisitorCount - PendingSpawns.Num();
 	const int32 ActualSpawn = FMath::Min(Count, AvailableSlots);
 
 	if (ActualSpawn <= 0)
@@ -98,8 +312,7 @@ void UVisitorSubsystem::SpawnVisitors(int32 Count)
 		return;
 	}
 
-	UWorld* World = GetWorld();
-	if (!World || !VisitorCharacterClass)
+	if (!GetWorld() || !VisitorCharacterClass)
 	{
 		// Fallback: just increment counter if no class assigned.
 		CurrentVisitorCount += ActualSpawn;
@@ -108,124 +321,1381 @@ void UVisitorSubsystem::SpawnVisitors(int32 Count)
 		return;
 	}
 
-	int32 Spawned = 0;
-	for (int32 i = 0; i < ActualSpawn; ++i)
+	// Split the request into groups drawn from the visitor type table.
+	int32 Remaining = ActualSpawn;
+	while (Remaining > 0)
+	{
+		const int32 TypeIndex = PickVisitorType();
+		const int32 GroupSize = FMath::Min(PickGroupSize(TypeIndex), Remaining);
+		const int32 Queued = QueueGroupArrival(GroupSize, TypeIndex);
+		if (Queued == 0)
+		{
+			break;
+		}
+		Remaining -= Queued;
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Queued %d visitor spawns. Pending: %d"),
+		ActualSpawn - Remaining, PendingSpawns.Num());
+}
+
+void UVisitorSubsystem::RefreshSpawnPoints()
+{
+	SpawnPoints.Reset();
+	SpawnTransforms.Reset();
+	NextSpawnPointIndex = 0;
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	LastSpawnPointScanTime = World->GetTimeSeconds();
+
+	TArray<AActor*> FoundActors;
+	UGameplayStatics::GetAllActorsWithTag(World, FName(TEXT("VisitorSpawn")), FoundActors);
+	for (AActor* Actor : FoundActors)
+	{
+		SpawnPoints.Add(Actor);
+		SpawnTransforms.Add(Actor->GetActorTransform());
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem::RefreshSpawnPoints - Cached %d visitor spawn points."), SpawnPoints.Num());
+}
+
+float UVisitorSubsystem::GetArrivalRate() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return 0.0f;
+	}
+
+	const UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>();
+	const float Hour = TimeSys ? TimeSys->CurrentTimeOfDay : PeakArrivalHour;
+
+	float Rate = PeakArrivalsPerHour * GetDaypartFactor(Hour);
+	if (Rate <= 0.0f)
 	{
-		FVector SpawnLocation = FVector::ZeroVector;
-		FRotator SpawnRotation = FRotator::ZeroRotator;
+		return 0.0f;
+	}
 
-		// Pick a random spawn point if available.
-		if (SpawnPoints.Num() > 0)
+	if (const UWeatherSubsystem* WeatherSys = World->GetSubsystem<UWeatherSubsystem>())
+	{
+		if (const float* WeatherMultiplier = WeatherArrivalMultipliers.Find(WeatherSys->CurrentWeather))
 		{
-			AActor* SpawnPoint = SpawnPoints[FMath::RandRange(0, SpawnPoints.Num() - 1)];
-			if (SpawnPoint)
-			{
-				SpawnLocation = SpawnPoint->GetActorLocation();
-				SpawnRotation = SpawnPoint->GetActorRotation();
-			}
+			Rate *= *WeatherMultiplier;
 		}
+	}
+
+	if (const UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+	{
+		Rate *= RatingSub->GetVisitorSpawnMultiplier();
+	}
+
+	return FMath::Max(0.0f, Rate);
+}
 
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+float UVisitorSubsystem::GetExpectedDailyArrivals() const
+{
+	const UWorld* World = GetWorld();
+	if (!World || !bEnableArrivalScheduler || !VisitorCharacterClass)
+	{
+		return 0.0f;
+	}
+
+	// Midpoint rule over quarter hours; the bell curve is smooth enough for this to be exact in practice.
+	constexpr int32 StepsPerDay = 96;
+	constexpr float StepHours = 24.0f / StepsPerDay;
+	float DaypartHours = 0.0f;
+	for (int32 Step = 0; Step < StepsPerDay; ++Step)
+	{
+		DaypartHours += GetDaypartFactor((Step + 0.5f) * StepHours) * StepHours;
+	}
 
-		AVisitorCharacter* NewVisitor = World->SpawnActor<AVisitorCharacter>(
-			VisitorCharacterClass, SpawnLocation, SpawnRotation, SpawnParams);
+	float Arrivals = PeakArrivalsPerHour * DaypartHours;
 
-		if (NewVisitor)
+	if (const UWeatherSubsystem* WeatherSys = World->GetSubsystem<UWeatherSubsystem>())
+	{
+		if (const float* WeatherMultiplier = WeatherArrivalMultipliers.Find(WeatherSys->CurrentWeather))
 		{
-			Spawned++;
+			Arrivals *= *WeatherMultiplier;
 		}
 	}
 
-	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Spawned %d/%d visitor actors. Total: %d"),
-		Spawned, ActualSpawn, CurrentVisitorCount);
+	if (const UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+	{
+		Arrivals *= RatingSub->GetVisitorSpawnMultiplier();
+	}
+
+	return FMath::Max(0.0f, Arrivals);
 }
 
-void UVisitorSubsystem::DespawnAllVisitors()
+float UVisitorSubsystem::GetAverageAdmission() const
 {
-	if (AllVisitorCharacters.Num() == 0 && CurrentVisitorCount == 0)
+	if (VisitorTypes.Num() > 0)
+	{
+		return AverageAdmission;
+	}
+
+	// Without visitor types, every visitor pays the character's default fee.
+	const AVisitorCharacter* DefaultVisitor = VisitorCharacterClass ? VisitorCharacterClass->GetDefaultObject<AVisitorCharacter>() : nullptr;
+	return DefaultVisitor ? static_cast<float>(DefaultVisitor->AdmissionFee) : 0.0f;
+}
+
+float UVisitorSubsystem::GetDaypartFactor(float Hour) const
+{
+	if (Hour < OpeningHour || Hour >= ClosingHour || ClosingHour <= OpeningHour)
+	{
+		return 0.0f;
+	}
+
+	// Bell curve around the peak hour, spanning the opening hours.
+	const float Spread = (ClosingHour - OpeningHour) * 0.25f;
+	const float Offset = (Hour - PeakArrivalHour) / Spread;
+	return FMath::Exp(-0.5f * Offset * Offset);
+}
+
+float UVisitorSubsystem::SampleUnitExponential()
+{
+	return -FMath::Loge(FMath::Max(FMath::FRand(), KINDA_SMALL_NUMBER));
+}
+
+void UVisitorSubsystem::ScheduleArrivals(float DeltaTime)
+{
+	if (!bEnableArrivalScheduler || !VisitorCharacterClass)
 	{
 		return;
 	}
 
-	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Despawning all %d visitors."), AllVisitorCharacters.Num());
+	const UWorld* World = GetWorld();
+	const UTimeSubsystem* TimeSys = World ? World->GetSubsystem<UTimeSubsystem>() : nullptr;
+	if (!TimeSys || TimeSys->bIsPaused)
+	{
+		return;
+	}
 
-	// Destroy all visitor actors. Copy the array since Destroy triggers EndPlay -> UnregisterVisitor.
-	TArray<TObjectPtr<AVisitorCharacter>> VisitorsCopy = AllVisitorCharacters;
-	for (AVisitorCharacter* Visitor : VisitorsCopy)
+	if (LoadedVisitorTypeTable.Get() != VisitorTypeDataTable)
+	{
+		LoadVisitorTypes();
+	}
+
+	// Time-change method: integrate the rate over game time and emit an arrival each time
+	// the integral passes a unit exponential threshold. Exact for a piecewise-constant rate.
+	// Each arrival is a whole group, so the visitor rate is divided by the mean group size.
+	const float GameHoursElapsed = DeltaTime * TimeSys->GameTimeScale / 3600.0f;
+	ArrivalHazard += GetArrivalRate() / FMath::Max(AverageGroupSize, 1.0f) * GameHoursElapsed;
+
+	while (ArrivalHazard >= NextArrivalThreshold)
 	{
-		if (Visitor)
+		ArrivalHazard -= NextArrivalThreshold;
+		NextArrivalThreshold = SampleUnitExponential();
+
+		const int32 TypeIndex = PickVisitorType();
+		const int32 GroupSize = PickGroupSize(TypeIndex);
+		TotalArrivals += GroupSize;
+
+		if (QueueGroupArrival(GroupSize, TypeIndex) == 0)
 		{
-			Visitor->Destroy();
+			TurnedAwayArrivals += GroupSize;
+			UE_LOG(LogZooKeeper, Verbose, TEXT("VisitorSubsystem - Turned away a group of %d at capacity (%d/%d)."),
+				GroupSize, CurrentVisitorCount, MaxVisitors);
 		}
 	}
+}
 
-	AllVisitorCharacters.Empty();
-	CurrentVisitorCount = 0;
-	OnVisitorCountChanged.Broadcast(CurrentVisitorCount);
+int32 UVisitorSubsystem::QueueGroupArrival(int32 GroupSize, int32 VisitorTypeIndex)
+{
+	const int32 AvailableSlots = MaxVisitors - CurrentVisitorCount - PendingSpawns.Num();
+	if (GroupSize <= 0 || GroupSize > AvailableSlots)
+	{
+		return 0;
+	}
+
+	const int32 GroupID = NextGroupID++;
+	Groups.Add(GroupID);
+
+	for (int32 Slot = 0; Slot < GroupSize; ++Slot)
+	{
+		FPendingVisitorSpawn& Pending = PendingSpawns.AddDefaulted_GetRef();
+		Pending.GroupID = GroupID;
+		Pending.VisitorTypeIndex = VisitorTypeIndex;
+		Pending.MemberSlot = Slot;
+	}
+
+	return GroupSize;
 }
 
-int32 UVisitorSubsystem::CalculateVisitorAttraction() const
+void UVisitorSubsystem::DrainSpawnQueue()
 {
-	const float SatisfactionFactor = AverageSatisfaction / 100.0f; // 0-1
-	const int32 BaseAttraction = 10;
+	if (PendingSpawns.Num() == 0)
+	{
+		return;
+	}
 
-	// Use zoo rating to boost attraction if ZooRatingSubsystem is available
-	float RatingMultiplier = 1.0f;
-	if (const UWorld* World = GetWorld())
+	if (!VisitorCharacterClass)
 	{
-		if (const UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+		PendingSpawns.Reset();
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = SpawnBudgetMs / 1000.0;
+
+	int32 Processed = 0;
+	int32 Spawned = 0;
+	TArray<int32, TInlineAllocator<4>> FailedGroups;
+	while (Processed < PendingSpawns.Num() && Processed < MaxSpawnsPerFrame)
+	{
+		if (Processed > 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
 		{
-			RatingMultiplier = RatingSub->GetVisitorSpawnMultiplier();
+			break;
+		}
+
+		if (SpawnVisitorActor(PendingSpawns[Processed]))
+		{
+			Spawned++;
+		}
+		else
+		{
+			FailedGroups.AddUnique(PendingSpawns[Processed].GroupID);
 		}
+		Processed++;
 	}
 
-	const int32 AttractionScore = FMath::FloorToInt(BaseAttraction * SatisfactionFactor * RatingMultiplier);
-	return FMath::Max(1, AttractionScore);
+	PendingSpawns.RemoveAt(0, Processed, EAllowShrinking::No);
+
+	// A group whose members all failed to spawn would otherwise linger.
+	for (const int32 GroupID : FailedGroups)
+	{
+		const FVisitorGroup* Group = Groups.Find(GroupID);
+		const bool bStillPending = PendingSpawns.ContainsByPredicate(
+			[GroupID](const FPendingVisitorSpawn& Pending) { return Pending.GroupID == GroupID; });
+		if (Group && Group->Members.Num() == 0 && !bStillPending)
+		{
+			Groups.Remove(GroupID);
+		}
+	}
+
+	if (Spawned > 0)
+	{
+		UE_LOG(LogZooKeeper, Verbose, TEXT("VisitorSubsystem - Spawned %d visitors this frame. Pending: %d, Total: %d"),
+			Spawned, PendingSpawns.Num(), CurrentVisitorCount);
+	}
 }
 
-void UVisitorSubsystem::UpdateSatisfaction()
+AVisitorCharacter* UVisitorSubsystem::SpawnVisitorActor(const FPendingVisitorSpawn& Pending)
 {
-	// Satisfaction is influenced by multiple factors:
-	// - Animal variety and happiness
-	// - Cleanliness
-	// - Available facilities (food, restrooms)
-	// - Crowding (visitor count vs capacity)
-	// For now, compute a simple crowding-based satisfaction.
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Rescan if a cached spawn point was destroyed, or (occasionally) if none were found yet.
+	const bool bStalePoint = SpawnPoints.IsValidIndex(NextSpawnPointIndex) && !IsValid(SpawnPoints[NextSpawnPointIndex]);
+	const bool bRetryEmpty = SpawnTransforms.Num() == 0 && World->GetTimeSeconds() - LastSpawnPointScanTime >= SpawnPointRescanInterval;
+	if (bStalePoint || bRetryEmpty)
+	{
+		RefreshSpawnPoints();
+	}
+
+	// Members of a group share their leader's spawn point.
+	FTransform SpawnTransform = FTransform::Identity;
+	if (SpawnTransforms.Num() > 0)
+	{
+		SpawnTransform = SpawnTransforms[NextSpawnPointIndex];
+		if (Pending.MemberSlot == 0)
+		{
+			NextSpawnPointIndex = (NextSpawnPointIndex + 1) % SpawnTransforms.Num();
+		}
+		else
+		{
+			const int32 LeaderPointIndex = (NextSpawnPointIndex + SpawnTransforms.Num() - 1) % SpawnTransforms.Num();
+			SpawnTransform = SpawnTransforms[LeaderPointIndex];
+		}
+	}
 
-	const float OldSatisfaction = AverageSatisfaction;
+	const FVector FormationOffset = GetFormationOffset(Pending.MemberSlot);
+	SpawnTransform.AddToTranslation(SpawnTransform.GetRotation().RotateVector(FormationOffset));
 
-	if (CurrentVisitorCount == 0)
+	AVisitorCharacter* NewVisitor = World->SpawnActorDeferred<AVisitorCharacter>(
+		VisitorCharacterClass, SpawnTransform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!NewVisitor)
 	{
-		// No visitors, keep neutral
-		AverageSatisfaction = 50.0f;
+		return nullptr;
 	}
-	else
+
+	NewVisitor->GroupID = Pending.GroupID;
+	NewVisitor->FormationOffset = FormationOffset;
+
+	if (VisitorTypes.IsValidIndex(Pending.VisitorTypeIndex))
 	{
-		const float CrowdingRatio = static_cast<float>(CurrentVisitorCount) / static_cast<float>(MaxVisitors);
-		// Satisfaction decreases as crowding increases beyond 70% capacity
-		float CrowdingPenalty = 0.0f;
-		if (CrowdingRatio > 0.7f)
+		const FVisitorTypeRow& Type = VisitorTypes[Pending.VisitorTypeIndex];
+		NewVisitor->VisitorTypeID = VisitorTypeNames[Pending.VisitorTypeIndex];
+		NewVisitor->AdmissionFee = Type.Admission;
+		NewVisitor->MaxTimeInZoo = Type.StayDuration;
+
+		// Followers walk slightly faster so they can catch up with the leader.
+		if (UCharacterMovementComponent* Movement = NewVisitor->GetCharacterMovement())
+		{
+			Movement->MaxWalkSpeed = Pending.MemberSlot == 0 ? Type.WalkSpeed : Type.WalkSpeed * FollowerSpeedMultiplier;
+		}
+	}
+
+	NewVisitor->FinishSpawning(SpawnTransform);
+	return NewVisitor;
+}
+
+// -------------------------------------------------------------------
+//  Visitor Types
+// -------------------------------------------------------------------
+
+void UVisitorSubsystem::LoadVisitorTypes()
+{
+	VisitorTypes.Reset();
+	VisitorTypeNames.Reset();
+	VisitorTypeCumulativeWeights.Reset();
+	LoadedVisitorTypeTable = VisitorTypeDataTable;
+
+	float TotalWeight = 0.0f;
+	float WeightedGroupSize = 0.0f;
+	float WeightedAdmission = 0.0f;
+
+	const UScriptStruct* RowStruct = VisitorTypeDataTable ? VisitorTypeDataTable->GetRowStruct() : nullptr;
+	if (VisitorTypeDataTable && (!RowStruct || !RowStruct->IsChildOf(FVisitorTypeRow::StaticStruct())))
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("VisitorSubsystem::LoadVisitorTypes - Table '%s' does not use FVisitorTypeRow."),
+			*VisitorTypeDataTable->GetName());
+	}
+	else if (VisitorTypeDataTable)
+	{
+		for (const auto& RowPair : VisitorTypeDataTable->GetRowMap())
 		{
-			CrowdingPenalty = (CrowdingRatio - 0.7f) * 100.0f; // up to 30 penalty at full capacity
+			const FVisitorTypeRow* Row = reinterpret_cast<const FVisitorTypeRow*>(RowPair.Value);
+			if (!Row || Row->SpawnWeight <= 0.0f)
+			{
+				continue;
+			}
+
+			TotalWeight += Row->SpawnWeight;
+			// Larger groups bring more visitors, so admission is weighted by expected group size too.
+			const float TypeGroupSize = 0.5f * (Row->MinGroupSize + FMath::Max(Row->MinGroupSize, Row->MaxGroupSize));
+			WeightedGroupSize += Row->SpawnWeight * TypeGroupSize;
+			WeightedAdmission += Row->SpawnWeight * TypeGroupSize * Row->Admission;
+
+			VisitorTypes.Add(*Row);
+			VisitorTypeNames.Add(RowPair.Key);
+			VisitorTypeCumulativeWeights.Add(TotalWeight);
 		}
+	}
 
-		AverageSatisfaction = FMath::Clamp(75.0f - CrowdingPenalty, 0.0f, 100.0f);
+	if (TotalWeight > 0.0f)
+	{
+		AverageGroupSize = WeightedGroupSize / TotalWeight;
+		AverageAdmission = WeightedGroupSize > 0.0f ? WeightedAdmission / WeightedGroupSize : 0.0f;
+		UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Loaded %d visitor types. Average group size: %.2f"),
+			VisitorTypes.Num(), AverageGroupSize);
 	}
+	else
+	{
+		AverageGroupSize = 0.5f * (DefaultMinGroupSize + FMath::Max(DefaultMinGroupSize, DefaultMaxGroupSize));
+	}
+}
 
-	if (!FMath::IsNearlyEqual(OldSatisfaction, AverageSatisfaction, 0.1f))
+int32 UVisitorSubsystem::PickVisitorType() const
+{
+	if (VisitorTypeCumulativeWeights.Num() == 0)
 	{
-		OnSatisfactionChanged.Broadcast(AverageSatisfaction);
+		return INDEX_NONE;
 	}
+
+	const float Roll = FMath::FRand() * VisitorTypeCumulativeWeights.Last();
+	const int32 Index = Algo::UpperBound(VisitorTypeCumulativeWeights, Roll);
+	return FMath::Min(Index, VisitorTypeCumulativeWeights.Num() - 1);
 }
 
-FZooVisitorReport UVisitorSubsystem::GetVisitorReport() const
+int32 UVisitorSubsystem::PickGroupSize(int32 VisitorTypeIndex) const
 {
-	FZooVisitorReport Report;
-	Report.CurrentCount = CurrentVisitorCount;
-	Report.MaxCapacity = MaxVisitors;
-	Report.AverageSatisfaction = AverageSatisfaction;
-	Report.AttractionScore = CalculateVisitorAttraction();
+	int32 MinSize = DefaultMinGroupSize;
+	int32 MaxSize = DefaultMaxGroupSize;
+	if (VisitorTypes.IsValidIndex(VisitorTypeIndex))
+	{
+		MinSize = VisitorTypes[VisitorTypeIndex].MinGroupSize;
+		MaxSize = VisitorTypes[VisitorTypeIndex].MaxGroupSize;
+	}
 
-	return Report;
+	MinSize = FMath::Max(1, MinSize);
+	return FMath::RandRange(MinSize, FMath::Max(MinSize, MaxSize));
+}
+
+FVector UVisitorSubsystem::GetFormationOffset(int32 MemberSlot)
+{
+	if (MemberSlot <= 0)
+	{
+		return FVector::ZeroVector;
+	}
+
+	// Pairs of followers fill rows behind the leader, alternating sides.
+	const int32 Row = (MemberSlot + 1) / 2;
+	const float Side = (MemberSlot % 2 == 1) ? 1.0f : -1.0f;
+	return FVector(-FormationRowSpacing * Row, FormationSideSpacing * Side, 0.0f);
+}
+
+// -------------------------------------------------------------------
+//  Groups
+// -------------------------------------------------------------------
+
+void UVisitorSubsystem::AddToGroup(AVisitorCharacter* Visitor)
+{
+	if (Visitor->GroupID == INDEX_NONE)
+	{
+		return;
+	}
+
+	FVisitorGroup* Group = Groups.Find(Visitor->GroupID);
+	if (!Group)
+	{
+		Visitor->GroupID = INDEX_NONE;
+		return;
+	}
+
+	if (Group->Members.Num() == 0)
+	{
+		Visitor->FormationOffset = FVector::ZeroVector;
+	}
+	else if (const AVisitorCharacter* Leader = Group->Members[0].Get())
+	{
+		// Join with the group's pooled satisfaction.
+		const int32 LeaderRow = GetNeedsRow(Leader);
+		const int32 Row = GetNeedsRow(Visitor);
+		if (LeaderRow != INDEX_NONE && Row != INDEX_NONE)
+		{
+			SetSatisfactionRow(Row, Needs.Satisfaction[LeaderRow]);
+		}
+	}
+
+	Group->Members.Add(Visitor);
+	Group->Money += Visitor->MoneyToSpend;
+}
+
+void UVisitorSubsystem::RemoveFromGroup(AVisitorCharacter* Visitor)
+{
+	if (Visitor->GroupID == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 GroupID = Visitor->GroupID;
+	FVisitorGroup* Group = Groups.Find(GroupID);
+	if (!Group)
+	{
+		return;
+	}
+
+	const int32 MemberIndex = Group->Members.IndexOfByKey(Visitor);
+	if (MemberIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Group->Members.RemoveAt(MemberIndex);
+
+	if (Group->Members.Num() == 0)
+	{
+		Groups.Remove(GroupID);
+		return;
+	}
+
+	if (MemberIndex != 0)
+	{
+		return;
+	}
+
+	// The leader leaving through the exit takes the whole group along.
+	if (Visitor->CurrentState == EVisitorState::Leaving)
+	{
+		TArray<TWeakObjectPtr<AVisitorCharacter>> Followers = MoveTemp(Group->Members);
+		Groups.Remove(GroupID);
+
+		for (const TWeakObjectPtr<AVisitorCharacter>& Follower : Followers)
+		{
+			if (AVisitorCharacter* FollowerActor = Follower.Get())
+			{
+				FollowerActor->GroupID = INDEX_NONE;
+				FollowerActor->Destroy();
+			}
+		}
+		return;
+	}
+
+	// Otherwise promote the next member; its controller picks up the decisions.
+	if (AVisitorCharacter* NewLeader = Group->Members[0].Get())
+	{
+		NewLeader->FormationOffset = FVector::ZeroVector;
+		UE_LOG(LogZooKeeper, Verbose, TEXT("VisitorSubsystem - Group %d promoted [%s] to leader."),
+			GroupID, *NewLeader->GetName());
+	}
+}
+
+void UVisitorSubsystem::SetGroupSatisfaction(const FVisitorGroup& Group, float Value)
+{
+	for (const TWeakObjectPtr<AVisitorCharacter>& Member : Group.Members)
+	{
+		const int32 Row = GetNeedsRow(Member.Get());
+		if (Row != INDEX_NONE)
+		{
+			SetSatisfactionRow(Row, Value);
+		}
+	}
+}
+
+AVisitorCharacter* UVisitorSubsystem::GetGroupLeader(int32 GroupID) const
+{
+	const FVisitorGroup* Group = Groups.Find(GroupID);
+	return (Group && Group->Members.Num() > 0) ? Group->Members[0].Get() : nullptr;
+}
+
+TArray<AVisitorCharacter*> UVisitorSubsystem::GetGroupMembers(int32 GroupID) const
+{
+	TArray<AVisitorCharacter*> Result;
+	if (const FVisitorGroup* Group = Groups.Find(GroupID))
+	{
+		for (const TWeakObjectPtr<AVisitorCharacter>& Member : Group->Members)
+		{
+			if (AVisitorCharacter* MemberActor = Member.Get())
+			{
+				Result.Add(MemberActor);
+			}
+		}
+	}
+	return Result;
+}
+
+int32 UVisitorSubsystem::GetGroupSize(int32 GroupID) const
+{
+	const FVisitorGroup* Group = Groups.Find(GroupID);
+	return Group ? Group->Members.Num() : 0;
+}
+
+float UVisitorSubsystem::GetGroupSatisfaction(int32 GroupID) const
+{
+	const FVisitorGroup* Group = Groups.Find(GroupID);
+	if (!Group || Group->Members.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 Row = GetNeedsRow(Group->Members[0].Get());
+	return Row != INDEX_NONE ? Needs.Satisfaction[Row] : 0.0f;
+}
+
+void UVisitorSubsystem::AddGroupSatisfaction(int32 GroupID, float Delta)
+{
+	FVisitorGroup* Group = Groups.Find(GroupID);
+	if (!Group || Group->Members.Num() == 0)
+	{
+		return;
+	}
+
+	const float Pooled = GetGroupSatisfaction(GroupID);
+	SetGroupSatisfaction(*Group, FMath::Clamp(Pooled + Delta, 0.0f, 1.0f));
+}
+
+int32 UVisitorSubsystem::GetGroupMoney(int32 GroupID) const
+{
+	const FVisitorGroup* Group = Groups.Find(GroupID);
+	return Group ? Group->Money : 0;
+}
+
+bool UVisitorSubsystem::SpendGroupMoney(int32 GroupID, int32 Amount)
+{
+	FVisitorGroup* Group = Groups.Find(GroupID);
+	if (!Group || Amount <= 0 || Group->Money < Amount)
+	{
+		return false;
+	}
+
+	Group->Money -= Amount;
+	return true;
+}
+
+void UVisitorSubsystem::DespawnAllVisitors()
+{
+	if (AllVisitorCharacters.Num() == 0 && CurrentVisitorCount == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Despawning all %d visitors."), AllVisitorCharacters.Num());
+
+	// Destroy all visitor actors. Copy the array since Destroy triggers EndPlay -> UnregisterVisitor.
+	TArray<TObjectPtr<AVisitorCharacter>> VisitorsCopy = AllVisitorCharacters;
+	for (AVisitorCharacter* Visitor : VisitorsCopy)
+	{
+		if (IsValid(Visitor))
+		{
+			Visitor->Destroy();
+		}
+	}
+
+	AllVisitorCharacters.Empty();
+	Groups.Empty();
+	Needs = FVisitorNeedsStore();
+	SatisfactionSum = 0.0;
+	PendingSpawns.Reset();
+	CurrentVisitorCount = 0;
+	OnVisitorCountChanged.Broadcast(CurrentVisitorCount);
+	RefreshAverageSatisfaction();
+}
+
+int32 UVisitorSubsystem::CalculateVisitorAttraction() const
+{
+	const float SatisfactionFactor = AverageSatisfaction / 100.0f; // 0-1
+	const int32 BaseAttraction = 10;
+
+	// Use zoo rating to boost attraction if ZooRatingSubsystem is available
+	float RatingMultiplier = 1.0f;
+	if (const UWorld* World = GetWorld())
+	{
+		if (const UZooRatingSubsystem* RatingSub = World->GetSubsystem<UZooRatingSubsystem>())
+		{
+			RatingMultiplier = RatingSub->GetVisitorSpawnMultiplier();
+		}
+	}
+
+	const int32 AttractionScore = FMath::FloorToInt(BaseAttraction * SatisfactionFactor * RatingMultiplier);
+	return FMath::Max(1, AttractionScore);
+}
+
+void UVisitorSubsystem::UpdateSatisfaction()
+{
+	SatisfactionSum = 0.0;
+	for (const float Value : Needs.Satisfaction)
+	{
+		SatisfactionSum += Value;
+	}
+	StepsSinceSatisfactionResync = 0;
+
+	RefreshAverageSatisfaction();
+}
+
+void UVisitorSubsystem::RefreshAverageSatisfaction()
+{
+	const int32 NumVisitors = Needs.Num();
+	AverageSatisfaction = NumVisitors > 0
+		? FMath::Clamp(static_cast<float>(SatisfactionSum / NumVisitors) * 100.0f, 0.0f, 100.0f)
+		: 50.0f; // No visitors, keep neutral
+
+	if (!FMath::IsNearlyEqual(LastBroadcastSatisfaction, AverageSatisfaction, 0.1f))
+	{
+		LastBroadcastSatisfaction = AverageSatisfaction;
+		OnSatisfactionChanged.Broadcast(AverageSatisfaction);
+	}
+}
+
+FZooVisitorReport UVisitorSubsystem::GetVisitorReport() const
+{
+	FZooVisitorReport Report;
+	Report.CurrentCount = CurrentVisitorCount;
+	Report.MaxCapacity = MaxVisitors;
+	Report.AverageSatisfaction = AverageSatisfaction;
+	Report.AttractionScore = CalculateVisitorAttraction();
+
+	return Report;
+}
+
+// -------------------------------------------------------------------
+//  Needs
+// -------------------------------------------------------------------
+
+void UVisitorSubsystem::AddNeedsRow(AVisitorCharacter* Visitor)
+{
+	const float Satisfaction = FMath::Clamp(StartingSatisfaction, 0.0f, 1.0f);
+
+	Visitor->NeedsIndex = Needs.Owners.Add(Visitor);
+	Needs.States.Add(Visitor->CurrentState);
+	Needs.Hunger.Add(1.0f);
+	Needs.Energy.Add(1.0f);
+	Needs.Fun.Add(1.0f);
+	Needs.Satisfaction.Add(Satisfaction);
+	Needs.TimeInZoo.Add(0.0f);
+
+	SatisfactionSum += Satisfaction;
+}
+
+void UVisitorSubsystem::RemoveNeedsRow(AVisitorCharacter* Visitor)
+{
+	const int32 Row = GetNeedsRow(Visitor);
+	if (Row == INDEX_NONE)
+	{
+		return;
+	}
+
+	SatisfactionSum -= Needs.Satisfaction[Row];
+
+	Needs.Owners.RemoveAtSwap(Row, EAllowShrinking::No);
+	Needs.States.RemoveAtSwap(Row, EAllowShrinking::No);
+	Needs.Hunger.RemoveAtSwap(Row, EAllowShrinking::No);
+	Needs.Energy.RemoveAtSwap(Row, EAllowShrinking::No);
+	Needs.Fun.RemoveAtSwap(Row, EAllowShrinking::No);
+	Needs.Satisfaction.RemoveAtSwap(Row, EAllowShrinking::No);
+	Needs.TimeInZoo.RemoveAtSwap(Row, EAllowShrinking::No);
+
+	if (Needs.Owners.IsValidIndex(Row))
+	{
+		Needs.Owners[Row]->NeedsIndex = Row;
+	}
+	Visitor->NeedsIndex = INDEX_NONE;
+}
+
+int32 UVisitorSubsystem::GetNeedsRow(const AVisitorCharacter* Visitor) const
+{
+	if (!Visitor || !Needs.Owners.IsValidIndex(Visitor->NeedsIndex) || Needs.Owners[Visitor->NeedsIndex] != Visitor)
+	{
+		return INDEX_NONE;
+	}
+	return Visitor->NeedsIndex;
+}
+
+void UVisitorSubsystem::SetSatisfactionRow(int32 Row, float Value)
+{
+	SatisfactionSum += Value - Needs.Satisfaction[Row];
+	Needs.Satisfaction[Row] = Value;
+}
+
+void UVisitorSubsystem::StepNeeds(float StepSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooVisitorNeeds);
+
+	const int32 NumRows = Needs.Num();
+	if (NumRows == 0)
+	{
+		return;
+	}
+
+	// States are read on the game thread; the workers only touch the needs arrays.
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		Needs.States[Row] = Needs.Owners[Row]->CurrentState;
+	}
+
+	const float HungerLoss = HungerDecayRate * StepSeconds;
+	const float EnergyLoss = EnergyDecayRate * StepSeconds;
+	const float FunLoss = FunDecayRate * StepSeconds;
+	const float Restore = NeedRestoreRate * StepSeconds;
+	const float PassiveLoss = PassiveSatisfactionDecay * StepSeconds;
+	const float LowNeedLoss = LowNeedSatisfactionPenalty * StepSeconds;
+	const float Threshold = LowNeedThreshold;
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumRows, NeedsBatchSize);
+	TArray<double, TInlineAllocator<16>> BatchSatisfactionDeltas;
+	BatchSatisfactionDeltas.SetNumZeroed(NumBatches);
+
+	ParallelFor(NumBatches, [&](int32 Batch)
+	{
+		const int32 Begin = Batch * NeedsBatchSize;
+		const int32 End = FMath::Min(Begin + NeedsBatchSize, NumRows);
+
+		float* RESTRICT Hunger = Needs.Hunger.GetData();
+		float* RESTRICT Energy = Needs.Energy.GetData();
+		float* RESTRICT Fun = Needs.Fun.GetData();
+		float* RESTRICT Satisfaction = Needs.Satisfaction.GetData();
+		float* RESTRICT TimeInZoo = Needs.TimeInZoo.GetData();
+		const EVisitorState* States = Needs.States.GetData();
+
+		double BatchDelta = 0.0;
+		for (int32 Row = Begin; Row < End; ++Row)
+		{
+			const EVisitorState State = States[Row];
+
+			Hunger[Row] = FMath::Clamp(Hunger[Row] + (State == EVisitorState::BuyingFood ? Restore : -HungerLoss), 0.0f, 1.0f);
+			Energy[Row] = FMath::Clamp(Energy[Row] + (State == EVisitorState::Resting ? Restore : -EnergyLoss), 0.0f, 1.0f);
+			Fun[Row] = FMath::Clamp(Fun[Row] + (State == EVisitorState::ViewingAnimal ? Restore : -FunLoss), 0.0f, 1.0f);
+			TimeInZoo[Row] += StepSeconds;
+
+			// Satisfaction slowly decays unless the visitor is doing something enjoyable.
+			float Loss = (State != EVisitorState::ViewingAnimal && State != EVisitorState::BuyingFood) ? PassiveLoss : 0.0f;
+			Loss += (Hunger[Row] < Threshold ? LowNeedLoss : 0.0f)
+				+ (Energy[Row] < Threshold ? LowNeedLoss : 0.0f)
+				+ (Fun[Row] < Threshold ? LowNeedLoss : 0.0f);
+
+			const float Old = Satisfaction[Row];
+			Satisfaction[Row] = FMath::Clamp(Old - Loss, 0.0f, 1.0f);
+			BatchDelta += Satisfaction[Row] - Old;
+		}
+
+		BatchSatisfactionDeltas[Batch] = BatchDelta;
+	});
+
+	for (const double Delta : BatchSatisfactionDeltas)
+	{
+		SatisfactionSum += Delta;
+	}
+
+	// Members drift apart when their states differ; pool them again. The mean keeps the sum unchanged.
+	for (const TPair<int32, FVisitorGroup>& Pair : Groups)
+	{
+		const FVisitorGroup& Group = Pair.Value;
+		if (Group.Members.Num() < 2)
+		{
+			continue;
+		}
+
+		float Total = 0.0f;
+		int32 Count = 0;
+		for (const TWeakObjectPtr<AVisitorCharacter>& Member : Group.Members)
+		{
+			const int32 Row = GetNeedsRow(Member.Get());
+			if (Row != INDEX_NONE)
+			{
+				Total += Needs.Satisfaction[Row];
+				Count++;
+			}
+		}
+
+		if (Count > 0)
+		{
+			SetGroupSatisfaction(Group, Total / Count);
+		}
+	}
+
+	if (++StepsSinceSatisfactionResync >= SatisfactionResyncSteps)
+	{
+		UpdateSatisfaction();
+		return;
+	}
+
+	RefreshAverageSatisfaction();
+}
+
+FZooVisitorNeeds UVisitorSubsystem::GetVisitorNeeds(const AVisitorCharacter* Visitor) const
+{
+	FZooVisitorNeeds Result;
+	const int32 Row = GetNeedsRow(Visitor);
+	if (Row != INDEX_NONE)
+	{
+		Result.Hunger = Needs.Hunger[Row];
+		Result.Energy = Needs.Energy[Row];
+		Result.Fun = Needs.Fun[Row];
+		Result.Satisfaction = Needs.Satisfaction[Row];
+		Result.TimeInZoo = Needs.TimeInZoo[Row];
+	}
+	return Result;
+}
+
+float UVisitorSubsystem::GetVisitorSatisfaction(const AVisitorCharacter* Visitor) const
+{
+	const int32 Row = GetNeedsRow(Visitor);
+	return Row != INDEX_NONE ? Needs.Satisfaction[Row] : StartingSatisfaction;
+}
+
+float UVisitorSubsystem::GetVisitorTimeInZoo(const AVisitorCharacter* Visitor) const
+{
+	const int32 Row = GetNeedsRow(Visitor);
+	return Row != INDEX_NONE ? Needs.TimeInZoo[Row] : 0.0f;
+}
+
+void UVisitorSubsystem::AddVisitorSatisfaction(AVisitorCharacter* Visitor, float Delta)
+{
+	const int32 Row = GetNeedsRow(Visitor);
+	if (Row == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (const FVisitorGroup* Group = Visitor->GroupID != INDEX_NONE ? Groups.Find(Visitor->GroupID) : nullptr)
+	{
+		// The leader's behavior tree decides for the whole group; a follower's own change is spread over it.
+		AddGroupSatisfaction(Visitor->GroupID, Visitor->IsGroupLeader() ? Delta : Delta / FMath::Max(Group->Members.Num(), 1));
+		return;
+	}
+
+	SetSatisfactionRow(Row, FMath::Clamp(Needs.Satisfaction[Row] + Delta, 0.0f, 1.0f));
+}
+
+// -------------------------------------------------------------------
+//  Points of Interest
+// -------------------------------------------------------------------
+
+void UVisitorSubsystem::ConfigurePointOfInterest(AActor* PointOfInterest, int32 Servers, float ServiceRate, int32 QueueCapacity)
+{
+	if (!PointOfInterest)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("VisitorSubsystem::ConfigurePointOfInterest - Null point of interest passed."));
+		return;
+	}
+
+	FPOIQueue& Queue = FindOrAddQueue(PointOfInterest);
+	Queue.Servers = FMath::Max(1, Servers);
+	Queue.ServiceRate = FMath::Max(0.001f, ServiceRate);
+
+	// Resize the slot ring, keeping waiting visitors in FIFO order. Visitors beyond
+	// the new capacity are dropped from the line.
+	TArray<TWeakObjectPtr<AVisitorCharacter>> Waiting;
+	Waiting.Reserve(Queue.Count);
+	for (int32 i = 0; i < Queue.Count; ++i)
+	{
+		Waiting.Add(Queue.SlotAt(i));
+	}
+
+	Queue.Slots.Reset();
+	Queue.Slots.SetNum(FMath::Max(0, QueueCapacity));
+	Queue.Head = 0;
+	Queue.Count = FMath::Min(Waiting.Num(), Queue.Slots.Num());
+	for (int32 i = 0; i < Queue.Count; ++i)
+	{
+		Queue.Slots[i] = Waiting[i];
+	}
+
+	AdmitFromQueue(Queue);
+
+	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Configured POI '%s': %d server(s), %.3f/s, queue %d."),
+		*PointOfInterest->GetName(), Queue.Servers, Queue.ServiceRate, Queue.Capacity());
+}
+
+bool UVisitorSubsystem::JoinQueue(AActor* PointOfInterest, AVisitorCharacter* Visitor)
+{
+	if (!PointOfInterest || !Visitor)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("VisitorSubsystem::JoinQueue - Null point of interest or visitor passed."));
+		return false;
+	}
+
+	FPOIQueue& Queue = FindOrAddQueue(PointOfInterest);
+
+	if (Queue.InService.Contains(Visitor))
+	{
+		return false;
+	}
+	for (int32 i = 0; i < Queue.Count; ++i)
+	{
+		if (Queue.SlotAt(i) == Visitor)
+		{
+			return false;
+		}
+	}
+
+	if (Queue.InService.Num() < Queue.Servers && Queue.Count == 0)
+	{
+		Queue.InService.Add(Visitor);
+		Queue.ServiceTimeRemaining.Add(SampleServiceTime(Queue));
+	}
+	else if (Queue.Count < Queue.Capacity())
+	{
+		Queue.SlotAt(Queue.Count) = Visitor;
+		Queue.Count++;
+	}
+	else
+	{
+		return false;
+	}
+
+	Queue.WindowArrivals++;
+	return true;
+}
+
+void UVisitorSubsystem::LeaveQueue(AActor* PointOfInterest, AVisitorCharacter* Visitor)
+{
+	if (!PointOfInterest || !Visitor)
+	{
+		return;
+	}
+
+	FPOIQueue* Queue = POIQueues.Find(PointOfInterest);
+	if (!Queue)
+	{
+		return;
+	}
+
+	const int32 ServerIndex = Queue->InService.IndexOfByKey(Visitor);
+	if (ServerIndex != INDEX_NONE)
+	{
+		Queue->InService.RemoveAtSwap(ServerIndex);
+		Queue->ServiceTimeRemaining.RemoveAtSwap(ServerIndex);
+		AdmitFromQueue(*Queue);
+		return;
+	}
+
+	for (int32 i = 0; i < Queue->Count; ++i)
+	{
+		if (Queue->SlotAt(i) == Visitor)
+		{
+			RemoveQueueSlot(*Queue, i);
+			return;
+		}
+	}
+}
+
+bool UVisitorSubsystem::IsInQueue(AActor* PointOfInterest, const AVisitorCharacter* Visitor) const
+{
+	const FPOIQueue* Queue = POIQueues.Find(PointOfInterest);
+	if (!Queue || !Visitor)
+	{
+		return false;
+	}
+
+	if (Queue->InService.Contains(Visitor))
+	{
+		return true;
+	}
+
+	for (int32 i = 0; i < Queue->Count; ++i)
+	{
+		if (Queue->SlotAt(i) == Visitor)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UVisitorSubsystem::IsBeingServed(AActor* PointOfInterest, const AVisitorCharacter* Visitor) const
+{
+	const FPOIQueue* Queue = POIQueues.Find(PointOfInterest);
+	return Queue && Visitor && Queue->InService.Contains(Visitor);
+}
+
+bool UVisitorSubsystem::IsPointOfInterestFull(AActor* PointOfInterest) const
+{
+	const FPOIQueue* Queue = POIQueues.Find(PointOfInterest);
+	if (!Queue)
+	{
+		return false;
+	}
+
+	return Queue->InService.Num() >= Queue->Servers && Queue->Count >= Queue->Capacity();
+}
+
+float UVisitorSubsystem::GetExpectedWait(AActor* PointOfInterest) const
+{
+	const FPOIQueue* Queue = POIQueues.Find(PointOfInterest);
+	return Queue ? ComputeExpectedWait(*Queue) : 0.0f;
+}
+
+FZooPOIQueueStats UVisitorSubsystem::GetPointOfInterestStats(AActor* PointOfInterest) const
+{
+	FZooPOIQueueStats Stats;
+
+	const FPOIQueue* Queue = POIQueues.Find(PointOfInterest);
+	if (!Queue)
+	{
+		Stats.Servers = DefaultPOIServers;
+		Stats.ServiceRate = DefaultPOIServiceRate;
+		Stats.QueueCapacity = DefaultPOIQueueCapacity;
+		return Stats;
+	}
+
+	Stats.Servers = Queue->Servers;
+	Stats.ServiceRate = Queue->ServiceRate;
+	Stats.QueueLength = Queue->Count;
+	Stats.QueueCapacity = Queue->Capacity();
+	Stats.InService = Queue->InService.Num();
+	Stats.ArrivalRate = Queue->ArrivalRate;
+	Stats.Utilization = Queue->ArrivalRate / (Queue->Servers * Queue->ServiceRate);
+	Stats.ExpectedWait = ComputeExpectedWait(*Queue);
+	Stats.TotalServed = Queue->TotalServed;
+
+	return Stats;
+}
+
+UVisitorSubsystem::FPOIQueue& UVisitorSubsystem::FindOrAddQueue(AActor* PointOfInterest)
+{
+	if (FPOIQueue* Existing = POIQueues.Find(PointOfInterest))
+	{
+		return *Existing;
+	}
+
+	FPOIQueue& Queue = POIQueues.Add(PointOfInterest);
+	Queue.Servers = FMath::Max(1, DefaultPOIServers);
+	Queue.ServiceRate = FMath::Max(0.001f, DefaultPOIServiceRate);
+	Queue.Slots.SetNum(FMath::Max(0, DefaultPOIQueueCapacity));
+	return Queue;
+}
+
+void UVisitorSubsystem::AdmitFromQueue(FPOIQueue& Queue)
+{
+	while (Queue.Count > 0 && Queue.InService.Num() < Queue.Servers)
+	{
+		TWeakObjectPtr<AVisitorCharacter> Next = Queue.SlotAt(0);
+		Queue.SlotAt(0).Reset();
+		Queue.Head = (Queue.Head + 1) % Queue.Capacity();
+		Queue.Count--;
+
+		if (Next.IsValid())
+		{
+			Queue.InService.Add(Next);
+			Queue.ServiceTimeRemaining.Add(SampleServiceTime(Queue));
+		}
+	}
+}
+
+void UVisitorSubsystem::RemoveQueueSlot(FPOIQueue& Queue, int32 Index)
+{
+	for (int32 i = Index; i < Queue.Count - 1; ++i)
+	{
+		Queue.SlotAt(i) = Queue.SlotAt(i + 1);
+	}
+	Queue.SlotAt(Queue.Count - 1).Reset();
+	Queue.Count--;
+}
+
+float UVisitorSubsystem::SampleServiceTime(const FPOIQueue& Queue)
+{
+	// Exponential service times keep the simulation consistent with the M/M/c estimate.
+	const float U = FMath::Max(FMath::FRand(), KINDA_SMALL_NUMBER);
+	return -FMath::Loge(U) / Queue.ServiceRate;
+}
+
+float UVisitorSubsystem::ComputeExpectedWait(const FPOIQueue& Queue)
+{
+	const float TotalServiceRate = Queue.Servers * Queue.ServiceRate;
+
+	// Explicit queue: everyone ahead must clear a server first.
+	float QueueWait = 0.0f;
+	if (Queue.InService.Num() >= Queue.Servers)
+	{
+		QueueWait = static_cast<float>(Queue.Count + 1) / TotalServiceRate;
+	}
+
+	// Steady-state M/M/c estimate anticipates visitors already heading here.
+	float SteadyStateWait = 0.0f;
+	if (Queue.ArrivalRate > 0.0f && Queue.ArrivalRate < TotalServiceRate)
+	{
+		const float OfferedLoad = Queue.ArrivalRate / Queue.ServiceRate;
+		SteadyStateWait = ErlangC(Queue.Servers, OfferedLoad) / (TotalServiceRate - Queue.ArrivalRate);
+	}
+
+	return FMath::Max(QueueWait, SteadyStateWait);
+}
+
+float UVisitorSubsystem::ErlangC(int32 Servers, float OfferedLoad)
+{
+	const float Utilization = OfferedLoad / Servers;
+	if (Utilization >= 1.0f)
+	{
+		return 1.0f;
+	}
+
+	// Sum a^k / k! for k < c, building each term from the previous one.
+	float Term = 1.0f;
+	float Sum = 1.0f;
+	for (int32 k = 1; k < Servers; ++k)
+	{
+		Term *= OfferedLoad / k;
+		Sum += Term;
+	}
+
+	const float WaitTerm = Term * (OfferedLoad / Servers) / (1.0f - Utilization);
+	return WaitTerm / (Sum + WaitTerm);
+}
+
+// -------------------------------------------------------------------
+//  Crowd Density
+// -------------------------------------------------------------------
+
+void UVisitorSubsystem::EnsureCrowdGrid()
+{
+	CrowdGridSize.X = FMath::Max(1, CrowdGridSize.X);
+	CrowdGridSize.Y = FMath::Max(1, CrowdGridSize.Y);
+
+	const int32 NumCells = CrowdGridSize.X * CrowdGridSize.Y;
+	if (CrowdDensity.Num() == NumCells)
+	{
+		return;
+	}
+
+	CrowdCounts.Init(0, NumCells);
+	CrowdDensity.Init(0.0f, NumCells);
+	CrowdPeakDensity.Init(0.0f, NumCells);
+}
+
+int32 UVisitorSubsystem::GetCrowdCellIndex(const FVector& Location) const
+{
+	if (CrowdDensity.Num() != CrowdGridSize.X * CrowdGridSize.Y || CrowdCellSize <= 0.0f)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 CellX = FMath::FloorToInt32((Location.X - CrowdGridOrigin.X) / CrowdCellSize);
+	const int32 CellY = FMath::FloorToInt32((Location.Y - CrowdGridOrigin.Y) / CrowdCellSize);
+	if (CellX < 0 || CellY < 0 || CellX >= CrowdGridSize.X || CellY >= CrowdGridSize.Y)
+	{
+		return INDEX_NONE;
+	}
+
+	return CellY * CrowdGridSize.X + CellX;
+}
+
+void UVisitorSubsystem::SampleCrowdDensity()
+{
+	EnsureCrowdGrid();
+
+	FMemory::Memzero(CrowdCounts.GetData(), CrowdCounts.Num() * sizeof(uint16));
+
+	for (const AVisitorCharacter* Visitor : AllVisitorCharacters)
+	{
+		if (!Visitor)
+		{
+			continue;
+		}
+
+		const int32 Cell = GetCrowdCellIndex(Visitor->GetActorLocation());
+		if (Cell != INDEX_NONE && CrowdCounts[Cell] < MAX_uint16)
+		{
+			CrowdCounts[Cell]++;
+		}
+	}
+
+	// Smooth every cell so emptied cells decay rather than snapping to zero.
+	for (int32 Cell = 0; Cell < CrowdDensity.Num(); ++Cell)
+	{
+		float& Density = CrowdDensity[Cell];
+		Density += CrowdSmoothing * (static_cast<float>(CrowdCounts[Cell]) - Density);
+		CrowdPeakDensity[Cell] = FMath::Max(CrowdPeakDensity[Cell], Density);
+	}
+
+	if (CrowdingSatisfactionPenalty <= 0.0f)
+	{
+		return;
+	}
+
+	// Visitors in congested cells lose satisfaction in proportion to how crowded it feels.
+	const float MaxPenalty = CrowdingSatisfactionPenalty * CrowdSampleInterval;
+	for (AVisitorCharacter* Visitor : AllVisitorCharacters)
+	{
+		if (!Visitor)
+		{
+			continue;
+		}
+
+		const float Crowding = GetCrowdingFactor(Visitor->GetActorLocation());
+		if (Crowding > 0.0f)
+		{
+			Visitor->UpdateSatisfaction(-MaxPenalty * Crowding);
+		}
+	}
+}
+
+float UVisitorSubsystem::GetCrowdDensityAtLocation(const FVector& Location) const
+{
+	const int32 Cell = GetCrowdCellIndex(Location);
+	return Cell != INDEX_NONE ? CrowdDensity[Cell] : 0.0f;
+}
+
+float UVisitorSubsystem::GetPeakCrowdDensityAtLocation(const FVector& Location) const
+{
+	const int32 Cell = GetCrowdCellIndex(Location);
+	return Cell != INDEX_NONE ? CrowdPeakDensity[Cell] : 0.0f;
+}
+
+float UVisitorSubsystem::GetCrowdingFactor(const FVector& Location) const
+{
+	const float Comfort = FMath::Max(CrowdComfortCapacity, 1.0f);
+	return FMath::Clamp((GetCrowdDensityAtLocation(Location) - Comfort) / Comfort, 0.0f, 1.0f);
+}
+
+void UVisitorSubsystem::ResetCrowdPeaks()
+{
+	for (float& Peak : CrowdPeakDensity)
+	{
+		Peak = 0.0f;
+	}
+}
+
+FString UVisitorSubsystem::ExportCrowdHeatmap(ECrowdHeatmapFormat Format, bool bPeak)
+{
+	const UWorld* World = GetWorld();
+	const UTimeSubsystem* TimeSys = World ? World->GetSubsystem<UTimeSubsystem>() : nullptr;
+	return WriteCrowdHeatmap(Format, bPeak, TimeSys ? TimeSys->CurrentDay : 0);
+}
+
+FString UVisitorSubsystem::WriteCrowdHeatmap(ECrowdHeatmapFormat Format, bool bPeak, int32 Day)
+{
+	EnsureCrowdGrid();
+
+	const TArray<float>& Values = bPeak ? CrowdPeakDensity : CrowdDensity;
+
+	const FString FileName = FString::Printf(TEXT("CrowdHeatmap_Day%03d_%s.%s"),
+		Day, bPeak ? TEXT("Peak") : TEXT("Smoothed"), Format == ECrowdHeatmapFormat::Csv ? TEXT("csv") : TEXT("png"));
+	const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Heatmaps"), FileName);
+
+	bool bSaved = false;
+	if (Format == ECrowdHeatmapFormat::Csv)
+	{
+		FString Csv;
+		Csv.Reserve(Values.Num() * 6);
+		for (int32 Y = 0; Y < CrowdGridSize.Y; ++Y)
+		{
+			for (int32 X = 0; X < CrowdGridSize.X; ++X)
+			{
+				if (X > 0)
+				{
+					Csv.AppendChar(TEXT(','));
+				}
+				Csv.Append(FString::Printf(TEXT("%.2f"), Values[Y * CrowdGridSize.X + X]));
+			}
+			Csv.AppendChar(TEXT('\n'));
+		}
+		bSaved = FFileHelper::SaveStringToFile(Csv, *FilePath);
+	}
+	else
+	{
+		// Scale against twice the comfortable density so images from different days are comparable.
+		const float Scale = 1.0f / (2.0f * FMath::Max(CrowdComfortCapacity, 1.0f));
+		const FLinearColor Ramp[] = {
+			FLinearColor::Black, FLinearColor::Blue, FLinearColor::Green, FLinearColor::Yellow, FLinearColor::Red };
+		constexpr int32 NumSegments = UE_ARRAY_COUNT(Ramp) - 1;
+
+		const int32 Width = CrowdGridSize.X * HeatmapPixelsPerCell;
+		const int32 Height = CrowdGridSize.Y * HeatmapPixelsPerCell;
+		TArray64<FColor> Pixels;
+		Pixels.SetNumUninitialized(static_cast<int64>(Width) * Height);
+
+		for (int32 Y = 0; Y < CrowdGridSize.Y; ++Y)
+		{
+			for (int32 X = 0; X < CrowdGridSize.X; ++X)
+			{
+				const float T = FMath::Clamp(Values[Y * CrowdGridSize.X + X] * Scale, 0.0f, 1.0f) * NumSegments;
+				const int32 Segment = FMath::Min(FMath::FloorToInt32(T), NumSegments - 1);
+				const FColor Color = FMath::Lerp(Ramp[Segment], Ramp[Segment + 1], T - Segment).ToFColor(true);
+
+				for (int32 PY = 0; PY < HeatmapPixelsPerCell; ++PY)
+				{
+					FColor* Row = &Pixels[static_cast<int64>(Y * HeatmapPixelsPerCell + PY) * Width + X * HeatmapPixelsPerCell];
+					for (int32 PX = 0; PX < HeatmapPixelsPerCell; ++PX)
+					{
+						Row[PX] = Color;
+					}
+				}
+			}
+		}
+
+		TArray64<uint8> Png;
+		FImageUtils::PNGCompressImageArray(Width, Height, Pixels, Png);
+		bSaved = Png.Num() > 0 && FFileHelper::SaveArrayToFile(Png, *FilePath);
+	}
+
+	if (!bSaved)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("VisitorSubsystem::ExportCrowdHeatmap - Failed to write '%s'."), *FilePath);
+		return FString();
+	}
+
+	UE_LOG(LogZooKeeper, Log, TEXT("VisitorSubsystem - Exported crowd heatmap to '%s'."), *FilePath);
+	return FilePath;
+}
+
+void UVisitorSubsystem::HandleDayChanged(int32 NewDay)
+{
+	if (CVarCrowdAutoExportDaily.GetValueOnGameThread())
+	{
+		// The peaks belong to the day that just ended.
+		WriteCrowdHeatmap(ECrowdHeatmapFormat::Png, true, NewDay - 1);
+		WriteCrowdHeatmap(ECrowdHeatmapFormat::Csv, true, NewDay - 1);
+	}
+
+	ResetCrowdPeaks();
 }
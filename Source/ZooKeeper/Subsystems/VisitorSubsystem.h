@@ -2,14 +2,31 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Subsystems/WeatherSubsystem.h"
+#include "Data/ZooDataTypes.h"
 #include "VisitorSubsystem.generated.h"
 
+class AVisitorCharacter;
+class UDataTable;
+enum class EVisitorState : uint8;
+
+/** File format for crowd heatmap exports. */
+UENUM(BlueprintType)
+enum class ECrowdHeatmapFormat : uint8
+{
+	Png  UMETA(DisplayName = "PNG"),
+	Csv  UMETA(DisplayName = "CSV")
+};
+
 /** Broadcast when the number of visitors changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVisitorCountChanged, int32, NewCount);
 
 /** Broadcast when the average visitor satisfaction level changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSatisfactionChanged, float, NewSatisfaction);
 
+/** Broadcast when a visitor finishes being served at a point of interest. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnVisitorServed, AActor*, PointOfInterest, AVisitorCharacter*, Visitor);
+
 /**
  * FZooVisitorReport
  *
@@ -37,13 +54,107 @@ struct ZOOKEEPER_API FZooVisitorReport
 	int32 AttractionScore = 0;
 };
 
+/**
+ * FZooPOIQueueStats
+ *
+ * Snapshot of a point of interest's queue, used by visitor AI to score
+ * destinations and by the UI to measure and tune stall throughput.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooPOIQueueStats
+{
+	GENERATED_BODY()
+
+	/** Number of visitors that can be served simultaneously (c in M/M/c). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	int32 Servers = 0;
+
+	/** Visitors served per second by a single server (mu). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	float ServiceRate = 0.0f;
+
+	/** Visitors currently waiting in the FIFO queue. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	int32 QueueLength = 0;
+
+	/** Maximum number of visitors that may wait in the queue. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	int32 QueueCapacity = 0;
+
+	/** Visitors currently being served. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	int32 InService = 0;
+
+	/** Smoothed arrival rate in visitors per second (lambda). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	float ArrivalRate = 0.0f;
+
+	/** Offered load per server (lambda / (c * mu)). Values >= 1 mean the queue grows without bound. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	float Utilization = 0.0f;
+
+	/** Expected wait in seconds for a visitor joining the queue now. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	float ExpectedWait = 0.0f;
+
+	/** Total visitors served since the point of interest was first used. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
+	int32 TotalServed = 0;
+};
+
+/**
+ * FZooVisitorNeeds
+ *
+ * Snapshot of a single visitor's needs. Need values run from 0 (empty) to 1 (full).
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooVisitorNeeds
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Needs")
+	float Hunger = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Needs")
+	float Energy = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Needs")
+	float Fun = 1.0f;
+
+	/** Satisfaction (0-1); pooled across the visitor's group. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Needs")
+	float Satisfaction = 0.5f;
+
+	/** Seconds the visitor has spent in the zoo. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Needs")
+	float TimeInZoo = 0.0f;
+};
+
 /**
  * UVisitorSubsystem
  *
  * World subsystem that manages visitor spawning, despawning, satisfaction
- * tracking, and attraction calculations for the zoo.
+ * tracking, and attraction calculations for the zoo. Also models the
+ * queues at points of interest (food stalls, benches, attractions).
+ *
+ * Arrivals follow a non-homogeneous Poisson process whose rate depends on
+ * the time of day, the weather, and the zoo rating. Arrivals are queued and
+ * spawned under a per-frame budget so inflow stays smooth.
+ *
+ * Visitors arrive in groups. The group leader runs the behavior tree and
+ * makes destination decisions; the other members follow in formation.
+ * Satisfaction and spending money are pooled per group.
+ *
+ * Visitor needs (hunger, energy, fun) and satisfaction live in a
+ * struct-of-arrays store here rather than on the actors, and are advanced
+ * at a fixed rate in a single ParallelFor pass. The average satisfaction
+ * is maintained incrementally from a running sum.
+ *
+ * Visitor positions are binned into a coarse crowd density grid every
+ * sample step. The grid keeps a smoothed density and a daily peak per
+ * cell; the AI uses it to avoid congested destinations, dense cells cost
+ * satisfaction, and the grid can be exported as a heatmap for layout tuning.
  */
-class AVisitorCharacter;
 
 UCLASS(meta = (DisplayName = "Visitor Subsystem"))
 class ZOOKEEPER_API UVisitorSubsystem : public UWorldSubsystem
@@ -57,6 +168,14 @@ public:
 	virtual void Deinitialize() override;
 	//~ End USubsystem Interface
 
+	/**
+	 * Advances the visitor simulation (arrivals, spawn queue, queues at points of interest).
+	 * Should be called once per frame from the game mode.
+	 * @param DeltaTime  Real-world seconds since the last frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors")
+	void Tick(float DeltaTime);
+
 	// -------------------------------------------------------------------
 	//  Registration
 	// -------------------------------------------------------------------
@@ -74,12 +193,40 @@ public:
 	// -------------------------------------------------------------------
 
 	/**
-	 * Spawns the given number of visitors into the zoo, up to MaxVisitors.
+	 * Queues the given number of visitors for spawning, up to MaxVisitors.
+	 * Spawns are drained by Tick() under the per-frame spawn budget.
 	 * @param Count  The number of visitors to spawn.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors")
 	void SpawnVisitors(int32 Count);
 
+	/** Re-scans the level for actors tagged "VisitorSpawn" and caches their transforms. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors")
+	void RefreshSpawnPoints();
+
+	/**
+	 * Returns the current visitor arrival rate in visitors per game hour,
+	 * combining opening hours, weather, and the zoo rating.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Arrivals")
+	float GetArrivalRate() const;
+
+	/**
+	 * Returns the number of visitors expected to arrive over a whole day if the
+	 * current weather and zoo rating hold, integrating the arrival rate over the opening hours.
+	 * Returns 0 while the arrival scheduler is disabled.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Arrivals")
+	float GetExpectedDailyArrivals() const;
+
+	/** Returns the mean admission fee per arriving visitor, weighted by visitor type. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Arrivals")
+	float GetAverageAdmission() const;
+
+	/** Returns the number of visitors waiting to be spawned. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Arrivals")
+	int32 GetPendingSpawnCount() const { return PendingSpawns.Num(); }
+
 	/** Removes all visitors from the zoo (e.g. at closing time). */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors")
 	void DespawnAllVisitors();
@@ -92,14 +239,167 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors")
 	int32 CalculateVisitorAttraction() const;
 
-	/** Re-evaluates the average satisfaction across all visitors. */
+	/**
+	 * Re-evaluates the average satisfaction across all visitors from scratch.
+	 * The average is otherwise maintained incrementally; this also cancels float drift.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors")
 	void UpdateSatisfaction();
 
+	/** Returns all visitor characters currently in the zoo. */
+	const TArray<TObjectPtr<AVisitorCharacter>>& GetAllVisitors() const { return AllVisitorCharacters; }
+
 	/** Returns a snapshot report of the current visitor state. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors")
 	FZooVisitorReport GetVisitorReport() const;
 
+	// -------------------------------------------------------------------
+	//  Needs
+	// -------------------------------------------------------------------
+
+	/** Returns a snapshot of the visitor's needs (defaults if the visitor is not registered). */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Needs")
+	FZooVisitorNeeds GetVisitorNeeds(const AVisitorCharacter* Visitor) const;
+
+	/** Returns the visitor's satisfaction (0-1). */
+	float GetVisitorSatisfaction(const AVisitorCharacter* Visitor) const;
+
+	/** Returns the seconds the visitor has spent in the zoo. */
+	float GetVisitorTimeInZoo(const AVisitorCharacter* Visitor) const;
+
+	/**
+	 * Changes a visitor's satisfaction, clamped to [0, 1]. A group leader acts for its group, so its
+	 * changes move the group pool by the full Delta; a follower's change is shared, moving it by Delta / member count.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Needs")
+	void AddVisitorSatisfaction(AVisitorCharacter* Visitor, float Delta);
+
+	// -------------------------------------------------------------------
+	//  Groups
+	// -------------------------------------------------------------------
+
+	/** Returns the leader of the given group, or nullptr if the group no longer exists. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Groups")
+	AVisitorCharacter* GetGroupLeader(int32 GroupID) const;
+
+	/** Returns all members of the given group, leader first. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Groups")
+	TArray<AVisitorCharacter*> GetGroupMembers(int32 GroupID) const;
+
+	/** Returns the number of visitors currently in the given group. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Groups")
+	int32 GetGroupSize(int32 GroupID) const;
+
+	/** Returns the pooled satisfaction (0-1) of the given group. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Groups")
+	float GetGroupSatisfaction(int32 GroupID) const;
+
+	/** Adds a satisfaction change the whole group experienced to its pool, clamped to [0, 1]. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Groups")
+	void AddGroupSatisfaction(int32 GroupID, float Delta);
+
+	/** Returns the money the group still has available to spend. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Groups")
+	int32 GetGroupMoney(int32 GroupID) const;
+
+	/**
+	 * Spends money from the group's pooled budget.
+	 * @return true if the group could afford the amount.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Groups")
+	bool SpendGroupMoney(int32 GroupID, int32 Amount);
+
+	/** Returns the expected group size of an arrival, weighted by visitor type. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Groups")
+	float GetAverageGroupSize() const { return AverageGroupSize; }
+
+	// -------------------------------------------------------------------
+	//  Points of Interest
+	// -------------------------------------------------------------------
+
+	/**
+	 * Sets the queue parameters for a point of interest. Points of interest that
+	 * are never configured use the Default* values below on first use.
+	 * @param PointOfInterest  The stall, bench, or attraction actor.
+	 * @param Servers          Number of visitors served at once.
+	 * @param ServiceRate      Visitors served per second by each server.
+	 * @param QueueCapacity    Maximum number of visitors waiting in line.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Queues")
+	void ConfigurePointOfInterest(AActor* PointOfInterest, int32 Servers, float ServiceRate, int32 QueueCapacity);
+
+	/**
+	 * Adds a visitor to a point of interest. The visitor is served immediately if a
+	 * server is free, otherwise it takes the next FIFO slot.
+	 * @return false if the queue is full or the visitor is already queued there.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Queues")
+	bool JoinQueue(AActor* PointOfInterest, AVisitorCharacter* Visitor);
+
+	/** Removes a visitor from a point of interest, whether waiting or being served. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Queues")
+	void LeaveQueue(AActor* PointOfInterest, AVisitorCharacter* Visitor);
+
+	/**
+	 * Returns true if the visitor is waiting in line or being served at the point of interest.
+	 * Visitors leave on their own once their service completes.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Queues")
+	bool IsInQueue(AActor* PointOfInterest, const AVisitorCharacter* Visitor) const;
+
+	/** Returns true if the visitor is currently being served at the point of interest. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Queues")
+	bool IsBeingServed(AActor* PointOfInterest, const AVisitorCharacter* Visitor) const;
+
+	/** Returns true if the point of interest cannot accept another visitor. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Queues")
+	bool IsPointOfInterestFull(AActor* PointOfInterest) const;
+
+	/**
+	 * Returns the expected wait in seconds for a visitor joining the point of interest now.
+	 * Combines the explicit queue ahead of the visitor with the M/M/c steady-state
+	 * estimate, so visitors already walking there are anticipated.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Queues")
+	float GetExpectedWait(AActor* PointOfInterest) const;
+
+	/** Returns a snapshot of the queue at the given point of interest. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Queues")
+	FZooPOIQueueStats GetPointOfInterestStats(AActor* PointOfInterest) const;
+
+	// -------------------------------------------------------------------
+	//  Crowd Density
+	// -------------------------------------------------------------------
+
+	/** Returns the smoothed number of visitors in the grid cell containing the location (0 outside the grid). */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Crowd")
+	float GetCrowdDensityAtLocation(const FVector& Location) const;
+
+	/** Returns the highest smoothed density seen today in the cell containing the location. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Crowd")
+	float GetPeakCrowdDensityAtLocation(const FVector& Location) const;
+
+	/**
+	 * Returns how crowded the location feels (0-1): 0 at or below CrowdComfortCapacity,
+	 * rising to 1 at twice the comfortable density.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitors|Crowd")
+	float GetCrowdingFactor(const FVector& Location) const;
+
+	/** Clears the per-cell peaks. Called at the start of each day. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Crowd")
+	void ResetCrowdPeaks();
+
+	/**
+	 * Writes the crowd grid to Saved/Heatmaps.
+	 * PNG maps density to a color ramp; CSV writes one row of cell values per grid row.
+	 * @param Format  Output file format.
+	 * @param bPeak   Export today's peaks instead of the smoothed density.
+	 * @return The written file path, or an empty string on failure.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Visitors|Crowd")
+	FString ExportCrowdHeatmap(ECrowdHeatmapFormat Format, bool bPeak);
+
 	// -------------------------------------------------------------------
 	//  Delegates
 	// -------------------------------------------------------------------
@@ -110,6 +410,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Zoo|Visitors")
 	FOnSatisfactionChanged OnSatisfactionChanged;
 
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Visitors|Queues")
+	FOnVisitorServed OnVisitorServed;
+
 	// -------------------------------------------------------------------
 	//  State
 	// -------------------------------------------------------------------
@@ -122,10 +425,61 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors")
 	TSubclassOf<AVisitorCharacter> VisitorCharacterClass;
 
-	/** Spawn points for visitors (actors tagged "VisitorSpawn" are found at init). */
+	/** Spawn points for visitors (actors tagged "VisitorSpawn", cached by RefreshSpawnPoints). */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
 	TArray<TObjectPtr<AActor>> SpawnPoints;
 
+	/** DataTable of FVisitorTypeRow rows used to pick arriving visitor types and group sizes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors")
+	TObjectPtr<UDataTable> VisitorTypeDataTable;
+
+	/** Group size range used when no visitor type table is assigned. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Groups", meta = (ClampMin = "1"))
+	int32 DefaultMinGroupSize;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Groups", meta = (ClampMin = "1"))
+	int32 DefaultMaxGroupSize;
+
+	/** Whether visitors arrive on their own according to the arrival rate. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals")
+	bool bEnableArrivalScheduler;
+
+	/** Arrival rate (visitors per game hour) at the daily peak, before weather and rating multipliers. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals", meta = (ClampMin = "0.0"))
+	float PeakArrivalsPerHour;
+
+	/** Hour at which the gates open. No visitors arrive before this. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals", meta = (ClampMin = "0.0", ClampMax = "24.0"))
+	float OpeningHour;
+
+	/** Hour at which the gates close. No visitors arrive after this. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals", meta = (ClampMin = "0.0", ClampMax = "24.0"))
+	float ClosingHour;
+
+	/** Hour of the day at which arrivals peak. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals", meta = (ClampMin = "0.0", ClampMax = "24.0"))
+	float PeakArrivalHour;
+
+	/** Arrival rate multiplier per weather state. Missing entries count as 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals")
+	TMap<EWeatherState, float> WeatherArrivalMultipliers;
+
+	/** Maximum number of visitor actors spawned in a single frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals", meta = (ClampMin = "1"))
+	int32 MaxSpawnsPerFrame;
+
+	/** Time budget (milliseconds) for spawning visitors in a single frame. At least one spawn always happens. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Arrivals", meta = (ClampMin = "0.0"))
+	float SpawnBudgetMs;
+
+	/** Total visitors (not groups) generated by the scheduler this session. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Arrivals")
+	int32 TotalArrivals;
+
+	/** Arrivals turned away because the zoo was at capacity. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors|Arrivals")
+	int32 TurnedAwayArrivals;
+
 	/** Current number of visitors in the zoo. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
 	int32 CurrentVisitorCount;
@@ -134,8 +488,350 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitors")
 	float AverageSatisfaction;
 
+	/** Servers used for points of interest that were never explicitly configured. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Queues", meta = (ClampMin = "1"))
+	int32 DefaultPOIServers;
+
+	/** Service rate (visitors per second per server) for unconfigured points of interest. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Queues", meta = (ClampMin = "0.001"))
+	float DefaultPOIServiceRate;
+
+	/** Queue capacity for unconfigured points of interest. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Queues", meta = (ClampMin = "0"))
+	int32 DefaultPOIQueueCapacity;
+
+	/** Satisfaction (0-1 scale) a visitor loses per second spent waiting in a queue. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Queues", meta = (ClampMin = "0.0"))
+	float QueueWaitSatisfactionPenalty;
+
+	/** Needs updates per second. Each update advances every visitor by a fixed step. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "1.0"))
+	float NeedsUpdateRate;
+
+	/** Satisfaction (0-1) a newly arrived visitor starts with. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float StartingSatisfaction;
+
+	/** Hunger lost per second. Restored while buying food. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0"))
+	float HungerDecayRate;
+
+	/** Energy lost per second. Restored while resting. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0"))
+	float EnergyDecayRate;
+
+	/** Fun lost per second. Restored while viewing animals. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0"))
+	float FunDecayRate;
+
+	/** Need gained per second while the visitor is doing the activity that restores it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0"))
+	float NeedRestoreRate;
+
+	/** Satisfaction lost per second while not viewing animals or buying food. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0"))
+	float PassiveSatisfactionDecay;
+
+	/** Need level below which a need counts as unmet. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float LowNeedThreshold;
+
+	/** Satisfaction lost per second for each unmet need. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Needs", meta = (ClampMin = "0.0"))
+	float LowNeedSatisfactionPenalty;
+
+	/** World XY position of the crowd grid's minimum corner. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd")
+	FVector2D CrowdGridOrigin;
+
+	/** Number of crowd grid cells along X and Y. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd", meta = (ClampMin = "1"))
+	FIntPoint CrowdGridSize;
+
+	/** Edge length (cm) of a crowd grid cell. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd", meta = (ClampMin = "50.0"))
+	float CrowdCellSize;
+
+	/** Seconds between crowd density samples. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd", meta = (ClampMin = "0.05"))
+	float CrowdSampleInterval;
+
+	/** Weight of each new sample in the smoothed density (higher reacts faster). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float CrowdSmoothing;
+
+	/** Visitors a single cell holds before it starts to feel crowded. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd", meta = (ClampMin = "1.0"))
+	float CrowdComfortCapacity;
+
+	/** Satisfaction (0-1 scale) a visitor loses per second in a fully crowded cell. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitors|Crowd", meta = (ClampMin = "0.0"))
+	float CrowdingSatisfactionPenalty;
+
 private:
+	/**
+	 * Queue state for a single point of interest. Waiting visitors occupy a
+	 * fixed ring of FIFO slots; served visitors each hold one server with an
+	 * exponentially distributed service time.
+	 */
+	struct FPOIQueue
+	{
+		int32 Servers = 1;
+		float ServiceRate = 0.2f;
+
+		/** Ring buffer of waiting visitors, sized to the queue capacity. */
+		TArray<TWeakObjectPtr<AVisitorCharacter>> Slots;
+		int32 Head = 0;
+		int32 Count = 0;
+
+		/** Visitors being served and their remaining service time in seconds. */
+		TArray<TWeakObjectPtr<AVisitorCharacter>> InService;
+		TArray<float> ServiceTimeRemaining;
+
+		/** Arrival rate estimate (visitors per second), smoothed over sample windows. */
+		float ArrivalRate = 0.0f;
+		int32 WindowArrivals = 0;
+		float WindowElapsed = 0.0f;
+
+		int32 TotalServed = 0;
+
+		int32 Capacity() const { return Slots.Num(); }
+		TWeakObjectPtr<AVisitorCharacter>& SlotAt(int32 Index) { return Slots[(Head + Index) % Slots.Num()]; }
+		const TWeakObjectPtr<AVisitorCharacter>& SlotAt(int32 Index) const { return Slots[(Head + Index) % Slots.Num()]; }
+	};
+
+	/** Returns the queue for a point of interest, creating it with default parameters if needed. */
+	FPOIQueue& FindOrAddQueue(AActor* PointOfInterest);
+
+	/** Moves waiting visitors from the head of the queue onto free servers. */
+	void AdmitFromQueue(FPOIQueue& Queue);
+
+	/** Removes the waiting visitor at the given queue position, preserving FIFO order. */
+	static void RemoveQueueSlot(FPOIQueue& Queue, int32 Index);
+
+	/** Bins visitor positions into the crowd grid, updates smoothed and peak densities, and applies crowding penalties. */
+	void SampleCrowdDensity();
+
+	/** Resizes the crowd grid buffers if the grid dimensions changed. */
+	void EnsureCrowdGrid();
+
+	/** Returns the crowd grid cell index for a world location, or INDEX_NONE outside the grid. */
+	int32 GetCrowdCellIndex(const FVector& Location) const;
+
+	/** Writes the crowd heatmap file labelled with the given day. Backs ExportCrowdHeatmap. */
+	FString WriteCrowdHeatmap(ECrowdHeatmapFormat Format, bool bPeak, int32 Day);
+
+	/** Exports the previous day's peaks if auto-export is enabled, then starts a new day of peaks. */
+	UFUNCTION()
+	void HandleDayChanged(int32 NewDay);
+
+	/** Samples an exponentially distributed service time for the queue. */
+	static float SampleServiceTime(const FPOIQueue& Queue);
+
+	/** Expected wait for a new arrival at the given queue. */
+	static float ComputeExpectedWait(const FPOIQueue& Queue);
+
+	/** Erlang C probability that an arrival has to wait in an M/M/c queue. */
+	static float ErlangC(int32 Servers, float OfferedLoad);
+
+	/** Generates Poisson arrivals for the elapsed game time and queues them for spawning. */
+	void ScheduleArrivals(float DeltaTime);
+
+	/** Spawns queued visitors until the per-frame count or time budget is used up. */
+	void DrainSpawnQueue();
+
+	/** A visitor waiting to be spawned as part of a group. */
+	struct FPendingVisitorSpawn
+	{
+		int32 GroupID = INDEX_NONE;
+		int32 VisitorTypeIndex = INDEX_NONE;
+		int32 MemberSlot = 0;
+	};
+
+	/**
+	 * Creates a group of the given size and queues its members for spawning.
+	 * @return The number of visitors queued (0 if the group does not fit).
+	 */
+	int32 QueueGroupArrival(int32 GroupSize, int32 VisitorTypeIndex);
+
+	/** Spawns a single visitor at the next cached spawn point. */
+	AVisitorCharacter* SpawnVisitorActor(const FPendingVisitorSpawn& Pending);
+
+	/** Caches visitor type rows, spawn weights, and the average group size. */
+	void LoadVisitorTypes();
+
+	/** Picks a visitor type index by spawn weight, or INDEX_NONE if no types are loaded. */
+	int32 PickVisitorType() const;
+
+	/** Picks a group size for the given visitor type. */
+	int32 PickGroupSize(int32 VisitorTypeIndex) const;
+
+	/** Returns the formation offset (leader space) for the given member slot. Slot 0 is the leader. */
+	static FVector GetFormationOffset(int32 MemberSlot);
+
+	/**
+	 * Pooled state for a visitor group. Members[0] is the leader; when the leader
+	 * leaves early the next member is promoted.
+	 */
+	struct FVisitorGroup
+	{
+		TArray<TWeakObjectPtr<AVisitorCharacter>> Members;
+		int32 Money = 0;
+	};
+
+	/** Adds a freshly spawned visitor to its group. */
+	void AddToGroup(AVisitorCharacter* Visitor);
+
+	/** Removes a visitor from its group, promoting a new leader or dissolving the group as needed. */
+	void RemoveFromGroup(AVisitorCharacter* Visitor);
+
+	/** Sets every member's satisfaction row to the given pooled value. */
+	void SetGroupSatisfaction(const FVisitorGroup& Group, float Value);
+
+	/**
+	 * Visitor needs in struct-of-arrays layout. Row i belongs to Owners[i], whose
+	 * NeedsIndex is i. Rows are removed by swapping in the last row.
+	 */
+	struct FVisitorNeedsStore
+	{
+		TArray<AVisitorCharacter*> Owners;
+		TArray<EVisitorState> States;
+		TArray<float> Hunger;
+		TArray<float> Energy;
+		TArray<float> Fun;
+		TArray<float> Satisfaction;
+		TArray<float> TimeInZoo;
+
+		int32 Num() const { return Owners.Num(); }
+	};
+
+	/** Appends a needs row for a newly registered visitor. */
+	void AddNeedsRow(AVisitorCharacter* Visitor);
+
+	/** Removes a visitor's needs row. */
+	void RemoveNeedsRow(AVisitorCharacter* Visitor);
+
+	/** Returns the visitor's needs row, or INDEX_NONE if it has none. */
+	int32 GetNeedsRow(const AVisitorCharacter* Visitor) const;
+
+	/** Writes a satisfaction row and keeps the running sum in step. */
+	void SetSatisfactionRow(int32 Row, float Value);
+
+	/** Advances every visitor's needs and satisfaction by one fixed step. */
+	void StepNeeds(float StepSeconds);
+
+	/** Refreshes AverageSatisfaction from the running sum and broadcasts when it moved. */
+	void RefreshAverageSatisfaction();
+
+	/** Returns the opening-hours arrival curve (0-1) for the given hour of day. */
+	float GetDaypartFactor(float Hour) const;
+
+	/** Samples a unit-rate exponential variate. */
+	static float SampleUnitExponential();
+
 	/** All visitor characters currently in the zoo. */
 	UPROPERTY()
 	TArray<TObjectPtr<AVisitorCharacter>> AllVisitorCharacters;
+
+	/** Cached spawn point transforms, parallel to SpawnPoints. */
+	TArray<FTransform> SpawnTransforms;
+
+	/** Round-robin cursor into SpawnTransforms. */
+	int32 NextSpawnPointIndex = 0;
+
+	/** World time of the last spawn point scan. */
+	double LastSpawnPointScanTime = 0.0;
+
+	/** Visitors waiting to be spawned, in arrival order. */
+	TArray<FPendingVisitorSpawn> PendingSpawns;
+
+	/** Active visitor groups by ID. */
+	TMap<int32, FVisitorGroup> Groups;
+
+	/** ID assigned to the next group. */
+	int32 NextGroupID = 0;
+
+	/** Copies of the visitor type rows of VisitorTypeDataTable, which stay valid if the table is reimported. */
+	TArray<FVisitorTypeRow> VisitorTypes;
+
+	/** Row names parallel to VisitorTypes. */
+	TArray<FName> VisitorTypeNames;
+
+	/** Running sum of spawn weights parallel to VisitorTypes, for weighted picks. */
+	TArray<float> VisitorTypeCumulativeWeights;
+
+	/** The table VisitorTypes was loaded from, to detect reassignment. */
+	TWeakObjectPtr<UDataTable> LoadedVisitorTypeTable;
+
+	/** Expected group size of an arrival. */
+	float AverageGroupSize = 1.0f;
+
+	/** Expected admission per visitor from the visitor type table; unused when the table is empty. */
+	float AverageAdmission = 0.0f;
+
+	/** Integrated arrival rate since the last arrival, in expected visitors. */
+	float ArrivalHazard = 0.0f;
+
+	/** Integrated rate at which the next arrival occurs (unit exponential). */
+	float NextArrivalThreshold = 1.0f;
+
+	/** Queue state per point of interest. */
+	TMap<TWeakObjectPtr<AActor>, FPOIQueue> POIQueues;
+
+	/** Needs and satisfaction of every registered visitor. */
+	FVisitorNeedsStore Needs;
+
+	/** Sum of Needs.Satisfaction, kept up to date on every write. */
+	double SatisfactionSum = 0.0;
+
+	/** AverageSatisfaction at the last OnSatisfactionChanged broadcast. */
+	float LastBroadcastSatisfaction = 50.0f;
+
+	/** Seconds accumulated towards the next needs step. */
+	float NeedsAccumulator = 0.0f;
+
+	/** Needs steps since the satisfaction sum was last recomputed. */
+	int32 StepsSinceSatisfactionResync = 0;
+
+	/** Visitors binned into each crowd cell by the latest sample. Row-major, X fastest. */
+	TArray<uint16> CrowdCounts;
+
+	/** Smoothed visitors per crowd cell, parallel to CrowdCounts. */
+	TArray<float> CrowdDensity;
+
+	/** Highest smoothed density per crowd cell since the last peak reset. */
+	TArray<float> CrowdPeakDensity;
+
+	/** Seconds accumulated towards the next crowd sample. */
+	float CrowdSampleAccumulator = 0.0f;
+
+	/** Seconds over which POI arrivals are counted before updating the arrival rate. */
+	static constexpr float ArrivalSampleWindow = 10.0f;
+
+	/** Smoothing factor applied to each new arrival rate sample. */
+	static constexpr float ArrivalRateSmoothing = 0.3f;
+
+	/** Distance (cm) between rows of followers behind a group leader. */
+	static constexpr float FormationRowSpacing = 120.0f;
+
+	/** Sideways distance (cm) of followers from the leader's path. */
+	static constexpr float FormationSideSpacing = 70.0f;
+
+	/** Walk speed multiplier for followers so they can close gaps to the leader. */
+	static constexpr float FollowerSpeedMultiplier = 1.15f;
+
+	/** Minimum seconds between spawn point rescans while none are cached. */
+	static constexpr double SpawnPointRescanInterval = 10.0;
+
+	/** Maximum needs steps run in one frame; further backlog is dropped after a hitch. */
+	static constexpr int32 MaxNeedsStepsPerFrame = 4;
+
+	/** Visitors per ParallelFor batch in the needs step. */
+	static constexpr int32 NeedsBatchSize = 256;
+
+	/** Needs steps between exact recomputations of the satisfaction sum. */
+	static constexpr int32 SatisfactionResyncSteps = 240;
+
+	/** Width and height in pixels of one crowd cell in exported PNG heatmaps. */
+	static constexpr int32 HeatmapPixelsPerCell = 8;
 };
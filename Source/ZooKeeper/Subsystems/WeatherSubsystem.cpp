@@ -1,5 +1,6 @@
 #include "WeatherSubsystem.h"
 #include "TimeSubsystem.h"
+#include "ZooModifierSubsystem.h"
 #include "ZooKeeper.h"
 
 bool UWeatherSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -27,6 +28,9 @@ void UWeatherSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		}
 	}
 
+	Collection.InitializeDependency<UZooModifierSubsystem>();
+	ApplyWeatherModifiers();
+
 	UE_LOG(LogZooKeeper, Log, TEXT("WeatherSubsystem::Initialize - Starting weather: Clear, Period: %.0fs"),
 		WeatherChangePeriod);
 }
@@ -51,6 +55,7 @@ void UWeatherSubsystem::Tick(float DeltaTime)
 		if (NewWeather != CurrentWeather)
 		{
 			CurrentWeather = NewWeather;
+			ApplyWeatherModifiers();
 			OnWeatherChanged.Broadcast(CurrentWeather);
 
 			UE_LOG(LogZooKeeper, Log, TEXT("WeatherSubsystem - Weather changed to: %s"),
@@ -68,6 +73,7 @@ void UWeatherSubsystem::HandleSeasonChanged(int32 NewSeason)
 	if (NewWeather != CurrentWeather)
 	{
 		CurrentWeather = NewWeather;
+		ApplyWeatherModifiers();
 		OnWeatherChanged.Broadcast(CurrentWeather);
 
 		UE_LOG(LogZooKeeper, Log, TEXT("WeatherSubsystem - Season changed, new weather: %s"),
@@ -86,6 +92,7 @@ void UWeatherSubsystem::ForceWeather(EWeatherState NewWeather)
 	CurrentWeather = NewWeather;
 	WeatherChangeTimer = WeatherChangePeriod;
 
+	ApplyWeatherModifiers();
 	OnWeatherChanged.Broadcast(CurrentWeather);
 
 	UE_LOG(LogZooKeeper, Log, TEXT("WeatherSubsystem - Weather forced to: %s"),
@@ -196,3 +203,41 @@ EWeatherState UWeatherSubsystem::PickRandomWeather(int32 Season) const
 	// Fallback
 	return EWeatherState::Clear;
 }
+
+void UWeatherSubsystem::ApplyWeatherModifiers()
+{
+	UWorld* World = GetWorld();
+	UZooModifierSubsystem* ModifierSys = World ? World->GetSubsystem<UZooModifierSubsystem>() : nullptr;
+	if (!ModifierSys)
+	{
+		return;
+	}
+
+	TArray<FZooModifier> Modifiers;
+	switch (CurrentWeather)
+	{
+	case EWeatherState::Clear:
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::VisitorSpending, EZooModifierOp::Multiply, 1.1f));
+		break;
+	case EWeatherState::Cloudy:
+		break;
+	case EWeatherState::Rain:
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::VisitorSpending, EZooModifierOp::Multiply, 0.9f));
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::HappinessDecay, EZooModifierOp::Multiply, 1.1f));
+		break;
+	case EWeatherState::Storm:
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::VisitorSpending, EZooModifierOp::Multiply, 0.75f));
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::HappinessDecay, EZooModifierOp::Multiply, 1.5f));
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::BuildingConditionDecay, EZooModifierOp::Multiply, 1.5f));
+		break;
+	case EWeatherState::Snow:
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::EnergyDecay, EZooModifierOp::Multiply, 1.25f));
+		Modifiers.Add(FZooModifier::Make(EZooModifierStat::BuildingConditionDecay, EZooModifierOp::Multiply, 1.25f));
+		break;
+	case EWeatherState::Fog:
+		break;
+	}
+
+	// An empty list removes the previous weather's modifiers.
+	ModifierSys->SetSourceModifiers(FName(TEXT("Weather")), Modifiers);
+}
@@ -28,6 +28,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeatherChanged, EWeatherState, Ne
  *
  * World subsystem that simulates weather patterns for the zoo. Weather changes
  * periodically based on a configurable timer and is influenced by the current season.
+ * The current weather is pushed to UZooModifierSubsystem as the "Weather" source.
  */
 UCLASS(meta = (DisplayName = "Weather Subsystem"))
 class ZOOKEEPER_API UWeatherSubsystem : public UWorldSubsystem
@@ -118,6 +119,9 @@ private:
 	 */
 	EWeatherState PickRandomWeather(int32 Season) const;
 
+	/** Replaces the weather's gameplay modifiers with those of the current weather. */
+	void ApplyWeatherModifiers();
+
 	/** Cached season for weather selection. */
 	int32 CachedSeason;
 };
@@ -0,0 +1,447 @@
+#include "ZooMetricsSubsystem.h"
+#include "TimeSubsystem.h"
+#include "EconomySubsystem.h"
+#include "VisitorSubsystem.h"
+#include "ZooRatingSubsystem.h"
+#include "ResearchSubsystem.h"
+#include "SaveLoad/ZooSaveGame.h"
+#include "ZooKeeper.h"
+
+DECLARE_CYCLE_STAT(TEXT("Metrics Rollover"), STAT_ZooMetricsRollover, STATGROUP_ZooKeeper);
+
+// ---------------------------------------------------------------------------
+//  Buckets
+// ---------------------------------------------------------------------------
+
+void UZooMetricsSubsystem::FOpenBucket::Add(float Value)
+{
+	Min = Count > 0 ? FMath::Min(Min, Value) : Value;
+	Max = Count > 0 ? FMath::Max(Max, Value) : Value;
+	Sum += Value;
+	Last = Value;
+	Count++;
+}
+
+void UZooMetricsSubsystem::FOpenBucket::Add(const FZooMetricSample& Sample)
+{
+	// Each closed period counts once, so a coarser average weighs its periods equally.
+	Min = Count > 0 ? FMath::Min(Min, Sample.Min) : Sample.Min;
+	Max = Count > 0 ? FMath::Max(Max, Sample.Max) : Sample.Max;
+	Sum += Sample.Average;
+	Last = Sample.Last;
+	Count++;
+}
+
+FZooMetricSample UZooMetricsSubsystem::FOpenBucket::ToSample() const
+{
+	FZooMetricSample Sample;
+	Sample.Min = Min;
+	Sample.Max = Max;
+	Sample.Average = Count > 0 ? static_cast<float>(Sum / Count) : Last;
+	Sample.Last = Last;
+	return Sample;
+}
+
+void UZooMetricsSubsystem::FSeries::Push(const FZooMetricSample& Sample)
+{
+	Samples[Head] = Sample;
+	Head = (Head + 1) % Samples.Num();
+	Num = FMath::Min(Num + 1, Samples.Num());
+}
+
+// ---------------------------------------------------------------------------
+//  Subsystem
+// ---------------------------------------------------------------------------
+
+bool UZooMetricsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return true;
+}
+
+void UZooMetricsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (FMetricHistory& History : Histories)
+	{
+		for (int32 ResolutionIndex = 0; ResolutionIndex < NumResolutions; ++ResolutionIndex)
+		{
+			History.Series[ResolutionIndex].Samples.SetNumZeroed(Capacities[ResolutionIndex]);
+		}
+	}
+
+	TimeSubsystem = Collection.InitializeDependency<UTimeSubsystem>();
+	if (TimeSubsystem)
+	{
+		TimeSubsystem->OnHourChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleHourChanged);
+		TimeSubsystem->OnDayChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleDayChanged);
+		TimeSubsystem->OnSeasonChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleSeasonChanged);
+	}
+
+	RatingSubsystem = Collection.InitializeDependency<UZooRatingSubsystem>();
+	if (RatingSubsystem)
+	{
+		RatingSubsystem->OnRatingChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleRatingChanged);
+		RecordSample(EZooMetric::Rating, RatingSubsystem->GetRating());
+	}
+
+	if (UEconomySubsystem* EconSub = Collection.InitializeDependency<UEconomySubsystem>())
+	{
+		EconSub->OnFundsChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleFundsChanged);
+		RecordSample(EZooMetric::Funds, static_cast<float>(EconSub->GetBalance()));
+	}
+
+	if (UVisitorSubsystem* VisitorSub = Collection.InitializeDependency<UVisitorSubsystem>())
+	{
+		VisitorSub->OnVisitorCountChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleVisitorCountChanged);
+		VisitorSub->OnSatisfactionChanged.AddDynamic(this, &UZooMetricsSubsystem::HandleSatisfactionChanged);
+	}
+
+	ResearchSubsystem = Collection.InitializeDependency<UResearchSubsystem>();
+
+	SyncClock();
+
+	UE_LOG(LogZooKeeper, Log, TEXT("ZooMetricsSubsystem::Initialize - %d metrics at %d resolutions."), NumMetrics, NumResolutions);
+}
+
+void UZooMetricsSubsystem::Deinitialize()
+{
+	UE_LOG(LogZooKeeper, Log, TEXT("ZooMetricsSubsystem::Deinitialize"));
+
+	TimeSubsystem = nullptr;
+	RatingSubsystem = nullptr;
+	ResearchSubsystem = nullptr;
+
+	Super::Deinitialize();
+}
+
+// ---------------------------------------------------------------------------
+//  Recording
+// ---------------------------------------------------------------------------
+
+void UZooMetricsSubsystem::RecordSample(EZooMetric Metric, float Value)
+{
+	const int32 MetricIndex = static_cast<int32>(Metric);
+	if (MetricIndex < 0 || MetricIndex >= NumMetrics)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("ZooMetricsSubsystem::RecordSample - Invalid metric: %d"), MetricIndex);
+		return;
+	}
+
+	FMetricHistory& History = Histories[MetricIndex];
+	History.Open[static_cast<int32>(EZooMetricResolution::Hour)].Add(Value);
+	History.CurrentValue = Value;
+	History.bHasValue = true;
+}
+
+void UZooMetricsSubsystem::RecordPolledMetrics()
+{
+	if (RatingSubsystem)
+	{
+		RecordSample(EZooMetric::AnimalHappiness, RatingSubsystem->AnimalHappinessScore);
+	}
+
+	if (ResearchSubsystem)
+	{
+		RecordSample(EZooMetric::ResearchProgress, ResearchSubsystem->GetCurrentResearchProgress());
+	}
+}
+
+// ---------------------------------------------------------------------------
+//  Periods
+// ---------------------------------------------------------------------------
+
+void UZooMetricsSubsystem::SyncClock()
+{
+	if (!TimeSubsystem)
+	{
+		return;
+	}
+
+	OpenDay = TimeSubsystem->CurrentDay;
+	OpenHourKey = OpenDay * 24 + FMath::FloorToInt(TimeSubsystem->CurrentTimeOfDay);
+	OpenSeason = TimeSubsystem->CurrentSeason;
+}
+
+void UZooMetricsSubsystem::AdvanceClock()
+{
+	if (!TimeSubsystem)
+	{
+		return;
+	}
+
+	// The time subsystem announces a new day before the hour and season that go
+	// with it, so each period is compared on its own and closes on whichever
+	// event shows it first. Coarser periods always close after the finer ones
+	// that fold into them.
+	const int32 Day = TimeSubsystem->CurrentDay;
+	const int32 HourKey = Day * 24 + FMath::FloorToInt(TimeSubsystem->CurrentTimeOfDay);
+
+	if (HourKey != OpenHourKey)
+	{
+		RecordPolledMetrics();
+		ClosePeriod(static_cast<int32>(EZooMetricResolution::Hour));
+		OpenHourKey = HourKey;
+	}
+
+	if (Day != OpenDay)
+	{
+		ClosePeriod(static_cast<int32>(EZooMetricResolution::Day));
+		OpenDay = Day;
+	}
+
+	if (TimeSubsystem->CurrentSeason != OpenSeason)
+	{
+		ClosePeriod(static_cast<int32>(EZooMetricResolution::Season));
+		OpenSeason = TimeSubsystem->CurrentSeason;
+	}
+}
+
+void UZooMetricsSubsystem::ClosePeriod(int32 ResolutionIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ZooMetricsRollover);
+
+	const bool bHasCoarser = ResolutionIndex + 1 < NumResolutions;
+
+	for (FMetricHistory& History : Histories)
+	{
+		FOpenBucket& Open = History.Open[ResolutionIndex];
+		if (Open.Count == 0)
+		{
+			// Nothing recorded yet for this metric.
+			continue;
+		}
+
+		const FZooMetricSample Sample = Open.ToSample();
+		History.Series[ResolutionIndex].Push(Sample);
+
+		if (bHasCoarser)
+		{
+			History.Open[ResolutionIndex + 1].Add(Sample);
+		}
+
+		Open = FOpenBucket();
+
+		// A value holds until it changes, so the next hour starts from the current one.
+		if (ResolutionIndex == static_cast<int32>(EZooMetricResolution::Hour))
+		{
+			Open.Add(History.CurrentValue);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+//  Queries
+// ---------------------------------------------------------------------------
+
+float UZooMetricsSubsystem::GetCurrentValue(EZooMetric Metric) const
+{
+	const int32 MetricIndex = static_cast<int32>(Metric);
+	return MetricIndex >= 0 && MetricIndex < NumMetrics ? Histories[MetricIndex].CurrentValue : 0.0f;
+}
+
+int32 UZooMetricsSubsystem::GetSampleCount(EZooMetric Metric, EZooMetricResolution Resolution) const
+{
+	const int32 MetricIndex = static_cast<int32>(Metric);
+	const int32 ResolutionIndex = static_cast<int32>(Resolution);
+	if (MetricIndex < 0 || MetricIndex >= NumMetrics || ResolutionIndex < 0 || ResolutionIndex >= NumResolutions)
+	{
+		return 0;
+	}
+
+	return Histories[MetricIndex].Series[ResolutionIndex].Num;
+}
+
+int32 UZooMetricsSubsystem::GetCapacity(EZooMetricResolution Resolution)
+{
+	const int32 ResolutionIndex = static_cast<int32>(Resolution);
+	return ResolutionIndex >= 0 && ResolutionIndex < NumResolutions ? Capacities[ResolutionIndex] : 0;
+}
+
+void UZooMetricsSubsystem::GetSamples(EZooMetric Metric, EZooMetricResolution Resolution, int32 MaxSamples,
+	TArrayView<const FZooMetricSample>& OutOlder, TArrayView<const FZooMetricSample>& OutNewer) const
+{
+	OutOlder = TArrayView<const FZooMetricSample>();
+	OutNewer = TArrayView<const FZooMetricSample>();
+
+	const int32 MetricIndex = static_cast<int32>(Metric);
+	const int32 ResolutionIndex = static_cast<int32>(Resolution);
+	if (MetricIndex < 0 || MetricIndex >= NumMetrics || ResolutionIndex < 0 || ResolutionIndex >= NumResolutions)
+	{
+		return;
+	}
+
+	const FSeries& Series = Histories[MetricIndex].Series[ResolutionIndex];
+	const int32 Count = FMath::Clamp(MaxSamples, 0, Series.Num);
+	if (Count == 0)
+	{
+		return;
+	}
+
+	// Head is one past the newest sample; the range ends there and may wrap past index 0.
+	const int32 Capacity = Series.Samples.Num();
+	const int32 Start = (Series.Head - Count + Capacity) % Capacity;
+	const FZooMetricSample* Data = Series.Samples.GetData();
+
+	if (Start + Count <= Capacity)
+	{
+		OutOlder = TArrayView<const FZooMetricSample>(Data + Start, Count);
+	}
+	else
+	{
+		OutOlder = TArrayView<const FZooMetricSample>(Data + Start, Capacity - Start);
+		OutNewer = TArrayView<const FZooMetricSample>(Data, Count - (Capacity - Start));
+	}
+}
+
+int32 UZooMetricsSubsystem::CopySamples(EZooMetric Metric, EZooMetricResolution Resolution, TArrayView<FZooMetricSample> OutSamples) const
+{
+	TArrayView<const FZooMetricSample> Older;
+	TArrayView<const FZooMetricSample> Newer;
+	GetSamples(Metric, Resolution, OutSamples.Num(), Older, Newer);
+
+	FMemory::Memcpy(OutSamples.GetData(), Older.GetData(), Older.Num() * sizeof(FZooMetricSample));
+	FMemory::Memcpy(OutSamples.GetData() + Older.Num(), Newer.GetData(), Newer.Num() * sizeof(FZooMetricSample));
+
+	return Older.Num() + Newer.Num();
+}
+
+TArray<FZooMetricSample> UZooMetricsSubsystem::GetRecentSamples(EZooMetric Metric, EZooMetricResolution Resolution, int32 MaxSamples) const
+{
+	TArray<FZooMetricSample> Samples;
+	Samples.SetNumUninitialized(FMath::Clamp(MaxSamples, 0, GetSampleCount(Metric, Resolution)));
+	CopySamples(Metric, Resolution, Samples);
+	return Samples;
+}
+
+// ---------------------------------------------------------------------------
+//  Save / Load
+// ---------------------------------------------------------------------------
+
+void UZooMetricsSubsystem::SaveMetrics(FZooMetricsSaveData& OutData) const
+{
+	OutData.Series.Reset(NumMetrics * NumResolutions);
+	OutData.CurrentValues.Reset();
+
+	for (int32 MetricIndex = 0; MetricIndex < NumMetrics; ++MetricIndex)
+	{
+		const FMetricHistory& History = Histories[MetricIndex];
+		if (!History.bHasValue)
+		{
+			continue;
+		}
+
+		OutData.CurrentValues.Add(static_cast<uint8>(MetricIndex), History.CurrentValue);
+
+		for (int32 ResolutionIndex = 0; ResolutionIndex < NumResolutions; ++ResolutionIndex)
+		{
+			const EZooMetric Metric = static_cast<EZooMetric>(MetricIndex);
+			const EZooMetricResolution Resolution = static_cast<EZooMetricResolution>(ResolutionIndex);
+			const FOpenBucket& Open = History.Open[ResolutionIndex];
+
+			FZooMetricSeriesSaveData& SeriesData = OutData.Series.AddDefaulted_GetRef();
+			SeriesData.Metric = static_cast<uint8>(MetricIndex);
+			SeriesData.Resolution = static_cast<uint8>(ResolutionIndex);
+			SeriesData.Samples.SetNumUninitialized(GetSampleCount(Metric, Resolution));
+			CopySamples(Metric, Resolution, SeriesData.Samples);
+			SeriesData.OpenSample = Open.ToSample();
+			SeriesData.OpenCount = Open.Count;
+		}
+	}
+}
+
+void UZooMetricsSubsystem::LoadMetrics(const FZooMetricsSaveData& Data)
+{
+	for (FMetricHistory& History : Histories)
+	{
+		for (int32 ResolutionIndex = 0; ResolutionIndex < NumResolutions; ++ResolutionIndex)
+		{
+			History.Open[ResolutionIndex] = FOpenBucket();
+			History.Series[ResolutionIndex].Head = 0;
+			History.Series[ResolutionIndex].Num = 0;
+		}
+		History.CurrentValue = 0.0f;
+		History.bHasValue = false;
+	}
+
+	for (const TPair<uint8, float>& Value : Data.CurrentValues)
+	{
+		if (Value.Key < NumMetrics)
+		{
+			Histories[Value.Key].CurrentValue = Value.Value;
+			Histories[Value.Key].bHasValue = true;
+		}
+	}
+
+	for (const FZooMetricSeriesSaveData& SeriesData : Data.Series)
+	{
+		if (SeriesData.Metric >= NumMetrics || SeriesData.Resolution >= NumResolutions)
+		{
+			continue;
+		}
+
+		FMetricHistory& History = Histories[SeriesData.Metric];
+		FSeries& Series = History.Series[SeriesData.Resolution];
+
+		// Only the newest samples fit if the capacity shrank since the save.
+		const int32 FirstSample = FMath::Max(0, SeriesData.Samples.Num() - Series.Samples.Num());
+		for (int32 SampleIndex = FirstSample; SampleIndex < SeriesData.Samples.Num(); ++SampleIndex)
+		{
+			Series.Push(SeriesData.Samples[SampleIndex]);
+		}
+
+		if (SeriesData.OpenCount > 0)
+		{
+			FOpenBucket& Open = History.Open[SeriesData.Resolution];
+			Open.Sum = static_cast<double>(SeriesData.OpenSample.Average) * SeriesData.OpenCount;
+			Open.Count = SeriesData.OpenCount;
+			Open.Min = SeriesData.OpenSample.Min;
+			Open.Max = SeriesData.OpenSample.Max;
+			Open.Last = SeriesData.OpenSample.Last;
+		}
+	}
+
+	// The restored time was set directly, so the open periods are taken to be the current ones.
+	SyncClock();
+
+	UE_LOG(LogZooKeeper, Log, TEXT("ZooMetricsSubsystem - Loaded %d metric series."), Data.Series.Num());
+}
+
+// ---------------------------------------------------------------------------
+//  Event Handlers
+// ---------------------------------------------------------------------------
+
+void UZooMetricsSubsystem::HandleHourChanged(int32 NewHour)
+{
+	AdvanceClock();
+}
+
+void UZooMetricsSubsystem::HandleDayChanged(int32 NewDay)
+{
+	AdvanceClock();
+}
+
+void UZooMetricsSubsystem::HandleSeasonChanged(int32 NewSeason)
+{
+	AdvanceClock();
+}
+
+void UZooMetricsSubsystem::HandleRatingChanged(float NewRating)
+{
+	RecordSample(EZooMetric::Rating, NewRating);
+}
+
+void UZooMetricsSubsystem::HandleFundsChanged(int32 NewBalance)
+{
+	RecordSample(EZooMetric::Funds, static_cast<float>(NewBalance));
+}
+
+void UZooMetricsSubsystem::HandleVisitorCountChanged(int32 NewCount)
+{
+	RecordSample(EZooMetric::VisitorCount, static_cast<float>(NewCount));
+}
+
+void UZooMetricsSubsystem::HandleSatisfactionChanged(float NewSatisfaction)
+{
+	RecordSample(EZooMetric::VisitorSatisfaction, NewSatisfaction);
+}
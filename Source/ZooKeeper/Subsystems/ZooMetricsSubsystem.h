@@ -0,0 +1,230 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ZooMetricsSubsystem.generated.h"
+
+class UTimeSubsystem;
+class UZooRatingSubsystem;
+class UResearchSubsystem;
+struct FZooMetricsSaveData;
+
+/** Gameplay values recorded over time. */
+UENUM(BlueprintType)
+enum class EZooMetric : uint8
+{
+	Rating				UMETA(DisplayName = "Rating"),
+	Funds				UMETA(DisplayName = "Funds"),
+	VisitorCount		UMETA(DisplayName = "Visitor Count"),
+	VisitorSatisfaction	UMETA(DisplayName = "Visitor Satisfaction"),
+	AnimalHappiness		UMETA(DisplayName = "Animal Happiness"),
+	ResearchProgress	UMETA(DisplayName = "Research Progress"),
+
+	Count				UMETA(Hidden)
+};
+
+/** Length of the period each recorded sample covers. */
+UENUM(BlueprintType)
+enum class EZooMetricResolution : uint8
+{
+	Hour	UMETA(DisplayName = "Game Hour"),
+	Day		UMETA(DisplayName = "Day"),
+	Season	UMETA(DisplayName = "Season"),
+
+	Count	UMETA(Hidden)
+};
+
+/**
+ * FZooMetricSample
+ *
+ * Summary of one metric over one period.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooMetricSample
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Metrics")
+	float Min = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Metrics")
+	float Max = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Metrics")
+	float Average = 0.0f;
+
+	/** Value at the end of the period. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Metrics")
+	float Last = 0.0f;
+};
+
+/**
+ * UZooMetricsSubsystem
+ *
+ * World subsystem that records gameplay values as time series. Each metric
+ * keeps a fixed-capacity ring buffer of samples per resolution:
+ *   - Hour   - the last 72 game hours
+ *   - Day    - the last 56 days
+ *   - Season - the last 40 seasons
+ *
+ * Values are recorded as they change, from the events of the subsystems
+ * that own them, into an open hourly bucket. When the hour ends its bucket
+ * is closed into the hourly series and folded into the open daily bucket,
+ * and days fold into seasons the same way, so older history is kept only
+ * at coarser resolution. All buffers are allocated once, so memory stays
+ * constant however long the zoo runs.
+ *
+ * Reads return views into the ring buffers and do not allocate.
+ */
+UCLASS(meta = (DisplayName = "Metrics Subsystem"))
+class ZOOKEEPER_API UZooMetricsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	// -------------------------------------------------------------------
+	//  Recording
+	// -------------------------------------------------------------------
+
+	/** Records the current value of a metric into the open hourly bucket. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Metrics")
+	void RecordSample(EZooMetric Metric, float Value);
+
+	// -------------------------------------------------------------------
+	//  Queries
+	// -------------------------------------------------------------------
+
+	/** Returns the last recorded value of a metric. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Metrics")
+	float GetCurrentValue(EZooMetric Metric) const;
+
+	/** Returns the number of closed samples held for a metric at a resolution. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Metrics")
+	int32 GetSampleCount(EZooMetric Metric, EZooMetricResolution Resolution) const;
+
+	/** Returns the most samples a series can hold at a resolution. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Metrics")
+	static int32 GetCapacity(EZooMetricResolution Resolution);
+
+	/**
+	 * Returns up to MaxSamples of the newest closed samples, oldest first, without copying.
+	 * The ring buffer may wrap, so the range comes back as two views to be read in order;
+	 * either may be empty. The views stay valid until the next period closes.
+	 */
+	void GetSamples(EZooMetric Metric, EZooMetricResolution Resolution, int32 MaxSamples,
+		TArrayView<const FZooMetricSample>& OutOlder, TArrayView<const FZooMetricSample>& OutNewer) const;
+
+	/** Copies the newest closed samples, oldest first, into OutSamples. Returns the number written. */
+	int32 CopySamples(EZooMetric Metric, EZooMetricResolution Resolution, TArrayView<FZooMetricSample> OutSamples) const;
+
+	/** Blueprint access to the newest closed samples, oldest first. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Metrics")
+	TArray<FZooMetricSample> GetRecentSamples(EZooMetric Metric, EZooMetricResolution Resolution, int32 MaxSamples) const;
+
+	// -------------------------------------------------------------------
+	//  Save / Load
+	// -------------------------------------------------------------------
+
+	/** Writes every series and open bucket into save data. */
+	void SaveMetrics(FZooMetricsSaveData& OutData) const;
+
+	/** Replaces the recorded history with save data. Data that does not fit the current layout is dropped. */
+	void LoadMetrics(const FZooMetricsSaveData& Data);
+
+private:
+	static constexpr int32 NumMetrics = static_cast<int32>(EZooMetric::Count);
+	static constexpr int32 NumResolutions = static_cast<int32>(EZooMetricResolution::Count);
+	static constexpr int32 Capacities[NumResolutions] = { 72, 56, 40 };
+
+	/** Running summary of the period still in progress. */
+	struct FOpenBucket
+	{
+		double Sum = 0.0;
+		int32 Count = 0;
+		float Min = 0.0f;
+		float Max = 0.0f;
+		float Last = 0.0f;
+
+		void Add(float Value);
+		void Add(const FZooMetricSample& Sample);
+		FZooMetricSample ToSample() const;
+	};
+
+	/** Fixed-capacity ring of closed samples. */
+	struct FSeries
+	{
+		TArray<FZooMetricSample> Samples;
+		int32 Head = 0;
+		int32 Num = 0;
+
+		void Push(const FZooMetricSample& Sample);
+	};
+
+	/** Per metric: the open bucket of each resolution and the closed series. */
+	struct FMetricHistory
+	{
+		FOpenBucket Open[NumResolutions];
+		FSeries Series[NumResolutions];
+		float CurrentValue = 0.0f;
+		bool bHasValue = false;
+	};
+
+	/** Closes every period that ended since the last call. */
+	void AdvanceClock();
+
+	/** Takes the current period keys from the time subsystem without closing anything. */
+	void SyncClock();
+
+	/** Closes the open bucket of a resolution for every metric and folds it into the next one. */
+	void ClosePeriod(int32 ResolutionIndex);
+
+	/** Records the metrics that change continuously and have no change event. */
+	void RecordPolledMetrics();
+
+	// --- Time ---
+
+	UFUNCTION()
+	void HandleHourChanged(int32 NewHour);
+
+	UFUNCTION()
+	void HandleDayChanged(int32 NewDay);
+
+	UFUNCTION()
+	void HandleSeasonChanged(int32 NewSeason);
+
+	// --- Metric sources ---
+
+	UFUNCTION()
+	void HandleRatingChanged(float NewRating);
+
+	UFUNCTION()
+	void HandleFundsChanged(int32 NewBalance);
+
+	UFUNCTION()
+	void HandleVisitorCountChanged(int32 NewCount);
+
+	UFUNCTION()
+	void HandleSatisfactionChanged(float NewSatisfaction);
+
+	UPROPERTY()
+	TObjectPtr<UTimeSubsystem> TimeSubsystem;
+
+	UPROPERTY()
+	TObjectPtr<UZooRatingSubsystem> RatingSubsystem;
+
+	UPROPERTY()
+	TObjectPtr<UResearchSubsystem> ResearchSubsystem;
+
+	FMetricHistory Histories[NumMetrics];
+
+	/** Keys of the hour, day and season the open buckets belong to. */
+	int32 OpenHourKey = INDEX_NONE;
+	int32 OpenDay = INDEX_NONE;
+	int32 OpenSeason = INDEX_NONE;
+};
@@ -0,0 +1,203 @@
+#include "ZooModifierSubsystem.h"
+#include "ZooKeeper.h"
+
+bool UZooModifierSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return true;
+}
+
+void UZooModifierSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UE_LOG(LogZooKeeper, Log, TEXT("ZooModifierSubsystem::Initialize"));
+}
+
+void UZooModifierSubsystem::Deinitialize()
+{
+	UE_LOG(LogZooKeeper, Log, TEXT("ZooModifierSubsystem::Deinitialize - %d modifier sources active."), Sources.Num());
+
+	Sources.Empty();
+	for (FStatTotals& Totals : StatTotals)
+	{
+		Totals = FStatTotals();
+	}
+
+	Super::Deinitialize();
+}
+
+void UZooModifierSubsystem::SetSourceModifiers(FName SourceID, const TArray<FZooModifier>& Modifiers)
+{
+	if (SourceID.IsNone())
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("ZooModifierSubsystem::SetSourceModifiers - Invalid source ID (None)."));
+		return;
+	}
+
+	if (Modifiers.Num() == 0)
+	{
+		RemoveSource(SourceID);
+		return;
+	}
+
+	// Both the old and the new modifiers' stats change.
+	TArray<FZooModifier> Previous;
+	if (TArray<FZooModifier>* Existing = Sources.Find(SourceID))
+	{
+		Previous = MoveTemp(*Existing);
+	}
+
+	TArray<FZooModifier>& Stored = Sources.Add(SourceID, Modifiers);
+	Stored.RemoveAll([](const FZooModifier& Modifier)
+	{
+		return static_cast<int32>(Modifier.Stat) >= NumStats;
+	});
+
+	Previous.Append(Stored);
+	DirtyStats(Previous);
+
+	UE_LOG(LogZooKeeper, Verbose, TEXT("ZooModifierSubsystem - Source '%s' now has %d modifiers."),
+		*SourceID.ToString(), Stored.Num());
+}
+
+void UZooModifierSubsystem::RemoveSource(FName SourceID)
+{
+	TArray<FZooModifier> Removed;
+	if (Sources.RemoveAndCopyValue(SourceID, Removed))
+	{
+		DirtyStats(Removed);
+
+		UE_LOG(LogZooKeeper, Verbose, TEXT("ZooModifierSubsystem - Source '%s' removed."), *SourceID.ToString());
+	}
+}
+
+float UZooModifierSubsystem::GetModifiedValue(EZooModifierStat Stat, float BaseValue, const AActor* Actor,
+	const AActor* Enclosure, FName SpeciesID) const
+{
+	const int32 StatIndex = static_cast<int32>(Stat);
+	if (StatIndex < 0 || StatIndex >= NumStats)
+	{
+		return BaseValue;
+	}
+
+	FStatTotals& Totals = StatTotals[StatIndex];
+	if (Totals.bDirty)
+	{
+		RebuildStat(StatIndex);
+	}
+
+	float Add = Totals.Global.Add;
+	float Multiply = Totals.Global.Multiply;
+
+	auto Combine = [&Add, &Multiply](const FModifierTotals* Scoped)
+	{
+		if (Scoped)
+		{
+			Add += Scoped->Add;
+			Multiply *= Scoped->Multiply;
+		}
+	};
+
+	if (Enclosure && Totals.ByEnclosure.Num() > 0)
+	{
+		Combine(Totals.ByEnclosure.Find(FObjectKey(Enclosure)));
+	}
+	if (!SpeciesID.IsNone() && Totals.BySpecies.Num() > 0)
+	{
+		Combine(Totals.BySpecies.Find(SpeciesID));
+	}
+	if (Actor && Totals.ByActor.Num() > 0)
+	{
+		Combine(Totals.ByActor.Find(FObjectKey(Actor)));
+	}
+
+	return (BaseValue + Add) * Multiply;
+}
+
+uint32 UZooModifierSubsystem::GetStatVersion(EZooModifierStat Stat) const
+{
+	const int32 StatIndex = static_cast<int32>(Stat);
+	return StatIndex >= 0 && StatIndex < NumStats ? StatVersions[StatIndex] : 0;
+}
+
+void UZooModifierSubsystem::FModifierTotals::Accumulate(const FZooModifier& Modifier)
+{
+	if (Modifier.Op == EZooModifierOp::Add)
+	{
+		Add += Modifier.Value;
+	}
+	else
+	{
+		Multiply *= Modifier.Value;
+	}
+}
+
+void UZooModifierSubsystem::DirtyStats(const TArray<FZooModifier>& Modifiers)
+{
+	bool bChanged[NumStats] = {};
+	for (const FZooModifier& Modifier : Modifiers)
+	{
+		const int32 StatIndex = static_cast<int32>(Modifier.Stat);
+		if (StatIndex < NumStats)
+		{
+			bChanged[StatIndex] = true;
+		}
+	}
+
+	for (int32 StatIndex = 0; StatIndex < NumStats; ++StatIndex)
+	{
+		if (bChanged[StatIndex])
+		{
+			StatTotals[StatIndex].bDirty = true;
+			StatVersions[StatIndex]++;
+			OnModifiersChanged.Broadcast(static_cast<EZooModifierStat>(StatIndex));
+		}
+	}
+}
+
+void UZooModifierSubsystem::RebuildStat(int32 StatIndex) const
+{
+	FStatTotals& Totals = StatTotals[StatIndex];
+	Totals.Global = FModifierTotals();
+	Totals.ByEnclosure.Reset();
+	Totals.BySpecies.Reset();
+	Totals.ByActor.Reset();
+
+	for (const TPair<FName, TArray<FZooModifier>>& Source : Sources)
+	{
+		for (const FZooModifier& Modifier : Source.Value)
+		{
+			if (static_cast<int32>(Modifier.Stat) != StatIndex)
+			{
+				continue;
+			}
+
+			switch (Modifier.Scope)
+			{
+			case EZooModifierScope::Global:
+				Totals.Global.Accumulate(Modifier);
+				break;
+			case EZooModifierScope::Enclosure:
+				if (const AActor* Target = Modifier.Target.Get())
+				{
+					Totals.ByEnclosure.FindOrAdd(FObjectKey(Target)).Accumulate(Modifier);
+				}
+				break;
+			case EZooModifierScope::Species:
+				if (!Modifier.SpeciesID.IsNone())
+				{
+					Totals.BySpecies.FindOrAdd(Modifier.SpeciesID).Accumulate(Modifier);
+				}
+				break;
+			case EZooModifierScope::Actor:
+				if (const AActor* Target = Modifier.Target.Get())
+				{
+					Totals.ByActor.FindOrAdd(FObjectKey(Target)).Accumulate(Modifier);
+				}
+				break;
+			}
+		}
+	}
+
+	Totals.bDirty = false;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ZooModifierSubsystem.generated.h"
+
+class AActor;
+
+/** Gameplay rates that modifiers can change. */
+UENUM(BlueprintType)
+enum class EZooModifierStat : uint8
+{
+	/** Need decay rates of UAnimalNeedsComponent, in units per second. */
+	HungerDecay				UMETA(DisplayName = "Hunger Decay"),
+	ThirstDecay				UMETA(DisplayName = "Thirst Decay"),
+	EnergyDecay				UMETA(DisplayName = "Energy Decay"),
+	HappinessDecay			UMETA(DisplayName = "Happiness Decay"),
+	SocialDecay				UMETA(DisplayName = "Social Decay"),
+
+	/** Multiplier on what visitors pay, base 1. */
+	VisitorSpending			UMETA(DisplayName = "Visitor Spending"),
+
+	/** Rate at which buildings lose condition. */
+	BuildingConditionDecay	UMETA(DisplayName = "Building Condition Decay"),
+
+	Count					UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EZooModifierOp : uint8
+{
+	/** Added to the base value. */
+	Add			UMETA(DisplayName = "Add"),
+
+	/** Multiplies the base value plus all additions. */
+	Multiply	UMETA(DisplayName = "Multiply")
+};
+
+/** What a modifier applies to. */
+UENUM(BlueprintType)
+enum class EZooModifierScope : uint8
+{
+	Global		UMETA(DisplayName = "Global"),
+	Enclosure	UMETA(DisplayName = "Enclosure"),
+	Species		UMETA(DisplayName = "Species"),
+	Actor		UMETA(DisplayName = "Actor")
+};
+
+/**
+ * FZooModifier
+ *
+ * One change to a gameplay rate, pushed by a modifier source.
+ */
+USTRUCT(BlueprintType)
+struct ZOOKEEPER_API FZooModifier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Modifiers")
+	EZooModifierStat Stat = EZooModifierStat::HungerDecay;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Modifiers")
+	EZooModifierOp Op = EZooModifierOp::Multiply;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Modifiers")
+	float Value = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Modifiers")
+	EZooModifierScope Scope = EZooModifierScope::Global;
+
+	/** The enclosure or actor for Enclosure and Actor scopes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Modifiers")
+	TWeakObjectPtr<AActor> Target;
+
+	/** The species for Species scope. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Modifiers")
+	FName SpeciesID;
+
+	static FZooModifier Make(EZooModifierStat InStat, EZooModifierOp InOp, float InValue)
+	{
+		FZooModifier Modifier;
+		Modifier.Stat = InStat;
+		Modifier.Op = InOp;
+		Modifier.Value = InValue;
+		return Modifier;
+	}
+};
+
+/** Broadcast when the modifiers of a stat change. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnModifiersChanged, EZooModifierStat, Stat);
+
+/**
+ * UZooModifierSubsystem
+ *
+ * World subsystem that collects gameplay modifiers from sources such as
+ * weather, research, staff, enrichment and random events. Each source is
+ * identified by name and replaces its whole set of modifiers at once.
+ *
+ * Modifiers are folded into per-stat totals for each scope. The totals of a
+ * stat are rebuilt only on the first query after one of its sources
+ * changed. Each stat also has a version that changes with its modifiers, so
+ * consumers can cache their effective values and recompute them only when
+ * the version moves. An effective value is
+ * (Base + sum of additions) * product of multipliers, over the global,
+ * enclosure, species and actor scopes that match.
+ */
+UCLASS(meta = (DisplayName = "Modifier Subsystem"))
+class ZOOKEEPER_API UZooModifierSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	// -------------------------------------------------------------------
+	//  Sources
+	// -------------------------------------------------------------------
+
+	/** Replaces all modifiers of a source. An empty list removes the source. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Modifiers")
+	void SetSourceModifiers(FName SourceID, const TArray<FZooModifier>& Modifiers);
+
+	/** Removes all modifiers of a source. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Modifiers")
+	void RemoveSource(FName SourceID);
+
+	// -------------------------------------------------------------------
+	//  Queries
+	// -------------------------------------------------------------------
+
+	/**
+	 * Applies the modifiers of a stat to a base value.
+	 * @param Actor      The actor the value belongs to, for Actor-scoped modifiers (may be nullptr).
+	 * @param Enclosure  The enclosure the actor is in, for Enclosure-scoped modifiers (may be nullptr).
+	 * @param SpeciesID  The species of the actor, for Species-scoped modifiers (may be None).
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Modifiers")
+	float GetModifiedValue(EZooModifierStat Stat, float BaseValue, const AActor* Actor = nullptr,
+		const AActor* Enclosure = nullptr, FName SpeciesID = NAME_None) const;
+
+	/** Returns a counter that changes whenever the modifiers of a stat change. */
+	uint32 GetStatVersion(EZooModifierStat Stat) const;
+
+	// -------------------------------------------------------------------
+	//  Delegates
+	// -------------------------------------------------------------------
+
+	UPROPERTY(BlueprintAssignable, Category = "Zoo|Modifiers")
+	FOnModifiersChanged OnModifiersChanged;
+
+private:
+	static constexpr int32 NumStats = static_cast<int32>(EZooModifierStat::Count);
+
+	/** Combined effect of the modifiers in one scope. */
+	struct FModifierTotals
+	{
+		float Add = 0.0f;
+		float Multiply = 1.0f;
+
+		void Accumulate(const FZooModifier& Modifier);
+	};
+
+	/** Totals of one stat across all scopes, rebuilt when dirty. */
+	struct FStatTotals
+	{
+		FModifierTotals Global;
+		TMap<FObjectKey, FModifierTotals> ByEnclosure;
+		TMap<FName, FModifierTotals> BySpecies;
+		TMap<FObjectKey, FModifierTotals> ByActor;
+		bool bDirty = true;
+	};
+
+	/** Marks the stats touched by a set of modifiers dirty and broadcasts their change. */
+	void DirtyStats(const TArray<FZooModifier>& Modifiers);
+
+	/** Rebuilds the totals of a stat from every source. */
+	void RebuildStat(int32 StatIndex) const;
+
+	/** Modifiers of each source. */
+	TMap<FName, TArray<FZooModifier>> Sources;
+
+	/** Per-stat totals, rebuilt lazily from const queries. */
+	mutable FStatTotals StatTotals[NumStats];
+
+	/** Per-stat change counters. */
+	uint32 StatVersions[NumStats] = {};
+};
@@ -3,7 +3,6 @@
 #include "VisitorSubsystem.h"
 #include "StaffSubsystem.h"
 #include "BuildingManagerSubsystem.h"
-#include "TimeSubsystem.h"
 #include "Animals/AnimalBase.h"
 #include "Animals/AnimalNeedsComponent.h"
 #include "Buildings/EnclosureActor.h"
@@ -19,115 +18,311 @@ void UZooRatingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	Super::Initialize(Collection);
 
 	CurrentRating = 0.0f;
+	LastBroadcastRating = 0.0f;
 	AnimalDiversityScore = 0.0f;
 	AnimalHappinessScore = 0.0f;
 	VisitorSatisfactionScore = 0.0f;
 	EnclosureQualityScore = 0.0f;
 	AmenityScore = 0.0f;
 
-	// Subscribe to day changes to recalculate daily.
-	if (UWorld* World = GetWorld())
+	// The aggregates follow these subsystems' events, so they must exist first.
+	if (UAnimalManagerSubsystem* AnimalMgr = Collection.InitializeDependency<UAnimalManagerSubsystem>())
 	{
-		if (UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>())
-		{
-			TimeSys->OnDayChanged.AddDynamic(this, &UZooRatingSubsystem::HandleDayChanged);
-		}
+		AnimalMgr->OnAnimalAdded.AddDynamic(this, &UZooRatingSubsystem::HandleAnimalAdded);
+		AnimalMgr->OnAnimalRemoved.AddDynamic(this, &UZooRatingSubsystem::HandleAnimalRemoved);
+	}
+
+	if (UBuildingManagerSubsystem* BuildingMgr = Collection.InitializeDependency<UBuildingManagerSubsystem>())
+	{
+		BuildingMgr->OnEnclosureFormed.AddDynamic(this, &UZooRatingSubsystem::HandleEnclosureFormed);
+		BuildingMgr->OnBuildingDemolished.AddDynamic(this, &UZooRatingSubsystem::HandleBuildingDemolished);
 	}
 
+	if (UStaffSubsystem* StaffSub = Collection.InitializeDependency<UStaffSubsystem>())
+	{
+		StaffSub->OnStaffHired.AddDynamic(this, &UZooRatingSubsystem::HandleStaffHired);
+		StaffSub->OnStaffFired.AddDynamic(this, &UZooRatingSubsystem::HandleStaffFired);
+	}
+
+	if (UVisitorSubsystem* VisitorSub = Collection.InitializeDependency<UVisitorSubsystem>())
+	{
+		VisitorSub->OnSatisfactionChanged.AddDynamic(this, &UZooRatingSubsystem::HandleSatisfactionChanged);
+	}
+
+	RecalculateRating();
+
 	UE_LOG(LogZooKeeper, Log, TEXT("ZooRatingSubsystem::Initialize"));
 }
 
 void UZooRatingSubsystem::Deinitialize()
 {
 	UE_LOG(LogZooKeeper, Log, TEXT("ZooRatingSubsystem::Deinitialize - Final rating: %.2f"), CurrentRating);
+
+	ResetAggregates();
+
 	Super::Deinitialize();
 }
 
 void UZooRatingSubsystem::RecalculateRating()
 {
+	ResetAggregates();
+
 	UWorld* World = GetWorld();
 	if (!World)
 	{
 		return;
 	}
 
-	// --- Animal Diversity (0-1): based on unique species count ---
-	AnimalDiversityScore = 0.0f;
 	if (UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>())
 	{
-		TSet<FName> UniqueSpecies;
-		TArray<AAnimalBase*> Animals = AnimalMgr->GetAnimalsInEnclosure(nullptr);
-		for (AAnimalBase* Animal : Animals)
+		for (AAnimalBase* Animal : AnimalMgr->GetAnimalsInEnclosure(nullptr))
 		{
-			if (Animal && !Animal->SpeciesID.IsNone())
-			{
-				UniqueSpecies.Add(Animal->SpeciesID);
-			}
+			AddAnimal(Animal);
 		}
-		// Score: 1 species = 0.2, 5+ species = 1.0
-		AnimalDiversityScore = FMath::Clamp(static_cast<float>(UniqueSpecies.Num()) / 5.0f, 0.0f, 1.0f);
 	}
 
-	// --- Animal Happiness (0-1): average happiness across all animals ---
-	AnimalHappinessScore = 0.5f;
-	if (UAnimalManagerSubsystem* AnimalMgr = World->GetSubsystem<UAnimalManagerSubsystem>())
+	if (UBuildingManagerSubsystem* BuildingMgr = World->GetSubsystem<UBuildingManagerSubsystem>())
 	{
-		TArray<AAnimalBase*> Animals = AnimalMgr->GetAnimalsInEnclosure(nullptr);
-		if (Animals.Num() > 0)
+		for (AEnclosureActor* Enclosure : BuildingMgr->GetAllEnclosures())
 		{
-			float TotalHappiness = 0.0f;
-			int32 Count = 0;
-			for (AAnimalBase* Animal : Animals)
-			{
-				if (Animal && Animal->NeedsComponent)
-				{
-					TotalHappiness += Animal->NeedsComponent->GetNeedValue(FName("Happiness"));
-					Count++;
-				}
-			}
-			if (Count > 0)
-			{
-				AnimalHappinessScore = TotalHappiness / static_cast<float>(Count);
-			}
+			AddEnclosure(Enclosure);
 		}
 	}
 
-	// --- Visitor Satisfaction (0-1) ---
-	VisitorSatisfactionScore = 0.5f;
+	if (UStaffSubsystem* StaffSub = World->GetSubsystem<UStaffSubsystem>())
+	{
+		StaffCount = StaffSub->GetStaffCount();
+	}
+
 	if (UVisitorSubsystem* VisitorSub = World->GetSubsystem<UVisitorSubsystem>())
 	{
-		VisitorSatisfactionScore = VisitorSub->AverageSatisfaction / 100.0f;
+		VisitorSatisfaction = VisitorSub->AverageSatisfaction;
 	}
 
-	// --- Enclosure Quality (0-1): average condition across all enclosures ---
-	EnclosureQualityScore = 0.5f;
-	if (UBuildingManagerSubsystem* BuildingMgr = World->GetSubsystem<UBuildingManagerSubsystem>())
+	UpdateRating();
+}
+
+float UZooRatingSubsystem::GetVisitorSpawnMultiplier() const
+{
+	return 1.0f + CurrentRating * 0.5f;
+}
+
+// ---------------------------------------------------------------------------
+//  Event Handlers
+// ---------------------------------------------------------------------------
+
+void UZooRatingSubsystem::HandleAnimalAdded(AAnimalBase* Animal)
+{
+	AddAnimal(Animal);
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleAnimalRemoved(AAnimalBase* Animal)
+{
+	RemoveAnimal(Animal);
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleAnimalNeedChanged(AAnimalBase* Animal, FName NeedName, float NewValue)
+{
+	static const FName HappinessNeed(TEXT("Happiness"));
+	if (NeedName != HappinessNeed)
+	{
+		return;
+	}
+
+	FAnimalContribution* Contribution = Animals.Find(Animal);
+	if (!Contribution || !Contribution->bHasNeeds)
+	{
+		return;
+	}
+
+	HappinessSum += NewValue - Contribution->Happiness;
+	Contribution->Happiness = NewValue;
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleEnclosureFormed(AEnclosureActor* Enclosure)
+{
+	AddEnclosure(Enclosure);
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleBuildingDemolished(AZooBuildingActor* Building)
+{
+	if (AEnclosureActor* Enclosure = Cast<AEnclosureActor>(Building))
+	{
+		RemoveEnclosure(Enclosure);
+		UpdateRating();
+	}
+}
+
+void UZooRatingSubsystem::HandleEnclosureQualityChanged(AEnclosureActor* Enclosure, float NewQuality)
+{
+	float* Quality = EnclosureQualities.Find(Enclosure);
+	if (!Quality)
+	{
+		return;
+	}
+
+	QualitySum += NewQuality - *Quality;
+	*Quality = NewQuality;
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleStaffHired(int32 StaffID)
+{
+	StaffCount++;
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleStaffFired(int32 StaffID)
+{
+	StaffCount = FMath::Max(StaffCount - 1, 0);
+	UpdateRating();
+}
+
+void UZooRatingSubsystem::HandleSatisfactionChanged(float NewSatisfaction)
+{
+	VisitorSatisfaction = NewSatisfaction;
+	UpdateRating();
+}
+
+// ---------------------------------------------------------------------------
+//  Aggregates
+// ---------------------------------------------------------------------------
+
+void UZooRatingSubsystem::AddAnimal(AAnimalBase* Animal)
+{
+	if (!Animal || Animals.Contains(Animal))
+	{
+		return;
+	}
+
+	FAnimalContribution& Contribution = Animals.Add(Animal);
+	Contribution.SpeciesID = Animal->SpeciesID;
+
+	if (!Contribution.SpeciesID.IsNone())
 	{
-		TArray<AEnclosureActor*> Enclosures = BuildingMgr->GetAllEnclosures();
-		if (Enclosures.Num() > 0)
+		SpeciesCounts.FindOrAdd(Contribution.SpeciesID)++;
+	}
+
+	if (Animal->NeedsComponent)
+	{
+		Contribution.bHasNeeds = true;
+		Contribution.Happiness = Animal->NeedsComponent->GetNeedValue(FName("Happiness"));
+		HappinessSum += Contribution.Happiness;
+		HappinessCount++;
+	}
+
+	Animal->OnAnimalNeedChanged.AddDynamic(this, &UZooRatingSubsystem::HandleAnimalNeedChanged);
+}
+
+void UZooRatingSubsystem::RemoveAnimal(AAnimalBase* Animal)
+{
+	FAnimalContribution Contribution;
+	if (!Animals.RemoveAndCopyValue(Animal, Contribution))
+	{
+		return;
+	}
+
+	if (!Contribution.SpeciesID.IsNone())
+	{
+		int32& Count = SpeciesCounts.FindChecked(Contribution.SpeciesID);
+		if (--Count <= 0)
 		{
-			float TotalCondition = 0.0f;
-			for (AEnclosureActor* Enc : Enclosures)
-			{
-				if (Enc)
-				{
-					TotalCondition += Enc->Condition;
-				}
-			}
-			EnclosureQualityScore = TotalCondition / static_cast<float>(Enclosures.Num());
+			SpeciesCounts.Remove(Contribution.SpeciesID);
 		}
 	}
 
-	// --- Path & Amenities (0-1): based on staff count as proxy ---
-	AmenityScore = 0.3f;
-	if (UStaffSubsystem* StaffSub = World->GetSubsystem<UStaffSubsystem>())
+	if (Contribution.bHasNeeds)
+	{
+		HappinessSum -= Contribution.Happiness;
+		HappinessCount--;
+	}
+
+	if (Animal)
+	{
+		Animal->OnAnimalNeedChanged.RemoveDynamic(this, &UZooRatingSubsystem::HandleAnimalNeedChanged);
+	}
+}
+
+void UZooRatingSubsystem::AddEnclosure(AEnclosureActor* Enclosure)
+{
+	if (!Enclosure || EnclosureQualities.Contains(Enclosure))
+	{
+		return;
+	}
+
+	const float Quality = Enclosure->GetQualityScore();
+	EnclosureQualities.Add(Enclosure, Quality);
+	QualitySum += Quality;
+
+	Enclosure->OnQualityChanged.AddDynamic(this, &UZooRatingSubsystem::HandleEnclosureQualityChanged);
+}
+
+void UZooRatingSubsystem::RemoveEnclosure(AEnclosureActor* Enclosure)
+{
+	float Quality = 0.0f;
+	if (!EnclosureQualities.RemoveAndCopyValue(Enclosure, Quality))
+	{
+		return;
+	}
+
+	QualitySum -= Quality;
+
+	if (Enclosure)
 	{
-		// Having 5+ staff members gives full amenity score.
-		AmenityScore = FMath::Clamp(static_cast<float>(StaffSub->GetStaffCount()) / 5.0f, 0.0f, 1.0f);
+		Enclosure->OnQualityChanged.RemoveDynamic(this, &UZooRatingSubsystem::HandleEnclosureQualityChanged);
 	}
+}
+
+void UZooRatingSubsystem::ResetAggregates()
+{
+	for (const TPair<TWeakObjectPtr<AAnimalBase>, FAnimalContribution>& Pair : Animals)
+	{
+		if (AAnimalBase* Animal = Pair.Key.Get())
+		{
+			Animal->OnAnimalNeedChanged.RemoveDynamic(this, &UZooRatingSubsystem::HandleAnimalNeedChanged);
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<AEnclosureActor>, float>& Pair : EnclosureQualities)
+	{
+		if (AEnclosureActor* Enclosure = Pair.Key.Get())
+		{
+			Enclosure->OnQualityChanged.RemoveDynamic(this, &UZooRatingSubsystem::HandleEnclosureQualityChanged);
+		}
+	}
+
+	Animals.Empty();
+	SpeciesCounts.Empty();
+	HappinessSum = 0.0;
+	HappinessCount = 0;
+	EnclosureQualities.Empty();
+	QualitySum = 0.0;
+	StaffCount = 0;
+	VisitorSatisfaction = 50.0f;
+}
+
+void UZooRatingSubsystem::UpdateRating()
+{
+	// --- Animal Diversity (0-1): 1 species = 0.2, 5+ species = 1.0 ---
+	AnimalDiversityScore = FMath::Clamp(static_cast<float>(SpeciesCounts.Num()) / 5.0f, 0.0f, 1.0f);
+
+	// --- Animal Happiness (0-1): average happiness across all animals ---
+	AnimalHappinessScore = HappinessCount > 0 ? static_cast<float>(HappinessSum / HappinessCount) : 0.5f;
+
+	// --- Visitor Satisfaction (0-1) ---
+	VisitorSatisfactionScore = VisitorSatisfaction / 100.0f;
+
+	// --- Enclosure Quality (0-1): average quality score across all enclosures ---
+	EnclosureQualityScore = EnclosureQualities.Num() > 0 ? static_cast<float>(QualitySum / EnclosureQualities.Num()) : 0.5f;
+
+	// --- Path & Amenities (0-1): staff count as proxy, 5+ staff gives the full score ---
+	AmenityScore = FMath::Clamp(static_cast<float>(StaffCount) / 5.0f, 0.0f, 1.0f);
 
 	// --- Weighted total (0-5 stars) ---
-	const float OldRating = CurrentRating;
 	CurrentRating = (
 		AnimalDiversityScore * 0.25f +
 		AnimalHappinessScore * 0.25f +
@@ -138,19 +333,11 @@ void UZooRatingSubsystem::RecalculateRating()
 
 	CurrentRating = FMath::Clamp(CurrentRating, 0.0f, 5.0f);
 
-	if (!FMath::IsNearlyEqual(OldRating, CurrentRating, 0.05f))
+	// Compared against the last broadcast, so a slow drift is still reported.
+	if (!FMath::IsNearlyEqual(LastBroadcastRating, CurrentRating, 0.05f))
 	{
+		UE_LOG(LogZooKeeper, Verbose, TEXT("ZooRatingSubsystem - Rating changed: %.2f -> %.2f stars"), LastBroadcastRating, CurrentRating);
+		LastBroadcastRating = CurrentRating;
 		OnRatingChanged.Broadcast(CurrentRating);
-		UE_LOG(LogZooKeeper, Log, TEXT("ZooRatingSubsystem - Rating changed: %.2f -> %.2f stars"), OldRating, CurrentRating);
 	}
 }
-
-float UZooRatingSubsystem::GetVisitorSpawnMultiplier() const
-{
-	return 1.0f + CurrentRating * 0.5f;
-}
-
-void UZooRatingSubsystem::HandleDayChanged(int32 NewDay)
-{
-	RecalculateRating();
-}
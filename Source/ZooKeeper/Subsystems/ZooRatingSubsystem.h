@@ -4,6 +4,10 @@
 #include "Subsystems/WorldSubsystem.h"
 #include "ZooRatingSubsystem.generated.h"
 
+class AAnimalBase;
+class AEnclosureActor;
+class AZooBuildingActor;
+
 /** Broadcast when the zoo's star rating changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRatingChanged, float, NewRating);
 
@@ -18,6 +22,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRatingChanged, float, NewRating);
  *   - EnclosureQuality (0.15)
  *   - PathAndAmenities (0.15)
  * Drives visitor spawn rate: VisitorsPerHour = BaseRate * (1 + Rating * 0.5).
+ *
+ * The factors come from running aggregates (happiness sum, species counts,
+ * enclosure quality sum, staff count, visitor satisfaction) that are
+ * updated from animal, building, staff, and visitor events, so the rating
+ * is always current and costs O(1) to update.
  */
 UCLASS(meta = (DisplayName = "Zoo Rating Subsystem"))
 class ZOOKEEPER_API UZooRatingSubsystem : public UWorldSubsystem
@@ -31,7 +40,10 @@ public:
 	virtual void Deinitialize() override;
 	//~ End USubsystem Interface
 
-	/** Recalculates the zoo rating from all contributing factors. */
+	/**
+	 * Rebuilds the running aggregates from scratch and updates the rating.
+	 * Only needed when state changed without events, e.g. after loading a save.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Rating")
 	void RecalculateRating();
 
@@ -73,7 +85,89 @@ public:
 	float AmenityScore;
 
 private:
-	/** Called when the day changes to recalculate the rating. */
+	// -------------------------------------------------------------------
+	//  Event Handlers
+	// -------------------------------------------------------------------
+
+	UFUNCTION()
+	void HandleAnimalAdded(AAnimalBase* Animal);
+
+	UFUNCTION()
+	void HandleAnimalRemoved(AAnimalBase* Animal);
+
+	UFUNCTION()
+	void HandleAnimalNeedChanged(AAnimalBase* Animal, FName NeedName, float NewValue);
+
+	UFUNCTION()
+	void HandleEnclosureFormed(AEnclosureActor* Enclosure);
+
+	UFUNCTION()
+	void HandleBuildingDemolished(AZooBuildingActor* Building);
+
 	UFUNCTION()
-	void HandleDayChanged(int32 NewDay);
+	void HandleEnclosureQualityChanged(AEnclosureActor* Enclosure, float NewQuality);
+
+	UFUNCTION()
+	void HandleStaffHired(int32 StaffID);
+
+	UFUNCTION()
+	void HandleStaffFired(int32 StaffID);
+
+	UFUNCTION()
+	void HandleSatisfactionChanged(float NewSatisfaction);
+
+	// -------------------------------------------------------------------
+	//  Aggregates
+	// -------------------------------------------------------------------
+
+	/** Adds an animal to the aggregates and subscribes to its needs. */
+	void AddAnimal(AAnimalBase* Animal);
+
+	/** Removes an animal from the aggregates and unsubscribes from it. */
+	void RemoveAnimal(AAnimalBase* Animal);
+
+	/** Adds an enclosure to the aggregates and subscribes to its quality. */
+	void AddEnclosure(AEnclosureActor* Enclosure);
+
+	/** Removes an enclosure from the aggregates and unsubscribes from it. */
+	void RemoveEnclosure(AEnclosureActor* Enclosure);
+
+	/** Unsubscribes from every tracked animal and enclosure and clears the aggregates. */
+	void ResetAggregates();
+
+	/** Derives the factor scores and rating from the aggregates and broadcasts a change. */
+	void UpdateRating();
+
+	/** What an animal currently contributes to the aggregates. */
+	struct FAnimalContribution
+	{
+		FName SpeciesID;
+		float Happiness = 0.0f;
+		bool bHasNeeds = false;
+	};
+
+	/** Tracked animals and their current contribution. */
+	TMap<TWeakObjectPtr<AAnimalBase>, FAnimalContribution> Animals;
+
+	/** Number of tracked animals per species. */
+	TMap<FName, int32> SpeciesCounts;
+
+	/** Sum of happiness over animals with needs, and how many there are. */
+	double HappinessSum = 0.0;
+	int32 HappinessCount = 0;
+
+	/** Tracked enclosures and their last known quality score. */
+	TMap<TWeakObjectPtr<AEnclosureActor>, float> EnclosureQualities;
+
+	/** Sum of EnclosureQualities. */
+	double QualitySum = 0.0;
+
+	/** Number of staff on the payroll. */
+	int32 StaffCount = 0;
+
+	/** Average visitor satisfaction (0-100). */
+	float VisitorSatisfaction = 50.0f;
+
+	/** Rating at the last OnRatingChanged broadcast. */
+	float LastBroadcastRating = 0.0f;
 };
@@ -9,8 +9,11 @@
 #include "Components/TextBlock.h"
 #include "Components/ScrollBox.h"
 #include "Components/PanelWidget.h"
+#include "Components/ProgressBar.h"
+#include "Components/SizeBox.h"
 #include "Blueprint/WidgetTree.h"
 #include "Subsystems/EconomySubsystem.h"
+#include "Subsystems/TimeSubsystem.h"
 #include "ZooKeeper.h"
 
 TSharedRef<SWidget> UFinancePanelWidget::RebuildWidget()
@@ -111,6 +114,57 @@ TSharedRef<SWidget> UFinancePanelWidget::RebuildWidget()
 		NetProfitText->SetColorAndOpacity(FSlateColor(FLinearColor::White));
 		NetRow->AddChildToHorizontalBox(NetProfitText);
 
+		// --- Net Profit History ---
+		HistoryRangeText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("HistoryRange"));
+		HistoryRangeText->SetText(FText::FromString(FString::Printf(TEXT("Net Profit, last %d days:"), HistoryDays)));
+		HistoryRangeText->SetFont(LabelFont);
+		HistoryRangeText->SetColorAndOpacity(FSlateColor(FLinearColor(0.8f, 0.8f, 0.8f)));
+		MainLayout->AddChildToVerticalBox(HistoryRangeText)->SetPadding(FMargin(0.0f, 0.0f, 0.0f, 4.0f));
+
+		USizeBox* ChartBox = WidgetTree->ConstructWidget<USizeBox>(USizeBox::StaticClass(), TEXT("HistoryChartBox"));
+		ChartBox->SetHeightOverride(HistoryChartHeight);
+		MainLayout->AddChildToVerticalBox(ChartBox)->SetPadding(FMargin(0.0f, 0.0f, 0.0f, 8.0f));
+
+		UHorizontalBox* Chart = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass(), TEXT("HistoryChart"));
+		ChartBox->AddChild(Chart);
+
+		HistoryBars.Reset();
+		for (int32 i = 0; i < HistoryBarCount; ++i)
+		{
+			UProgressBar* Bar = WidgetTree->ConstructWidget<UProgressBar>(UProgressBar::StaticClass(),
+				*FString::Printf(TEXT("HistoryBar_%d"), i));
+			Bar->SetBarFillType(EProgressBarFillType::BottomToTop);
+			Bar->SetPercent(0.0f);
+			UHorizontalBoxSlot* BarSlot = Chart->AddChildToHorizontalBox(Bar);
+			BarSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
+			BarSlot->SetPadding(FMargin(1.0f, 0.0f));
+			HistoryBars.Add(Bar);
+		}
+
+		// --- Forecast ---
+		ForecastText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("ForecastText"));
+		ForecastText->SetText(FText::FromString(TEXT("Forecast: calculating...")));
+		ForecastText->SetFont(LabelFont);
+		ForecastText->SetColorAndOpacity(FSlateColor(FLinearColor(0.8f, 0.8f, 0.8f)));
+		MainLayout->AddChildToVerticalBox(ForecastText)->SetPadding(FMargin(0.0f, 0.0f, 0.0f, 4.0f));
+
+		UHorizontalBox* RiskRow = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass(), TEXT("RiskRow"));
+		MainLayout->AddChildToVerticalBox(RiskRow)->SetPadding(FMargin(0.0f, 0.0f, 0.0f, 8.0f));
+
+		BankruptcyRiskText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("BankruptcyRisk"));
+		BankruptcyRiskText->SetText(FText::FromString(TEXT("Bankruptcy risk: --")));
+		BankruptcyRiskText->SetFont(LabelFont);
+		BankruptcyRiskText->SetColorAndOpacity(FSlateColor(FLinearColor::White));
+		UHorizontalBoxSlot* RiskTextSlot = RiskRow->AddChildToHorizontalBox(BankruptcyRiskText);
+		RiskTextSlot->SetPadding(FMargin(0.0f, 0.0f, 8.0f, 0.0f));
+		RiskTextSlot->SetVerticalAlignment(VAlign_Center);
+
+		BankruptcyRiskBar = WidgetTree->ConstructWidget<UProgressBar>(UProgressBar::StaticClass(), TEXT("BankruptcyRiskBar"));
+		BankruptcyRiskBar->SetPercent(0.0f);
+		UHorizontalBoxSlot* RiskBarSlot = RiskRow->AddChildToHorizontalBox(BankruptcyRiskBar);
+		RiskBarSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
+		RiskBarSlot->SetVerticalAlignment(VAlign_Center);
+
 		// --- Transaction History Header ---
 		UTextBlock* TxnHeader = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("TxnHeader"));
 		TxnHeader->SetText(FText::FromString(TEXT("Recent Transactions:")));
@@ -128,6 +182,41 @@ TSharedRef<SWidget> UFinancePanelWidget::RebuildWidget()
 	return Super::RebuildWidget();
 }
 
+void UFinancePanelWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	if (UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>())
+	{
+		EconSys->OnForecastUpdated.AddDynamic(this, &UFinancePanelWidget::HandleForecastUpdated);
+		EconSys->OnTransactionBatch.AddDynamic(this, &UFinancePanelWidget::HandleTransactionBatch);
+	}
+	else
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("FinancePanelWidget: EconomySubsystem not found during NativeConstruct."));
+	}
+}
+
+void UFinancePanelWidget::NativeDestruct()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>())
+		{
+			EconSys->OnForecastUpdated.RemoveDynamic(this, &UFinancePanelWidget::HandleForecastUpdated);
+			EconSys->OnTransactionBatch.RemoveDynamic(this, &UFinancePanelWidget::HandleTransactionBatch);
+		}
+	}
+
+	Super::NativeDestruct();
+}
+
 void UFinancePanelWidget::UpdateFinanceDisplay()
 {
 	UWorld* World = GetWorld();
@@ -218,15 +307,116 @@ void UFinancePanelWidget::RefreshReport()
 		TransactionListPanel->ClearChildren();
 	}
 
-	FZooDailyFinanceReport Report = EconSys->GetDailyReport();
+	const FZooDailyFinanceReport Report = EconSys->GetDailyReport();
+	const TArray<FZooTransaction> Transactions = EconSys->GetDailyTransactions(Report.Day);
 
-	for (const FZooTransaction& Transaction : Report.Transactions)
+	for (const FZooTransaction& Transaction : Transactions)
 	{
 		AddTransactionEntry(Transaction);
 	}
 
 	UpdateFinanceDisplay();
+	RefreshHistoryChart();
+	UpdateForecastDisplay(EconSys->GetLatestForecast());
+	EconSys->RequestForecast();
 
 	UE_LOG(LogZooKeeper, Log, TEXT("FinancePanelWidget: Report refreshed with %d transactions."),
-		Report.Transactions.Num());
+		Transactions.Num());
+}
+
+void UFinancePanelWidget::RefreshHistoryChart()
+{
+	UWorld* World = GetWorld();
+	if (!World || HistoryBars.Num() == 0)
+	{
+		return;
+	}
+
+	UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>();
+	if (!EconSys)
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("FinancePanelWidget: EconomySubsystem not found during RefreshHistoryChart."));
+		return;
+	}
+
+	const UTimeSubsystem* TimeSys = World->GetSubsystem<UTimeSubsystem>();
+	const int32 LastDay = TimeSys ? TimeSys->CurrentDay : 0;
+	const int32 FirstDay = LastDay - HistoryDays + 1;
+
+	const TArray<FZooFinanceHistoryBucket> Buckets = EconSys->GetFinanceHistory(FirstDay, LastDay, HistoryBars.Num());
+
+	// Bars are scaled to the largest swing so both profit and loss stay readable.
+	int32 MaxSwing = 1;
+	for (const FZooFinanceHistoryBucket& Bucket : Buckets)
+	{
+		MaxSwing = FMath::Max(MaxSwing, FMath::Abs(Bucket.NetProfit));
+	}
+
+	for (int32 i = 0; i < HistoryBars.Num(); ++i)
+	{
+		UProgressBar* Bar = HistoryBars[i];
+		if (!Bar)
+		{
+			continue;
+		}
+
+		const int32 NetProfit = Buckets.IsValidIndex(i) ? Buckets[i].NetProfit : 0;
+		Bar->SetPercent(static_cast<float>(FMath::Abs(NetProfit)) / MaxSwing);
+		Bar->SetFillColorAndOpacity(NetProfit >= 0 ? FLinearColor(0.3f, 1.0f, 0.3f) : FLinearColor(1.0f, 0.4f, 0.4f));
+	}
+}
+
+void UFinancePanelWidget::UpdateForecastDisplay(const FZooFinanceForecast& Forecast)
+{
+	if (Forecast.Days.Num() == 0)
+	{
+		return;
+	}
+
+	const FZooForecastDay& LastDay = Forecast.Days.Last();
+
+	if (ForecastText)
+	{
+		ForecastText->SetText(FText::FromString(FString::Printf(TEXT("In %d days: $%d (likely $%d to $%d)"),
+			Forecast.Days.Num(), LastDay.P50, LastDay.P5, LastDay.P95)));
+	}
+
+	const FLinearColor RiskColor = Forecast.BankruptcyProbability >= 0.25f ? FLinearColor(1.0f, 0.4f, 0.4f)
+		: Forecast.BankruptcyProbability >= 0.05f ? FLinearColor(1.0f, 0.8f, 0.3f)
+		: FLinearColor(0.3f, 1.0f, 0.3f);
+
+	if (BankruptcyRiskText)
+	{
+		BankruptcyRiskText->SetText(FText::FromString(FString::Printf(TEXT("Bankruptcy risk: %.0f%%"),
+			Forecast.BankruptcyProbability * 100.0f)));
+		BankruptcyRiskText->SetColorAndOpacity(FSlateColor(RiskColor));
+	}
+
+	if (BankruptcyRiskBar)
+	{
+		BankruptcyRiskBar->SetPercent(Forecast.BankruptcyProbability);
+		BankruptcyRiskBar->SetFillColorAndOpacity(RiskColor);
+	}
+}
+
+void UFinancePanelWidget::HandleForecastUpdated(const FZooFinanceForecast& Forecast)
+{
+	UpdateForecastDisplay(Forecast);
+}
+
+void UFinancePanelWidget::HandleTransactionBatch(const FZooTransactionBatch& Batch)
+{
+	// Hidden panels do not keep the forecast running.
+	if (!IsVisible())
+	{
+		return;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>())
+		{
+			EconSys->RequestForecast();
+		}
+	}
 }
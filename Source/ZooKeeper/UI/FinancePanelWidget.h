@@ -6,14 +6,19 @@
 
 class UTextBlock;
 class UPanelWidget;
+class UProgressBar;
 struct FZooTransaction;
+struct FZooTransactionBatch;
+struct FZooFinanceForecast;
 
 /**
  * UFinancePanelWidget
  *
  * Widget that displays the zoo's financial information, including current
- * funds, daily income, daily expenses, net profit, and a scrollable list
- * of recent transactions.
+ * funds, daily income, daily expenses, net profit, a chart of net profit
+ * over the last months, a forecast of the balance with its bankruptcy
+ * risk, and a scrollable list of recent transactions. While visible, the
+ * forecast is re-requested whenever money moves.
  * Builds its widget tree entirely in C++ — no Blueprint asset required.
  */
 UCLASS(meta = (DisplayName = "Finance Panel Widget"))
@@ -35,10 +40,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Finance")
 	void RefreshReport();
 
+	/** Redraws the net profit history chart. Reuses the same bars, so cost does not grow with history length. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Finance")
+	void RefreshHistoryChart();
+
+	/** Shows the percentile band and bankruptcy risk of a forecast. */
+	UFUNCTION(BlueprintCallable, Category = "Zoo|Finance")
+	void UpdateForecastDisplay(const FZooFinanceForecast& Forecast);
+
 protected:
 	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 private:
+	UFUNCTION()
+	void HandleForecastUpdated(const FZooFinanceForecast& Forecast);
+
+	UFUNCTION()
+	void HandleTransactionBatch(const FZooTransactionBatch& Batch);
+
 	UPROPERTY()
 	TObjectPtr<UTextBlock> CurrentFundsText;
 
@@ -53,4 +74,29 @@ private:
 
 	UPROPERTY()
 	TObjectPtr<UPanelWidget> TransactionListPanel;
+
+	UPROPERTY()
+	TObjectPtr<UTextBlock> HistoryRangeText;
+
+	/** One bar per history bucket, oldest first. */
+	UPROPERTY()
+	TArray<TObjectPtr<UProgressBar>> HistoryBars;
+
+	UPROPERTY()
+	TObjectPtr<UTextBlock> ForecastText;
+
+	UPROPERTY()
+	TObjectPtr<UTextBlock> BankruptcyRiskText;
+
+	UPROPERTY()
+	TObjectPtr<UProgressBar> BankruptcyRiskBar;
+
+	/** Number of bars in the history chart. */
+	static constexpr int32 HistoryBarCount = 30;
+
+	/** In-game days covered by the history chart. */
+	static constexpr int32 HistoryDays = 120;
+
+	/** Height of the history chart in slate units. */
+	static constexpr float HistoryChartHeight = 80.0f;
 };
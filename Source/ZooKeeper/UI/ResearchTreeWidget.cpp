@@ -88,11 +88,115 @@ TSharedRef<SWidget> UResearchTreeWidget::RebuildWidget()
 		CompletedHeader->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
 		UVerticalBoxSlot* CompHeaderSlot = MainLayout->AddChildToVerticalBox(CompletedHeader);
 		CompHeaderSlot->SetPadding(FMargin(0.0f, 8.0f, 0.0f, 4.0f));
+
+		// --- Completed Nodes ---
+		UVerticalBox* CompletedBox = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("CompletedBox"));
+		MainLayout->AddChildToVerticalBox(CompletedBox);
+		CompletedNodesPanel = CompletedBox;
+
+		EmptyResearchText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("EmptyResearch"));
+		EmptyResearchText->SetText(FText::FromString(TEXT("No research available.")));
+		FSlateFontInfo EmptyFont = EmptyResearchText->GetFont();
+		EmptyFont.Size = 11;
+		EmptyResearchText->SetFont(EmptyFont);
+		EmptyResearchText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
+		NodesScroll->AddChild(EmptyResearchText);
 	}
 
 	return Super::RebuildWidget();
 }
 
+void UResearchTreeWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	if (UResearchSubsystem* ResearchSub = World->GetSubsystem<UResearchSubsystem>())
+	{
+		ResearchSub->OnResearchStarted.AddDynamic(this, &UResearchTreeWidget::HandleResearchChanged);
+		ResearchSub->OnResearchCompleted.AddDynamic(this, &UResearchTreeWidget::HandleResearchChanged);
+	}
+	else
+	{
+		UE_LOG(LogZooKeeper, Warning, TEXT("ResearchTreeWidget: ResearchSubsystem not found during NativeConstruct."));
+	}
+}
+
+void UResearchTreeWidget::NativeDestruct()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UResearchSubsystem* ResearchSub = World->GetSubsystem<UResearchSubsystem>())
+		{
+			ResearchSub->OnResearchStarted.RemoveDynamic(this, &UResearchTreeWidget::HandleResearchChanged);
+			ResearchSub->OnResearchCompleted.RemoveDynamic(this, &UResearchTreeWidget::HandleResearchChanged);
+		}
+	}
+
+	Super::NativeDestruct();
+}
+
+void UResearchTreeWidget::HandleResearchChanged(FName ResearchID)
+{
+	RefreshResearchTree();
+}
+
+void UResearchTreeWidget::BuildTopicRows(const UResearchSubsystem* ResearchSub)
+{
+	for (UTextBlock* Row : AvailableRows)
+	{
+		Row->RemoveFromParent();
+	}
+	for (UTextBlock* Row : CompletedRows)
+	{
+		Row->RemoveFromParent();
+	}
+	AvailableRows.Reset();
+	CompletedRows.Reset();
+
+	TopicIDs = ResearchSub->GetAllResearchTopics();
+
+	for (int32 NodeIndex = 0; NodeIndex < TopicIDs.Num(); ++NodeIndex)
+	{
+		const FName& TopicID = TopicIDs[NodeIndex];
+		FString DisplayName = TopicID.ToString();
+		FString AvailableStr = FString::Printf(TEXT("  [Start] %s"), *DisplayName);
+
+		if (const FResearchNodeData* Node = ResearchSub->GetResearchNode(TopicID))
+		{
+			DisplayName = Node->DisplayName.ToString();
+			AvailableStr = FString::Printf(TEXT("  [Start] %s  |  %.0fs  |  $%d"),
+				*DisplayName, Node->ResearchDuration, Node->ResearchCost);
+		}
+
+		UTextBlock* NodeText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(),
+			*FString::Printf(TEXT("ResearchNode_%d"), NodeIndex));
+		NodeText->SetText(FText::FromString(AvailableStr));
+		FSlateFontInfo NodeFont = NodeText->GetFont();
+		NodeFont.Size = 12;
+		NodeText->SetFont(NodeFont);
+		NodeText->SetColorAndOpacity(FSlateColor(FLinearColor(0.3f, 1.0f, 0.3f)));
+		ResearchNodesPanel->AddChild(NodeText);
+		AvailableRows.Add(NodeText);
+
+		UTextBlock* DoneText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(),
+			*FString::Printf(TEXT("CompletedNode_%d"), NodeIndex));
+		DoneText->SetText(FText::FromString(FString::Printf(TEXT("  %s"), *DisplayName)));
+		DoneText->SetFont(NodeFont);
+		DoneText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
+		if (CompletedNodesPanel)
+		{
+			CompletedNodesPanel->AddChild(DoneText);
+		}
+		CompletedRows.Add(DoneText);
+	}
+}
+
 void UResearchTreeWidget::RefreshResearchTree()
 {
 	if (!ResearchNodesPanel)
@@ -101,8 +205,6 @@ void UResearchTreeWidget::RefreshResearchTree()
 		return;
 	}
 
-	ResearchNodesPanel->ClearChildren();
-
 	UWorld* World = GetWorld();
 	if (!World)
 	{
@@ -115,49 +217,31 @@ void UResearchTreeWidget::RefreshResearchTree()
 		return;
 	}
 
-	// Populate available research nodes
-	TArray<FName> Available = ResearchSub->GetAvailableResearch();
-	if (Available.Num() == 0)
+	// The topic set is fixed once the research graph is loaded, so rows are only built once.
+	if (TopicIDs.Num() != ResearchSub->GetNumResearchTopics())
 	{
-		UTextBlock* EmptyText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("EmptyResearch"));
-		EmptyText->SetText(FText::FromString(TEXT("No research available.")));
-		FSlateFontInfo EmptyFont = EmptyText->GetFont();
-		EmptyFont.Size = 11;
-		EmptyText->SetFont(EmptyFont);
-		EmptyText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
-		ResearchNodesPanel->AddChild(EmptyText);
+		BuildTopicRows(ResearchSub);
 	}
-	else
+
+	int32 NumAvailable = 0;
+	for (int32 NodeIndex = 0; NodeIndex < TopicIDs.Num(); ++NodeIndex)
 	{
-		int32 NodeIndex = 0;
-		for (const FName& TopicID : Available)
-		{
-			FString DisplayStr = FString::Printf(TEXT("  [Start] %s"), *TopicID.ToString());
-
-			// Try to get display name from DataTable
-			if (ResearchSub->ResearchDataTable)
-			{
-				if (const FResearchNodeData* Row = ResearchSub->ResearchDataTable->FindRow<FResearchNodeData>(TopicID, TEXT("RefreshUI")))
-				{
-					DisplayStr = FString::Printf(TEXT("  [Start] %s  |  %.0fs  |  $%d"),
-						*Row->DisplayName.ToString(), Row->ResearchDuration, Row->ResearchCost);
-				}
-			}
-
-			UTextBlock* NodeText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(),
-				*FString::Printf(TEXT("ResearchNode_%d"), NodeIndex++));
-			NodeText->SetText(FText::FromString(DisplayStr));
-			FSlateFontInfo NodeFont = NodeText->GetFont();
-			NodeFont.Size = 12;
-			NodeText->SetFont(NodeFont);
-			NodeText->SetColorAndOpacity(FSlateColor(FLinearColor(0.3f, 1.0f, 0.3f)));
-			ResearchNodesPanel->AddChild(NodeText);
-		}
+		const bool bAvailable = ResearchSub->IsResearchAvailable(TopicIDs[NodeIndex]);
+		const bool bCompleted = ResearchSub->IsResearched(TopicIDs[NodeIndex]);
+
+		AvailableRows[NodeIndex]->SetVisibility(bAvailable ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+		CompletedRows[NodeIndex]->SetVisibility(bCompleted ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+		NumAvailable += bAvailable ? 1 : 0;
+	}
+
+	if (EmptyResearchText)
+	{
+		EmptyResearchText->SetVisibility(NumAvailable == 0 ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
 	}
 
 	UpdateResearchProgress();
 
-	UE_LOG(LogZooKeeper, Log, TEXT("ResearchTreeWidget: Refreshed with %d available topics."), Available.Num());
+	UE_LOG(LogZooKeeper, Verbose, TEXT("ResearchTreeWidget: Refreshed with %d available topics."), NumAvailable);
 }
 
 void UResearchTreeWidget::StartResearchClicked(FName ResearchID)
@@ -177,10 +261,9 @@ void UResearchTreeWidget::StartResearchClicked(FName ResearchID)
 	UResearchSubsystem* ResearchSub = World->GetSubsystem<UResearchSubsystem>();
 	if (ResearchSub)
 	{
+		// The tree refreshes from OnResearchStarted.
 		ResearchSub->StartResearch(ResearchID);
 	}
-
-	RefreshResearchTree();
 }
 
 void UResearchTreeWidget::UpdateResearchProgress()
@@ -7,6 +7,7 @@
 class UTextBlock;
 class UProgressBar;
 class UPanelWidget;
+class UResearchSubsystem;
 
 /**
  * UResearchTreeWidget
@@ -14,6 +15,10 @@ class UPanelWidget;
  * Widget that displays the zoo's research tree, showing available research
  * nodes, the currently active research topic, and its progress.
  * Builds its widget tree entirely in C++ — no Blueprint asset required.
+ *
+ * Every topic gets one available row and one completed row, created once.
+ * A refresh only toggles their visibility, and the widget refreshes itself
+ * when research starts or completes.
  */
 UCLASS(meta = (DisplayName = "Research Tree Widget"))
 class ZOOKEEPER_API UResearchTreeWidget : public UUserWidget
@@ -25,6 +30,7 @@ public:
 	//  Functions
 	// -------------------------------------------------------------------
 
+	/** Shows the rows of available and completed topics. Creates the rows the first time. */
 	UFUNCTION(BlueprintCallable, Category = "Zoo|Research")
 	void RefreshResearchTree();
 
@@ -36,11 +42,34 @@ public:
 
 protected:
 	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 private:
+	UFUNCTION()
+	void HandleResearchChanged(FName ResearchID);
+
+	/** Creates the rows of every research topic. */
+	void BuildTopicRows(const UResearchSubsystem* ResearchSub);
+
 	UPROPERTY()
 	TObjectPtr<UPanelWidget> ResearchNodesPanel;
 
+	UPROPERTY()
+	TObjectPtr<UPanelWidget> CompletedNodesPanel;
+
+	UPROPERTY()
+	TObjectPtr<UTextBlock> EmptyResearchText;
+
+	/** Topic IDs in research graph order, parallel to the row arrays. */
+	TArray<FName> TopicIDs;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTextBlock>> AvailableRows;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTextBlock>> CompletedRows;
+
 	UPROPERTY()
 	TObjectPtr<UTextBlock> CurrentResearchText;
 
@@ -0,0 +1,200 @@
+#include "BTTask_VisitPointOfInterest.h"
+#include "VisitorCharacter.h"
+#include "Subsystems/VisitorSubsystem.h"
+#include "ZooKeeper.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "Navigation/PathFollowingComponent.h"
+
+UBTTask_VisitPointOfInterest::UBTTask_VisitPointOfInterest()
+{
+	NodeName = TEXT("Visit Point Of Interest");
+	bNotifyTick = true;
+	AcceptanceRadius = 150.0f;
+	MaxQueueWait = 60.0f;
+	AbandonSatisfactionPenalty = 0.05f;
+
+	PointOfInterestKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_VisitPointOfInterest, PointOfInterestKey), AActor::StaticClass());
+}
+
+void UBTTask_VisitPointOfInterest::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* Blackboard = GetBlackboardAsset())
+	{
+		PointOfInterestKey.ResolveSelectedKey(*Blackboard);
+	}
+}
+
+EBTNodeResult::Type UBTTask_VisitPointOfInterest::ExecuteTask(UBehaviorTreeComponent& OwnerComp,
+                                                              uint8* NodeMemory)
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	const UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	if (!AIController || !Blackboard || !Cast<AVisitorCharacter>(AIController->GetPawn()))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	AActor* PointOfInterest = Cast<AActor>(Blackboard->GetValueAsObject(PointOfInterestKey.SelectedKeyName));
+	if (!PointOfInterest)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FVisitMemory& Memory = *CastInstanceNodeMemory<FVisitMemory>(NodeMemory);
+	Memory = FVisitMemory();
+	Memory.PointOfInterest = PointOfInterest;
+
+	// A partial path would end the walk short of the point of interest.
+	FAIMoveRequest MoveRequest(PointOfInterest);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	MoveRequest.SetAllowPartialPath(false);
+
+	const FPathFollowingRequestResult MoveResult = AIController->MoveTo(MoveRequest);
+	if (MoveResult.Code == EPathFollowingRequestResult::Failed)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	if (MoveResult.Code == EPathFollowingRequestResult::AlreadyAtGoal)
+	{
+		return JoinQueue(OwnerComp, Memory) ? EBTNodeResult::InProgress : EBTNodeResult::Failed;
+	}
+
+	// The queue is joined from OnMessage once the move reports how it ended.
+	WaitForMessage(OwnerComp, UBrainComponent::AIMessage_MoveFinished, MoveResult.MoveId);
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UBTTask_VisitPointOfInterest::AbortTask(UBehaviorTreeComponent& OwnerComp,
+                                                            uint8* NodeMemory)
+{
+	FVisitMemory& Memory = *CastInstanceNodeMemory<FVisitMemory>(NodeMemory);
+	LeaveQueue(OwnerComp, Memory);
+
+	if (AAIController* AIController = OwnerComp.GetAIOwner())
+	{
+		AIController->StopMovement();
+	}
+
+	return EBTNodeResult::Aborted;
+}
+
+void UBTTask_VisitPointOfInterest::TickTask(UBehaviorTreeComponent& OwnerComp,
+                                            uint8* NodeMemory, float DeltaSeconds)
+{
+	FVisitMemory& Memory = *CastInstanceNodeMemory<FVisitMemory>(NodeMemory);
+	AActor* PointOfInterest = Memory.PointOfInterest.Get();
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	AVisitorCharacter* Visitor = AIController ? Cast<AVisitorCharacter>(AIController->GetPawn()) : nullptr;
+	const UWorld* World = OwnerComp.GetWorld();
+	UVisitorSubsystem* VisitorSys = World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+	if (!PointOfInterest || !Visitor || !VisitorSys)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	// Still walking there.
+	if (!Memory.bQueued)
+	{
+		return;
+	}
+
+	// The subsystem removes visitors whose service has completed.
+	if (!VisitorSys->IsInQueue(PointOfInterest, Visitor))
+	{
+		Memory.bQueued = false;
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	if (VisitorSys->IsBeingServed(PointOfInterest, Visitor))
+	{
+		return;
+	}
+
+	Memory.QueueWaitTime += DeltaSeconds;
+	if (Memory.QueueWaitTime >= MaxQueueWait)
+	{
+		LeaveQueue(OwnerComp, Memory);
+		Visitor->UpdateSatisfaction(-AbandonSatisfactionPenalty);
+
+		UE_LOG(LogZooKeeper, Verbose, TEXT("BTTask_VisitPointOfInterest: '%s' gave up waiting at [%s]."),
+		       *Visitor->GetName(), *PointOfInterest->GetName());
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+	}
+}
+
+void UBTTask_VisitPointOfInterest::OnMessage(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, FName Message,
+                                             int32 RequestID, bool bSuccess)
+{
+	// A move that failed or was aborted ends the visit without queuing.
+	FVisitMemory& Memory = *CastInstanceNodeMemory<FVisitMemory>(NodeMemory);
+	if (!bSuccess || !JoinQueue(OwnerComp, Memory))
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+	}
+}
+
+uint16 UBTTask_VisitPointOfInterest::GetInstanceMemorySize() const
+{
+	return sizeof(FVisitMemory);
+}
+
+void UBTTask_VisitPointOfInterest::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+                                                    EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FVisitMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_VisitPointOfInterest::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+                                                 EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FVisitMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTTask_VisitPointOfInterest::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Queue at %s (give up after %.0fs)"), *PointOfInterestKey.SelectedKeyName.ToString(), MaxQueueWait);
+}
+
+bool UBTTask_VisitPointOfInterest::JoinQueue(UBehaviorTreeComponent& OwnerComp, FVisitMemory& Memory) const
+{
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+	AVisitorCharacter* Visitor = AIController ? Cast<AVisitorCharacter>(AIController->GetPawn()) : nullptr;
+	const UWorld* World = OwnerComp.GetWorld();
+	UVisitorSubsystem* VisitorSys = World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+	AActor* PointOfInterest = Memory.PointOfInterest.Get();
+	if (!Visitor || !VisitorSys || !PointOfInterest)
+	{
+		return false;
+	}
+
+	Memory.bQueued = VisitorSys->JoinQueue(PointOfInterest, Visitor);
+	Memory.QueueWaitTime = 0.0f;
+	return Memory.bQueued;
+}
+
+void UBTTask_VisitPointOfInterest::LeaveQueue(UBehaviorTreeComponent& OwnerComp, FVisitMemory& Memory) const
+{
+	if (!Memory.bQueued)
+	{
+		return;
+	}
+
+	Memory.bQueued = false;
+
+	const AAIController* AIController = OwnerComp.GetAIOwner();
+	AVisitorCharacter* Visitor = AIController ? Cast<AVisitorCharacter>(AIController->GetPawn()) : nullptr;
+	const UWorld* World = OwnerComp.GetWorld();
+	UVisitorSubsystem* VisitorSys = World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+	if (Visitor && VisitorSys)
+	{
+		VisitorSys->LeaveQueue(Memory.PointOfInterest.Get(), Visitor);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "BTTask_VisitPointOfInterest.generated.h"
+
+/**
+ * UBTTask_VisitPointOfInterest
+ *
+ * Walks the visitor to a point of interest and uses it through the
+ * VisitorSubsystem's queue. The visitor joins the queue on arrival and
+ * waits until its service completes. Visitors that wait in line longer
+ * than their patience leave the queue, and so does a visitor whose task
+ * is aborted. A visitor that despawns is removed by the subsystem.
+ */
+UCLASS(meta = (DisplayName = "Visit Point Of Interest"))
+class ZOOKEEPER_API UBTTask_VisitPointOfInterest : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_VisitPointOfInterest();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	virtual void OnMessage(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, FName Message, int32 RequestID, bool bSuccess) override;
+
+public:
+	/** Blackboard key holding the point of interest, e.g. the result of FindFoodStall. */
+	UPROPERTY(EditAnywhere, Category = "Zoo|Visit")
+	FBlackboardKeySelector PointOfInterestKey;
+
+	/** Distance (cm) from the point of interest at which the visitor joins its queue. */
+	UPROPERTY(EditAnywhere, Category = "Zoo|Visit", meta = (ClampMin = "0.0"))
+	float AcceptanceRadius;
+
+	/** Seconds the visitor waits in line before giving up. Time being served does not count. */
+	UPROPERTY(EditAnywhere, Category = "Zoo|Visit", meta = (ClampMin = "0.0"))
+	float MaxQueueWait;
+
+	/** Satisfaction lost when the visitor gives up on a queue. */
+	UPROPERTY(EditAnywhere, Category = "Zoo|Visit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float AbandonSatisfactionPenalty;
+
+private:
+	struct FVisitMemory
+	{
+		TWeakObjectPtr<AActor> PointOfInterest;
+		float QueueWaitTime = 0.0f;
+		bool bQueued = false;
+	};
+
+	/** Joins the queue on arrival. Returns false if the queue is full. */
+	bool JoinQueue(UBehaviorTreeComponent& OwnerComp, FVisitMemory& Memory) const;
+
+	/** Leaves the queue if the visitor is still in it. */
+	void LeaveQueue(UBehaviorTreeComponent& OwnerComp, FVisitMemory& Memory) const;
+};
@@ -1,24 +1,57 @@
 #include "VisitorAIController.h"
 #include "VisitorCharacter.h"
+#include "Subsystems/VisitorSubsystem.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "Navigation/CrowdFollowingComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Core/ZooBehaviorTreeComponent.h"
 #include "ZooKeeper.h"
 
-AVisitorAIController::AVisitorAIController()
+AVisitorAIController::AVisitorAIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCrowdFollowingComponent>(TEXT("PathFollowingComponent")))
 {
+	// Only followers tick; leaders are driven by the behavior tree.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// RunBehaviorTree reuses this, so the LOD subsystem can throttle decisions.
+	BrainComponent = CreateDefaultSubobject<UZooBehaviorTreeComponent>(TEXT("BehaviorTreeComponent"));
+
 	VisitorBehaviorTree = nullptr;
+	DestinationWaitWeight = 1.0f;
+	DestinationCrowdWeight = 30.0f;
+	FollowAcceptanceRadius = 60.0f;
+	FollowPathfindDistance = 1500.0f;
 }
 
 void AVisitorAIController::OnPossess(APawn* InPawn)
 {
 	Super::OnPossess(InPawn);
 
+	UpdateGroupRole();
+}
+
+void AVisitorAIController::UpdateGroupRole()
+{
+	const AVisitorCharacter* Visitor = Cast<AVisitorCharacter>(GetPawn());
+	if (Visitor && !Visitor->IsGroupLeader())
+	{
+		// Followers leave decisions and path queries to their leader.
+		UZooCrowdManager::ConfigureAgent(this, CrowdSettings, true);
+		SetActorTickEnabled(true);
+		return;
+	}
+
+	UZooCrowdManager::ConfigureAgent(this, CrowdSettings);
+	SetActorTickEnabled(false);
+
 	if (VisitorBehaviorTree)
 	{
 		RunBehaviorTree(VisitorBehaviorTree);
 		UE_LOG(LogZooKeeper, Log, TEXT("VisitorAIController [%s] started behavior tree for pawn [%s]."),
-			*GetName(), *InPawn->GetName());
+			*GetName(), *GetNameSafe(GetPawn()));
 	}
 	else
 	{
@@ -27,6 +60,65 @@ void AVisitorAIController::OnPossess(APawn* InPawn)
 	}
 }
 
+void AVisitorAIController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	AVisitorCharacter* Visitor = Cast<AVisitorCharacter>(GetPawn());
+	if (!Visitor)
+	{
+		return;
+	}
+
+	AVisitorCharacter* Leader = Visitor->GetGroupLeader();
+	if (!Leader || Leader == Visitor)
+	{
+		// Promoted to leader (or the group dissolved): take over decision-making.
+		StopMovement();
+		UpdateGroupRole();
+		return;
+	}
+
+	TickFollowLeader(Visitor, Leader);
+}
+
+void AVisitorAIController::TickFollowLeader(AVisitorCharacter* Visitor, AVisitorCharacter* Leader)
+{
+	Visitor->CurrentState = Leader->CurrentState;
+
+	const FVector VisitorLocation = Visitor->GetActorLocation();
+	const FVector LeaderLocation = Leader->GetActorLocation();
+
+	// Too far behind to steer in a straight line: fall back to a single path query.
+	if (FVector::DistSquared2D(VisitorLocation, LeaderLocation) > FMath::Square(FollowPathfindDistance))
+	{
+		if (GetMoveStatus() != EPathFollowingStatus::Moving)
+		{
+			MoveToActor(Leader, FollowPathfindDistance * 0.5f);
+		}
+		return;
+	}
+
+	if (GetMoveStatus() == EPathFollowingStatus::Moving)
+	{
+		StopMovement();
+	}
+
+	const FVector SlotLocation = LeaderLocation + Leader->GetActorRotation().RotateVector(Visitor->FormationOffset);
+	FVector ToSlot = SlotLocation - VisitorLocation;
+	ToSlot.Z = 0.0f;
+
+	const float Distance = ToSlot.Size();
+	if (Distance <= FollowAcceptanceRadius)
+	{
+		return;
+	}
+
+	// Ease in over the last couple of metres so followers don't overshoot their slot.
+	const float Scale = FMath::Clamp(Distance / (FollowAcceptanceRadius * 4.0f), 0.25f, 1.0f);
+	Visitor->AddMovementInput(ToSlot / Distance, Scale);
+}
+
 void AVisitorAIController::OnUnPossess()
 {
 	UBrainComponent* BrainComp = GetBrainComponent();
@@ -53,7 +145,7 @@ void AVisitorAIController::EnsureCacheValid(TArray<AActor*>& Cache, const FName&
 	}
 }
 
-AActor* AVisitorAIController::FindNearestFromCache(TArray<AActor*>& Cache, const FName& Tag) const
+AActor* AVisitorAIController::FindBestFromCache(TArray<AActor*>& Cache, const FName& Tag) const
 {
 	APawn* ControlledPawn = GetPawn();
 	if (!ControlledPawn)
@@ -63,9 +155,19 @@ AActor* AVisitorAIController::FindNearestFromCache(TArray<AActor*>& Cache, const
 
 	EnsureCacheValid(Cache, Tag);
 
+	const UWorld* World = GetWorld();
+	const UVisitorSubsystem* VisitorSys = World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+
+	// Convert distance to seconds so it can be weighed against queue time.
+	float WalkSpeed = 150.0f;
+	if (const UPawnMovementComponent* Movement = ControlledPawn->GetMovementComponent())
+	{
+		WalkSpeed = FMath::Max(Movement->GetMaxSpeed(), 1.0f);
+	}
+
 	const FVector PawnLocation = ControlledPawn->GetActorLocation();
-	AActor* Nearest = nullptr;
-	float NearestDistSq = TNumericLimits<float>::Max();
+	AActor* Best = nullptr;
+	float BestCost = TNumericLimits<float>::Max();
 
 	for (AActor* Actor : Cache)
 	{
@@ -74,28 +176,38 @@ AActor* AVisitorAIController::FindNearestFromCache(TArray<AActor*>& Cache, const
 			continue;
 		}
 
-		const float DistSq = FVector::DistSquared(PawnLocation, Actor->GetActorLocation());
-		if (DistSq < NearestDistSq)
+		float Cost = FVector::Dist(PawnLocation, Actor->GetActorLocation()) / WalkSpeed;
+		if (VisitorSys)
+		{
+			if (VisitorSys->IsPointOfInterestFull(Actor))
+			{
+				continue;
+			}
+			Cost += DestinationWaitWeight * VisitorSys->GetExpectedWait(Actor);
+			Cost += DestinationCrowdWeight * VisitorSys->GetCrowdingFactor(Actor->GetActorLocation());
+		}
+
+		if (Cost < BestCost)
 		{
-			NearestDistSq = DistSq;
-			Nearest = Actor;
+			BestCost = Cost;
+			Best = Actor;
 		}
 	}
 
-	return Nearest;
+	return Best;
 }
 
 AActor* AVisitorAIController::FindNearestAttraction() const
 {
-	return FindNearestFromCache(CachedAttractions, FName(TEXT("Attraction")));
+	return FindBestFromCache(CachedAttractions, FName(TEXT("Attraction")));
 }
 
 AActor* AVisitorAIController::FindFoodStall() const
 {
-	return FindNearestFromCache(CachedFoodStalls, FName(TEXT("FoodStall")));
+	return FindBestFromCache(CachedFoodStalls, FName(TEXT("FoodStall")));
 }
 
 AActor* AVisitorAIController::FindBench() const
 {
-	return FindNearestFromCache(CachedBenches, FName(TEXT("Bench")));
+	return FindBestFromCache(CachedBenches, FName(TEXT("Bench")));
 }
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "Core/ZooCrowdManager.h"
 #include "VisitorAIController.generated.h"
 
 class UBehaviorTree;
@@ -12,6 +13,14 @@ class UBehaviorTree;
  * AI controller that drives visitor behavior using a behavior tree.
  * Provides utility functions for the behavior tree to find points
  * of interest within the zoo (attractions, food stalls, benches).
+ * Destinations are chosen by trading walking time against the expected
+ * queue wait reported by the VisitorSubsystem, so load spreads across POIs.
+ *
+ * Only group leaders run the behavior tree. Followers steer towards their
+ * formation slot behind the leader and only path-find when left far behind.
+ *
+ * Path following uses DetourCrowd. Leaders are simulated agents with local
+ * avoidance; followers only register as obstacles, since they steer themselves.
  */
 UCLASS(Blueprintable, meta = (DisplayName = "Visitor AI Controller"))
 class ZOOKEEPER_API AVisitorAIController : public AAIController
@@ -19,11 +28,12 @@ class ZOOKEEPER_API AVisitorAIController : public AAIController
 	GENERATED_BODY()
 
 public:
-	AVisitorAIController();
+	AVisitorAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	//~ Begin AAIController Interface
 	virtual void OnPossess(APawn* InPawn) override;
 	virtual void OnUnPossess() override;
+	virtual void Tick(float DeltaSeconds) override;
 	//~ End AAIController Interface
 
 	// -------------------------------------------------------------------
@@ -31,22 +41,22 @@ public:
 	// -------------------------------------------------------------------
 
 	/**
-	 * Finds the nearest attraction (e.g. enclosure with animals) to the controlled visitor.
-	 * @return The nearest attraction actor, or nullptr if none found.
+	 * Finds the best attraction (e.g. enclosure with animals) for the controlled visitor.
+	 * @return The best attraction actor, or nullptr if none found.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor|AI")
 	AActor* FindNearestAttraction() const;
 
 	/**
-	 * Finds the nearest food stall to the controlled visitor.
-	 * @return The nearest food stall actor, or nullptr if none found.
+	 * Finds the food stall with the lowest combined walking time and expected wait.
+	 * @return The chosen food stall actor, or nullptr if none found.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor|AI")
 	AActor* FindFoodStall() const;
 
 	/**
-	 * Finds the nearest bench or resting spot to the controlled visitor.
-	 * @return The nearest bench actor, or nullptr if none found.
+	 * Finds the bench or resting spot with the lowest combined walking time and expected wait.
+	 * @return The chosen bench actor, or nullptr if none found.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor|AI")
 	AActor* FindBench() const;
@@ -60,9 +70,44 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Visitor|AI")
 	TObjectPtr<UBehaviorTree> VisitorBehaviorTree;
 
+	/**
+	 * How many seconds of walking a visitor will accept to avoid one second of queueing.
+	 * 0 ignores queues entirely (always nearest); higher values spread visitors further.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Visitor|AI", meta = (ClampMin = "0.0"))
+	float DestinationWaitWeight;
+
+	/**
+	 * Extra walking seconds a visitor will accept to avoid a fully crowded destination.
+	 * Scaled by the destination's crowding factor (0-1) from the visitor subsystem.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Visitor|AI", meta = (ClampMin = "0.0"))
+	float DestinationCrowdWeight;
+
+	/** Distance (cm) from the formation slot within which a follower stops steering. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Visitor|AI", meta = (ClampMin = "0.0"))
+	float FollowAcceptanceRadius;
+
+	/** Distance (cm) from the leader beyond which a follower path-finds instead of steering directly. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Visitor|AI", meta = (ClampMin = "0.0"))
+	float FollowPathfindDistance;
+
+	/** DetourCrowd avoidance settings. Disable avoidance to fall back to plain path following. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Zoo|Visitor|AI")
+	FZooCrowdAgentSettings CrowdSettings;
+
 private:
-	/** Finds the nearest actor from the given cached array (populates cache lazily). */
-	AActor* FindNearestFromCache(TArray<AActor*>& Cache, const FName& Tag) const;
+	/** Starts the behavior tree if this visitor leads its group, otherwise starts following. */
+	void UpdateGroupRole();
+
+	/** Steers a follower towards its formation slot behind the group leader. */
+	void TickFollowLeader(AVisitorCharacter* Visitor, AVisitorCharacter* Leader);
+
+	/**
+	 * Picks the cached actor with the lowest travel time plus weighted expected wait,
+	 * skipping points of interest whose queue is full (populates cache lazily).
+	 */
+	AActor* FindBestFromCache(TArray<AActor*>& Cache, const FName& Tag) const;
 
 	/** Refresh a cached actor list if it's empty. */
 	void EnsureCacheValid(TArray<AActor*>& Cache, const FName& Tag) const;
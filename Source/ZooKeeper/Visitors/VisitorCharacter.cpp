@@ -1,18 +1,20 @@
 #include "VisitorCharacter.h"
 #include "Subsystems/VisitorSubsystem.h"
 #include "Subsystems/EconomySubsystem.h"
+#include "Subsystems/CharacterLODSubsystem.h"
 #include "ZooKeeper.h"
 
 AVisitorCharacter::AVisitorCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Needs and satisfaction are updated in batches by the VisitorSubsystem.
+	PrimaryActorTick.bCanEverTick = false;
 
-	Satisfaction = 0.5f;
 	MoneyToSpend = FMath::RandRange(50, 150);
 	AdmissionFee = 10;
-	TimeInZoo = 0.0f;
 	MaxTimeInZoo = FMath::RandRange(300.0f, 600.0f);
 	CurrentState = EVisitorState::Entering;
+	GroupID = INDEX_NONE;
+	FormationOffset = FVector::ZeroVector;
 }
 
 void AVisitorCharacter::BeginPlay()
@@ -29,14 +31,24 @@ void AVisitorCharacter::BeginPlay()
 			UE_LOG(LogZooKeeper, Log, TEXT("VisitorCharacter [%s] registered with VisitorSubsystem."), *GetName());
 		}
 
+		if (UCharacterLODSubsystem* LODSubsystem = World->GetSubsystem<UCharacterLODSubsystem>())
+		{
+			LODSubsystem->RegisterCharacter(this);
+		}
+
 		// Pay admission fee to the economy.
 		if (AdmissionFee > 0)
 		{
-			if (UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>())
+			UEconomySubsystem* EconSys = World->GetSubsystem<UEconomySubsystem>();
+			const int32 Fee = EconSys ? EconSys->ApplyVisitorSpending(AdmissionFee) : AdmissionFee;
+			if (Fee > 0)
 			{
-				EconSys->AddIncome(AdmissionFee, TEXT("Visitor admission"));
+				if (EconSys)
+				{
+					EconSys->AddIncome(Fee, TEXT("Visitor admission"), ETransactionCategory::VisitorTicket);
+				}
+				SpendMoney(Fee);
 			}
-			SpendMoney(AdmissionFee);
 		}
 	}
 }
@@ -52,34 +64,21 @@ void AVisitorCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 			VisitorSubsystem->UnregisterVisitor(this);
 			UE_LOG(LogZooKeeper, Log, TEXT("VisitorCharacter [%s] unregistered from VisitorSubsystem."), *GetName());
 		}
+
+		if (UCharacterLODSubsystem* LODSubsystem = World->GetSubsystem<UCharacterLODSubsystem>())
+		{
+			LODSubsystem->UnregisterCharacter(this);
+		}
 	}
 
 	Super::EndPlay(EndPlayReason);
 }
 
-void AVisitorCharacter::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	TimeInZoo += DeltaTime;
-
-	// Gradually reduce satisfaction over time if nothing positive happens
-	if (CurrentState != EVisitorState::ViewingAnimal && CurrentState != EVisitorState::BuyingFood)
-	{
-		const float PassiveDecay = 0.001f * DeltaTime;
-		UpdateSatisfaction(-PassiveDecay);
-	}
-}
-
 void AVisitorCharacter::UpdateSatisfaction(float Delta)
 {
-	const float OldSatisfaction = Satisfaction;
-	Satisfaction = FMath::Clamp(Satisfaction + Delta, 0.0f, 1.0f);
-
-	if (!FMath::IsNearlyEqual(OldSatisfaction, Satisfaction))
+	if (UVisitorSubsystem* VisitorSubsystem = GetVisitorSubsystem())
 	{
-		UE_LOG(LogZooKeeper, Verbose, TEXT("Visitor [%s] satisfaction changed: %.2f -> %.2f"),
-			*GetName(), OldSatisfaction, Satisfaction);
+		VisitorSubsystem->AddVisitorSatisfaction(this, Delta);
 	}
 }
 
@@ -92,6 +91,23 @@ bool AVisitorCharacter::SpendMoney(int32 Amount)
 		return false;
 	}
 
+	if (GroupID != INDEX_NONE)
+	{
+		if (UVisitorSubsystem* VisitorSubsystem = GetVisitorSubsystem())
+		{
+			if (!VisitorSubsystem->SpendGroupMoney(GroupID, Amount))
+			{
+				UE_LOG(LogZooKeeper, Verbose, TEXT("Visitor [%s] group %d cannot afford %d (has %d)."),
+					*GetName(), GroupID, Amount, VisitorSubsystem->GetGroupMoney(GroupID));
+				return false;
+			}
+
+			UE_LOG(LogZooKeeper, Verbose, TEXT("Visitor [%s] spent %d from group %d, remaining: %d"),
+				*GetName(), Amount, GroupID, VisitorSubsystem->GetGroupMoney(GroupID));
+			return true;
+		}
+	}
+
 	if (MoneyToSpend < Amount)
 	{
 		UE_LOG(LogZooKeeper, Verbose, TEXT("Visitor [%s] cannot afford %d (has %d)."),
@@ -107,19 +123,26 @@ bool AVisitorCharacter::SpendMoney(int32 Amount)
 
 float AVisitorCharacter::GetSatisfaction() const
 {
-	return Satisfaction;
+	const UVisitorSubsystem* VisitorSubsystem = GetVisitorSubsystem();
+	return VisitorSubsystem ? VisitorSubsystem->GetVisitorSatisfaction(this) : 0.5f;
+}
+
+float AVisitorCharacter::GetTimeInZoo() const
+{
+	const UVisitorSubsystem* VisitorSubsystem = GetVisitorSubsystem();
+	return VisitorSubsystem ? VisitorSubsystem->GetVisitorTimeInZoo(this) : 0.0f;
 }
 
 bool AVisitorCharacter::ShouldLeave() const
 {
 	// Leave if time is up
-	if (TimeInZoo >= MaxTimeInZoo)
+	if (GetTimeInZoo() >= MaxTimeInZoo)
 	{
 		return true;
 	}
 
 	// Leave if out of money and satisfaction is very low
-	if (MoneyToSpend <= 0 && Satisfaction < 0.2f)
+	if (GetAvailableMoney() <= 0 && GetSatisfaction() < 0.2f)
 	{
 		return true;
 	}
@@ -132,3 +155,39 @@ bool AVisitorCharacter::ShouldLeave() const
 
 	return false;
 }
+
+int32 AVisitorCharacter::GetAvailableMoney() const
+{
+	if (GroupID != INDEX_NONE)
+	{
+		if (const UVisitorSubsystem* VisitorSubsystem = GetVisitorSubsystem())
+		{
+			return VisitorSubsystem->GetGroupMoney(GroupID);
+		}
+	}
+
+	return MoneyToSpend;
+}
+
+bool AVisitorCharacter::IsGroupLeader() const
+{
+	const AVisitorCharacter* Leader = GetGroupLeader();
+	return !Leader || Leader == this;
+}
+
+AVisitorCharacter* AVisitorCharacter::GetGroupLeader() const
+{
+	if (GroupID == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const UVisitorSubsystem* VisitorSubsystem = GetVisitorSubsystem();
+	return VisitorSubsystem ? VisitorSubsystem->GetGroupLeader(GroupID) : nullptr;
+}
+
+UVisitorSubsystem* AVisitorCharacter::GetVisitorSubsystem() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UVisitorSubsystem>() : nullptr;
+}
@@ -4,6 +4,8 @@
 #include "GameFramework/Character.h"
 #include "VisitorCharacter.generated.h"
 
+class UVisitorSubsystem;
+
 /**
  * EVisitorState
  *
@@ -23,9 +25,11 @@ enum class EVisitorState : uint8
 /**
  * AVisitorCharacter
  *
- * Represents a visitor navigating the zoo. Tracks satisfaction, spending
- * money, and time in the zoo. Registers/unregisters with the VisitorSubsystem
- * on BeginPlay/EndPlay respectively.
+ * Represents a visitor navigating the zoo. Registers/unregisters with the
+ * VisitorSubsystem on BeginPlay/EndPlay respectively. The subsystem owns
+ * the visitor's needs, satisfaction, and time in the zoo and updates them
+ * in batches, so visitors do not tick. Visitors that arrive as part of a
+ * group share the group's satisfaction and spending money.
  */
 UCLASS(Blueprintable, meta = (DisplayName = "Visitor Character"))
 class ZOOKEEPER_API AVisitorCharacter : public ACharacter
@@ -38,7 +42,6 @@ public:
 	//~ Begin AActor Interface
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-	virtual void Tick(float DeltaTime) override;
 	//~ End AActor Interface
 
 	// -------------------------------------------------------------------
@@ -68,18 +71,30 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor")
 	float GetSatisfaction() const;
 
+	/** Returns the seconds this visitor has been in the zoo. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor")
+	float GetTimeInZoo() const;
+
 	/** Returns true if the visitor has exceeded their maximum time or has no money and low satisfaction. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor")
 	bool ShouldLeave() const;
 
+	/** Returns the money available to this visitor: the group's pooled budget, or MoneyToSpend when alone. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor")
+	int32 GetAvailableMoney() const;
+
+	/** Returns true if this visitor is alone or leads its group. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor|Group")
+	bool IsGroupLeader() const;
+
+	/** Returns the leader of this visitor's group, or nullptr when visiting alone. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Zoo|Visitor|Group")
+	AVisitorCharacter* GetGroupLeader() const;
+
 	// -------------------------------------------------------------------
 	//  State
 	// -------------------------------------------------------------------
 
-	/** Current satisfaction level. 0 = miserable, 1 = ecstatic. */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitor", meta = (ClampMin = "0.0", ClampMax = "1.0"))
-	float Satisfaction;
-
 	/** Amount of money the visitor is willing to spend. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitor", meta = (ClampMin = "0"))
 	int32 MoneyToSpend;
@@ -88,10 +103,6 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitor", meta = (ClampMin = "0"))
 	int32 AdmissionFee;
 
-	/** Elapsed time (in seconds) this visitor has been in the zoo. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitor")
-	float TimeInZoo;
-
 	/** Maximum time (in seconds) this visitor will stay before wanting to leave. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitor", meta = (ClampMin = "0.0"))
 	float MaxTimeInZoo;
@@ -99,4 +110,25 @@ public:
 	/** The visitor's current behavioral state. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zoo|Visitor")
 	EVisitorState CurrentState;
+
+	/** Row name of the visitor type this visitor was spawned as. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitor")
+	FName VisitorTypeID;
+
+	/** The group this visitor belongs to, or INDEX_NONE when visiting alone. Set before BeginPlay. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitor|Group")
+	int32 GroupID;
+
+	/** Position relative to the group leader (in the leader's local space) that this member steers towards. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Zoo|Visitor|Group")
+	FVector FormationOffset;
+
+private:
+	friend class UVisitorSubsystem;
+
+	/** Returns the visitor subsystem, or nullptr outside a game world. */
+	UVisitorSubsystem* GetVisitorSubsystem() const;
+
+	/** Row of this visitor in the subsystem's needs store, or INDEX_NONE when unregistered. */
+	int32 NeedsIndex = INDEX_NONE;
 };
@@ -5,6 +5,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogZooKeeper, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("ZooKeeper"), STATGROUP_ZooKeeper, STATCAT_Advanced);
+
 class FZooKeeperModule : public FDefaultGameModuleImpl
 {
 public: